@@ -3,6 +3,7 @@ set(FRAMEWORK_ROOT_DIR "${BHUMAN_PREFIX}/Src/Libs/Framework")
 set(FRAMEWORK_SOURCES
     "${FRAMEWORK_ROOT_DIR}/Blackboard.cpp"
     "${FRAMEWORK_ROOT_DIR}/Blackboard.h"
+    "${FRAMEWORK_ROOT_DIR}/Checkpointable.h"
     "${FRAMEWORK_ROOT_DIR}/Configuration.h"
     "${FRAMEWORK_ROOT_DIR}/Debug.cpp"
     "${FRAMEWORK_ROOT_DIR}/Debug.h"
@@ -10,12 +11,17 @@ set(FRAMEWORK_SOURCES
     "${FRAMEWORK_ROOT_DIR}/DebugHandler.h"
     "${FRAMEWORK_ROOT_DIR}/Communication.cpp"
     "${FRAMEWORK_ROOT_DIR}/Communication.h"
+    "${FRAMEWORK_ROOT_DIR}/FrameArena.cpp"
+    "${FRAMEWORK_ROOT_DIR}/FrameArena.h"
     "${FRAMEWORK_ROOT_DIR}/FrameExecutionUnit.cpp"
     "${FRAMEWORK_ROOT_DIR}/FrameExecutionUnit.h"
     "${FRAMEWORK_ROOT_DIR}/Logger.cpp"
     "${FRAMEWORK_ROOT_DIR}/Logger.h"
     "${FRAMEWORK_ROOT_DIR}/LoggingTools.cpp"
     "${FRAMEWORK_ROOT_DIR}/LoggingTools.h"
+    "${FRAMEWORK_ROOT_DIR}/LogReplayBarrier.cpp"
+    "${FRAMEWORK_ROOT_DIR}/LogReplayBarrier.h"
+    "${FRAMEWORK_ROOT_DIR}/MemoizedFunction.h"
     "${FRAMEWORK_ROOT_DIR}/Module.cpp"
     "${FRAMEWORK_ROOT_DIR}/Module.h"
     "${FRAMEWORK_ROOT_DIR}/ModuleContainer.cpp"
@@ -26,6 +32,8 @@ set(FRAMEWORK_SOURCES
     "${FRAMEWORK_ROOT_DIR}/ModuleGraphRunner.h"
     "${FRAMEWORK_ROOT_DIR}/ModulePacket.h"
     "${FRAMEWORK_ROOT_DIR}/Next.h"
+    "${FRAMEWORK_ROOT_DIR}/PendingLogFrames.cpp"
+    "${FRAMEWORK_ROOT_DIR}/PendingLogFrames.h"
     "${FRAMEWORK_ROOT_DIR}/Robot.cpp"
     "${FRAMEWORK_ROOT_DIR}/Robot.h"
     "${FRAMEWORK_ROOT_DIR}/Robots.h"
@@ -3,6 +3,8 @@ set(IMAGEPROCESSING_ROOT_DIR "${BHUMAN_PREFIX}/Src/Libs/ImageProcessing")
 set(IMAGEPROCESSING_SOURCES
     "${IMAGEPROCESSING_ROOT_DIR}/CNS/CameraModelOpenCV.cpp"
     "${IMAGEPROCESSING_ROOT_DIR}/CNS/CameraModelOpenCV.h"
+    "${IMAGEPROCESSING_ROOT_DIR}/CNS/CNSMaxPyramid.cpp"
+    "${IMAGEPROCESSING_ROOT_DIR}/CNS/CNSMaxPyramid.h"
     "${IMAGEPROCESSING_ROOT_DIR}/CNS/CNSResponse.h"
     "${IMAGEPROCESSING_ROOT_DIR}/CNS/CNSSSE.cpp"
     "${IMAGEPROCESSING_ROOT_DIR}/CNS/CNSSSE.h"
@@ -24,6 +26,8 @@ set(IMAGEPROCESSING_SOURCES
     "${IMAGEPROCESSING_ROOT_DIR}/AVX.h"
     "${IMAGEPROCESSING_ROOT_DIR}/ColorModelConversions.h"
     "${IMAGEPROCESSING_ROOT_DIR}/Image.h"
+    "${IMAGEPROCESSING_ROOT_DIR}/ImageBufferPool.cpp"
+    "${IMAGEPROCESSING_ROOT_DIR}/ImageBufferPool.h"
     "${IMAGEPROCESSING_ROOT_DIR}/ImageTransform.h"
     "${IMAGEPROCESSING_ROOT_DIR}/LabelImage.cpp"
     "${IMAGEPROCESSING_ROOT_DIR}/LabelImage.h"
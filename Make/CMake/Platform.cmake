@@ -61,5 +61,8 @@ else()
   target_compile_options(Platform${TARGET_SUFFIX} PRIVATE $<$<CONFIG:Develop>:-UNDEBUG>)
   target_link_libraries(Platform${TARGET_SUFFIX} PRIVATE Flags::Default)
 endif()
+if(CHECK_ALLOCATIONS)
+  target_compile_definitions(Platform${TARGET_SUFFIX} PUBLIC CHECK_ALLOCATIONS)
+endif()
 target_include_directories(Platform${TARGET_SUFFIX} PUBLIC "${PLATFORM_ROOT_DIR}/..")
 source_group(TREE "${PLATFORM_ROOT_DIR}" FILES ${PLATFORM_SOURCES})
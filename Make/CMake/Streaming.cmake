@@ -28,6 +28,7 @@ set(STREAMING_SOURCES
     "${STREAMING_ROOT_DIR}/Streamable.h"
     "${STREAMING_ROOT_DIR}/TypeInfo.cpp"
     "${STREAMING_ROOT_DIR}/TypeInfo.h"
+    "${STREAMING_ROOT_DIR}/TypeName.h"
     "${STREAMING_ROOT_DIR}/TypeRegistry.cpp"
     "${STREAMING_ROOT_DIR}/TypeRegistry.h")
 
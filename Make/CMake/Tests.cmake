@@ -8,6 +8,9 @@ if(MACOS AND NOT DEFINED ENV{NO_XCTEST})
   list(APPEND TESTS_SOURCES "${TESTS_ROOT_DIR}/Test.mm")
 endif()
 
+# The SimulatedNao library is not linked, but some of its classes are tested.
+list(APPEND TESTS_SOURCES "${BHUMAN_PREFIX}/Src/Libs/SimulatedNao/Visualization/PlotHistory.cpp")
+
 add_executable(Tests MACOSX_BUNDLE ${TESTS_SOURCES})
 
 set_property(TARGET Tests PROPERTY RUNTIME_OUTPUT_DIRECTORY "${TESTS_OUTPUT_DIR}")
@@ -0,0 +1,122 @@
+#include "Framework/PendingLogFrames.h"
+#include "Streaming/MessageQueue.h"
+
+#include <gtest/gtest.h>
+#include <barrier>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  /** Records a frame that contains a JPEG image, which might be skipped. */
+  void record(MessageQueue& buffer, unsigned number)
+  {
+    buffer.clear();
+    buffer.bin(idFrameBegin) << number;
+    buffer.bin(idJPEGImage) << number;
+    buffer.bin(idFrameFinished) << number;
+  }
+
+  unsigned numberOf(const MessageQueue& buffer)
+  {
+    unsigned number;
+    (*buffer.begin()).bin() >> number;
+    return number;
+  }
+
+  bool containsImage(const MessageQueue& buffer)
+  {
+    for(MessageQueue::const_iterator i = buffer.begin(); i != buffer.end(); ++i)
+      if((*i).id() == idJPEGImage)
+        return true;
+    return false;
+  }
+}
+
+GTEST_TEST(PendingLogFrames, laterFramesOfOtherThreadsWait)
+{
+  MessageQueue buffers[3];
+  for(unsigned i = 0; i < 3; ++i)
+    record(buffers[i], i);
+  PendingLogFrames pendingFrames;
+  std::deque<MessageQueue*> buffersToWrite;
+
+  // The first thread skips the image, the second one does not.
+  EXPECT_EQ(pendingFrames.add({&buffers[0], 0, 0, {idJPEGImage}}, 0, 0, 100, buffersToWrite), 0u);
+  EXPECT_EQ(pendingFrames.add({&buffers[1], 10, 0, {}}, 0, 10, 100, buffersToWrite), 0u);
+  EXPECT_EQ(pendingFrames.add({&buffers[2], 100, 0, {idJPEGImage}}, 0, 100, 100, buffersToWrite), 2u);
+
+  ASSERT_EQ(buffersToWrite.size(), 2u);
+  EXPECT_EQ(buffersToWrite[0], &buffers[0]);
+  EXPECT_FALSE(containsImage(buffers[0]));
+  EXPECT_EQ(buffersToWrite[1], &buffers[1]);
+  EXPECT_TRUE(containsImage(buffers[1]));
+
+  EXPECT_EQ(pendingFrames.flush(buffersToWrite), 1u);
+  ASSERT_EQ(buffersToWrite.size(), 3u);
+  EXPECT_EQ(buffersToWrite[2], &buffers[2]);
+  EXPECT_FALSE(containsImage(buffers[2]));
+}
+
+GTEST_TEST(PendingLogFrames, burstWritesAllFramesAtFullRate)
+{
+  MessageQueue buffers[3];
+  for(unsigned i = 0; i < 3; ++i)
+    record(buffers[i], i);
+  PendingLogFrames pendingFrames;
+  std::deque<MessageQueue*> buffersToWrite;
+
+  EXPECT_EQ(pendingFrames.add({&buffers[0], 0, 0, {idJPEGImage}}, 0, 0, 100, buffersToWrite), 0u);
+
+  // The second frame was recorded before another thread triggered a burst with the third frame.
+  EXPECT_EQ(pendingFrames.add({&buffers[1], 10, 0, {idJPEGImage}}, 1, 20, 100, buffersToWrite), 2u);
+  EXPECT_EQ(pendingFrames.add({&buffers[2], 20, 1, {}}, 1, 20, 100, buffersToWrite), 1u);
+
+  ASSERT_EQ(buffersToWrite.size(), 3u);
+  for(unsigned i = 0; i < 3; ++i)
+  {
+    EXPECT_EQ(buffersToWrite[i], &buffers[i]);
+    EXPECT_TRUE(containsImage(buffers[i]));
+  }
+}
+
+GTEST_TEST(PendingLogFrames, framesOfAllThreadsAreWrittenInOrder)
+{
+  constexpr unsigned numOfThreads = 4;
+  constexpr unsigned numOfFrames = 1000;
+  constexpr unsigned preTriggerDuration = 50;
+  std::vector<MessageQueue> buffers(numOfThreads * numOfFrames);
+  PendingLogFrames pendingFrames;
+  std::deque<MessageQueue*> buffersToWrite;
+  std::vector<unsigned> added;
+  std::mutex mutex;
+  std::barrier sync(numOfThreads);
+
+  // Every thread skips the image in a different subset of its frames.
+  std::vector<std::thread> threads;
+  for(unsigned thread = 0; thread < numOfThreads; ++thread)
+    threads.emplace_back([&, thread]
+    {
+      for(unsigned frame = 0; frame < numOfFrames; ++frame)
+      {
+        const unsigned number = frame * numOfThreads + thread;
+        record(buffers[number], number);
+        std::vector<MessageID> skipped;
+        if((frame + thread) % (thread + 2))
+          skipped.push_back(idJPEGImage);
+        sync.arrive_and_wait();
+        std::lock_guard<std::mutex> lock(mutex);
+        added.push_back(number);
+        pendingFrames.add({&buffers[number], frame, 0, skipped}, 0, frame, preTriggerDuration, buffersToWrite);
+      }
+    });
+  for(std::thread& thread : threads)
+    thread.join();
+  pendingFrames.flush(buffersToWrite);
+
+  ASSERT_EQ(buffersToWrite.size(), added.size());
+  for(std::size_t i = 0; i < added.size(); ++i)
+    EXPECT_EQ(numberOf(*buffersToWrite[i]), added[i]);
+}
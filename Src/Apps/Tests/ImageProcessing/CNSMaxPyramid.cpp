@@ -0,0 +1,190 @@
+#include "ImageProcessing/CNS/CNSMaxPyramid.h"
+#include "ImageProcessing/CNS/ObjectCNSStereoDetector.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  /**
+   * Fills a CNS image with random responses.
+   * @param strongEdgeScale The length scale of every eighth response. The others are shorter.
+   */
+  void randomCNSImage(Image<CNSResponse>& cns, float strongEdgeScale = 1.f)
+  {
+    std::srand(42);
+    for(unsigned y = 0; y < cns.height; ++y)
+      for(unsigned x = 0; x < cns.width; ++x)
+      {
+        const float scale = std::rand() % 8 == 0 ? strongEdgeScale : 0.2f;
+        cns(x, y) = CNSResponse(scale * (static_cast<float>(std::rand()) / RAND_MAX * 2.f - 1.f),
+                                scale * (static_cast<float>(std::rand()) / RAND_MAX * 2.f - 1.f));
+      }
+  }
+
+  constexpr double ballRadius = 50.;
+
+  /** The ground seen by a camera 500 mm above it that looks down by 30°. The image frame has x right, y down, and z forward. */
+  Eigen::Isometry3d groundInImage()
+  {
+    Eigen::Matrix4d cameraInImage;
+    cameraInImage << 0, -1,  0, 0,
+                     0,  0, -1, 0,
+                     1,  0,  0, 0,
+                     0,  0,  0, 1;
+    const Eigen::Isometry3d cameraInGround = Eigen::Translation3d(0., 0., 500.) * Eigen::AngleAxisd(M_PI / 6., Eigen::Vector3d::UnitY());
+    return Eigen::Isometry3d(cameraInImage) * cameraInGround.inverse();
+  }
+
+  /** Creates a detector that searches for balls on the ground, which is seen by a 320x240 camera. */
+  void createBallDetector(ObjectCNSStereoDetector& detector, int nResponses)
+  {
+    detector.create(TriangleMesh::sphere(ballRadius, 3), CameraModelOpenCV(),
+                    Eigen::AlignedBox3d(Eigen::Vector3d(-3000., -3000., 400.), Eigen::Vector3d(3000., 3000., 500.)), 50.);
+    detector.setCamera(CameraModelOpenCV(Eigen::Isometry3d::Identity(), 320, 240, 280., 280., 160., 120.));
+
+    // The search space must not be centered below the camera, because rays along its axis are degenerated.
+    SearchSpecification spec;
+    spec.positionSpace = CylinderRing(groundInImage() * Eigen::Translation3d(-50., 0., 0.), 0, 3000, ballRadius - 1, ballRadius + 1);
+    spec.object2WorldOrientation.emplace_back(groundInImage().rotation());
+    spec.nResponses = nResponses;
+    spec.nRefineIterations = 0;
+    detector.setSearchSpecification(spec);
+  }
+
+  /** Adds the edge of a bright ball on the ground to a CNS image. */
+  void addBall(Image<CNSResponse>& cns, const ObjectCNSStereoDetector& detector, const Eigen::Vector2d& ballOnGround)
+  {
+    double centerX, centerY, radius;
+    ASSERT_TRUE(detector.camera.worldBall2ImageCircleClipped(groundInImage() * Eigen::Vector3d(ballOnGround.x(), ballOnGround.y(), ballRadius),
+                                                             ballRadius, centerX, centerY, radius));
+    for(unsigned y = 0; y < cns.height; ++y)
+      for(unsigned x = 0; x < cns.width; ++x)
+      {
+        const double dX = x - centerX, dY = y - centerY;
+        const double distance = std::sqrt(dX * dX + dY * dY);
+        if(std::abs(distance - radius) < 1.5)
+          cns(x, y) = CNSResponse(static_cast<float>(-dX / distance), static_cast<float>(-dY / distance));
+      }
+  }
+}
+
+GTEST_TEST(CNSMaxPyramid, boundsAllPixels)
+{
+  Image<CNSResponse> cns(160, 120);
+  randomCNSImage(cns);
+  const CNSMaxPyramid pyramid(cns);
+
+  for(int i = 0; i < 1000; ++i)
+  {
+    const int xLo = std::rand() % 160, yLo = std::rand() % 120;
+    const int xHi = xLo + 1 + std::rand() % (160 - xLo), yHi = yLo + 1 + std::rand() % (120 - yLo);
+    int max = 0;
+    for(int y = yLo; y < yHi; ++y)
+      for(int x = xLo; x < xHi; ++x)
+      {
+        const int dX = cns(x, y).filterX - CNSResponse::OFFSET, dY = cns(x, y).filterY - CNSResponse::OFFSET;
+        max = std::max(max, dX * dX + dY * dY);
+      }
+    const int bound = pyramid.max(xLo, xHi, yLo, yHi);
+    EXPECT_GE(bound, max);
+    EXPECT_LE(bound, CNSMaxPyramid::MAX_VALUE);
+  }
+
+  EXPECT_EQ(pyramid.max(-1, 16, 10, 26), CNSMaxPyramid::MAX_VALUE);
+  EXPECT_EQ(pyramid.max(150, 161, 10, 26), CNSMaxPyramid::MAX_VALUE);
+}
+
+GTEST_TEST(CNSMaxPyramid, boundsContourResponse)
+{
+  Image<CNSResponse> cns(320, 240);
+  randomCNSImage(cns);
+  const CNSMaxPyramid pyramid(cns);
+
+  for(int r = 4; r <= 24; r += 5)
+  {
+    CodedContour ct = CodedContour::circle(r);
+    for(int i = 0; i < 20; ++i)
+    {
+      ct.referenceX = 64 + std::rand() % 160;
+      ct.referenceY = 64 + std::rand() % 96;
+      alignas(16) signed short responseBin[16][16];
+      ct.evaluateX16Y16(responseBin, cns, -8, -8);
+      const int bound = ObjectCNSStereoDetector::responseBound(ct, pyramid, -8, 8, -8, 8);
+      for(int y = 0; y < 16; ++y)
+        for(int x = 0; x < 16; ++x)
+          EXPECT_GE(bound, responseBin[y][x]);
+    }
+  }
+}
+
+GTEST_TEST(ObjectCNSStereoDetector, boundedSearchMatchesExhaustiveSearch)
+{
+  ObjectCNSStereoDetector detector;
+  createBallDetector(detector, 5);
+
+  // Contours are evaluated up to 64 rows beyond the image, as with the CNSImage.
+  Image<CNSResponse> cns(320, 240, 320 * 64 * sizeof(CNSResponse));
+  std::memset(reinterpret_cast<char*>(cns[-64]), CNSResponse::OFFSET, cns.width * (128 + cns.height) * sizeof(CNSResponse));
+  randomCNSImage(cns, 0.2f);
+  addBall(cns, detector, Eigen::Vector2d(800., 300.));
+  addBall(cns, detector, Eigen::Vector2d(1500., -400.));
+  const CNSMaxPyramid pyramid(cns);
+  const LinearResponseMapping mapping;
+
+  // Small blocks result in many poses, large blocks in many image translations per pose.
+  for(const auto& [blockX, blockY] : {std::pair(16, 16), std::pair(32, 48)})
+  {
+    SCOPED_TRACE(testing::Message() << blockX << "x" << blockY);
+    SearchSpecification spec = detector.spec;
+    spec.blockX = blockX;
+    spec.blockY = blockY;
+    detector.setSearchSpecification(spec);
+
+    // Evaluate every pose in all image translations of its block, as the search did before it used bounds.
+    ObjectCNSStereoDetector::Candidates candidates;
+    int order = 0;
+    for(int y = 0; y < 240; y += blockY)
+      for(int x = 0; x < 320; x += blockX)
+        detector.addBlockCandidates(candidates, pyramid, x, y, order);
+    ObjectCNSStereoDetector::IsometryWithResponses expected;
+    for(const ObjectCNSStereoDetector::Candidate& candidate : candidates)
+    {
+      int maxVal = 0, argMaxX = 0, argMaxY = 0;
+      detector.responseXYMax(maxVal, argMaxX, argMaxY, cns, candidate.object2World, blockX, blockY);
+      IsometryWithResponse result(candidate.object2World, mapping.finalBin2FinalFloat(static_cast<short>(maxVal)));
+      if(result.response > 0)
+      {
+        detector.updateWithXY(result, argMaxX, argMaxY);
+        expected.push_back(result);
+      }
+    }
+
+    // Among equal responses, the one found first wins.
+    std::stable_sort(expected.begin(), expected.end(), [](const IsometryWithResponse& a, const IsometryWithResponse& b)
+    {
+      return a.response > b.response;
+    });
+    ASSERT_GT(expected.size(), static_cast<size_t>(spec.nResponses));
+    expected.resize(spec.nResponses);
+
+    ObjectCNSStereoDetector::IsometryWithResponses found;
+    detector.search(found, cns);
+    ASSERT_EQ(found.size(), expected.size());
+
+    // The final sort of search does not keep the order of equal responses.
+    for(size_t i = 0; i < found.size(); ++i)
+    {
+      EXPECT_EQ(found[i].response, expected[i].response) << "response " << i;
+      EXPECT_TRUE(std::any_of(expected.begin(), expected.end(), [&](const IsometryWithResponse& e)
+      {
+        return e.response == found[i].response && e.matrix().isApprox(found[i].matrix());
+      })) << "pose " << i;
+    }
+  }
+}
@@ -0,0 +1,165 @@
+#include "ImageProcessing/PatchUtilities.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+  /** Computes the first sample and the number of samples inside the image along one axis, as PatchUtilities does. */
+  void clip(int upperLeft, int inSize, int outSize, float stepSize, int imageSize, float border, float& start, int& offset, int& steps)
+  {
+    start = static_cast<float>(upperLeft);
+    offset = 0;
+    steps = outSize;
+    if(start < 0.f)
+    {
+      const float skipped = std::ceil(-start / stepSize);
+      start += skipped * stepSize;
+      offset = static_cast<int>(skipped);
+      steps -= std::min(steps, offset);
+    }
+    const float overshoot = start + inSize - imageSize + border;
+    if(overshoot > 0)
+      steps -= std::min(steps, static_cast<int>(std::ceil(overshoot / stepSize)));
+  }
+
+  /** The pixel by pixel implementation of PatchUtilities::getImageSection as a reference. */
+  template<typename OutType>
+  void extractReference(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* output, bool interpolate)
+  {
+    const Vector2i upperLeft = (center.array() - inSize.array() / 2).matrix();
+    const Vector2f stepSize = (inSize.cast<float>().array() / outSize.cast<float>().array()).matrix();
+    float xStart, yImage;
+    int xOffset, yOffset, xSteps, ySteps;
+    clip(upperLeft.x(), inSize.x(), outSize.x(), stepSize.x(), src.width, interpolate ? 1.f : 0.f, xStart, xOffset, xSteps);
+    clip(upperLeft.y(), inSize.y(), outSize.y(), stepSize.y(), src.height, interpolate ? 1.f : 0.f, yImage, yOffset, ySteps);
+
+    std::fill_n(output, outSize.x() * outSize.y(), static_cast<OutType>(128));
+    for(int y = yOffset; y < yOffset + ySteps; ++y, yImage += stepSize.y())
+    {
+      float xImage = xStart;
+      for(int x = xOffset; x < xOffset + xSteps; ++x, xImage += stepSize.x())
+      {
+        OutType& dest = output[y * outSize.x() + x];
+        const size_t xIndex = static_cast<size_t>(xImage);
+        const size_t yIndex = static_cast<size_t>(yImage);
+        if(!interpolate)
+          dest = static_cast<OutType>(src[yIndex][xIndex]);
+        else
+        {
+          const float xWeight1 = xImage - static_cast<float>(xIndex);
+          const float yWeight1 = yImage - static_cast<float>(yIndex);
+          dest = static_cast<OutType>(std::min(255.f,
+                                               (1 - yWeight1) * (src[yIndex][xIndex] * (1 - xWeight1) + src[yIndex][xIndex + 1] * xWeight1)
+                                               + yWeight1 * (src[yIndex + 1][xIndex] * (1 - xWeight1) + src[yIndex + 1][xIndex + 1] * xWeight1)));
+        }
+      }
+    }
+  }
+
+  GrayscaledImage createImage()
+  {
+    GrayscaledImage image(80, 60);
+    std::srand(42);
+    for(unsigned y = 0; y < image.height; ++y)
+      for(unsigned x = 0; x < image.width; ++x)
+        image[y][x] = static_cast<PixelTypes::GrayscaledPixel>(std::rand() % 256);
+    return image;
+  }
+
+  /** Patches inside the image, overlapping its borders, and scaled up and down. */
+  const std::vector<PatchUtilities::PatchRegion> regions =
+  {
+    {Vector2i(40, 30), Vector2i(32, 32)},
+    {Vector2i(41, 29), Vector2i(20, 20)},
+    {Vector2i(3, 4), Vector2i(24, 24)},
+    {Vector2i(77, 58), Vector2i(36, 36)},
+    {Vector2i(40, 30), Vector2i(72, 56)},
+    {Vector2i(10, 50), Vector2i(13, 7)}
+  };
+}
+
+/** The sampling kernels may differ by one gray level due to a different rounding of fused multiply-adds. */
+GTEST_TEST(PatchUtilities, extractPatchMatchesReference)
+{
+  const GrayscaledImage image = createImage();
+  const Vector2i outSize(32, 32);
+  for(const PatchUtilities::PatchRegion& region : regions)
+    for(const bool interpolate : {false, true})
+    {
+      const PatchUtilities::ExtractionMode mode = interpolate ? PatchUtilities::fastInterpolated : PatchUtilities::fast;
+      std::vector<unsigned char> bytes(outSize.x() * outSize.y()), expectedBytes(bytes.size());
+      std::vector<float> floats(bytes.size()), expectedFloats(bytes.size());
+      PatchUtilities::extractPatch(region.center, region.inSize, outSize, image, bytes.data(), mode);
+      PatchUtilities::extractPatch(region.center, region.inSize, outSize, image, floats.data(), mode);
+      extractReference(region.center, region.inSize, outSize, image, expectedBytes.data(), interpolate);
+      extractReference(region.center, region.inSize, outSize, image, expectedFloats.data(), interpolate);
+      for(size_t i = 0; i < bytes.size(); ++i)
+      {
+        EXPECT_NEAR(bytes[i], expectedBytes[i], 1);
+        EXPECT_NEAR(floats[i], expectedFloats[i], 1e-3f);
+      }
+    }
+}
+
+GTEST_TEST(PatchUtilities, fusedNormalizationMatchesSeparatePass)
+{
+  const GrayscaledImage image = createImage();
+  const Vector2i outSize(16, 16);
+  for(const PatchUtilities::PatchRegion& region : regions)
+    for(const PatchUtilities::ExtractionMode mode : {PatchUtilities::fast, PatchUtilities::fastInterpolated})
+    {
+      std::vector<unsigned char> contrast(outSize.x() * outSize.y()), brightness(contrast.size());
+      std::vector<unsigned char> expectedContrast(contrast.size()), expectedBrightness(contrast.size());
+      PatchUtilities::extractPatch(region.center, region.inSize, outSize, image, contrast.data(), mode, PatchUtilities::contrastNormalization);
+      PatchUtilities::extractPatch(region.center, region.inSize, outSize, image, brightness.data(), mode, PatchUtilities::brightnessNormalization);
+      PatchUtilities::extractPatch(region.center, region.inSize, outSize, image, expectedContrast.data(), mode);
+      PatchUtilities::normalizeContrast(expectedContrast.data(), outSize);
+      PatchUtilities::extractPatch(region.center, region.inSize, outSize, image, expectedBrightness.data(), mode);
+      PatchUtilities::normalizeBrightness(expectedBrightness.data(), outSize);
+      EXPECT_EQ(contrast, expectedContrast);
+      EXPECT_EQ(brightness, expectedBrightness);
+
+      // Float patches without interpolation only contain integral values, so they must be normalized in the same way.
+      if(mode == PatchUtilities::fast)
+      {
+        std::vector<float> floats(contrast.size());
+        PatchUtilities::extractPatch(region.center, region.inSize, outSize, image, floats.data(), mode);
+        PatchUtilities::normalizeContrast(floats.data(), outSize);
+        for(size_t i = 0; i < floats.size(); ++i)
+          EXPECT_EQ(static_cast<unsigned char>(floats[i]), expectedContrast[i]);
+      }
+    }
+}
+
+GTEST_TEST(PatchUtilities, extractPatchesMatchesSinglePatches)
+{
+  const GrayscaledImage image = createImage();
+  const Vector2i outSize(8, 12);
+  const size_t patchSize = outSize.x() * outSize.y();
+  std::vector<float> batch(regions.size() * patchSize), single(patchSize);
+  PatchUtilities::extractPatches(regions, outSize, image, batch.data(), PatchUtilities::fastInterpolated, PatchUtilities::brightnessNormalization);
+  for(size_t i = 0; i < regions.size(); ++i)
+  {
+    PatchUtilities::extractPatch(regions[i].center, regions[i].inSize, outSize, image, single.data(), PatchUtilities::fastInterpolated, PatchUtilities::brightnessNormalization);
+    EXPECT_TRUE(std::equal(single.begin(), single.end(), batch.begin() + i * patchSize));
+  }
+}
+
+GTEST_TEST(PatchUtilities, extractPatchesMatchesSingleGrayscaledImages)
+{
+  const GrayscaledImage image = createImage();
+  const Vector2i outSize(16, 16);
+  const size_t patchSize = outSize.x() * outSize.y();
+  std::vector<unsigned char> batch(regions.size() * patchSize);
+  PatchUtilities::extractPatches(regions, outSize, image, batch.data());
+  for(size_t i = 0; i < regions.size(); ++i)
+  {
+    GrayscaledImage single;
+    PatchUtilities::extractPatch(regions[i].center, regions[i].inSize, outSize, image, single);
+    EXPECT_TRUE(std::equal(single[0], single[0] + patchSize, batch.begin() + i * patchSize));
+  }
+}
@@ -0,0 +1,93 @@
+#include "Tools/Inference/InferenceEngine.h"
+#include "Platform/File.h"
+
+#include <gtest/gtest.h>
+#include <barrier>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  /** Makes the InferenceEngine read settings that enable batching and prefer CompiledNN, which cannot batch. */
+  void enableBatching()
+  {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "InferenceEngineTest";
+    std::filesystem::create_directories(dir);
+    std::ofstream(dir / "inference.cfg")
+      << "autotune = false; benchmarkRuns = 1; maxSamples = 1; backends = [compiledNN, onnx]; tolerance = 0;"
+      << "networks = []; recordInterval = 0; maxRecordedInputs = 0; batchInSimulation = true;";
+    File::setSearchPath({dir.string() + "/"});
+  }
+
+  void fillInputs(InferenceEngine& network, unsigned seed)
+  {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> distribution(0.f, 1.f);
+    for(std::size_t i = 0; i < network.numOfInputs(); ++i)
+      for(float& value : network.input(i))
+        value = distribution(generator);
+  }
+
+  std::vector<float> getOutputs(InferenceEngine& network)
+  {
+    std::vector<float> outputs;
+    for(std::size_t i = 0; i < network.numOfOutputs(); ++i)
+      outputs.insert(outputs.end(), network.output(i).begin(), network.output(i).end());
+    return outputs;
+  }
+}
+
+GTEST_TEST(InferenceEngine, batchedOutputsMatchSingleRuns)
+{
+  enableBatching();
+  constexpr std::size_t numOfInstances = 4;
+  constexpr unsigned numOfRuns = 20;
+  const std::string filename = std::string(File::getBHDir()) + "/Config/NeuralNets/FieldBoundary/net.h5";
+
+  std::vector<InferenceEngine> networks(numOfInstances);
+  for(InferenceEngine& network : networks)
+  {
+    network.load(filename);
+    ASSERT_TRUE(network.valid());
+    EXPECT_EQ(network.getBackend(), InferenceEngine::onnx);
+  }
+
+  // The expected outputs are computed one after another, i.e. without batches.
+  std::vector<std::vector<std::vector<float>>> expected(numOfInstances);
+  for(std::size_t i = 0; i < numOfInstances; ++i)
+    for(unsigned run = 0; run < numOfRuns; ++run)
+    {
+      fillInputs(networks[i], static_cast<unsigned>(i * numOfRuns + run));
+      networks[i].apply();
+      expected[i].push_back(getOutputs(networks[i]));
+    }
+
+  // All instances run the network at the same time, so their runs are combined.
+  std::vector<std::vector<std::vector<float>>> actual(numOfInstances);
+  std::barrier sync(numOfInstances);
+  std::vector<std::thread> threads;
+  for(std::size_t i = 0; i < numOfInstances; ++i)
+    threads.emplace_back([&, i]
+    {
+      for(unsigned run = 0; run < numOfRuns; ++run)
+      {
+        fillInputs(networks[i], static_cast<unsigned>(i * numOfRuns + run));
+        sync.arrive_and_wait();
+        networks[i].apply();
+        actual[i].push_back(getOutputs(networks[i]));
+      }
+    });
+  for(std::thread& thread : threads)
+    thread.join();
+
+  // All instances share the same batches, which must have combined runs.
+  EXPECT_GT(networks.front().getLargestBatchSize(), 1u);
+
+  for(std::size_t i = 0; i < numOfInstances; ++i)
+    for(unsigned run = 0; run < numOfRuns; ++run)
+      EXPECT_EQ(actual[i][run], expected[i][run]);
+}
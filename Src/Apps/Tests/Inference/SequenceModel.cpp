@@ -0,0 +1,120 @@
+#include "Tools/Inference/SequenceModel.h"
+
+#include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <span>
+#include <vector>
+
+namespace
+{
+  constexpr unsigned historyLength = 4;
+  constexpr unsigned sliceSize = 3;
+
+  /** The weights of the time slices in the window, the oldest first. */
+  constexpr std::array<float, historyLength> weights = {0.1f, -0.4f, 0.7f, 1.3f};
+
+  /** Filters each feature over the window. */
+  void filter(const float* window, float* result)
+  {
+    for(unsigned feature = 0; feature < sliceSize; ++feature)
+    {
+      result[feature] = 0.f;
+      for(unsigned slice = 0; slice < historyLength; ++slice)
+        result[feature] += weights[slice] * window[slice * sliceSize + feature];
+    }
+  }
+
+  /** A model that gets the whole window. */
+  struct WindowedFilter
+  {
+    std::vector<float> window = std::vector<float>(historyLength * sliceSize);
+    std::vector<float> result = std::vector<float>(sliceSize);
+    unsigned runs = 0;
+
+    std::size_t numOfInputs() const {return 1;}
+    std::span<float> input(std::size_t) {return window;}
+    std::span<float> output(std::size_t) {return result;}
+    void apply() {filter(window.data(), result.data()); ++runs;}
+  };
+
+  /**
+   * The same model as a streaming one. It only gets the newest slice. Its state
+   * are the slices before it, which it returns as its second output.
+   */
+  struct StreamingFilter
+  {
+    std::vector<float> slice = std::vector<float>(sliceSize);
+    std::vector<float> stateIn = std::vector<float>((historyLength - 1) * sliceSize);
+    std::vector<float> result = std::vector<float>(sliceSize);
+    std::vector<float> stateOut = std::vector<float>((historyLength - 1) * sliceSize);
+    unsigned runs = 0;
+
+    std::size_t numOfInputs() const {return 2;}
+    std::span<float> input(std::size_t i) {return i == 0 ? slice : stateIn;}
+    std::span<float> output(std::size_t i) {return i == 0 ? result : stateOut;}
+
+    void apply()
+    {
+      std::vector<float> window(stateIn);
+      window.insert(window.end(), slice.begin(), slice.end());
+      filter(window.data(), result.data());
+      std::copy(window.begin() + sliceSize, window.end(), stateOut.begin());
+      ++runs;
+    }
+  };
+
+  /** A synthetic sequence of time slices. */
+  std::array<float, sliceSize> slice(unsigned time)
+  {
+    std::array<float, sliceSize> slice;
+    for(unsigned feature = 0; feature < sliceSize; ++feature)
+      slice[feature] = std::sin(0.3f * static_cast<float>(time) + static_cast<float>(feature)) + 0.01f * static_cast<float>(time);
+    return slice;
+  }
+}
+
+GTEST_TEST(SequenceModel, streamingOutputsMatchWindowedOutputs)
+{
+  SequenceModel<WindowedFilter> windowed;
+  windowed.reset(historyLength, sliceSize);
+  SequenceModel<StreamingFilter> streaming;
+  streaming.reset(historyLength, sliceSize);
+
+  unsigned predictions = 0;
+  for(unsigned time = 0; time < 50; ++time)
+  {
+    // Predictions are not needed in every frame, but the streaming model must still see them.
+    const bool predict = time % 7 != 3;
+    const std::array<float, sliceSize> values = slice(time);
+    const bool windowedPredicted = windowed.add(values.data(), predict);
+    const bool streamingPredicted = streaming.add(values.data(), predict);
+    ASSERT_EQ(windowedPredicted, streamingPredicted);
+    EXPECT_EQ(windowedPredicted, predict && time + 1 >= historyLength);
+    EXPECT_EQ(streaming.network.runs, time + 1);
+    if(windowedPredicted)
+    {
+      ++predictions;
+      for(unsigned feature = 0; feature < sliceSize; ++feature)
+        EXPECT_NEAR(windowed.network.result[feature], streaming.network.result[feature], 1e-5f) << "time " << time << ", feature " << feature;
+    }
+  }
+  EXPECT_EQ(windowed.network.runs, predictions);
+}
+
+GTEST_TEST(SequenceModel, reloadedStreamingModelWaitsForWholeWindow)
+{
+  SequenceModel<StreamingFilter> streaming;
+  streaming.reset(historyLength, sliceSize);
+  unsigned time = 0;
+  for(; time < historyLength; ++time)
+    streaming.add(slice(time).data(), true);
+
+  // A reloaded model has lost its state, so the first predictions would be wrong.
+  streaming.reset(historyLength, sliceSize);
+  for(float value : streaming.network.stateIn)
+    EXPECT_EQ(value, 0.f);
+  for(unsigned i = 0; i < historyLength - 1; ++i, ++time)
+    EXPECT_FALSE(streaming.add(slice(time).data(), true));
+  EXPECT_TRUE(streaming.add(slice(time).data(), true));
+}
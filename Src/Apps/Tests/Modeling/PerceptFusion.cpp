@@ -0,0 +1,115 @@
+#include "Tools/Modeling/PerceptFusion.h"
+#include "Representations/Perception/BallPercepts/BallPercept.h"
+#include "Representations/Perception/FieldPercepts/FieldLines.h"
+#include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
+#include "Representations/Perception/ObstaclesPercepts/ObstaclesFieldPercept.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+  /** The robot moved 100 mm forward and turned left by 90° between both images. */
+  const Pose2f offset = PerceptFusion::olderToNewer(Pose2f(90_deg, 1100.f, 500.f), Pose2f(0.f, 1000.f, 500.f));
+
+  FieldLines::Line line(float length, const Vector2f& first, const Vector2f& last)
+  {
+    FieldLines::Line line;
+    line.alpha = 0.f;
+    line.length = length;
+    line.first = first;
+    line.last = last;
+    line.cov = Matrix2f::Identity();
+    return line;
+  }
+
+  void expectNear(const Vector2f& expected, const Vector2f& actual)
+  {
+    EXPECT_NEAR(expected.x(), actual.x(), 0.01f);
+    EXPECT_NEAR(expected.y(), actual.y(), 0.01f);
+  }
+}
+
+GTEST_TEST(PerceptFusion, offsetMovesOlderPerceptsToNewerPose)
+{
+  // A point 100 mm ahead of the robot when the older image was taken is
+  // where the robot is now, and a point to the left of it is ahead now.
+  expectNear(Vector2f::Zero(), offset * Vector2f(100.f, 0.f));
+  expectNear(Vector2f(100.f, 0.f), offset * Vector2f(100.f, 100.f));
+}
+
+GTEST_TEST(PerceptFusion, olderBallReplacesOnlyWorseBall)
+{
+  BallPercept older;
+  older.status = BallPercept::seen;
+  older.positionOnField = Vector2f(100.f, 100.f);
+  older.covarianceOnField << 4.f, 0.f, 0.f, 1.f;
+
+  BallPercept newer;
+  newer.status = BallPercept::guessed;
+  EXPECT_TRUE(PerceptFusion::isBetter(older, newer));
+  PerceptFusion::fuse(newer, older, offset);
+  EXPECT_EQ(newer.status, BallPercept::seen);
+  expectNear(Vector2f(100.f, 0.f), newer.positionOnField);
+  EXPECT_NEAR(newer.covarianceOnField(0, 0), 1.f, 0.001f);
+  EXPECT_NEAR(newer.covarianceOnField(1, 1), 4.f, 0.001f);
+
+  BallPercept seen;
+  seen.status = BallPercept::seen;
+  seen.positionOnField = Vector2f(500.f, 0.f);
+  EXPECT_FALSE(PerceptFusion::isBetter(older, seen));
+  PerceptFusion::fuse(seen, older, offset);
+  expectNear(Vector2f(500.f, 0.f), seen.positionOnField);
+}
+
+GTEST_TEST(PerceptFusion, linesAreMovedAndStaySorted)
+{
+  FieldLines newer;
+  newer.lines.emplace_back(line(300.f, Vector2f(0.f, 0.f), Vector2f(300.f, 0.f)));
+  newer.lines.emplace_back(line(100.f, Vector2f(0.f, 0.f), Vector2f(100.f, 0.f)));
+  FieldLines older;
+  older.lines.emplace_back(line(200.f, Vector2f(100.f, 100.f), Vector2f(300.f, 100.f)));
+
+  PerceptFusion::fuse(newer, older, offset);
+  ASSERT_EQ(newer.lines.size(), 3u);
+  EXPECT_EQ(newer.lines[0].length, 300.f);
+  EXPECT_EQ(newer.lines[1].length, 200.f);
+  EXPECT_EQ(newer.lines[2].length, 100.f);
+  expectNear(Vector2f(100.f, 0.f), newer.lines[1].first);
+  expectNear(Vector2f(100.f, -200.f), newer.lines[1].last);
+  EXPECT_NEAR(newer.lines[1].alpha, -90_deg, 0.001f);
+}
+
+GTEST_TEST(PerceptFusion, obstaclesAreAppendedAndMoved)
+{
+  ObstaclesFieldPercept newer;
+  newer.obstacles.emplace_back().center = Vector2f(1000.f, 0.f);
+  ObstaclesFieldPercept older;
+  ObstaclesFieldPercept::Obstacle& obstacle = older.obstacles.emplace_back();
+  obstacle.center = Vector2f(100.f, 500.f);
+  obstacle.left = Vector2f(100.f, 600.f);
+  obstacle.right = Vector2f(100.f, 400.f);
+  obstacle.covariance = Matrix2f::Identity();
+
+  PerceptFusion::fuse(newer, older, offset);
+  ASSERT_EQ(newer.obstacles.size(), 2u);
+  expectNear(Vector2f(1000.f, 0.f), newer.obstacles[0].center);
+  expectNear(Vector2f(500.f, 0.f), newer.obstacles[1].center);
+  expectNear(Vector2f(600.f, 0.f), newer.obstacles[1].left);
+  expectNear(Vector2f(400.f, 0.f), newer.obstacles[1].right);
+}
+
+GTEST_TEST(PerceptFusion, olderCameraMatrixIsMovedToNewerPose)
+{
+  CameraMatrix cameraMatrix(Pose3f(Vector3f(50.f, 0.f, 500.f)));
+  cameraMatrix.isValid = false;
+
+  const CameraMatrix moved = PerceptFusion::moveToNewer(cameraMatrix, offset);
+  EXPECT_FALSE(moved.isValid);
+  EXPECT_NEAR(moved.translation.x(), 0.f, 0.01f);
+  EXPECT_NEAR(moved.translation.y(), 50.f, 0.01f);
+  EXPECT_NEAR(moved.translation.z(), 500.f, 0.01f);
+
+  // The direction the camera looked at is now to the right of the robot.
+  const Vector3f lookingAt = moved.rotation * Vector3f::UnitX();
+  EXPECT_NEAR(lookingAt.y(), -1.f, 0.001f);
+}
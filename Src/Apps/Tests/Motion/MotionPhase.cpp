@@ -0,0 +1,59 @@
+#include "Tools/Motion/MotionPhase.h"
+#include "Platform/Memory.h"
+
+#include <cstdint>
+#include <gtest/gtest.h>
+
+namespace
+{
+  struct TestPhase : MotionPhase
+  {
+    TestPhase() : MotionPhase(MotionPhase::stand) {}
+
+    bool isDone(const MotionRequest&) const override {return true;}
+    void calcJoints(const MotionRequest&, JointRequest&, Pose2f&, MotionInfo&) override {}
+
+    float state[100]; /**< Makes the phase larger than the other ones used in the tests. */
+  };
+
+  struct UnpooledPhase : MotionPhase
+  {
+    UnpooledPhase() : MotionPhase(MotionPhase::stand) {}
+
+    bool isDone(const MotionRequest&) const override {return true;}
+    void calcJoints(const MotionRequest&, JointRequest&, Pose2f&, MotionInfo&) override {}
+
+    float state[200]; /**< Makes the phase larger than the other ones used in the tests. */
+  };
+}
+
+GTEST_TEST(MotionPhase, PreallocatedPhasesAreRecycled)
+{
+  MotionPhase::preallocate<TestPhase>(2);
+
+  // Transitions between preallocated phases do not access the heap (checked if CHECK_ALLOCATIONS is enabled).
+  Memory::NoAllocationScope noAllocationScope;
+  std::unique_ptr<MotionPhase> phase = std::make_unique<TestPhase>();
+  std::unique_ptr<MotionPhase> nextPhase = std::make_unique<TestPhase>();
+  ASSERT_NE(phase.get(), nextPhase.get());
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(phase.get()) % 32, 0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(nextPhase.get()) % 32, 0u);
+
+  const MotionPhase* const first = phase.get();
+  phase = std::move(nextPhase);
+  nextPhase = std::make_unique<TestPhase>();
+  EXPECT_EQ(nextPhase.get(), first);
+}
+
+GTEST_TEST(MotionPhase, PoolMissIsReported)
+{
+#ifdef CHECK_ALLOCATIONS
+  EXPECT_DEATH(
+  {
+    Memory::NoAllocationScope noAllocationScope;
+    std::unique_ptr<MotionPhase> phase = std::make_unique<UnpooledPhase>();
+  }, "in a NoAllocationScope");
+#else
+  GTEST_SKIP() << "Heap allocations are only checked if CHECK_ALLOCATIONS is enabled";
+#endif
+}
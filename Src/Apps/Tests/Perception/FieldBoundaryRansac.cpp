@@ -0,0 +1,125 @@
+#include "Tools/Perception/FieldBoundaryRansac.h"
+#include "Math/Pose3f.h"
+#include "Representations/Infrastructure/CameraInfo.h"
+#include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
+#include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
+#include "Tools/Math/Transformation.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+  using Spot = FieldBoundaryRansac::Spot;
+
+  CameraInfo cameraInfo()
+  {
+    CameraInfo cameraInfo;
+    cameraInfo.width = 640;
+    cameraInfo.height = 480;
+    cameraInfo.opticalCenter = Vector2f(320.f, 240.f);
+    cameraInfo.focalLength = 560.f;
+    cameraInfo.focalLengthHeight = 560.f;
+    cameraInfo.focalLenPow2 = sqr(cameraInfo.focalLength);
+    cameraInfo.focalLengthInv = 1.f / cameraInfo.focalLength;
+    cameraInfo.focalLengthHeightInv = 1.f / cameraInfo.focalLengthHeight;
+    return cameraInfo;
+  }
+
+  /** A camera 500 mm above the ground that looks down by 20°. */
+  const CameraMatrix cameraMatrix(Pose3f(Vector3f(0.f, 0.f, 500.f)).rotateY(20_deg));
+  const CameraInfo info = cameraInfo();
+
+  ImageCoordinateSystem imageCoordinateSystem()
+  {
+    ImageCoordinateSystem imageCoordinateSystem;
+    imageCoordinateSystem.cameraInfo = info;
+    imageCoordinateSystem.offset = imageCoordinateSystem.robotOffset = Vector2f::Zero();
+    return imageCoordinateSystem;
+  }
+
+  /**
+   * Creates the boundary spots of a field boundary given as a polyline in
+   * robot-relative coordinates. There is at most one spot per image column.
+   */
+  std::vector<Spot> spotsOn(const std::vector<Vector2f>& boundary)
+  {
+    std::vector<Spot> spots;
+    for(size_t i = 1; i < boundary.size(); ++i)
+      for(float t = 0.f; t < 1.f; t += 0.01f)
+      {
+        const Vector2f onField = boundary[i - 1] + (boundary[i] - boundary[i - 1]) * t;
+        Vector2f inImage;
+        if(Transformation::robotToImage(onField, cameraMatrix, info, inImage)
+           && inImage.x() >= 0.f && inImage.x() < static_cast<float>(info.width)
+           && inImage.y() >= 0.f && inImage.y() < static_cast<float>(info.height))
+          spots.emplace_back(inImage.cast<int>(), onField, 0.f);
+      }
+    std::sort(spots.begin(), spots.end(), [](const Spot& a, const Spot& b) {return a.inImage.x() < b.inImage.x();});
+    spots.erase(std::unique(spots.begin(), spots.end(), [](const Spot& a, const Spot& b) {return a.inImage.x() == b.inImage.x();}), spots.end());
+    return spots;
+  }
+
+  /** Is the spot one of the boundary spots? */
+  bool isSpotOf(const Spot& spot, const std::vector<Spot>& spots)
+  {
+    return std::any_of(spots.begin(), spots.end(), [&](const Spot& s) {return s.inImage == spot.inImage && s.onField == spot.onField;});
+  }
+}
+
+GTEST_TEST(FieldBoundaryRansac, warmStartRefinesPreviousModelOnCurrentImage)
+{
+  FieldBoundaryRansac ransac;
+  FieldBoundaryRansac::Parameters parameters = {200, 100, 1, 0.1f, true};
+  std::vector<Spot> model;
+
+  // A straight boundary 3 m ahead.
+  const std::vector<Spot> before = spotsOn({Vector2f(3000.f, 3000.f), Vector2f(3000.f, -3000.f)});
+  ASSERT_GT(before.size(), 10u);
+  ransac.fit(before, parameters, cameraMatrix, info, imageCoordinateSystem(), Pose2f(), model);
+  ASSERT_EQ(model.size(), 2u);
+
+  // The robot walked 300 mm forward, but the odometry only measured 200 mm. Without
+  // any random samples, only the hypothesis from the previous model is evaluated.
+  const std::vector<Spot> after = spotsOn({Vector2f(2700.f, 3000.f), Vector2f(2700.f, -3000.f)});
+  parameters.maxNumberOfIterations = 0;
+  ransac.fit(after, parameters, cameraMatrix, info, imageCoordinateSystem(), Pose2f(200.f, 0.f), model);
+  ASSERT_EQ(model.size(), 2u);
+  for(const Spot& spot : model)
+  {
+    EXPECT_TRUE(isSpotOf(spot, after));
+    EXPECT_NEAR(spot.onField.x(), 2700.f, 1.f);
+  }
+}
+
+GTEST_TEST(FieldBoundaryRansac, warmStartFindsMovedCorner)
+{
+  FieldBoundaryRansac ransac;
+  FieldBoundaryRansac::Parameters parameters = {1000, 100, 1, 0.01f, true};
+  std::vector<Spot> model;
+
+  // The boundary turns towards the robot 1 m to its right.
+  const std::vector<Spot> before = spotsOn({Vector2f(3000.f, 3000.f), Vector2f(3000.f, -1000.f), Vector2f(0.f, -1000.f)});
+  ransac.fit(before, parameters, cameraMatrix, info, imageCoordinateSystem(), Pose2f(), model);
+  ASSERT_EQ(model.size(), 3u);
+
+  // The robot walked 100 mm to the left, which the odometry did not measure.
+  const std::vector<Spot> after = spotsOn({Vector2f(3000.f, 3100.f), Vector2f(3000.f, -900.f), Vector2f(0.f, -900.f)});
+  parameters.maxNumberOfIterations = 0;
+  ransac.fit(after, parameters, cameraMatrix, info, imageCoordinateSystem(), Pose2f(), model);
+  ASSERT_EQ(model.size(), 3u);
+  EXPECT_TRUE(isSpotOf(model[0], after));
+  EXPECT_TRUE(isSpotOf(model[2], after));
+  EXPECT_NEAR(model[1].onField.x(), 3000.f, 1.f);
+  EXPECT_NEAR(model[1].onField.y(), -900.f, 1.f);
+}
+
+GTEST_TEST(FieldBoundaryRansac, noWarmStartWithoutPreviousModel)
+{
+  FieldBoundaryRansac ransac;
+  std::vector<Spot> model;
+  const std::vector<Spot> spots = spotsOn({Vector2f(3000.f, 3000.f), Vector2f(3000.f, -3000.f)});
+  ransac.fit(spots, {0, 100, 1, 0.1f, true}, cameraMatrix, info, imageCoordinateSystem(), Pose2f(), model);
+  EXPECT_TRUE(model.empty());
+}
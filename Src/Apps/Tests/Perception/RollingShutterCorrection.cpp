@@ -0,0 +1,101 @@
+#include "Representations/Perception/ImagePreprocessing/RollingShutterCorrection.h"
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+  float random(float min, float max)
+  {
+    return min + static_cast<float>(std::rand()) / RAND_MAX * (max - min);
+  }
+
+  CameraInfo cameraInfo()
+  {
+    CameraInfo cameraInfo;
+    cameraInfo.width = 640;
+    cameraInfo.height = 480;
+    cameraInfo.opticalCenter = Vector2f(322.f, 236.f);
+    cameraInfo.focalLength = 560.f;
+    cameraInfo.focalLengthHeight = 558.f;
+    return cameraInfo;
+  }
+
+  /** The correction as computed by ImageCoordinateSystem before it was tabulated. */
+  Vector2f toCorrected(const CameraInfo& cameraInfo, float a, float b, const Vector2f& offset, const Vector2f& imageCoords)
+  {
+    const float factor = a + imageCoords.y() * b;
+    return Vector2f(cameraInfo.opticalCenter.x() - std::tan(std::atan((cameraInfo.opticalCenter.x() - imageCoords.x()) / cameraInfo.focalLength) - factor * offset.x()) * cameraInfo.focalLength,
+                    cameraInfo.opticalCenter.y() + std::tan(std::atan((imageCoords.y() - cameraInfo.opticalCenter.y()) / cameraInfo.focalLengthHeight) - factor * offset.y()) * cameraInfo.focalLengthHeight);
+  }
+}
+
+GTEST_TEST(RollingShutterCorrection, matchesTrigonometry)
+{
+  std::srand(42);
+  const CameraInfo info = cameraInfo();
+  for(int i = 0; i < 100; ++i)
+  {
+    const float a = random(-1.f, 1.f);
+    const float b = random(0.5f, 1.f) / static_cast<float>(info.height);
+    const Vector2f offset(random(-0.1f, 0.1f), random(-0.1f, 0.1f));
+    const RollingShutterCorrection correction(info, a, b, offset);
+
+    std::vector<Vector2f> points;
+    for(int j = 0; j < 103; ++j)
+      points.emplace_back(random(-200.f, 840.f), random(-400.f, 880.f));
+    std::vector<Vector2f> corrected(points.size());
+    correction.toCorrected(points.data(), corrected.data(), points.size());
+
+    for(std::size_t j = 0; j < points.size(); ++j)
+    {
+      const Vector2f expected = toCorrected(info, a, b, offset, points[j]);
+      EXPECT_NEAR(correction.toCorrected(points[j]).x(), expected.x(), 0.01f);
+      EXPECT_NEAR(correction.toCorrected(points[j]).y(), expected.y(), 0.01f);
+      EXPECT_NEAR(corrected[j].x(), expected.x(), 0.01f);
+      EXPECT_NEAR(corrected[j].y(), expected.y(), 0.01f);
+    }
+  }
+}
+
+GTEST_TEST(RollingShutterCorrection, invertsCorrection)
+{
+  std::srand(42);
+  const CameraInfo info = cameraInfo();
+  for(int i = 0; i < 100; ++i)
+  {
+    const float a = random(-1.f, 1.f);
+    const float b = random(0.5f, 1.f) / static_cast<float>(info.height);
+    const Vector2f offset(random(-0.1f, 0.1f), random(-0.1f, 0.1f));
+    const RollingShutterCorrection correction(info, a, b, offset);
+
+    std::vector<Vector2f> points;
+    for(int j = 0; j < 103; ++j)
+      points.emplace_back(random(0.f, 640.f), random(0.f, 480.f));
+    std::vector<Vector2f> corrected(points.size());
+    for(std::size_t j = 0; j < points.size(); ++j)
+      corrected[j] = toCorrected(info, a, b, offset, points[j]);
+    std::vector<Vector2f> original(points.size());
+    correction.fromCorrected(corrected.data(), original.data(), points.size());
+
+    for(std::size_t j = 0; j < points.size(); ++j)
+    {
+      if(corrected[j].y() < -info.height / 4 || corrected[j].y() >= info.height * 5 / 4)
+        continue;
+      EXPECT_NEAR(correction.fromCorrected(corrected[j]).x(), points[j].x(), 0.05f);
+      EXPECT_NEAR(correction.fromCorrected(corrected[j]).y(), points[j].y(), 0.05f);
+      EXPECT_NEAR(original[j].x(), points[j].x(), 0.05f);
+      EXPECT_NEAR(original[j].y(), points[j].y(), 0.05f);
+    }
+  }
+
+  // Points that cannot be the result of a correction are not changed.
+  const RollingShutterCorrection correction(info, 0.5f, 1.f / static_cast<float>(info.height), Vector2f(0.05f, 0.05f));
+  const Vector2f outside[] = {{10.f, -200.f}, {20.f, 700.f}, {30.f, -121.f}, {40.f, 600.f}};
+  Vector2f original[4];
+  correction.fromCorrected(outside, original, 4);
+  for(int j = 0; j < 4; ++j)
+    EXPECT_EQ(original[j], outside[j]);
+}
@@ -0,0 +1,59 @@
+#include "Platform/Memory.h"
+
+#include <cstdint>
+#include <cstring>
+#include <gtest/gtest.h>
+
+GTEST_TEST(Memory, HugePageMalloc)
+{
+  for(std::size_t size : {std::size_t(1000), std::size_t(1) << 20, (std::size_t(3) << 20) + 12345})
+  {
+    char* buffer = static_cast<char*>(Memory::hugePageMalloc(size));
+    ASSERT_NE(buffer, nullptr);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer) % 64, 0u);
+    std::memset(buffer, 0x55, size);
+    EXPECT_EQ(buffer[size - 1], 0x55);
+    Memory::hugePageFree(buffer, size);
+  }
+  Memory::hugePageFree(nullptr, 0);
+}
+
+GTEST_TEST(Memory, NoAllocationScope)
+{
+#ifdef CHECK_ALLOCATIONS
+  {
+    Memory::NoAllocationScope noAllocationScope;
+    char buffer[16];
+    std::memset(buffer, 0, sizeof(buffer));
+  }
+  int* volatile allowed = new int(0);
+  delete allowed;
+  EXPECT_DEATH(
+  {
+    Memory::NoAllocationScope noAllocationScope;
+    int* volatile forbidden = new int(0);
+    delete forbidden;
+  }, "Heap allocation of 4 bytes in a NoAllocationScope");
+#else
+  GTEST_SKIP() << "Heap allocations are only checked if CHECK_ALLOCATIONS is enabled";
+#endif
+}
+
+GTEST_TEST(Memory, AllowAllocationScope)
+{
+#ifdef CHECK_ALLOCATIONS
+  EXPECT_DEATH(
+  {
+    Memory::NoAllocationScope noAllocationScope;
+    {
+      Memory::AllowAllocationScope allowAllocationScope;
+      double* volatile allowed = new double(0);
+      delete allowed;
+    }
+    int* volatile forbidden = new int(0);
+    delete forbidden;
+  }, "Heap allocation of 4 bytes in a NoAllocationScope");
+#else
+  GTEST_SKIP() << "Heap allocations are only checked if CHECK_ALLOCATIONS is enabled";
+#endif
+}
@@ -0,0 +1,88 @@
+#include "SimulatedNao/Visualization/PlotHistory.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+
+GTEST_TEST(PlotHistory, keepsNewestValues)
+{
+  PlotHistory history;
+  history.setCapacity(10);
+  for(int i = 0; i < 25; ++i)
+    history.add(static_cast<float>(i));
+
+  ASSERT_EQ(history.size(), 10u);
+  for(std::size_t age = 0; age < history.size(); ++age)
+    EXPECT_EQ(history[age], static_cast<float>(24 - age));
+}
+
+GTEST_TEST(PlotHistory, setCapacityKeepsNewestValues)
+{
+  PlotHistory history;
+  history.setCapacity(10);
+  for(int i = 0; i < 25; ++i)
+    history.add(static_cast<float>(i));
+
+  history.setCapacity(4);
+  ASSERT_EQ(history.size(), 4u);
+  for(std::size_t age = 0; age < history.size(); ++age)
+    EXPECT_EQ(history[age], static_cast<float>(24 - age));
+
+  history.setCapacity(8);
+  ASSERT_EQ(history.size(), 4u);
+  history.add(25.f);
+  EXPECT_EQ(history.size(), 5u);
+  EXPECT_EQ(history[0], 25.f);
+  EXPECT_EQ(history[4], 21.f);
+}
+
+GTEST_TEST(PlotHistory, blocksMatchValues)
+{
+  std::mt19937 generator(0);
+  std::uniform_real_distribution<float> distribution(-100.f, 100.f);
+  PlotHistory history;
+  history.setCapacity(1000);
+  for(int i = 0; i < 2345; ++i)
+  {
+    history.add(distribution(generator));
+
+    // Check partially filled blocks and blocks that wrapped around in the ring buffers.
+    if(i != 17 && i != 999 && i != 2344)
+      continue;
+
+    for(const std::size_t numOfValues : {history.size(), std::min<std::size_t>(history.size(), 100)})
+      for(std::size_t level = 0; level < PlotHistory::numOfLevels; ++level)
+      {
+        std::size_t nextAge = 0;
+        history.forEachBlock(level, numOfValues, [&](std::size_t newest, std::size_t oldest, const PlotHistory::Range& range)
+        {
+          // The blocks must cover the values without gaps, newest first.
+          EXPECT_EQ(newest, nextAge);
+          ASSERT_LE(newest, oldest);
+          ASSERT_LT(oldest, numOfValues);
+          nextAge = oldest + 1;
+
+          float min = history[newest];
+          float max = min;
+          for(std::size_t age = newest + 1; age <= oldest; ++age)
+          {
+            min = std::min(min, history[age]);
+            max = std::max(max, history[age]);
+          }
+
+          // A block clipped at its old end may also contain values that are not covered.
+          if(oldest + 1 < numOfValues)
+          {
+            EXPECT_EQ(range.min, min);
+            EXPECT_EQ(range.max, max);
+          }
+          else
+          {
+            EXPECT_LE(range.min, min);
+            EXPECT_GE(range.max, max);
+          }
+        });
+        EXPECT_EQ(nextAge, numOfValues);
+      }
+  }
+}
@@ -0,0 +1,25 @@
+#include "Streaming/TypeRegistry.h"
+
+#include <gtest/gtest.h>
+
+GTEST_TEST(TypeRegistry, CompileTimeNamesMatchDemangledNames)
+{
+  EXPECT_FALSE(TypeRegistry::getNames().empty());
+  for(const auto& [type, name] : TypeRegistry::getNames())
+  {
+    const std::string demangled = TypeRegistry::demangle(type);
+
+    // The regular expressions cannot handle std::array inside of other containers.
+    if(demangled.find("std::array<") == std::string::npos)
+      EXPECT_EQ(demangled, name);
+  }
+}
+
+GTEST_TEST(TypeRegistry, Containers)
+{
+  EXPECT_STREQ("std::string", TypeRegistry::getName<std::string>());
+  EXPECT_STREQ("unsigned short*", TypeRegistry::getName<std::vector<unsigned short>>());
+  EXPECT_STREQ("float[3]*", (TypeRegistry::getName<std::list<std::array<float, 3>>>()));
+  EXPECT_STREQ("int[2][3]", TypeRegistry::getName<int[2][3]>());
+  EXPECT_STREQ("int[2]", TypeRegistry::getName<int(*)[2]>());
+}
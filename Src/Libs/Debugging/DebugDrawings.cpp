@@ -8,6 +8,15 @@
 
 #include "DebugDrawings.h"
 #include "Platform/BHAssert.h"
+#include "Streaming/MessageQueue.h"
+#include <atomic>
+
+/** The source of generations that are unique among all drawing managers. */
+static std::atomic<unsigned> nextGeneration = 1;
+
+DrawingManager::DrawingManager() :
+  generation(nextGeneration++)
+{}
 
 void DrawingManager::addDrawingId(const char* name, const char* typeName)
 {
@@ -33,6 +42,8 @@ void DrawingManager::addDrawingId(const char* name, const char* typeName)
 
 void DrawingManager::clear()
 {
+  generation = nextGeneration++;
+  shapes.clear();
   types.clear();
   drawings.clear();
   strings.clear();
@@ -40,6 +51,38 @@ void DrawingManager::clear()
   typesById.clear();
 }
 
+void DrawingManager::bind(Site& site, const char* name)
+{
+  site.generation = generation;
+  const auto i = drawings.find(name);
+  if(i == drawings.end())
+  {
+    OUTPUT_WARNING("Debug drawing " << name << " not declared");
+    site.shapes = &undeclaredShapes;
+    return;
+  }
+
+  const std::size_t id = static_cast<unsigned char>(i->second.id);
+  if(id >= shapes.size())
+    shapes.resize(id + 1);
+  if(!shapes[id])
+    shapes[id] = std::make_unique<ShapeStream>();
+  site.shapes = shapes[id].get();
+}
+
+void DrawingManager::flush(MessageQueue& queue)
+{
+  for(std::size_t id = 0; id < shapes.size(); ++id)
+    if(shapes[id] && !shapes[id]->data.empty())
+    {
+      auto stream = queue.bin(idDebugDrawingShapes);
+      stream << static_cast<char>(id);
+      stream.write(shapes[id]->data.data(), shapes[id]->data.size());
+      shapes[id]->data.clear();
+    }
+  undeclaredShapes.data.clear();
+}
+
 const char* DrawingManager::getString(const std::string& string)
 {
   std::unordered_map<std::string, const char*>::iterator i = strings.find(string);
@@ -9,7 +9,12 @@
 #include "Math/BHMath.h"
 #include "Math/Covariance.h"
 #include "Math/Eigen.h"
+#include "Streaming/OutStreams.h"
+#include <memory>
 #include <unordered_map>
+#include <vector>
+
+class MessageQueue;
 
 namespace Drawings
 {
@@ -39,6 +44,18 @@ namespace Drawings
 
 class DrawingManager
 {
+  /** A memory stream that is reused every frame. */
+  class ShapeMemory : public PhysicalOutStream
+  {
+  public:
+    std::vector<char> data; /**< The bytes written in the current frame. */
+
+    void writeToStream(const void* p, size_t size) override
+    {
+      data.insert(data.end(), static_cast<const char*>(p), static_cast<const char*>(p) + size);
+    }
+  };
+
 public:
   struct Drawing
   {
@@ -46,10 +63,42 @@ public:
     char type;
   };
 
+  /** The stream the shapes of a drawing are recorded in during a frame. */
+  using ShapeStream = OutStream<ShapeMemory, OutBinary>;
+
+  /** Remembers for a place in the code which drawing it adds shapes to. */
+  struct Site
+  {
+    unsigned generation = 0; /**< The generation of the drawing manager the stream belongs to. */
+    ShapeStream* shapes = nullptr; /**< The stream shapes are recorded in. */
+  };
+
   /** Constructor. */
-  DrawingManager() = default;
+  DrawingManager();
   DrawingManager(const DrawingManager&) = delete;
   void clear();
+
+  /**
+   * Returns the stream the shapes of a drawing are recorded in. The drawing is
+   * only looked up when a site is used for the first time.
+   * @param site The cached information of the place this is called from.
+   * @param name The name of the drawing.
+   * @return The stream.
+   */
+  Out& getShapes(Site& site, const char* name)
+  {
+    if(site.generation != generation)
+      bind(site, name);
+    return *site.shapes;
+  }
+
+  /**
+   * Sends the shapes recorded in this frame as one message per drawing,
+   * i.e. the drawing id followed by the shapes, and clears them.
+   * @param queue The queue the messages are written to.
+   */
+  void flush(MessageQueue& queue);
+
   void addDrawingId(const char* name, const char* typeName);
   char getDrawingId(const char* name) const;
   const char* getDrawingType(const char* name) const;
@@ -61,6 +110,17 @@ public:
 private:
   const char* getTypeName(char id) const;
 
+  /**
+   * Associates a site with the shapes of a drawing.
+   * @param site The site that is updated.
+   * @param name The name of the drawing.
+   */
+  void bind(Site& site, const char* name);
+
+  unsigned generation; /**< Changes whenever sites must look up their drawings again. Unique among all drawing managers. */
+  std::vector<std::unique_ptr<ShapeStream>> shapes; /**< The shapes recorded in the current frame, indexed by drawing id. */
+  ShapeStream undeclaredShapes; /**< Shapes of drawings that were not declared. They are not sent. */
+
   std::unordered_map<std::string, const char*> strings;
   std::unordered_map<const char*, char> types;
 
@@ -135,6 +195,13 @@ inline const char* DrawingManager::getTypeName(char id) const
   } \
   while(false)
 
+/**
+ * Returns the stream shapes are recorded in for a drawing.
+ * @param id A drawing id
+ */
+#define _DRAWING_SHAPES(id) \
+  Global::getDrawingManager().getShapes([]() -> DrawingManager::Site& {static thread_local DrawingManager::Site _site; return _site;}(), id)
+
 /**
  * Complex drawings should be encapsulated by this macro.
  * @param id A drawing id
@@ -158,14 +225,12 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::circle) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(center_x) << static_cast<int>(center_y) << \
-             static_cast<int>(radius) << static_cast<char>(penWidth) << \
-             static_cast<char>(penStyle) << ColorRGBA(penColor) << \
-             static_cast<char>(brushStyle) << ColorRGBA(brushColor)\
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::circle) << \
+        static_cast<int>(center_x) << static_cast<int>(center_y) << \
+        static_cast<int>(radius) << static_cast<char>(penWidth) << \
+        static_cast<char>(penStyle) << ColorRGBA(penColor) << \
+        static_cast<char>(brushStyle) << ColorRGBA(brushColor); \
     } \
   while(false)
 
@@ -187,15 +252,13 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::arc) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(center_x) << static_cast<int>(center_y) << static_cast<int>(radius) << \
-             Angle(startAngle) << Angle(spanAngle) << \
-             static_cast<char>(penWidth) << \
-             static_cast<char>(penStyle) << ColorRGBA(penColor) << \
-             static_cast<char>(brushStyle) << ColorRGBA(brushColor)\
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::arc) << \
+        static_cast<int>(center_x) << static_cast<int>(center_y) << static_cast<int>(radius) << \
+        Angle(startAngle) << Angle(spanAngle) << \
+        static_cast<char>(penWidth) << \
+        static_cast<char>(penStyle) << ColorRGBA(penColor) << \
+        static_cast<char>(brushStyle) << ColorRGBA(brushColor); \
     } \
   while(false)
 
@@ -216,14 +279,12 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::ellipse) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>((center).x()) << static_cast<int>((center).y()) << \
-             static_cast<int>(radiusX) << static_cast<int>(radiusY) << static_cast<float>(rotation) << \
-             static_cast<char>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor) << \
-             static_cast<char>(brushStyle) << ColorRGBA(brushColor) \
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::ellipse) << \
+        static_cast<int>((center).x()) << static_cast<int>((center).y()) << \
+        static_cast<int>(radiusX) << static_cast<int>(radiusY) << static_cast<float>(rotation) << \
+        static_cast<char>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor) << \
+        static_cast<char>(brushStyle) << ColorRGBA(brushColor); \
     } \
   while(false)
 
@@ -242,14 +303,12 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::rectangle) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>((topLeft).x()) << static_cast<int>((topLeft).y()) << \
-             static_cast<int>(width) << static_cast<int>(height) << static_cast<float>(rotation) << \
-             static_cast<char>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor) << \
-             static_cast<char>(brushStyle) << ColorRGBA(brushColor)\
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::rectangle) << \
+        static_cast<int>((topLeft).x()) << static_cast<int>((topLeft).y()) << \
+        static_cast<int>(width) << static_cast<int>(height) << static_cast<float>(rotation) << \
+        static_cast<char>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor) << \
+        static_cast<char>(brushStyle) << ColorRGBA(brushColor); \
     } \
   while(false)
 
@@ -271,14 +330,12 @@ inline const char* DrawingManager::getTypeName(char id) const
       OutTextMemory _stream(static_cast<int>(numberOfPoints) * 12); \
       for(int _i = 0; _i < static_cast<int>(numberOfPoints); ++_i) \
         _stream << static_cast<int>(points[_i].x()) << static_cast<int>(points[_i].y()); \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::polygon) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(numberOfPoints) << \
-             _stream.data() << \
-             static_cast<char>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor) << \
-             static_cast<char>(brushStyle) << ColorRGBA(brushColor) \
-            );  \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::polygon) << \
+        static_cast<int>(numberOfPoints) << \
+        _stream.data() << \
+        static_cast<char>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor) << \
+        static_cast<char>(brushStyle) << ColorRGBA(brushColor); \
     } \
   while(false)
 
@@ -294,11 +351,9 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::dot) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(x) << static_cast<int>(y) << ColorRGBA(penColor) << ColorRGBA(brushColor) \
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::dot) << \
+        static_cast<int>(x) << static_cast<int>(y) << ColorRGBA(penColor) << ColorRGBA(brushColor); \
     } \
   while(false)
 
@@ -313,12 +368,10 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::dot) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>((xy).x()) << static_cast<int>((xy).y()) << \
-             ColorRGBA(penColor) << ColorRGBA(brushColor) \
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::dot) << \
+        static_cast<int>((xy).x()) << static_cast<int>((xy).y()) << \
+        ColorRGBA(penColor) << ColorRGBA(brushColor); \
     } \
   while(false)
 
@@ -334,11 +387,9 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::dotMedium) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(x) << static_cast<int>(y) << ColorRGBA(penColor) << ColorRGBA(brushColor) \
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::dotMedium) << \
+        static_cast<int>(x) << static_cast<int>(y) << ColorRGBA(penColor) << ColorRGBA(brushColor); \
     } \
   while(false)
 
@@ -354,11 +405,9 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::dotLarge) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(x) << static_cast<int>(y) << ColorRGBA(penColor) << ColorRGBA(brushColor) \
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::dotLarge) << \
+        static_cast<int>(x) << static_cast<int>(y) << ColorRGBA(penColor) << ColorRGBA(brushColor); \
     } \
   while(false)
 
@@ -377,13 +426,11 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::line) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<float>(x1) << static_cast<float>(y1) << \
-             static_cast<float>(x2) << static_cast<float>(y2) << \
-             static_cast<float>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor) \
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::line) << \
+        static_cast<float>(x1) << static_cast<float>(y1) << \
+        static_cast<float>(x2) << static_cast<float>(y2) << \
+        static_cast<float>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor); \
     } \
   while(false)
 
@@ -409,13 +456,11 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::arrow) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<float>(x1) << static_cast<float>(y1) << \
-             static_cast<float>(x2) << static_cast<float>(y2) << \
-             static_cast<float>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor) \
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::arrow) << \
+        static_cast<float>(x1) << static_cast<float>(y1) << \
+        static_cast<float>(x2) << static_cast<float>(y2) << \
+        static_cast<float>(penWidth) << static_cast<char>(penStyle) << ColorRGBA(penColor); \
     } \
   while(false)
 
@@ -513,12 +558,10 @@ inline const char* DrawingManager::getTypeName(char id) const
     { \
       OutTextRawMemory _stream; \
       _stream << txt; \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::text) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(x) << static_cast<int>(y) << \
-             static_cast<short>(fontSize) << ColorRGBA(color) << _stream.data() \
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::text) << \
+        static_cast<int>(x) << static_cast<int>(y) << \
+        static_cast<short>(fontSize) << ColorRGBA(color) << _stream.data(); \
     } \
   while(false)
 
@@ -531,12 +574,10 @@ inline const char* DrawingManager::getTypeName(char id) const
     { \
       OutTextRawMemory _stream(1024); \
       _stream << action; \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::spot) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(x1) << static_cast<int>(y1) << \
-             static_cast<int>(x2) << static_cast<int>(y2) << _stream.data() \
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::spot) << \
+        static_cast<int>(x1) << static_cast<int>(y1) << \
+        static_cast<int>(x2) << static_cast<int>(y2) << _stream.data(); \
     } \
   while(false)
 
@@ -554,11 +595,9 @@ inline const char* DrawingManager::getTypeName(char id) const
     { \
       OutTextRawMemory _stream(1024); \
       _stream << text; \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::tip) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(x) << static_cast<int>(y) << static_cast<int>(radius) << _stream.data() \
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::tip) << \
+        static_cast<int>(x) << static_cast<int>(y) << static_cast<int>(radius) << _stream.data(); \
     } \
   while(false)
 
@@ -571,11 +610,9 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::thread) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             (threadName) \
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::thread) << \
+        (threadName); \
     } \
   while(false)
 
@@ -590,11 +627,9 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::origin) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             static_cast<int>(x) << static_cast<int>(y) << static_cast<float>(angle) \
-            ); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::origin) << \
+        static_cast<int>(x) << static_cast<int>(y) << static_cast<float>(angle); \
     } \
   while(false)
 
@@ -613,11 +648,10 @@ inline const char* DrawingManager::getTypeName(char id) const
   do \
     COMPLEX_DRAWING(id) \
     { \
-      OUTPUT(idDebugDrawing, bin, \
-             static_cast<char>(Drawings::robot) << \
-             Global::getDrawingManager().getDrawingId(id) << \
-             Pose2f(p) << Vector2f(dirVec) << Vector2f(dirHeadVec) << \
-             static_cast<float>(alphaRobot) << ColorRGBA(colorBody) << ColorRGBA(colorDirVec) << ColorRGBA(colorDirHeadVec)); \
+      _DRAWING_SHAPES(id) << \
+        static_cast<char>(Drawings::robot) << \
+        Pose2f(p) << Vector2f(dirVec) << Vector2f(dirHeadVec) << \
+        static_cast<float>(alphaRobot) << ColorRGBA(colorBody) << ColorRGBA(colorDirVec) << ColorRGBA(colorDirHeadVec); \
     } \
   while(false)
 
@@ -758,9 +792,8 @@ inline const char* DrawingManager::getTypeName(char id) const
     { \
       const int _cellsX = static_cast<int>(cellsX); \
       const int _cellsY = static_cast<int>(cellsY); \
-      auto _stream = Global::getDebugOut().bin(idDebugDrawing); \
+      Out& _stream = _DRAWING_SHAPES(id); \
       _stream << static_cast<char>(Drawings::gridMono) \
-              << Global::getDrawingManager().getDrawingId(id) \
               << static_cast<int>(x) << static_cast<int>(y) << static_cast<int>(cellSize) \
               << _cellsX << _cellsY << ColorRGBA(baseColor); \
       _stream.write(cells, _cellsX * _cellsY); \
@@ -783,9 +816,8 @@ inline const char* DrawingManager::getTypeName(char id) const
     { \
       const int _cellsX = static_cast<int>(cellsX); \
       const int _cellsY = static_cast<int>(cellsY); \
-      auto _stream = Global::getDebugOut().bin(idDebugDrawing); \
+      Out& _stream = _DRAWING_SHAPES(id); \
       _stream << static_cast<char>(Drawings::gridRGBA) \
-              << Global::getDrawingManager().getDrawingId(id) \
               << static_cast<int>(x) << static_cast<int>(y) << static_cast<int>(cellSize) \
               << _cellsX << _cellsY; \
       _stream.write(cells, _cellsX * _cellsY * sizeof(ColorRGBA)); \
@@ -809,9 +841,8 @@ inline const char* DrawingManager::getTypeName(char id) const
     { \
       const int _cellsX = static_cast<int>(cellsX); \
       const int _cellsY = static_cast<int>(cellsY); \
-      auto _stream = Global::getDebugOut().bin(idDebugDrawing); \
+      Out& _stream = _DRAWING_SHAPES(id); \
       _stream << static_cast<char>(Drawings::gridRectangleRGBA) \
-              << Global::getDrawingManager().getDrawingId(id) \
               << static_cast<int>(x) << static_cast<int>(y) << static_cast<int>(cellWidth) \
               << static_cast<int>(cellHeight) << _cellsX << _cellsY; \
       _stream.write(cells, _cellsX * _cellsY * sizeof(ColorRGBA)); \
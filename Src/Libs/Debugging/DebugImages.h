@@ -9,6 +9,7 @@
 
 #include "Debugging/Debugging.h"
 #include "ImageProcessing/Image.h"
+#include "ImageProcessing/ImageBufferPool.h"
 #include "ImageProcessing/PixelTypes.h"
 #include "Platform/Memory.h"
 #include "Streaming/Streamable.h"
@@ -17,7 +18,7 @@
 struct DebugImage : public Streamable
 {
 private:
-  size_t maxSize = 0;
+  size_t maxSize = 0; /**< The capacity of the buffer from the ImageBufferPool if it is not a reference. */
 
 public:
   void* data = nullptr;
@@ -32,24 +33,18 @@ public:
   DebugImage(const Image<PixelTypes::BGRAPixel>& image)
     : data(const_cast<void*>(static_cast<const void*>(image[0]))), width(static_cast<unsigned short>(image.width)), height(static_cast<unsigned short>(image.height)), isReference(true), type(PixelTypes::PixelType::BGRA) {}
   DebugImage(const Image<PixelTypes::YUYVPixel>& image, const bool copy = false)
-    : data(copy ? Memory::alignedMalloc(image.width * image.height * sizeof(PixelTypes::YUYVPixel), 32) : const_cast<void*>(static_cast<const void*>(image[0]))), width(static_cast<unsigned short>(image.width)), height(static_cast<unsigned short>(image.height)), isReference(!copy), type(PixelTypes::PixelType::YUYV)
+    : data(copy ? ImageBufferPool::acquire(image.width * image.height * sizeof(PixelTypes::YUYVPixel), maxSize) : const_cast<void*>(static_cast<const void*>(image[0]))), width(static_cast<unsigned short>(image.width)), height(static_cast<unsigned short>(image.height)), isReference(!copy), type(PixelTypes::PixelType::YUYV)
   {
     if(copy)
-    {
-      maxSize = width * height * sizeof(PixelTypes::YUYVPixel);
-      memcpy(data, image[0], maxSize);
-    }
+      memcpy(data, image[0], width * height * sizeof(PixelTypes::YUYVPixel));
   }
   DebugImage(const Image<PixelTypes::YUVPixel>& image)
     : data(const_cast<void*>(static_cast<const void*>(image[0]))), width(static_cast<unsigned short>(image.width)), height(static_cast<unsigned short>(image.height)), isReference(true), type(PixelTypes::PixelType::YUV) {}
   DebugImage(const Image<PixelTypes::GrayscaledPixel>& image, const bool copy = false)
-    : data(copy ? Memory::alignedMalloc(image.width * image.height * sizeof(PixelTypes::GrayscaledPixel), 32) : const_cast<void*>(static_cast<const void*>(image[0]))), width(static_cast<unsigned short>(image.width)), height(static_cast<unsigned short>(image.height)), isReference(!copy), type(PixelTypes::PixelType::Grayscale)
+    : data(copy ? ImageBufferPool::acquire(image.width * image.height * sizeof(PixelTypes::GrayscaledPixel), maxSize) : const_cast<void*>(static_cast<const void*>(image[0]))), width(static_cast<unsigned short>(image.width)), height(static_cast<unsigned short>(image.height)), isReference(!copy), type(PixelTypes::PixelType::Grayscale)
   {
     if(copy)
-    {
-      maxSize = width * height * sizeof(PixelTypes::GrayscaledPixel);
-      memcpy(data, image[0], maxSize);
-    }
+      memcpy(data, image[0], width * height * sizeof(PixelTypes::GrayscaledPixel));
   }
   DebugImage(const Image<PixelTypes::HuePixel>& image)
     : data(const_cast<void*>(static_cast<const void*>(image[0]))), width(static_cast<unsigned short>(image.width)), height(static_cast<unsigned short>(image.height)), isReference(true), type(PixelTypes::PixelType::Hue) {}
@@ -68,7 +63,7 @@ public:
   {
     if(!isReference && data)
     {
-      Memory::alignedFree(data);
+      ImageBufferPool::release(data, maxSize);
       data = nullptr;
     }
   }
@@ -93,10 +88,9 @@ public:
     if(isReference || !data || size > maxSize)
     {
       if(!isReference && data)
-        Memory::alignedFree(data);
+        ImageBufferPool::release(data, maxSize);
       isReference = false;
-      data = Memory::alignedMalloc(size, 32);
-      maxSize = size;
+      data = ImageBufferPool::acquire(size, maxSize);
     }
     width = static_cast<unsigned short>(image.width);
     height = static_cast<unsigned short>(image.height);
@@ -110,10 +104,9 @@ public:
     if(isReference || !data || size > maxSize)
     {
       if(!isReference && data)
-        Memory::alignedFree(data);
+        ImageBufferPool::release(data, maxSize);
       isReference = false;
-      data = Memory::alignedMalloc(size, 32);
-      maxSize = size;
+      data = ImageBufferPool::acquire(size, maxSize);
     }
     width = static_cast<unsigned short>(image.width);
     height = static_cast<unsigned short>(image.height);
@@ -141,10 +134,9 @@ protected:
     if(isReference || !data || size > maxSize)
     {
       if(!isReference && data)
-        Memory::alignedFree(data);
+        ImageBufferPool::release(data, maxSize);
       isReference = false;
-      data = Memory::alignedMalloc(size, 32);
-      maxSize = size;
+      data = ImageBufferPool::acquire(size, maxSize);
     }
     stream.read(data, size);
   }
@@ -10,6 +10,7 @@
 
 #include "DebugRequest.h"
 #include "Platform/BHAssert.h"
+#include "Platform/Memory.h"
 
 DebugRequestTable::DebugRequestTable()
 {
@@ -43,6 +44,8 @@ void DebugRequestTable::addRequest(const DebugRequest& debugRequest)
 
 bool DebugRequestTable::isActiveSlow(const char* name)
 {
+  // Reached once per request, so it may even allocate in threads that must not.
+  Memory::AllowAllocationScope allowAllocationScope;
   std::unordered_map<std::string, size_t>::const_iterator j = slowIndex.find(name);
   size_t k;
   if(j != slowIndex.end())
@@ -67,6 +70,7 @@ bool DebugRequestTable::notYetPolled(const char* name)
 {
   if(polled.find(name) == polled.end())
   {
+    Memory::AllowAllocationScope allowAllocationScope;
     polled.insert(name);
     return true;
   }
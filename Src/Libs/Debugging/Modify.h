@@ -35,7 +35,7 @@
   { \
     Global::getDebugDataTable().updateObject(id, object, once); \
     DEBUG_RESPONSE("debug data:" id) \
-      OUTPUT(idDebugDataResponse, bin, id << TypeRegistry::demangle(typeid(object).name()) << object); \
+      OUTPUT(idDebugDataResponse, bin, id << TypeRegistry::getName(typeid(object).name()) << object); \
   } \
   while(false)
 
@@ -0,0 +1,38 @@
+/**
+ * @file Plot.cpp
+ *
+ * This file implements the collection of plot values per frame.
+ */
+
+#include "Plot.h"
+#include "Streaming/MessageQueue.h"
+#include <cstring>
+
+thread_local std::vector<PlotBuffer::Entry> PlotBuffer::entries;
+
+void PlotBuffer::bind(Site& site, const char* name)
+{
+  // Different PLOT statements can use the same plot.
+  for(site.index = 0; site.index < entries.size(); ++site.index)
+    if(!std::strcmp(entries[site.index].name, name))
+      return;
+  entries.push_back({name, {}});
+}
+
+void PlotBuffer::flush(MessageQueue& queue)
+{
+  bool empty = true;
+  for(const Entry& entry : entries)
+    empty &= entry.values.empty();
+  if(empty)
+    return;
+
+  auto stream = queue.bin(idPlotValues);
+  for(Entry& entry : entries)
+    if(!entry.values.empty())
+    {
+      stream << entry.name << static_cast<unsigned>(entry.values.size());
+      stream.write(entry.values.data(), entry.values.size() * sizeof(float));
+      entry.values.clear();
+    }
+}
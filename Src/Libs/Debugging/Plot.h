@@ -6,6 +6,64 @@
 
 #include "Debugging/Debugging.h"
 #include "Streaming/Output.h"
+#include <cstddef>
+#include <vector>
+
+class MessageQueue;
+
+/**
+ * Collects the values plotted by a thread during a frame. They are sent as a
+ * single idPlotValues message at the end of the frame, which contains, for each
+ * plot that received values, its name, the number of values, and the values.
+ */
+class PlotBuffer
+{
+public:
+  /** Caches the index of the plot a PLOT statement writes to in the current thread. */
+  struct Site
+  {
+    std::size_t index = static_cast<std::size_t>(-1); /**< The index of the plot or -1 if not bound yet. */
+  };
+
+private:
+  /** The values of a single plot collected in the current frame. */
+  struct Entry
+  {
+    const char* name; /**< The name of the plot. */
+    std::vector<float> values; /**< The values collected. */
+  };
+
+  static thread_local std::vector<Entry> entries; /**< All plots ever used by the current thread. */
+
+  /**
+   * Binds a plot site to the entry of a plot. A new entry is created if the
+   * plot was not used in this thread before.
+   * @param site The site that is bound.
+   * @param name The name of the plot.
+   */
+  static void bind(Site& site, const char* name);
+
+public:
+  /**
+   * Adds a value to a plot.
+   * @param site The site the value is plotted from.
+   * @param name The name of the plot.
+   * @param value The value.
+   */
+  static void add(Site& site, const char* name, float value)
+  {
+    if(site.index == static_cast<std::size_t>(-1))
+      bind(site, name);
+    entries[site.index].values.push_back(value);
+  }
+
+  /**
+   * Writes all values collected in the current frame to a message queue and
+   * clears them.
+   * @param queue The queue the idPlotValues message is written to.
+   */
+  static void flush(MessageQueue& queue);
+};
 
 #if !defined TARGET_ROBOT || !defined NDEBUG
 
@@ -24,7 +82,8 @@
  */
 #define PLOT(id, value) \
   do \
-    DEBUG_RESPONSE("plot:" id) OUTPUT(idPlot, bin, id << static_cast<float>(value)); \
+    DEBUG_RESPONSE("plot:" id) \
+      PlotBuffer::add([]() -> PlotBuffer::Site& {static thread_local PlotBuffer::Site _site; return _site;}(), id, static_cast<float>(value)); \
   while(false)
 
 #else
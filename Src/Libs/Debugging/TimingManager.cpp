@@ -28,11 +28,28 @@ struct TimingManager::Pimpl
    */
   std::unordered_map<const char*, unsigned long long> timing;
   std::unordered_map<const char*, unsigned short> idTable; /**< Key: name of the stopwatch. Value: the id that is used when sending timing data over the network */
+  std::unordered_map<const char*, std::pair<unsigned, unsigned>> calls; /**< Key: name of a memoized function. Value: hits and calls in this frame */
   unsigned currentThreadStartTime = 0; /**< Timestamp of the current thread iteration */
   unsigned frameNo = 0; /**<  Number of the current frame*/
   std::vector<const char*> watchNames; /**< Contains the names of the stopwatches */
   MessageQueue data; /**< Contains the timing data in streamable format in between frames */
   bool dataPrepared = false; /**< True if data hs already been prepared this frame */
+
+  /**
+   * Returns the id of a stopwatch or memoized function. Unknown names get a new id.
+   * @param identifier The name.
+   * @return The id.
+   */
+  unsigned short getId(const char* identifier)
+  {
+    auto id = idTable.find(identifier);
+    if(id == idTable.end())
+    {
+      watchNames.push_back(identifier);
+      id = idTable.emplace(identifier, static_cast<unsigned short>(idTable.size())).first; //NOTE: this assumes that an unsigned short will always be big big enough to count the timers...
+    }
+    return id->second;
+  }
   int watchNameIndex = 0; /**< Every frame a few watch names are transmitted. This is the index of the watchname that is to be transmitted next */
 };
 
@@ -52,8 +69,7 @@ void TimingManager::startTiming(const char* identifier)
   if(timing == prvt->timing.end())
   {
     //create new entry
-    prvt->watchNames.push_back(identifier);
-    prvt->idTable[identifier] = static_cast<unsigned short>(prvt->idTable.size()); //NOTE: this assumes that an unsigned short will always be big big enough to count the timers...
+    prvt->getId(identifier);
     timing = prvt->timing.insert(std::pair<const char*, unsigned long long>(identifier, 0)).first;
   }
   prvt->dataPrepared = false;
@@ -69,6 +85,29 @@ unsigned TimingManager::stopTiming(const char* identifier)
   return diff;
 }
 
+void TimingManager::countCall(const char* identifier, bool hit)
+{
+  auto calls = prvt->calls.find(identifier);
+  if(calls == prvt->calls.end())
+  {
+    // Readers of the timing data expect a stopwatch for each id.
+    if(prvt->timing.find(identifier) == prvt->timing.end())
+    {
+      prvt->getId(identifier);
+      prvt->timing.emplace(identifier, 0);
+    }
+    calls = prvt->calls.emplace(identifier, std::pair<unsigned, unsigned>(0, 0)).first;
+  }
+  prvt->dataPrepared = false;
+  calls->second.first += hit ? 1 : 0;
+  ++calls->second.second;
+}
+
+unsigned TimingManager::getFrameNumber() const
+{
+  return prvt->frameNo;
+}
+
 void TimingManager::signalThreadStart()
 {
   prvt->currentThreadStartTime = Time::getCurrentSystemTime();
@@ -77,6 +116,8 @@ void TimingManager::signalThreadStart()
   prvt->dataPrepared = false;
   for(std::pair<const char* const, unsigned long long>& it : prvt->timing)
     it.second = 0;
+  for(auto& [_, calls] : prvt->calls)
+    calls = std::pair<unsigned, unsigned>(0, 0);
 }
 
 MessageQueue& TimingManager::getData()
@@ -104,6 +145,12 @@ void TimingManager::prepareData()
    *
    * unsigned : timestamp at which the last iteration started.
    * unsigned : frame number of the current frame
+   *
+   * unsigned short : Total number of memoized functions (missing in older logs)
+   * for each memoized function:
+   *  short : id of the function (shared with the stopwatches)
+   *  unsigned : number of calls answered from the cache
+   *  unsigned : number of calls
    */
   MessageQueue::OutBinary out = prvt->data.bin(idStopwatch);
 
@@ -124,6 +171,10 @@ void TimingManager::prepareData()
   }
   out << prvt->currentThreadStartTime;
   out << prvt->frameNo;
+
+  out << static_cast<unsigned short>(prvt->calls.size());
+  for(const auto& [name, calls] : prvt->calls)
+    out << prvt->idTable[name] << calls.first << calls.second;
   if(out.failed())
     OUTPUT_WARNING("TimingManager: queue is full!!!");
 }
@@ -27,6 +27,17 @@ public:
   /** Stops the stopwatch for the specified identifier and returns the time in us. */
   unsigned stopTiming(const char* identifier);
 
+  /**
+   * Counts a call of a memoized function. The hit rate is shown next to the
+   * stopwatch with the same identifier.
+   * @param identifier The name of the function.
+   * @param hit Was the result taken from the cache?
+   */
+  void countCall(const char* identifier, bool hit);
+
+  /** Returns the number of the current frame, i.e. how often signalThreadStart was called. */
+  unsigned getFrameNumber() const;
+
   /**
    * The TimingManager has a special stopwatch that is used to keep track
    * of the overall thread time.
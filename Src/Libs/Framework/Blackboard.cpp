@@ -72,6 +72,7 @@ void Blackboard::reset(const char* representation)
 {
   Entry& entry = get(representation);
   entry.reset(&*entry.data);
+  ++version; // Providers that only bind functions must bind them again.
 }
 
 Blackboard& Blackboard::getInstance()
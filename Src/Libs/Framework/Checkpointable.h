@@ -0,0 +1,39 @@
+/**
+ * @file Checkpointable.h
+ *
+ * This file declares an interface that modules can implement if they keep an
+ * internal state between frames that should be restorable. During log replay,
+ * the states of all such modules of a thread are saved at regular intervals,
+ * so that seeking to a frame of the log can continue from the nearest saved
+ * state instead of replaying the log from its beginning.
+ * A module opts in by additionally deriving from this class, e.g.
+ *
+ * class MyModule : public MyModuleBase, public Checkpointable
+ *
+ * The state is written and read with the streaming operators, i.e. a module
+ * can either stream its members one by one or group them in a STREAMABLE.
+ */
+
+#pragma once
+
+class In;
+class Out;
+
+class Checkpointable
+{
+public:
+  virtual ~Checkpointable() = default;
+
+  /**
+   * Writes the internal state of the module.
+   * @param stream The stream the state is written to.
+   */
+  virtual void writeCheckpoint(Out& stream) const = 0;
+
+  /**
+   * Restores the internal state of the module.
+   * @param stream The stream the state is read from. It contains what
+   *               \c writeCheckpoint wrote.
+   */
+  virtual void readCheckpoint(In& stream) = 0;
+};
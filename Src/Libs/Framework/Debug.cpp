@@ -251,10 +251,10 @@ void Debug::removeRepetitions()
       case idDebugRequest:
       case idDebugResponse:
       case idPlot:
+      case idPlotValues:
       case idConsole:
       case idAudioData:
       case idAnnotation:
-      case idLogResponse:
       case idThread:
         return true;
 
@@ -273,6 +273,7 @@ void Debug::removeRepetitions()
       case idStopwatch:
       case idDebugImage:
       case idDebugDrawing:
+      case idDebugDrawingShapes:
       case idDebugDrawing3D:
         return messagesPerType[idFrameFinished] == 1;
     }
@@ -354,12 +355,6 @@ bool Debug::handleMessage(const MessageQueue::Message message)
       auto sender = senderMap.find(currentThread);
       if(sender != senderMap.end())
         *sender->second << message;
-      else if(message.id() == idFrameFinished)
-      {
-        debugSender->bin(idFrameBegin) << currentThread;
-        debugSender->bin(idLogResponse) << '\0';
-        debugSender->bin(idFrameFinished) << currentThread;
-      }
       currentThreadName = "";
       return true;
     }
@@ -0,0 +1,124 @@
+/**
+ * @file FrameArena.cpp
+ *
+ * This file implements a per-thread bump allocator for temporary data that
+ * only lives during a single frame.
+ */
+
+#include "FrameArena.h"
+#include "Platform/BHAssert.h"
+#include "Platform/Memory.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+thread_local FrameArena FrameArena::instance;
+
+FrameArena::~FrameArena()
+{
+  for(const Chunk& chunk : chunks)
+    Memory::alignedFree(chunk.begin);
+}
+
+void* FrameArena::allocate(std::size_t size, std::size_t alignment)
+{
+  FrameArena& arena = instance;
+  if(arena.chunks.empty())
+    arena.nextChunk(size, alignment);
+
+  char* ptr = reinterpret_cast<char*>((reinterpret_cast<std::uintptr_t>(arena.next) + alignment - 1) & ~(alignment - 1));
+  if(ptr + size > arena.chunks[arena.currentChunk].end)
+  {
+    arena.nextChunk(size, alignment);
+    ptr = reinterpret_cast<char*>((reinterpret_cast<std::uintptr_t>(arena.next) + alignment - 1) & ~(alignment - 1));
+  }
+
+  arena.usedBytes += ptr + size - arena.next;
+  arena.peakBytes = std::max(arena.peakBytes, arena.usedBytes);
+  arena.next = ptr + size;
+  ++arena.liveAllocations;
+  return ptr;
+}
+
+void FrameArena::deallocate(void* ptr, std::size_t size)
+{
+  FrameArena& arena = instance;
+  ASSERT(owns(ptr)); // Memory was passed to another thread or outlived a reset.
+  ASSERT(arena.liveAllocations > 0);
+
+  if(--arena.liveAllocations == 0)
+    arena.rewind();
+  else if(static_cast<char*>(ptr) + size == arena.next)
+  {
+    // Undo the last allocation, which is what a growing vector typically frees.
+    arena.usedBytes -= size;
+    arena.next = static_cast<char*>(ptr);
+  }
+}
+
+std::size_t FrameArena::reset()
+{
+  FrameArena& arena = instance;
+  if(arena.liveAllocations > 0)
+    return arena.liveAllocations;
+
+  if(arena.chunks.size() > 1)
+  {
+    std::size_t totalSize = 0;
+    for(const Chunk& chunk : arena.chunks)
+    {
+      totalSize += chunk.end - chunk.begin;
+      Memory::alignedFree(chunk.begin);
+    }
+    char* begin = static_cast<char*>(Memory::alignedMalloc(totalSize, 64));
+    ASSERT(begin);
+    arena.chunks.clear();
+    arena.chunks.push_back({begin, begin + totalSize});
+  }
+  arena.rewind();
+  return 0;
+}
+
+bool FrameArena::owns(const void* ptr)
+{
+  for(const Chunk& chunk : instance.chunks)
+    if(ptr >= chunk.begin && ptr < chunk.end)
+      return true;
+  return false;
+}
+
+void FrameArena::rewind()
+{
+#ifndef NDEBUG
+  // Overwrite released memory so that data used after the end of its frame is easy to recognize.
+  for(std::size_t i = 0; i <= currentChunk && i < chunks.size(); ++i)
+    std::memset(chunks[i].begin, 0xcd, (i == currentChunk ? next : chunks[i].end) - chunks[i].begin);
+#endif
+  currentChunk = 0;
+  next = chunks.empty() ? nullptr : chunks.front().begin;
+  usedBytes = 0;
+}
+
+void FrameArena::nextChunk(std::size_t size, std::size_t alignment)
+{
+  if(!chunks.empty())
+  {
+    // Everything that remains in the current chunk is lost for this frame.
+    usedBytes += chunks[currentChunk].end - next;
+
+    while(++currentChunk < chunks.size())
+      if(static_cast<std::size_t>(chunks[currentChunk].end - chunks[currentChunk].begin) >= size + alignment)
+      {
+        next = chunks[currentChunk].begin;
+        return;
+      }
+  }
+
+  const std::size_t chunkSize = std::max({minChunkSize, size + alignment,
+                                          chunks.empty() ? std::size_t(0) : 2 * static_cast<std::size_t>(chunks.back().end - chunks.back().begin)});
+  char* begin = static_cast<char*>(Memory::alignedMalloc(chunkSize, 64));
+  ASSERT(begin);
+  chunks.push_back({begin, begin + chunkSize});
+  currentChunk = chunks.size() - 1;
+  next = begin;
+}
@@ -0,0 +1,125 @@
+/**
+ * @file FrameArena.h
+ *
+ * This file declares a per-thread bump allocator for temporary data that
+ * only lives during a single frame, and container aliases that use it.
+ * Memory is handed out by advancing a pointer and it is released all at
+ * once, either when the last allocation of the frame is freed or when the
+ * thread finishes its frame (see ThreadFrame::threadMain).
+ * Memory allocated from the arena must neither outlive the frame nor be
+ * passed to another thread. Therefore, containers of this type must not be
+ * members of modules or representations.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+class FrameArena
+{
+private:
+  static constexpr std::size_t minChunkSize = 256 * 1024; /**< The size of the first chunk allocated. */
+
+  /** A contiguous block of memory from which allocations are served. */
+  struct Chunk
+  {
+    char* begin; /**< The start of the chunk. */
+    char* end; /**< The end of the chunk (exclusive). */
+  };
+
+  static thread_local FrameArena instance; /**< The arena of the current thread. */
+
+  std::vector<Chunk> chunks; /**< All chunks allocated. Only the first one remains after a reset. */
+  std::size_t currentChunk = 0; /**< The index of the chunk allocations are currently served from. */
+  char* next = nullptr; /**< The next free byte in the current chunk. */
+  std::size_t liveAllocations = 0; /**< The number of allocations that were not freed yet. */
+  std::size_t usedBytes = 0; /**< The number of bytes allocated in the current frame (including padding). */
+  std::size_t peakBytes = 0; /**< The highest value of usedBytes ever observed. */
+
+  ~FrameArena();
+
+  /** Rewinds to the beginning of the first chunk. */
+  void rewind();
+
+  /**
+   * Continues allocating from the next chunk that is large enough.
+   * A new chunk is created if there is none.
+   * @param size The number of bytes that must at least fit into the chunk.
+   * @param alignment The alignment requested for the allocation.
+   */
+  void nextChunk(std::size_t size, std::size_t alignment);
+
+public:
+  /**
+   * Allocates memory from the arena of the current thread.
+   * @param size The number of bytes to allocate.
+   * @param alignment The alignment of the memory returned. Must be a power of two.
+   * @return The memory allocated.
+   */
+  static void* allocate(std::size_t size, std::size_t alignment);
+
+  /**
+   * Returns memory to the arena of the current thread. The memory is only
+   * reused if it was the last one allocated or if all allocations were freed.
+   * @param ptr The memory to free.
+   * @param size The number of bytes that were allocated.
+   */
+  static void deallocate(void* ptr, std::size_t size);
+
+  /**
+   * Marks the end of a frame. If multiple chunks were needed in this frame,
+   * they are replaced by a single one large enough for all of them, so that
+   * the next frames are served from a single block of memory.
+   * @return The number of allocations that escaped this frame, i.e. that
+   *         still exist. They keep the arena from being reused until they
+   *         are freed.
+   */
+  static std::size_t reset();
+
+  /**
+   * Checks whether a pointer points to memory managed by the arena of the
+   * current thread.
+   * @param ptr The pointer to check.
+   * @return Does the memory belong to the arena?
+   */
+  static bool owns(const void* ptr);
+
+  /**
+   * Returns the highest number of bytes ever used within a single frame in
+   * the current thread.
+   * @return The peak number of bytes.
+   */
+  static std::size_t getPeakBytes() { return instance.peakBytes; }
+};
+
+/**
+ * A stateless allocator for standard containers that allocates from the
+ * FrameArena of the current thread.
+ * @tparam T The type of the elements allocated.
+ */
+template<typename T>
+class FrameAllocator
+{
+public:
+  using value_type = T;
+
+  FrameAllocator() = default;
+
+  template<typename U>
+  FrameAllocator(const FrameAllocator<U>&) {}
+
+  T* allocate(std::size_t n) { return static_cast<T*>(FrameArena::allocate(n * sizeof(T), alignof(T))); }
+
+  void deallocate(T* ptr, std::size_t n) { FrameArena::deallocate(ptr, n * sizeof(T)); }
+
+  template<typename U>
+  bool operator==(const FrameAllocator<U>&) const { return true; }
+
+  template<typename U>
+  bool operator!=(const FrameAllocator<U>&) const { return false; }
+};
+
+/** A vector that lives in the FrameArena of the current thread. */
+template<typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
@@ -10,6 +10,8 @@
 #pragma once
 
 #include "Streaming/TypeRegistry.h"
+#include <string>
+#include <vector>
 
 struct Configuration;
 class LoggingController;
@@ -40,6 +42,14 @@ public:
                                                [[maybe_unused]] const std::size_t index)
   {return nullptr;}
 
+  /**
+   * The function returns the threads whose results the frames of this thread
+   * depend on. During log replay, a frame is only processed after the frames
+   * of these threads that were replayed before it were processed.
+   * @return The names of the threads.
+   */
+  virtual std::vector<std::string> getReplayInputs() const {return {};}
+
   /**
    * The function is executed in every frame.
    * @return Must the modules of this frame be executed? They still can be
@@ -110,7 +120,7 @@ protected:
    * The function returns the name of the execution unit.
    * @return The name of the execution unit.
    */
-  const std::string getName() const override { return TypeRegistry::demangle(typeid(T).name()); }
+  const std::string getName() const override { return TypeRegistry::getName<T>(); }
 
   /**
    * The function creates a execution unit.
@@ -0,0 +1,109 @@
+/**
+ * @file Framework/LogReplayBarrier.cpp
+ *
+ * This file implements a class that synchronizes the replay of a log file
+ * between the console feeding the log frames and the threads of a robot
+ * processing them.
+ */
+
+#include "LogReplayBarrier.h"
+#include "Framework/ThreadFrame.h"
+#include <algorithm>
+
+thread_local LogReplayBarrier* LogReplayBarrier::theInstance = nullptr;
+thread_local LogReplayBarrier::Consumer* LogReplayBarrier::theConsumer = nullptr;
+
+void LogReplayBarrier::add(const std::string& name, ThreadFrame* thread, const std::vector<std::string>& inputs)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  Consumer& consumer = consumers[name];
+  consumer.name = name;
+  consumer.thread = thread;
+  consumer.inputs = inputs;
+}
+
+bool LogReplayBarrier::mayFeed(const std::string& name) const
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto consumer = consumers.find(name);
+  if(consumer == consumers.end())
+    return true;
+  if(consumer->second.accepted != consumer->second.fed)
+    return false;
+  for(const auto& [output, frames] : consumer->second.consumedBy)
+    if(consumers.at(output).accepted < frames)
+      return false;
+  return true;
+}
+
+void LogReplayBarrier::feed(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto consumer = consumers.find(name);
+  if(consumer == consumers.end())
+    return;
+  ++consumer->second.fed;
+
+  // The frame depends on all frames of its inputs fed since the previous frame of this thread.
+  for(const std::string& inputName : consumer->second.inputs)
+  {
+    const auto input = consumers.find(inputName);
+    if(input != consumers.end())
+    {
+      unsigned& required = consumer->second.required[inputName];
+      if(input->second.fed > required)
+      {
+        required = input->second.fed;
+        input->second.consumedBy[name] = consumer->second.fed;
+      }
+    }
+  }
+}
+
+void LogReplayBarrier::setInstance(LogReplayBarrier* instance, const std::string& name)
+{
+  theInstance = instance;
+  if(instance)
+  {
+    std::lock_guard<std::mutex> lock(instance->mutex);
+    const auto consumer = instance->consumers.find(name);
+    theConsumer = consumer == instance->consumers.end() ? nullptr : &consumer->second;
+  }
+  else
+    theConsumer = nullptr;
+}
+
+bool LogReplayBarrier::inputsPresent()
+{
+  if(!theConsumer)
+    return true;
+  std::lock_guard<std::mutex> lock(theInstance->mutex);
+  for(const auto& [input, frames] : theConsumer->required)
+    if(theInstance->consumers.at(input).finished < frames)
+      return false;
+  return true;
+}
+
+void LogReplayBarrier::accept()
+{
+  if(theConsumer)
+  {
+    std::lock_guard<std::mutex> lock(theInstance->mutex);
+    theConsumer->accepted = theConsumer->fed;
+  }
+}
+
+void LogReplayBarrier::finish()
+{
+  if(theConsumer)
+  {
+    std::lock_guard<std::mutex> lock(theInstance->mutex);
+    if(theConsumer->finished != theConsumer->accepted)
+    {
+      theConsumer->finished = theConsumer->accepted;
+      for(const auto& consumer : theInstance->consumers)
+        if(std::find(consumer.second.inputs.begin(), consumer.second.inputs.end(), theConsumer->name) != consumer.second.inputs.end())
+          consumer.second.thread->trigger();
+    }
+  }
+}
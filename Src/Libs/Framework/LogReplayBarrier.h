@@ -0,0 +1,99 @@
+/**
+ * @file Framework/LogReplayBarrier.h
+ *
+ * This file declares a class that synchronizes the replay of a log file
+ * between the console feeding the log frames and the threads of a robot
+ * processing them. For each thread, it counts the frames that were fed to
+ * it, that it accepted, and that it finished, i.e. whose results were sent
+ * to the other threads. A thread can declare that its frames depend on the
+ * results of other threads (its inputs). A frame fed to it can only be
+ * accepted after the frames of its inputs fed before were finished. The
+ * next frame of an input can only be fed after all threads depending on
+ * its previous frame accepted theirs, because the results sent between
+ * threads only keep the latest packet.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class ThreadFrame;
+
+class LogReplayBarrier
+{
+private:
+  /** The replay state of a thread. */
+  struct Consumer
+  {
+    std::string name; /**< The name of the thread. */
+    ThreadFrame* thread; /**< The thread, which is triggered when its inputs become present. */
+    std::vector<std::string> inputs; /**< The threads whose results the frames of this thread depend on. */
+    unsigned fed = 0; /**< The number of frames fed to the thread. */
+    unsigned accepted = 0; /**< The number of frames the thread accepted. */
+    unsigned finished = 0; /**< The number of frames the thread finished. */
+    std::unordered_map<std::string, unsigned> required; /**< The number of frames of each input that must be finished before the latest frame can be accepted. */
+    std::unordered_map<std::string, unsigned> consumedBy; /**< The number of frames of each output that must be accepted before the next frame can be fed. */
+  };
+
+  mutable std::mutex mutex; /**< Synchronizes the console with the threads. */
+  std::unordered_map<std::string, Consumer> consumers; /**< The replay states of all threads by their names. */
+
+  static thread_local LogReplayBarrier* theInstance; /**< The barrier the current thread uses during replay. */
+  static thread_local Consumer* theConsumer; /**< The replay state of the current thread. */
+
+public:
+  /**
+   * Adds a thread. All threads must be added before the replay begins.
+   * @param name The name of the thread.
+   * @param thread The thread.
+   * @param inputs The threads whose results the frames of this thread depend on.
+   */
+  void add(const std::string& name, ThreadFrame* thread, const std::vector<std::string>& inputs);
+
+  /**
+   * Can another frame be fed to a thread? This is the case if the thread
+   * accepted all frames fed to it and all threads depending on the results
+   * of its previous frame accepted the frames using them.
+   * @param name The name of the thread. Unknown threads are always ready.
+   * @return Can the next frame of the thread be fed?
+   */
+  bool mayFeed(const std::string& name) const;
+
+  /**
+   * Notes that a frame was fed to a thread.
+   * @param name The name of the thread.
+   */
+  void feed(const std::string& name);
+
+  /**
+   * Makes the barrier used by the current thread during replay.
+   * @param instance The barrier or nullptr if there is no replay.
+   * @param name The name of the current thread.
+   */
+  static void setInstance(LogReplayBarrier* instance, const std::string& name);
+
+  /**
+   * Is the replay of the current thread synchronized by a barrier?
+   * @return Are the frames of the inputs of the current thread known?
+   */
+  static bool synchronized() {return theConsumer != nullptr;}
+
+  /**
+   * Were the frames of all inputs finished that the latest frame fed to the
+   * current thread depends on?
+   * @return Are the inputs present? Always true if not synchronized.
+   */
+  static bool inputsPresent();
+
+  /** Notes that the current thread accepted the frame fed to it. */
+  static void accept();
+
+  /**
+   * Notes that the current thread finished all frames it accepted.
+   * Threads depending on its results are triggered.
+   */
+  static void finish();
+};
@@ -6,6 +6,9 @@
  * The class maintains a buffer of message queues that can be claimed by
  * individual threads, filled with data, and given back to the logger for
  * writing them to the log file.
+ * Representations can be logged at reduced rates. Frames are then kept in
+ * memory for a while before they are written, so that they can still be
+ * logged at full rate if a burst is triggered by an annotation.
  *
  * @author Thomas Röfer
  */
@@ -19,11 +22,15 @@
 #include "Framework/Settings.h"
 #include "Platform/BHAssert.h"
 #include "Platform/File.h"
+#include "Platform/Memory.h"
 #include "Platform/SystemCall.h"
+#include "Platform/Time.h"
 #include "Streaming/Global.h"
 #include "Streaming/TypeInfo.h"
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
+#include <string_view>
 #ifdef LINUX
 #include <unistd.h>
 #endif
@@ -86,6 +93,12 @@ Logger::Logger(const Configuration& config) :
     threadFound:;
     }
 
+  if(enabled)
+    for(const RatePolicy& policy : ratePolicies)
+      if(std::none_of(representationsPerThread.begin(), representationsPerThread.end(), [&policy](const RepresentationsPerThread& rpt)
+                      {return std::find(rpt.representations.begin(), rpt.representations.end(), policy.representation) != rpt.representations.end();}))
+        PRINT("Logger: Rate policy for representation " << policy.representation << " is not used");
+
 #ifndef TARGET_ROBOT
   enabled = false;
   path = "Logs/";
@@ -97,13 +110,30 @@ Logger::Logger(const Configuration& config) :
     typeInfo << *TypeInfo::current;
     LoggingTools::writeSettings(settings, Global::getSettings());
 
+    // The buffers are slices of a single allocation, which is large enough to be backed by huge pages.
+    VERIFY(bufferMemory = static_cast<char*>(Memory::hugePageMalloc(static_cast<std::size_t>(numOfBuffers) * sizeOfBuffer)));
     buffers.resize(numOfBuffers);
-    for(MessageQueue& buffer : buffers)
+    for(std::size_t i = 0; i < buffers.size(); ++i)
     {
-      buffer.reserve(sizeOfBuffer);
-      buffersAvailable.push(&buffer);
+      buffers[i].setBuffer(bufferMemory + i * sizeOfBuffer, 0, sizeOfBuffer);
+      buffersAvailable.push(&buffers[i]);
     }
 
+    for(const RepresentationsPerThread& rpt : representationsPerThread)
+      if(!rpt.representations.empty())
+      {
+        ThreadState& threadState = threadStates.emplace_back();
+        threadState.representationsPerThread = &rpt;
+        for(const std::string& representation : rpt.representations)
+        {
+          RepresentationState& representationState = threadState.representations.emplace_back();
+          representationState.id = static_cast<MessageID>(TypeRegistry::getEnumValue(typeid(MessageID).name(), "id" + representation));
+          for(const RatePolicy& policy : ratePolicies)
+            if(policy.representation == representation)
+              representationState.policy = &policy;
+        }
+      }
+
     writerThread.setPriority(writePriority);
     writerThread.start(this, &Logger::writer);
   }
@@ -135,8 +165,10 @@ void Logger::update(const LoggingController& controller)
     }
     else
     {
-      // Tell the writer thread that this logging period has ended.
+      // Write all frames still kept back and tell the writer thread that this logging period has ended.
       SYNC;
+      for(std::size_t i = pendingFrames.flush(buffersToWrite); i > 0; --i)
+        framesToWrite.post();
       buffersToWrite.push_back(nullptr);
     }
     framesToWrite.post();
@@ -153,63 +185,154 @@ bool Logger::execute(const std::string& threadName)
   if(!logging.load(std::memory_order_relaxed))
     return false;
 
+  auto threadState = std::find_if(threadStates.begin(), threadStates.end(), [&threadName](const ThreadState& threadState)
+                                  {return threadState.representationsPerThread->thread == threadName;});
+  if(threadState == threadStates.end())
+    return true;
+  ThreadState& state = *threadState;
+  const RepresentationsPerThread& rpt = *state.representationsPerThread;
+
+  const unsigned now = Time::getCurrentSystemTime();
+  const bool triggered = !burstTriggers.empty() && triggersBurst(Global::getAnnotationManager().getOut());
+  const bool keepBack = preTriggerDuration > 0 && !burstTriggers.empty();
+  bool fullRate;
+  unsigned triggersAtStart;
   bool bufferAvailabilityChanged = false;
-  for(const RepresentationsPerThread& rpt : representationsPerThread)
-    if(rpt.thread == threadName && !rpt.representations.empty())
+  MessageQueue* buffer = nullptr;
+  {
+    SYNC;
+    if(triggered)
     {
-      MessageQueue* buffer = nullptr;
-      {
-        SYNC;
-        if(!buffersAvailable.empty())
-        {
-          buffer = buffersAvailable.top();
-          buffersAvailable.pop();
-        }
-        const bool bufferIsAvailable = buffer != nullptr;
-        bufferAvailabilityChanged = bufferWasAvailable != bufferIsAvailable;
-        bufferWasAvailable = bufferIsAvailable;
-      }
-      if(!buffer)
-      {
-        if(bufferAvailabilityChanged)
-          OUTPUT_WARNING("Logger: No buffer available!");
-        return false;
-      }
-      else if(bufferAvailabilityChanged)
-        OUTPUT_WARNING("Logger: Buffer available again!");
+      ++triggers;
+      burstEnd = now + postTriggerDuration;
+    }
+    triggersAtStart = triggers;
+    fullRate = triggers && static_cast<int>(burstEnd - now) > 0;
 
-      STOPWATCH("Logger")
-      {
-        buffer->bin(idFrameBegin) << threadName;
+    if(!buffersAvailable.empty())
+    {
+      buffer = buffersAvailable.top();
+      buffersAvailable.pop();
+    }
+    const bool bufferIsAvailable = buffer != nullptr;
+    bufferAvailabilityChanged = bufferWasAvailable != bufferIsAvailable;
+    bufferWasAvailable = bufferIsAvailable;
+  }
+  if(!buffer)
+  {
+    if(bufferAvailabilityChanged)
+      OUTPUT_WARNING("Logger: No buffer available!");
+    return false;
+  }
+  else if(bufferAvailabilityChanged)
+    OUTPUT_WARNING("Logger: Buffer available again!");
 
-        for(const std::string& representation : rpt.representations)
+  PendingLogFrames::Frame frame = {buffer, now, triggersAtStart, {}};
+  STOPWATCH("Logger")
+  {
+    buffer->bin(idFrameBegin) << threadName;
+
+    for(std::size_t i = 0; i < rpt.representations.size(); ++i)
+    {
+      const std::string& representation = rpt.representations[i];
 #ifndef NDEBUG
-          if(Blackboard::getInstance().exists(representation.c_str()))
+      if(Blackboard::getInstance().exists(representation.c_str()))
 #endif
-          {
-            MessageQueue::OutBinary stream = buffer->bin(static_cast<MessageID>(TypeRegistry::getEnumValue(typeid(MessageID).name(), "id" + representation)));
-            stream << Blackboard::getInstance()[representation.c_str()];
-            if(stream.failed())
-              OUTPUT_WARNING("Logger: Representation " << representation << " did not fit into buffer!");
-          }
-#ifndef NDEBUG
+      {
+        RepresentationState& representationState = state.representations[i];
+        const std::size_t start = buffer->size();
+        MessageQueue::OutBinary stream = buffer->bin(representationState.id);
+        stream << Blackboard::getInstance()[representation.c_str()];
+        if(stream.failed())
+          OUTPUT_WARNING("Logger: Representation " << representation << " did not fit into buffer!");
+        else if(representationState.policy && !fullRate && buffer->size() > start
+                && !isDue(representationState, *(buffer->begin() + start), state.frame, now))
+        {
+          // Full-rate frames are kept back, so the representation is only removed when the frame is written.
+          if(keepBack)
+            frame.skipped.push_back(representationState.id);
           else
-            OUTPUT_WARNING("Logger: Representation " << representation << " does not exist!");
+            buffer->resize(start);
+        }
+      }
+#ifndef NDEBUG
+      else
+        OUTPUT_WARNING("Logger: Representation " << representation << " does not exist!");
 #endif
+    }
 
-        *buffer << Global::getAnnotationManager().getOut();
-      }
-      *buffer << Global::getTimingManager().getData();
-      buffer->bin(idFrameFinished) << threadName;
-      {
-        SYNC;
-        buffersToWrite.push_back(buffer);
-        bufferWasAvailable = true;
-      }
-      framesToWrite.post();
-      break;
+    *buffer << Global::getAnnotationManager().getOut();
+  }
+  *buffer << Global::getTimingManager().getData();
+  buffer->bin(idFrameFinished) << threadName;
+  ++state.frame;
+
+  if(!keepBack)
+  {
+    {
+      SYNC;
+      buffersToWrite.push_back(buffer);
+      bufferWasAvailable = true;
     }
+    framesToWrite.post();
+    return true;
+  }
+
+  // Keep the frame back. The frames of all threads are written in the order
+  // in which they were recorded.
+  std::size_t numOfFramesDue;
+  {
+    SYNC;
+    numOfFramesDue = pendingFrames.add(std::move(frame), triggers, now, preTriggerDuration, buffersToWrite);
+    if(numOfFramesDue)
+      bufferWasAvailable = true;
+  }
+  for(std::size_t i = 0; i < numOfFramesDue; ++i)
+    framesToWrite.post();
+  return true;
+}
+
+bool Logger::triggersBurst(const MessageQueue& annotations) const
+{
+  for(MessageQueue::const_iterator i = annotations.begin(); i != annotations.end(); ++i)
+  {
+    const MessageQueue::Message message = *i;
+    if(message.id() != idAnnotation)
+      continue;
+
+    // Skip the annotation number, which might be preceded by a frame number.
+    InBinaryMemory stream = message.bin();
+    unsigned number;
+    stream >> number;
+    if(!(number & 0x80000000))
+      stream >> number;
+    InTextMemory text(message.data() + stream.getPosition(), message.size() - stream.getPosition());
+    std::string name;
+    text >> name;
+    if(std::find(burstTriggers.begin(), burstTriggers.end(), name) != burstTriggers.end())
+      return true;
+  }
+  return false;
+}
+
+bool Logger::isDue(RepresentationState& state, const MessageQueue::Message& message, unsigned frame, unsigned now)
+{
+  const RatePolicy& policy = *state.policy;
+  if(state.logged && (frame - state.lastFrame < policy.everyNthFrame
+                      || static_cast<unsigned>(now - state.lastTime) < policy.minInterval))
+    return false;
+
+  if(policy.onChange)
+  {
+    const std::size_t hash = std::hash<std::string_view>()(std::string_view(message.data(), message.size()));
+    if(state.logged && hash == state.hash)
+      return false;
+    state.hash = hash;
+  }
 
+  state.logged = true;
+  state.lastFrame = frame;
+  state.lastTime = now;
   return true;
 }
 
@@ -218,6 +341,8 @@ Logger::~Logger()
   writerThread.announceStop();
   framesToWrite.post();
   writerThread.stop();
+  buffers.clear();
+  Memory::hugePageFree(bufferMemory, static_cast<std::size_t>(numOfBuffers) * sizeOfBuffer);
 }
 
 void Logger::writer()
@@ -6,6 +6,9 @@
  * The class maintains a buffer of message queues that can be claimed by
  * individual threads, filled with data, and given back to the logger for
  * writing them to the log file.
+ * Representations can be logged at reduced rates. Frames are then kept in
+ * memory for a while before they are written, so that they can still be
+ * logged at full rate if a burst is triggered by an annotation.
  *
  * @author Thomas Röfer
  */
@@ -13,6 +16,7 @@
 #pragma once
 
 #include "Framework/Configuration.h"
+#include "Framework/PendingLogFrames.h"
 #include "Platform/Semaphore.h"
 #include "Platform/Thread.h"
 #include "Streaming/MessageQueue.h"
@@ -53,10 +57,43 @@ STREAMABLE(Logger,
     (std::vector<std::string>) representations,
   });
 
+  /**
+   * At which rate will a representation be logged? It is logged if all
+   * conditions are met. Otherwise, it is left out of the frame unless the
+   * frame is part of a burst.
+   */
+  STREAMABLE(RatePolicy,
+  {,
+    (std::string) representation, /**< The representation this policy applies to in all threads. */
+    (unsigned)(1) everyNthFrame, /**< At least this many frames of the thread lie between two logged ones. */
+    (unsigned)(0) minInterval, /**< At least this many ms lie between two logged ones. */
+    (bool)(false) onChange, /**< Only log if the streamed data differ from the data logged last. */
+  });
+
 private:
+  /** The logging state of a representation in a thread. */
+  struct RepresentationState
+  {
+    MessageID id; /**< The message id the representation is logged with. */
+    const RatePolicy* policy = nullptr; /**< The rate policy of the representation or nullptr if it is logged in every frame. */
+    bool logged = false; /**< Was the representation logged before? */
+    unsigned lastFrame = 0; /**< The frame of the thread in which the representation was logged last. */
+    unsigned lastTime = 0; /**< The time when the representation was logged last. */
+    std::size_t hash = 0; /**< The hash of the data logged last. */
+  };
+
+  /** The logging state of a thread. */
+  struct ThreadState
+  {
+    const RepresentationsPerThread* representationsPerThread; /**< The configuration of the thread. */
+    std::vector<RepresentationState> representations; /**< The states of all representations logged in this thread. */
+    unsigned frame = 0; /**< The number of frames logged in this thread. */
+  };
+
   DECLARE_SYNC;
   OutBinaryMemory typeInfo; /**< Streamed type information created in main thread and used in logger thread. */
   OutBinaryMemory settings; /**< Streamed settings created in main thread and used in logger thread. */
+  char* bufferMemory = nullptr; /**< The memory of all buffers, which is backed by huge pages if possible. */
   std::vector<MessageQueue> buffers; /**< All buffers to write log data to. */
   std::stack<MessageQueue*> buffersAvailable; /**< The buffers currently available to fill with log data. */
   std::deque<MessageQueue*> buffersToWrite; /**< The buffers already filled that need to be written. */
@@ -64,10 +101,32 @@ private:
   std::atomic<bool> logging = false; /**< Are we currently logging? */
   Thread writerThread; /**< The thread that is writing the logged data to a file. */
   Semaphore framesToWrite; /**< How many frames the writer thread should write? */
+  std::vector<ThreadState> threadStates; /**< The logging states of all threads that log representations. */
+  PendingLogFrames pendingFrames; /**< The frames of all threads not written yet. Guarded by SYNC. */
+  unsigned triggers = 0; /**< The number of bursts triggered so far. Guarded by SYNC. */
+  unsigned burstEnd = 0; /**< Until when are frames logged at full rate? Guarded by SYNC. */
 
   /** The method runs in a separate thread and writes the logged data to a file. */
   void writer();
 
+  /**
+   * Does an annotation that triggers a burst exist?
+   * @param annotations The annotations of the current frame.
+   * @return Was one of the annotations found in \c burstTriggers ?
+   */
+  bool triggersBurst(const MessageQueue& annotations) const;
+
+  /**
+   * Determines whether a representation is logged in the current frame
+   * according to its rate policy. If it is, its state is updated.
+   * @param state The logging state of the representation.
+   * @param message The streamed representation.
+   * @param frame The current frame of the thread.
+   * @param now The current system time.
+   * @return Should the representation be logged?
+   */
+  static bool isDue(RepresentationState& state, const MessageQueue::Message& message, unsigned frame, unsigned now);
+
 public:
   /**
    * The constructor reads the configuration file and checks it against the module configuration.
@@ -102,4 +161,8 @@ private:,
   (unsigned) minFreeDriveSpace, /**< Logging will stop if less MB are available to the target device. */
   (std::vector<std::string>) loggablePerThread, /**< List of representations that can be logged in a thread that does not provide them. */
   (std::vector<RepresentationsPerThread>) representationsPerThread, /**< Representations to log per thread. */
+  (std::vector<RatePolicy>) ratePolicies, /**< Representations that are logged at reduced rates. */
+  (std::vector<std::string>) burstTriggers, /**< Names of annotations that cause logging at full rate. */
+  (unsigned) preTriggerDuration, /**< How long are frames kept back before they are written at reduced rate (in ms)? */
+  (unsigned) postTriggerDuration, /**< How long is logged at full rate after a burst was triggered (in ms)? */
 });
@@ -0,0 +1,85 @@
+/**
+ * @file MemoizedFunction.h
+ *
+ * This file declares a wrapper for pure functions that are provided through
+ * FUNCTION members of representations. Their results are cached, keyed by the
+ * arguments, so that calling such a function repeatedly with the same
+ * arguments within a frame computes the result only once. The cache is
+ * cleared when the thread starts its next frame. The time spent computing
+ * results and the hit rate of the cache are shown in the timing view under
+ * the name passed to the constructor.
+ * A wrapper is meant to be a member of the module providing the function.
+ * The FUNCTION member is bound to it by reference, e.g.
+ *
+ * fieldRating.potentialFieldOnly = std::ref(potentialFieldOnly);
+ *
+ * The arguments must be trivially copyable and must not contain padding,
+ * because the cache is keyed by their bytes.
+ */
+
+#pragma once
+
+#include "Debugging/TimingManager.h"
+#include "Streaming/Global.h"
+#include <array>
+#include <cstring>
+#include <functional>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+template<typename S> class MemoizedFunction;
+
+template<typename R, typename... A> class MemoizedFunction<R(A...)>
+{
+  static_assert(!std::is_void_v<R>, "Only functions that return a result can be memoized.");
+  static_assert((std::is_trivially_copyable_v<std::decay_t<A>> && ...), "Arguments must be trivially copyable.");
+
+  using Key = std::array<char, (sizeof(std::decay_t<A>) + ... + 0)>; /**< The bytes of all arguments. */
+
+  /** Hashes the bytes of the arguments. */
+  struct Hash
+  {
+    std::size_t operator()(const Key& key) const
+    {
+      return std::hash<std::string_view>()(std::string_view(key.data(), key.size()));
+    }
+  };
+
+  const char* name; /**< The name used in the timing view. Must be a string literal. */
+  std::function<R(A...)> function; /**< The function the results of which are cached. */
+  std::unordered_map<Key, R, Hash> results; /**< The results computed in the current frame. */
+  unsigned frame = 0; /**< The frame the results were computed in. */
+
+public:
+  /**
+   * Constructor.
+   * @param name The name used in the timing view. Must be a string literal.
+   * @param function The function the results of which are cached.
+   */
+  MemoizedFunction(const char* name, const std::function<R(A...)>& function) : name(name), function(function) {}
+
+  R operator()(A... args)
+  {
+    TimingManager& timingManager = Global::getTimingManager();
+    if(frame != timingManager.getFrameNumber())
+    {
+      results.clear();
+      frame = timingManager.getFrameNumber();
+    }
+
+    Key key;
+    [[maybe_unused]] char* p = key.data();
+    ((std::memcpy(p, &args, sizeof(std::decay_t<A>)), p += sizeof(std::decay_t<A>)), ...);
+
+    auto result = results.find(key);
+    timingManager.countCall(name, result != results.end());
+    if(result == results.end())
+    {
+      timingManager.startTiming(name);
+      result = results.emplace(key, function(std::forward<A>(args)...)).first;
+      timingManager.stopTiming(name);
+    }
+    return result->second;
+  }
+};
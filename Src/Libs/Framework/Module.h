@@ -12,6 +12,8 @@
  *   USES(RobotPose),                         // Is used, but has not to be updated before
  *   PROVIDES(BallPercept),                   // Class provides a method to update BallPercept.
  *   PROVIDES_WITHOUT_MODIFY(PlayersPercept), // Class provides a method to update PlayersPercept. Representation cannot be MODIFYed.
+ *   PROVIDES_ONCE(LibPosition),              // Class provides a method that only binds the functions of LibPosition. It is only called
+ *                                            // again after the blackboard changed, e.g. because LibPosition was reset.
  *   DEFINES_PARAMETERS(                      // Has parameters that must have an initial value. If LOADS_PARAMETERS is used instead,
  *   {,                                       // they are loaded from a configuration file that has the same name as the module defined, but starts with lowercase letters.
  *     (float)(42.0f) focalLen,               // Has a parameter named focalLen of type float. By default it has the value 42.0f.
@@ -26,6 +28,7 @@
  * {
  *   void update(BallPercept& ballPercept) override;
  *   void update(PlayersPercept& playersPercept) override;
+ *   void update(LibPosition& libPosition) override;
  * };
  *
  * In the implementation file, the existence of the module has to be announced:
@@ -406,6 +409,7 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
 #define _MODULE_PARAMETERS(x) _MODULE_JOIN(_MODULE_PARAMETERS_, x)
 #define _MODULE_PARAMETERS_PROVIDES(type)
 #define _MODULE_PARAMETERS_PROVIDES_WITHOUT_MODIFY(type)
+#define _MODULE_PARAMETERS_PROVIDES_ONCE(type)
 #define _MODULE_PARAMETERS_REQUIRES(type)
 #define _MODULE_PARAMETERS_USES(type)
 #define _MODULE_PARAMETERS__MODULE_DEFINES_PARAMETERS(header, ...) _STREAM_STREAMABLE(Params, Streamable, , , header, __VA_ARGS__); using NoParameters = Params;
@@ -419,6 +423,7 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
 #define _MODULE_LOAD(x) _MODULE_JOIN(_MODULE_LOAD_, x)
 #define _MODULE_LOAD_PROVIDES(type) _MODULE_INIT_ID(type)
 #define _MODULE_LOAD_PROVIDES_WITHOUT_MODIFY(type) _MODULE_INIT_ID(type)
+#define _MODULE_LOAD_PROVIDES_ONCE(type)
 #define _MODULE_LOAD_REQUIRES(type)
 #define _MODULE_LOAD_USES(type)
 #define _MODULE_LOAD__MODULE_DEFINES_PARAMETERS(...)
@@ -450,6 +455,7 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
 #define _MODULE_DECLARE_PROVIDES_WITHOUT_MODIFY(type) _MODULE_PROVIDES(type, \
     _MODULE_VERIFY(r) \
     _MODULE_DRAW(r))
+#define _MODULE_DECLARE_PROVIDES_ONCE(type) _MODULE_PROVIDES_ONCE(type)
 #define _MODULE_DECLARE_REQUIRES(type) public: const type& the##type = Blackboard::getInstance().alloc<type>(#type);
 #define _MODULE_DECLARE_USES(type) public: const type& the##type = Blackboard::getInstance().alloc<type>(#type);
 #define _MODULE_DECLARE__MODULE_DEFINES_PARAMETERS(...)
@@ -463,6 +469,7 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
 #define _MODULE_FREE(x) _MODULE_JOIN(_MODULE_FREE_, x)
 #define _MODULE_FREE_PROVIDES(type) if(_the##type) Blackboard::getInstance().free(#type);
 #define _MODULE_FREE_PROVIDES_WITHOUT_MODIFY(type) if(_the##type) Blackboard::getInstance().free(#type);
+#define _MODULE_FREE_PROVIDES_ONCE(type) if(_the##type) Blackboard::getInstance().free(#type);
 #define _MODULE_FREE_REQUIRES(type) Blackboard::getInstance().free(#type);
 #define _MODULE_FREE_USES(type) Blackboard::getInstance().free(#type);
 #define _MODULE_FREE__MODULE_DEFINES_PARAMETERS(...)
@@ -476,6 +483,7 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
 #define _MODULE_INFO(x) _MODULE_JOIN(_MODULE_INFO_, x)
 #define _MODULE_INFO_PROVIDES(type) infos.emplace_back(#type, &BaseType::update##type);
 #define _MODULE_INFO_PROVIDES_WITHOUT_MODIFY(type) infos.emplace_back(#type, &BaseType::update##type);
+#define _MODULE_INFO_PROVIDES_ONCE(type) infos.emplace_back(#type, &BaseType::update##type);
 #define _MODULE_INFO_REQUIRES(type) infos.emplace_back(#type, nullptr);
 #define _MODULE_INFO_USES(type)
 #define _MODULE_INFO__MODULE_DEFINES_PARAMETERS(...)
@@ -513,6 +521,32 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
       DEBUG_RESPONSE("representation:" #type) OUTPUT(static_cast<BaseType&>(module)._id##type, bin, r); \
   }
 
+/**
+ * The macro defines the code added for each PROVIDES_ONCE.
+ * In contrast to _MODULE_PROVIDES, the update method is only called again
+ * if the version of the blackboard changed since its last call, i.e. if
+ * the representation might have been reset. This is meant for representations
+ * that only consist of functions bound to the module.
+ * @param type The type of the representation provided.
+ */
+#define _MODULE_PROVIDES_ONCE(type) \
+  protected: virtual void update(type&) = 0; \
+  \
+  private: type* _the##type = 0; \
+  int _version##type = -1; \
+  static void update##type(Streamable& module) \
+  { \
+    static_cast<BaseType&>(module).modifyParameters(); \
+    if(!static_cast<BaseType&>(module)._the##type) \
+      static_cast<BaseType&>(module)._the##type = &Blackboard::getInstance().alloc<type>(#type); \
+    if(static_cast<BaseType&>(module)._version##type != Blackboard::getInstance().getVersion()) \
+    { \
+      static_cast<BaseType&>(module)._version##type = Blackboard::getInstance().getVersion(); \
+      BH_TRACE; \
+      static_cast<BaseType&>(module).update(*static_cast<BaseType&>(module)._the##type); \
+    } \
+  }
+
 /**
  * Helper for defining the module's base class.
  * @param name The name of the module.
@@ -543,7 +577,7 @@ void loadModuleParameters(Streamable& parameters, const char* moduleName, const
       { \
         Global::getDebugDataTable().updateObject("module:" #theName, *this, false); \
         DEBUG_RESPONSE_ONCE("debug data:module:" #theName) \
-          OUTPUT(idDebugDataResponse, bin, "module:" #theName << TypeRegistry::demangle(typeid(theName##Module::Parameters).name()) << *this); \
+          OUTPUT(idDebugDataResponse, bin, "module:" #theName << TypeRegistry::getName<theName##Module::Parameters>() << *this); \
       } \
     } \
   public: \
@@ -9,11 +9,13 @@
 #include "ModuleContainer.h"
 #include "Debugging/AnnotationManager.h"
 #include "Debugging/Debugging.h"
+#include "Debugging/Plot.h"
 #include "Debugging/Stopwatch.h"
 #include "Framework/Blackboard.h"
 #include "Framework/Debug.h"
 #include "Framework/FrameExecutionUnit.h"
 #include "Framework/Logger.h"
+#include "Framework/LogReplayBarrier.h"
 #include "Platform/BHAssert.h"
 #include "Platform/SystemCall.h"
 #include "Streaming/Global.h"
@@ -21,12 +23,14 @@
 
 thread_local std::list<std::function<bool(MessageQueue::Message message)>> ModuleContainer::messageHandlers;
 
-ModuleContainer::ModuleContainer(const Settings& settings, const std::string& robotName, const Configuration& config, const std::size_t index, Logger* logger) :
+ModuleContainer::ModuleContainer(const Settings& settings, const std::string& robotName, const Configuration& config, const std::size_t index, Logger* logger,
+                                 LogReplayBarrier* replayBarrier) :
   ThreadFrame(settings, robotName),
   name(config()[index].name),
   priority(config()[index].priority),
   moduleGraphRunner(config().size()),
-  logger(logger)
+  logger(logger),
+  replayBarrier(replayBarrier)
 {
   for(ExecutionUnitCreatorBase* i = ExecutionUnitCreatorBase::first; i; i = i->next)
   {
@@ -39,6 +43,7 @@ ModuleContainer::ModuleContainer(const Settings& settings, const std::string& ro
   ASSERT(executionUnit);
 
   loggingController = executionUnit->initLogging(config, index);
+  replayBarrier->add(name, this, executionUnit->getReplayInputs());
 }
 
 ModuleContainer::~ModuleContainer()
@@ -82,6 +87,9 @@ void ModuleContainer::init()
 {
   BH_TRACE_INIT(getName().c_str());
 
+  if(SystemCall::getMode() == SystemCall::logFileReplay)
+    LogReplayBarrier::setInstance(replayBarrier, getName());
+
   // Prepare first frame
   originalSize = debugSender->size();
   OUTPUT(idFrameBegin, bin, getName());
@@ -130,6 +138,11 @@ bool ModuleContainer::main()
     else if(!keepAnnotations)
       Global::getAnnotationManager().getOut().clear();
 
+    // Send the shapes of all debug drawings of this frame, one message per drawing, and all plotted values.
+    // This happens last, so that drawings made outside of the modules are also sent with this frame.
+    Global::getDrawingManager().flush(Global::getDebugOut());
+    PlotBuffer::flush(Global::getDebugOut());
+
     if(debugSender->size() > sizeAfterFrameBegin)
     {
       // messages were sent in this frame -> send thread finished
@@ -148,8 +161,12 @@ bool ModuleContainer::main()
   }
   else
   {
+    // Drawings and plots made between frames (e.g. while handling messages) are sent now.
+    Global::getDrawingManager().flush(Global::getDebugOut());
+    PlotBuffer::flush(Global::getDebugOut());
+
     // If data was not sent in the previous frame or new data was appended
-    // (idLogResponse or "pollingFinished"), try to send it now.
+    // ("pollingFinished"), try to send it now.
     if(originalSize > 0 || debugSender->size() > sizeAfterFrameBegin)
     {
       debugSender->send();
@@ -167,6 +184,9 @@ bool ModuleContainer::main()
       ++Global::getDebugRequestTable().pollCounter;
   }
 
+  // During log replay, the results of the frames accepted are now available to the other threads.
+  LogReplayBarrier::finish();
+
   if(executionUnit->afterFrame())
   {
     if(Global::getDebugRequestTable().pollCounter == 0
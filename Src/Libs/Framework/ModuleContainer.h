@@ -19,6 +19,7 @@
 
 class Debug;
 class FrameExecutionUnit;
+class LogReplayBarrier;
 struct Logger;
 class LoggingController;
 struct Settings;
@@ -46,6 +47,7 @@ private:
   size_t originalSize = 0; /**< The size of the outgoing message queue at the begin of the frame. */
   size_t sizeAfterFrameBegin; /**< The size of the message queue after the first message was added. */
   Logger* logger; /**< Points to the only logger of this robot. */
+  LogReplayBarrier* replayBarrier; /**< Synchronizes the threads of this robot during log replay. */
   const LoggingController* loggingController = nullptr; /**< The control interface to the logger, owned by this module container if it controls the logger. */
   bool debugRequestWaiting = false; /**< Is a debug request waiting for this thread? */
 
@@ -56,8 +58,11 @@ public:
    * @param robotName The name of the robot this module container belongs to.
    * @param config The initial configuration of all threads.
    * @param index The index of this thread in the config.
+   * @param logger The logger of this robot.
+   * @param replayBarrier The barrier that synchronizes the threads of this robot during log replay.
    */
-  ModuleContainer(const Settings& settings, const std::string& robotName, const Configuration& config, const std::size_t index, Logger* logger);
+  ModuleContainer(const Settings& settings, const std::string& robotName, const Configuration& config, const std::size_t index, Logger* logger,
+                  LogReplayBarrier* replayBarrier);
 
   /** The destructor frees the execution unit. */
   ~ModuleContainer();
@@ -8,6 +8,9 @@
  */
 
 #include "ModuleGraphRunner.h"
+#include "Framework/Checkpointable.h"
+#include "Streaming/InStreams.h"
+#include "Streaming/OutStreams.h"
 #ifdef TARGET_ROBOT
 #include "Platform/Time.h"
 #endif
@@ -151,6 +154,39 @@ void ModuleGraphRunner::writePacket(Out& stream, const std::size_t index) const
     stream << *s;
 }
 
+void ModuleGraphRunner::writeCheckpoint(Out& stream) const
+{
+  // Each state is preceded by its size, so that it can be skipped when reading.
+  for(const auto& [name, moduleState] : modules)
+    if(const Checkpointable* checkpointable = dynamic_cast<const Checkpointable*>(moduleState.instance); checkpointable)
+    {
+      OutBinaryMemory state;
+      checkpointable->writeCheckpoint(state);
+      stream << name << static_cast<unsigned>(state.size());
+      stream.write(state.data(), state.size());
+    }
+}
+
+void ModuleGraphRunner::readCheckpoint(In& stream)
+{
+  std::string name;
+  std::vector<char> state;
+  while(!stream.eof())
+  {
+    unsigned size;
+    stream >> name >> size;
+    state.resize(size);
+    stream.read(state.data(), size);
+    const auto moduleState = modules.find(name);
+    if(moduleState != modules.end())
+      if(Checkpointable* checkpointable = dynamic_cast<Checkpointable*>(moduleState->second.instance); checkpointable)
+      {
+        InBinaryMemory stateStream(state.data(), state.size());
+        checkpointable->readCheckpoint(stateStream);
+      }
+  }
+}
+
 const std::string& ModuleGraphRunner::getProvider(const std::string& representation) const
 {
   auto provider = representationProviders.find(representation);
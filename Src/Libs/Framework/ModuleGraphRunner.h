@@ -169,6 +169,20 @@ public:
     return toSend[index].empty();
   }
 
+  /**
+   * Writes the internal states of all modules of this thread that implement
+   * the interface \c Checkpointable.
+   * @param stream The stream the states are written to.
+   */
+  void writeCheckpoint(Out& stream) const;
+
+  /**
+   * Restores the internal states of modules written by \c writeCheckpoint.
+   * States of modules that do not exist anymore are skipped.
+   * @param stream The stream the states are read from.
+   */
+  void readCheckpoint(In& stream);
+
   /**
    * Returns the provider for a representation.
    * @param The name of the representation;
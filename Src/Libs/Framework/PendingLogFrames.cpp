@@ -0,0 +1,58 @@
+/**
+ * @file Framework/PendingLogFrames.cpp
+ *
+ * This file implements the queue of frames the logger keeps back before
+ * writing them.
+ */
+
+#include "PendingLogFrames.h"
+#include "Streaming/MessageQueue.h"
+#include <algorithm>
+
+std::size_t PendingLogFrames::add(Frame&& frame, unsigned triggers, unsigned now, unsigned preTriggerDuration,
+                                  std::deque<MessageQueue*>& buffersToWrite)
+{
+  if(triggers != this->triggers)
+  {
+    for(Frame& pendingFrame : frames)
+      pendingFrame.skipped.clear();
+    this->triggers = triggers;
+  }
+
+  // The frame might have been recorded while another thread triggered a burst.
+  if(frame.triggers != triggers)
+    frame.skipped.clear();
+  frames.push_back(std::move(frame));
+
+  std::size_t numOfBuffers = 0;
+  while(!frames.empty()
+        && (frames.front().skipped.empty() || static_cast<unsigned>(now - frames.front().time) >= preTriggerDuration))
+  {
+    reduce(frames.front());
+    buffersToWrite.push_back(frames.front().buffer);
+    frames.pop_front();
+    ++numOfBuffers;
+  }
+  return numOfBuffers;
+}
+
+std::size_t PendingLogFrames::flush(std::deque<MessageQueue*>& buffersToWrite)
+{
+  const std::size_t numOfBuffers = frames.size();
+  for(Frame& frame : frames)
+  {
+    reduce(frame);
+    buffersToWrite.push_back(frame.buffer);
+  }
+  frames.clear();
+  return numOfBuffers;
+}
+
+void PendingLogFrames::reduce(Frame& frame)
+{
+  if(!frame.skipped.empty())
+    frame.buffer->filter([&frame](MessageQueue::const_iterator message)
+    {
+      return std::find(frame.skipped.begin(), frame.skipped.end(), (*message).id()) == frame.skipped.end();
+    });
+}
@@ -0,0 +1,68 @@
+/**
+ * @file Framework/PendingLogFrames.h
+ *
+ * This file declares the queue of frames the logger keeps back before
+ * writing them. Frames are recorded at full rate. When they are old enough,
+ * the representations skipped by their rate policies are removed and the
+ * frames are written. If a burst is triggered before, they are written at
+ * full rate. There is a single queue for the frames of all threads, so that
+ * frames are written in the order in which they were recorded.
+ */
+
+#pragma once
+
+#include "Streaming/MessageIDs.h"
+#include <deque>
+#include <vector>
+
+class MessageQueue;
+
+class PendingLogFrames
+{
+public:
+  /** A filled buffer that is kept back to allow logging it at full rate if a burst is triggered. */
+  struct Frame
+  {
+    MessageQueue* buffer; /**< The buffer containing the frame at full rate. */
+    unsigned time; /**< The time when the frame was recorded. */
+    unsigned triggers; /**< The number of bursts triggered when the recording of the frame started. */
+    std::vector<MessageID> skipped; /**< The representations that must be removed when the frame is written at reduced rate. */
+  };
+
+private:
+  std::deque<Frame> frames; /**< The frames not written yet, oldest first. */
+  unsigned triggers = 0; /**< The number of bursts triggered the frames kept back know of. */
+
+  /**
+   * Removes the representations skipped from a frame.
+   * @param frame The frame. It is logged at reduced rate afterwards.
+   */
+  static void reduce(Frame& frame);
+
+public:
+  /**
+   * Adds a frame and moves all frames that are due to the buffers to write.
+   * Frames are due when they are old enough or when they need no reduction,
+   * either because a burst was triggered in time or because no
+   * representation was skipped anyway. A frame is only due if all frames
+   * added before are due as well.
+   * @param frame The frame recorded last.
+   * @param triggers The number of bursts triggered so far. If it changed,
+   *                 all frames kept back are written at full rate.
+   * @param now The current system time.
+   * @param preTriggerDuration How long are frames kept back (in ms)?
+   * @param buffersToWrite The buffers of all frames due are appended to
+   *                       this queue in the order they were added.
+   * @return The number of buffers appended.
+   */
+  std::size_t add(Frame&& frame, unsigned triggers, unsigned now, unsigned preTriggerDuration,
+                  std::deque<MessageQueue*>& buffersToWrite);
+
+  /**
+   * Moves all frames kept back to the buffers to write at reduced rate.
+   * @param buffersToWrite The buffers of all frames are appended to this queue
+   *                       in the order they were added.
+   * @return The number of buffers appended.
+   */
+  std::size_t flush(std::deque<MessageQueue*>& buffersToWrite);
+};
@@ -32,7 +32,7 @@ Robot::Robot(const Settings& settings, const std::string& name) : name(name)
 
   // start threads
   for(std::size_t i = 0; i < config().size(); i++)
-    push_back(new ModuleContainer(settings, name, config, i, logger));
+    push_back(new ModuleContainer(settings, name, config, i, logger, &replayBarrier));
 
   // connect sender and receiver
   for(const Configuration::Thread& con : config())
@@ -9,6 +9,7 @@
 #pragma once
 
 #include "Framework/Logger.h"
+#include "Framework/LogReplayBarrier.h"
 #include "Framework/ThreadFrame.h"
 #include <string>
 
@@ -24,6 +25,7 @@ class Robot : public ThreadList
 private:
   std::string name; /**< The name of the robot. */
   Logger* logger; /**< The logger for data from all threads. */
+  LogReplayBarrier replayBarrier; /**< Synchronizes the threads during log replay. */
 
 public:
   /**
@@ -41,4 +43,10 @@ public:
    * @return The name of the robot.
    */
   const std::string& getName() const { return name; }
+
+  /**
+   * The function returns the barrier that synchronizes the threads during log replay.
+   * @return The barrier.
+   */
+  LogReplayBarrier& getReplayBarrier() { return replayBarrier; }
 };
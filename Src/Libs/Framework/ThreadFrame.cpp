@@ -9,6 +9,7 @@
 
 #include "ThreadFrame.h"
 #include "Debugging/Debugging.h"
+#include "Framework/FrameArena.h"
 #include "Platform/File.h"
 #include "Streaming/Global.h"
 #include <asmjit/asmjit.h>
@@ -91,6 +92,13 @@ void ThreadFrame::threadMain()
 
     bool shouldWait = main();
 
+    // Release all temporaries of this frame. Allocations that are still alive were kept beyond the frame.
+    [[maybe_unused]] const std::size_t escapedAllocations = FrameArena::reset();
+#ifndef NDEBUG
+    if(escapedAllocations)
+      OUTPUT_WARNING(getName() << ": " << static_cast<unsigned>(escapedAllocations) << " allocations from the frame arena survived the frame");
+#endif
+
     if(Global::getDebugRequestTable().pollCounter > 0 &&
        --Global::getDebugRequestTable().pollCounter == 0)
     {
@@ -79,7 +79,7 @@ public:
    * The function returns the name of the thread.
    * @return The name of the thread.
    */
-  virtual const std::string getName() const { return TypeRegistry::demangle(typeid(*this).name()); }
+  virtual const std::string getName() const { return TypeRegistry::getName(typeid(*this).name()); }
 
   /**
    * The function initializes the pointers in class Global.
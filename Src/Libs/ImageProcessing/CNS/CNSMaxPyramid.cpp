@@ -0,0 +1,100 @@
+#include "CNSMaxPyramid.h"
+#include <algorithm>
+
+CNSMaxPyramid::CNSMaxPyramid(const Image<CNSResponse>& cns) :
+  cns(cns)
+{
+  int width = (static_cast<int>(cns.width) + (1 << BASE_SHIFT) - 1) >> BASE_SHIFT;
+  int height = (static_cast<int>(cns.height) + (1 << BASE_SHIFT) - 1) >> BASE_SHIFT;
+  if(width == 0 || height == 0)
+    return;
+  while(true)
+  {
+    levels.push_back({width, height, std::vector<unsigned short>(width * height, UNKNOWN)});
+    if(width == 1 && height == 1)
+      break;
+    width = (width + 1) / 2;
+    height = (height + 1) / 2;
+  }
+}
+
+int CNSMaxPyramid::cell(int level, int x, int y) const
+{
+  const Level& l = levels[level];
+  unsigned short& value = l.cells[y * l.width + x];
+  if(value == UNKNOWN)
+  {
+    int result = 0;
+    if(level == 0)
+    {
+      // Pooled directly from the image
+      const int xLo = x << BASE_SHIFT, xHi = std::min(xLo + (1 << BASE_SHIFT), static_cast<int>(cns.width));
+      const int yLo = y << BASE_SHIFT, yHi = std::min(yLo + (1 << BASE_SHIFT), static_cast<int>(cns.height));
+      for(int yy = yLo; yy < yHi; yy++)
+      {
+        const CNSResponse* p = &cns(xLo, yy);
+        for(int xx = xLo; xx < xHi; xx++, p++)
+        {
+          const int dX = p->filterX - CNSResponse::OFFSET, dY = p->filterY - CNSResponse::OFFSET;
+          result = std::max(result, dX * dX + dY * dY);
+        }
+      }
+    }
+    else
+    {
+      // Pooled from the next finer level
+      const Level& finer = levels[level - 1];
+      for(int yy = 2 * y; yy < std::min(2 * y + 2, finer.height); yy++)
+        for(int xx = 2 * x; xx < std::min(2 * x + 2, finer.width); xx++)
+          result = std::max(result, cell(level - 1, xx, yy));
+    }
+    value = static_cast<unsigned short>(result);
+  }
+  return value;
+}
+
+int CNSMaxPyramid::max(int xLo, int xHi, int yLo, int yHi) const
+{
+  if(xLo < 0 || xHi > static_cast<int>(cns.width) || yLo < 0 || yHi > static_cast<int>(cns.height) || xLo >= xHi || yLo >= yHi)
+    return MAX_VALUE;
+
+  const int size = std::min(xHi - xLo, yHi - yLo);
+  int level = 0;
+  while(level + 1 < static_cast<int>(levels.size()) && (1 << (BASE_SHIFT + level + 1)) <= size)
+    level++;
+
+  const int shift = BASE_SHIFT + level;
+  int result = 0;
+  for(int y = yLo >> shift; y <= (yHi - 1) >> shift; y++)
+    for(int x = xLo >> shift; x <= (xHi - 1) >> shift; x++)
+      result = std::max(result, cell(level, x, y));
+  return result;
+}
+
+void CNSMaxPyramid::max16(int* bounds, int x, int y, int nX, int nY) const
+{
+  static_assert(BASE_SHIFT == 4);
+  if(x < 0 || x + 16 * nX > static_cast<int>(cns.width) || y < 0 || y + 16 * nY > static_cast<int>(cns.height))
+  {
+    for(int j = 0; j < nY; j++)
+      for(int i = 0; i < nX; i++)
+        *bounds++ = max(x + 16 * i, x + 16 * i + 16, y + 16 * j, y + 16 * j + 16);
+    return;
+  }
+
+  // Unless x or y is a multiple of 16, each square overlaps two cells in that direction
+  const int xCell = x >> BASE_SHIFT, yCell = y >> BASE_SHIFT;
+  const int dX = (x & 15) ? 1 : 0, dY = (y & 15) ? 1 : 0;
+  const int width = nX + dX;
+  gridCells.resize(width * (nY + dY));
+  int* cells = gridCells.data();
+  for(int j = 0; j < nY + dY; j++)
+    for(int i = 0; i < width; i++)
+      cells[j * width + i] = cell(0, xCell + i, yCell + j);
+  for(int j = 0; j < nY; j++)
+    for(int i = 0; i < nX; i++)
+    {
+      const int* c = &cells[j * width + i];
+      *bounds++ = std::max(std::max(c[0], c[dX]), std::max(c[dY * width], c[dY * width + dX]));
+    }
+}
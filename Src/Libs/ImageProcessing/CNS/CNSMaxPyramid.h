@@ -0,0 +1,69 @@
+#pragma once
+
+#include "ImageProcessing/CNS/CNSResponse.h"
+#include "ImageProcessing/Image.h"
+#include <vector>
+
+//! Max-pooled pyramid of the squared lengths of the CNS responses in a CNS image
+/*! The value of a pixel is the squared length of its CNS vector in binary
+    units, i.e. \c (filterX-128)^2+(filterY-128)^2. Level \c l stores the
+    maximum of these values in cells of \c (16<<l)*(16<<l) pixels.
+
+    The response of a single contour point is the squared projection of the
+    CNS vector onto the normal of the contour. It is therefore bounded by the
+    value of the pixel times the squared length of the normal. Hence, \c max
+    allows to bound the response a contour can reach anywhere in a range of
+    image translations without evaluating it (see
+    \c ObjectCNSStereoDetector::responseBound).
+
+    The cells are computed when they are needed first, so a search that only
+    looks at a part of the image only pays for that part. The pyramid keeps
+    a reference to the image, which must not change while the pyramid is used.
+ */
+class CNSMaxPyramid
+{
+public:
+  //! The largest possible value of a pixel, returned for rectangles not inside the image
+  static constexpr int MAX_VALUE = 2 * CNSResponse::OFFSET * CNSResponse::OFFSET;
+
+  //! Creates the pyramid of \c cns without computing any cells
+  CNSMaxPyramid(const Image<CNSResponse>& cns);
+
+  //! Returns an upper bound of the values of the pixels in \c [xLo..xHi-1]*[yLo..yHi-1]
+  /*! The bound is the maximum over the cells of the coarsest level whose
+      cells are not larger than the shorter side of the rectangle, i.e. at
+      most 3 cells are looked at in this direction. If the rectangle is not
+      completely inside the image, \c MAX_VALUE is returned.
+   */
+  int max(int xLo, int xHi, int yLo, int yHi) const;
+
+  //! Computes \c max for a grid of \c nX*nY squares of 16*16 pixels, the first one at \c x,y
+  /*! \c bounds[j*nX+i] is set to \c max(x+16*i,x+16*i+16,y+16*j,y+16*j+16).
+      This is faster than calling \c max for each square, because the cells
+      shared by neighboring squares are only looked up once.
+   */
+  void max16(int* bounds, int x, int y, int nX, int nY) const;
+
+private:
+  enum {BASE_SHIFT = 4}; //!< The cells of level 0 have a size of 16*16 pixels
+  enum {UNKNOWN = 0xffff}; //!< Marks cells not computed yet
+
+  //! A single level of the pyramid
+  struct Level
+  {
+    int width, height;                         //!< Number of cells in x and y direction
+    mutable std::vector<unsigned short> cells; //!< The maxima of the cells, row by row
+  };
+
+  //! Returns the value of cell \c x,y in \c level, computing it if necessary
+  int cell(int level, int x, int y) const;
+
+  //! The image
+  const Image<CNSResponse>& cns;
+
+  //! The levels, from fine to coarse. The last one consists of a single cell.
+  std::vector<Level> levels;
+
+  //! Buffer for the cells looked up by \c max16
+  mutable std::vector<int> gridCells;
+};
@@ -1,8 +1,83 @@
 #include "ObjectCNSStereoDetector.h"
 #include "CNSSSE.h"
+#include <algorithm>
+#include <limits>
 
 using namespace std;
 
+namespace
+{
+  //! Maps the sum of bounds of the responses of contour points to a bound of the final binary response
+  /*! Like \c scaleOffsetUsingSSE, but considering that the accumulator saturates. */
+  int finalBinBound(unsigned rawBound, const LinearResponseMapping& mapping)
+  {
+    return std::min(0x7fff, ((static_cast<int>(std::min(rawBound, 0xffffu)) * mapping.rawBin2FinalBinScale) >> 16) + mapping.rawBin2FinalBinOffset);
+  }
+
+  //! The \c maxLength best object poses seen, with ties decided in favor of the smaller order
+  /*! This gives the same result as inserting the poses in the order of
+      ascending orders into a sorted list and only accepting poses that
+      are strictly better than the last one of a full list.
+   */
+  class BestResponses
+  {
+    struct Entry
+    {
+      IsometryWithResponse object2World;
+      int order;
+      EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+    };
+
+    //! A heap with the worst entry at the front
+    std::vector<Entry, Eigen::aligned_allocator<Entry>> heap;
+
+    size_t maxLength;
+
+    static bool better(double responseA, int orderA, double responseB, int orderB)
+    {return responseA > responseB || (responseA == responseB && orderA < orderB);}
+
+    static bool compare(const Entry& a, const Entry& b)
+    {return better(a.object2World.response, a.order, b.object2World.response, b.order);}
+
+  public:
+    BestResponses(int maxLength) : maxLength(static_cast<size_t>(maxLength)) {heap.reserve(this->maxLength + 1);}
+
+    //! Whether a pose with \c response and \c order would be added
+    bool accepts(double response, int order) const
+    {
+      if(heap.size() < maxLength)
+        return response > 0;
+      else
+        return maxLength > 0 && better(response, order, heap.front().object2World.response, heap.front().order);
+    }
+
+    //! Responses below this value are not added
+    double threshold() const
+    {return heap.size() < maxLength ? -std::numeric_limits<double>::infinity() : heap.front().object2World.response;}
+
+    //! Adds an entry, dropping the worst one if there are more than \c maxLength
+    void add(const IsometryWithResponse& object2World, int order)
+    {
+      heap.push_back({object2World, order});
+      std::push_heap(heap.begin(), heap.end(), compare);
+      if(heap.size() > maxLength)
+      {
+        std::pop_heap(heap.begin(), heap.end(), compare);
+        heap.pop_back();
+      }
+    }
+
+    //! Replaces the content of \c list with the entries, best first
+    void get(ObjectCNSStereoDetector::IsometryWithResponses& list)
+    {
+      std::sort_heap(heap.begin(), heap.end(), compare);
+      list.clear();
+      for(const Entry& entry : heap)
+        list.push_back(entry.object2World);
+    }
+  };
+}
+
 void ObjectCNSStereoDetector::create(const TriangleMesh& object, const CameraModelOpenCV& camera,
                                      const Eigen::AlignedBox3d& viewpointRange, double spacing,
                                      const SearchSpecification& spec, const ParametricLaplacian& distribution,
@@ -59,9 +134,13 @@ void ObjectCNSStereoDetector::search(IsometryWithResponses& object2WorldList,
   // Global search
   assert((xHi - xLo + 1) % spec.blockX == 0);
   assert((yHi - yLo + 1) % spec.blockY == 0);
+  const CNSMaxPyramid pyramid(cns);
+  Candidates candidates;
+  int order = 0;
   for(int y = yLo; y <= yHi; y += spec.blockY)
     for(int x = xLo; x <= xHi; x += spec.blockX)
-      searchBlockAllPoses(object2WorldList, cns, x, y);
+      addBlockCandidates(candidates, pyramid, x, y, order);
+  searchCandidates(object2WorldList, cns, pyramid, candidates);
   if(spec.refineExisting)
     object2WorldList.insert(object2WorldList.end(), oldObject2WorldList.begin(), oldObject2WorldList.end());
 
@@ -110,6 +189,21 @@ void ObjectCNSStereoDetector::renderBlockAllPoses(Contour& ct,
 void ObjectCNSStereoDetector::searchBlockAllPoses(IsometryWithResponses& object2WorldList,
     const Image<CNSResponse>& cns,
     int x, int y) const
+{
+  searchBlockAllPoses(object2WorldList, cns, CNSMaxPyramid(cns), x, y);
+}
+
+void ObjectCNSStereoDetector::searchBlockAllPoses(IsometryWithResponses& object2WorldList,
+    const Image<CNSResponse>& cns, const CNSMaxPyramid& pyramid,
+    int x, int y) const
+{
+  Candidates candidates;
+  int order = 0;
+  addBlockCandidates(candidates, pyramid, x, y, order);
+  searchCandidates(object2WorldList, cns, pyramid, candidates);
+}
+
+void ObjectCNSStereoDetector::addBlockCandidates(Candidates& candidates, const CNSMaxPyramid& pyramid, int x, int y, int& order) const
 {
   Eigen::Vector3d p, v;
   camera.image2WorldRay(x + spec.blockX / 2, y + spec.blockY / 2, p, v);
@@ -127,11 +221,11 @@ void ObjectCNSStereoDetector::searchBlockAllPoses(IsometryWithResponses& object2
     {
       Eigen::Isometry3d object2World(spec.object2WorldOrientation[i]);
       object2World.translation() = object2WorldTranslation;
-      IsometryWithResponse result;
-      if(object2WorldList.size() == static_cast<size_t>(spec.nResponses))
-        result.response = object2WorldList.back().response;
-      if(searchBlockFixedPose(result, cns, object2World))
-        addToList(object2WorldList, result, spec.nResponses);
+      Candidate& candidate = candidates.emplace_back();
+      candidate.object2World = object2World;
+      candidate.order = order++;
+      lr.rasterize(candidate.contour, object2World, camera);
+      candidate.bound = responseBound(candidate.contour, pyramid, -spec.blockX / 2, spec.blockX / 2, -spec.blockY / 2, spec.blockY / 2);
     }
 
     object2WorldTranslation = searchStepTranslationViewing(object2WorldTranslation, spec.stepInPixelGlobalDiscretization);
@@ -140,6 +234,45 @@ void ObjectCNSStereoDetector::searchBlockAllPoses(IsometryWithResponses& object2
   }
 }
 
+void ObjectCNSStereoDetector::searchCandidates(IsometryWithResponses& object2WorldList,
+    const Image<CNSResponse>& cns, const CNSMaxPyramid& pyramid,
+    Candidates& candidates) const
+{
+  // Entries already in the list precede all candidates
+  BestResponses best(spec.nResponses);
+  for(int i = 0; i < static_cast<int>(object2WorldList.size()); i++)
+    best.add(object2WorldList[i], i - static_cast<int>(object2WorldList.size()));
+
+  sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b)
+  {
+    return a.bound > b.bound || (a.bound == b.bound && a.order < b.order);
+  });
+
+  const LinearResponseMapping mapping;
+  for(const Candidate& candidate : candidates)
+  {
+    const double bound = mapping.finalBin2FinalFloat(static_cast<short>(candidate.bound));
+    if(!best.accepts(bound, candidate.order))
+    {
+      if(bound < best.threshold())
+        break; // No remaining candidate can be better.
+      else
+        continue;
+    }
+
+    int maxVal = 0, argMaxX = 0, argMaxY = 0;
+    responseXYMax(maxVal, argMaxX, argMaxY, cns, candidate.contour, pyramid, spec.blockX, spec.blockY, best.threshold());
+    const double maxF = mapping.finalBin2FinalFloat(static_cast<short>(maxVal));
+    if(best.accepts(maxF, candidate.order))
+    {
+      IsometryWithResponse result(candidate.object2World, maxF);
+      updateWithXY(result, argMaxX, argMaxY);
+      best.add(result, candidate.order);
+    }
+  }
+  best.get(object2WorldList);
+}
+
 void ObjectCNSStereoDetector::renderBlockFixedPose(Contour& ct,
     const Eigen::Isometry3d& object2WorldTry,
     const CameraModelOpenCV& renderCamera) const
@@ -233,6 +366,81 @@ void ObjectCNSStereoDetector::responseXYMax(int& maxVal, int& argMaxX, int& argM
     }
 }
 
+void ObjectCNSStereoDetector::responseXYMax(int& maxVal, int& argMaxX, int& argMaxY,
+    const Image<CNSResponse>& cns, const CodedContour& ct, const CNSMaxPyramid& pyramid,
+    int blockX, int blockY, double minResponse) const
+{
+  assert((blockX & 0xf) == 0 && (blockY & 0xf) == 0);
+  const int xMin = -blockX / 2, yMin = -blockY / 2;
+  const int nX = blockX / 16, n = nX * (blockY / 16);
+  const LinearResponseMapping mapping;
+
+  // Bounds of the 16*16 blocks, summed up over all contour points
+  std::vector<unsigned> rawBounds(n, 0);
+  std::vector<int> pointBounds(n);
+  for(CodedContourPoint ccp : ct)
+  {
+    const int normalX = nxOfCCP(ccp), normalY = nyOfCCP(ccp);
+    const unsigned normalSqr = normalX * normalX + normalY * normalY;
+    pyramid.max16(pointBounds.data(), ct.referenceX + xOfCCP(ccp) + xMin, ct.referenceY + yOfCCP(ccp) + yMin, nX, n / nX);
+    for(int i = 0; i < n; i++)
+      rawBounds[i] += (static_cast<unsigned>(pointBounds[i]) * normalSqr) >> RESPONSE_COMPUTATION_IMPLICIT_SHIFTRIGHT;
+  }
+
+  // Indices of the 16*16 blocks in the order of the exhaustive search
+  std::vector<std::pair<int, int>> blocks;
+  blocks.reserve(n);
+  for(int i = 0; i < n; i++)
+  {
+    const int bound = finalBinBound(rawBounds[i], ct.mapping);
+    if(bound > maxVal && mapping.finalBin2FinalFloat(static_cast<short>(bound)) >= minResponse)
+      blocks.emplace_back(bound, i);
+  }
+  sort(blocks.begin(), blocks.end(), [](const std::pair<int, int>& a, const std::pair<int, int>& b)
+  {
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+  });
+
+  // The exhaustive search keeps the first of equal maxima
+  int argMaxBlock = -1;
+  for(const auto& [bound, i] : blocks)
+  {
+    if(bound < maxVal)
+      break;
+    else if(bound == maxVal && (argMaxBlock < 0 || i > argMaxBlock))
+      continue;
+
+    const int x = xMin + (i % nX) * 16, y = yMin + (i / nX) * 16;
+    alignas(16) signed short responseBin[16][16];
+    ct.evaluateX16Y16(responseBin, cns, x, y);
+
+    int maxI = -0xffff, argMaxI = -1;
+    maximumUsingSSE2(maxI, argMaxI, 0, &responseBin[0][0], 16 * 16);
+    if(maxI > maxVal || (maxI == maxVal && argMaxBlock >= 0 && i < argMaxBlock))
+    {
+      maxVal = maxI;
+      argMaxX = x + (argMaxI & 0xf);
+      argMaxY = y + (argMaxI >> 4);
+      argMaxBlock = i;
+    }
+  }
+}
+
+int ObjectCNSStereoDetector::responseBound(const CodedContour& ct, const CNSMaxPyramid& pyramid, int xLo, int xHi, int yLo, int yHi)
+{
+  unsigned rawBound = 0;
+  for(CodedContourPoint ccp : ct)
+  {
+    const int x = ct.referenceX + xOfCCP(ccp), y = ct.referenceY + yOfCCP(ccp);
+    const int nX = nxOfCCP(ccp), nY = nyOfCCP(ccp);
+    rawBound += (static_cast<unsigned>(pyramid.max(x + xLo, x + xHi, y + yLo, y + yHi)) * (nX * nX + nY * nY))
+                >> RESPONSE_COMPUTATION_IMPLICIT_SHIFTRIGHT;
+    if(rawBound >= 0xffff)
+      break;
+  }
+  return finalBinBound(rawBound, ct.mapping);
+}
+
 Eigen::Vector3d ObjectCNSStereoDetector::searchStepTranslationViewing(const Eigen::Vector3d& object2WorldTrans, double stepInPixel) const
 {
   double f = (camera.scale_x + camera.scale_y) / 2;
@@ -442,17 +650,3 @@ void ObjectCNSStereoDetector::rasterizedConeOfOrientations(std::vector<Eigen::Is
         a2bList.push_back(a2b0 * Eigen::Isometry3d(Eigen::AngleAxisd(angle, angleAxis / angle)));
       }
 }
-
-void ObjectCNSStereoDetector::addToList(IsometryWithResponses& list, const IsometryWithResponse& newEntry, int maxLength)
-{
-  int idx = static_cast<int>(list.size() - 1);
-  while(idx >= 0 && list[idx].response < newEntry.response) idx--;
-  list.insert(list.begin() + (idx + 1), newEntry);
-  if(static_cast<int>(list.size()) > maxLength)
-    list.pop_back();
-#ifndef NDEBUG
-  for(int i = 0; i < static_cast<int>(list.size()) - 1; i++)
-    assert(list[i].response >= list[i + 1].response);
-  assert(static_cast<int>(list.size()) <= maxLength);
-#endif
-}
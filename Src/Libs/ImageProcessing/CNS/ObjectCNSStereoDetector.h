@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ImageProcessing/CNS/CameraModelOpenCV.h"
+#include "ImageProcessing/CNS/CNSMaxPyramid.h"
 #include "ImageProcessing/CNS/CNSResponse.h"
 #include "ImageProcessing/CNS/CodedContour.h"
 #include "ImageProcessing/CNS/IsometryWithResponse.h"
@@ -32,6 +33,30 @@ public:
   //! Type definition for a memory-aligned sequence of object poses and their responses
   using IsometryWithResponses = std::vector<IsometryWithResponse, Eigen::aligned_allocator<IsometryWithResponse>>;
 
+  //! An object pose of the global search together with an upper bound of its response
+  /*! The pose is searched with the image translations of a whole block
+      (see \c searchBlockFixedPose).
+   */
+  struct Candidate
+  {
+    //! The pose without image translation
+    Eigen::Isometry3d object2World;
+
+    //! The object rasterized in this pose
+    CodedContour contour;
+
+    //! Position of the pose in the order of an exhaustive search, decides between equal responses
+    int order;
+
+    //! Upper bound of the binary response of the pose in the whole block (see \c responseBound)
+    int bound;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+  };
+
+  //! Type definition for a memory-aligned sequence of candidates
+  using Candidates = std::vector<Candidate, Eigen::aligned_allocator<Candidate>>;
+
   //! The object's geometry in object coordinates
   TriangleMesh object;
 
@@ -127,6 +152,16 @@ public:
       shifted by \c
       [-spec.blockX/2..+spec.blockX/2-1]*[-spec.blockY/2..+spec.blockY/2-1].
 
+      The search does not evaluate all these poses. First, an upper bound
+      of the response of each pose in its whole block is computed from a
+      max-pooled pyramid of the CNS image (see \c responseBound). Then the
+      poses are evaluated in the order of descending bounds until no bound
+      can beat the \c spec.nResponses-th best response found so far. Inside
+      a block, the same is done for the 16*16 sub-blocks of image
+      translations. The result is the same as the one of evaluating all
+      poses in all translations, including which of several equal responses
+      is returned.
+
       The \c spec.nResponses largest responses are refined using \c refine
       and stored in \c object2World. If \c spec.refineExisting is \c true
       all these poses in \c object2World when calling \c search are additionally
@@ -147,11 +182,41 @@ public:
       gives the set of positions. The set of orientations is taken from \c spec.object2WorldOrientation.
       For all these poses \c searchBlockFixedPose is called and the result
       added to \c object2World.
+
+      The poses are evaluated in the order of their bounds as in \c search.
+      This variant creates the pyramid needed for the bounds itself. If
+      several blocks of the same image are searched, the pyramid should be
+      created once and passed to the other variant, so that its cells are
+      only computed once.
    */
   void searchBlockAllPoses(IsometryWithResponses& object2WorldList,
                            const Image<CNSResponse>& cns,
                            int x, int y) const;
 
+  //! See \c searchBlockAllPoses above, using the \c pyramid of \c cns
+  void searchBlockAllPoses(IsometryWithResponses& object2WorldList,
+                           const Image<CNSResponse>& cns, const CNSMaxPyramid& pyramid,
+                           int x, int y) const;
+
+  //! Appends all poses of the block at \c x,y to \c candidates together with their bounds
+  /*! The poses are the same as the ones \c searchBlockAllPoses goes through.
+      \c order is the order of the next pose and is increased for each pose.
+   */
+  void addBlockCandidates(Candidates& candidates, const CNSMaxPyramid& pyramid, int x, int y, int& order) const;
+
+  //! Searches the poses in \c candidates and adds the best to \c object2WorldList
+  /*! The entries already in \c object2WorldList are kept if they are better
+      than the candidates and are preferred to candidates with the same response.
+      Candidates are evaluated in the order of descending bounds as long as
+      their bound can beat the \c spec.nResponses-th best response. Finally,
+      \c object2WorldList contains the \c spec.nResponses best responses, sorted by
+      descending response. Among equal responses, the one with the
+      smaller \c order comes first. \c candidates is reordered.
+   */
+  void searchCandidates(IsometryWithResponses& object2WorldList,
+                        const Image<CNSResponse>& cns, const CNSMaxPyramid& pyramid,
+                        Candidates& candidates) const;
+
   //! Search for a single object pose \c object2WorldTry with a block of image translation
   /*! \c object is rasterized with the pose \c object2WorldTry and the resulting
       contour evaluated shifted by \c
@@ -191,14 +256,15 @@ public:
                             const Eigen::Isometry3d& object2WorldTry,
                             const CameraModelOpenCV& renderCamera) const;
 
-  //! Adds \c newEntry to the sorted \c list at the right position.
-  /*! \c list must be sorted by descending \c .response. If \c list becomes larger than \c maxLength, the last
-    entry is dropped.
-
-    Finally, addToList should not insert \c newEntry if it is too close to an existing entry, however
-    this is not implemented yet.
+  //! Returns an upper bound of the binary response of \c ct shifted by \c [xLo..xHi-1]*[yLo..yHi-1]
+  /*! The response of a single contour point is
+      \c ((cx-128)*nx+(cy-128)*ny)^2 >> RESPONSE_COMPUTATION_IMPLICIT_SHIFTRIGHT,
+      which is at most \c ((cx-128)^2+(cy-128)^2)*(nx^2+ny^2) >> RESPONSE_COMPUTATION_IMPLICIT_SHIFTRIGHT.
+      The first factor is bounded by \c pyramid over all pixels the point is
+      moved to. The sum of these bounds is mapped to the final response as in
+      \c CodedContour::evaluateX16Y16.
    */
-  static void addToList(IsometryWithResponses& list, const IsometryWithResponse& newEntry, int maxLength);
+  static int responseBound(const CodedContour& ct, const CNSMaxPyramid& pyramid, int xLo, int xHi, int yLo, int yHi);
 
   //! Returns how much in the stereo-image \c imgLeft, imgRight there appears to be \c object at \c object2World
   /*! rasterizes \c object using \c object2World and \c camera[0/1], evaluates the contour response at these
@@ -235,6 +301,18 @@ public:
                      const Image<CNSResponse>& cns, const Eigen::Isometry3d& object2World,
                      int blockX, int blockY) const;
 
+  //! Computes the same as \c responseXYMax above for a rasterized contour \c ct, skipping 16*16 blocks where possible
+  /*! The 16*16 blocks of translations are bounded using \c responseBound and
+      evaluated in the order of descending bounds. Blocks whose bound cannot
+      beat the maximum found so far are skipped. The result is the same as
+      with the exhaustive evaluation. In addition, blocks whose bound maps
+      to a response below \c minResponse are skipped. If the maximum is in such a
+      block, the result is smaller than \c minResponse, but not necessarily the maximum.
+   */
+  void responseXYMax(int& maxVal, int& argMaxX, int& argMaxY,
+                     const Image<CNSResponse>& cns, const CodedContour& ct, const CNSMaxPyramid& pyramid,
+                     int blockX, int blockY, double minResponse) const;
+
   //! Dimensions in the 6-DOF pose space used for searching
   enum {DIM_ROT_X = 0, DIM_ROT_Y = 1, DIM_ROT_Z = 2, DIM_TRANS_IMAGE_X = 3, DIM_TRANS_IMAGE_Y = 4, DIM_TRANS_VIEWING = 5};
 
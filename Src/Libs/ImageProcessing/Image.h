@@ -7,11 +7,12 @@
 
 #pragma once
 
+#include "ImageProcessing/ImageBufferPool.h"
 #include "ImageProcessing/PixelTypes.h"
 #include "Math/Eigen.h"
 #include "Platform/BHAssert.h"
 #include "Streaming/Streamable.h"
-#include <vector>
+#include <cstring>
 
 /**
  * Template class to represent an image of parameterizable pixel type.
@@ -25,10 +26,11 @@ public:
   unsigned int height;
 
 private:
-  std::vector<unsigned char> allocator;
+  unsigned char* buffer = nullptr; /**< The uninitialized memory from the ImageBufferPool. */
+  size_t capacity = 0; /**< The size of the buffer in bytes. */
 
 protected:
-  Pixel* image; /**< A pointer to the memory for the image */
+  Pixel* image = nullptr; /**< A pointer to the memory for the image */
 
 public:
   Image() : width(0), height(0) {}
@@ -40,6 +42,10 @@ public:
   {
     (*this) = other;
   }
+  ~Image()
+  {
+    ImageBufferPool::release(buffer, capacity);
+  }
 
   Image& operator=(const Image<Pixel>& other)
   {
@@ -78,10 +84,12 @@ public:
     this->width = width;
     this->height = height;
 
-    if(allocator.size() < width * height * sizeof(Pixel) + padding * 2)
+    if(capacity < width * height * sizeof(Pixel) + padding * 2)
     {
-      allocator.resize(width * height * sizeof(Pixel) + 31 + padding * 2);
-      image = reinterpret_cast<Pixel*>(reinterpret_cast<ptrdiff_t>(allocator.data() + 31 + padding) & (~ptrdiff_t(31)));
+      // The contents are not preserved, so release the old buffer first to allow its reuse.
+      ImageBufferPool::release(buffer, capacity);
+      buffer = static_cast<unsigned char*>(ImageBufferPool::acquire(width * height * sizeof(Pixel) + 31 + padding * 2, capacity));
+      image = reinterpret_cast<Pixel*>(reinterpret_cast<ptrdiff_t>(buffer + 31 + padding) & (~ptrdiff_t(31)));
     }
   }
 
@@ -95,7 +103,7 @@ protected:
     PUBLISH(reg);
     STREAM(width);
     STREAM(height);
-    setResolution(width, height, allocator.empty() ? 0 : static_cast<unsigned>(reinterpret_cast<unsigned char*>(image) - allocator.data()));
+    setResolution(width, height, buffer ? static_cast<unsigned>(reinterpret_cast<unsigned char*>(image) - buffer) : 0);
     stream.read(image, width * height * sizeof(Pixel));
   }
 
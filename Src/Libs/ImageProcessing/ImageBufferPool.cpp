@@ -0,0 +1,95 @@
+/**
+ * @file ImageBufferPool.cpp
+ *
+ * This file implements a per-thread pool of uninitialized, aligned buffers
+ * for image data.
+ */
+
+#include "ImageBufferPool.h"
+#include "Platform/BHAssert.h"
+#include "Platform/Memory.h"
+
+thread_local ImageBufferPool ImageBufferPool::instance;
+thread_local bool ImageBufferPool::destroyed = false;
+
+ImageBufferPool::~ImageBufferPool()
+{
+  for(std::size_t sizeClass = 0; sizeClass < numOfSizeClasses; ++sizeClass)
+    for(void* buffer : freeBuffers[sizeClass])
+      Memory::hugePageFree(buffer, getCapacity(sizeClass));
+  destroyed = true;
+}
+
+std::size_t ImageBufferPool::getSizeClass(std::size_t size, std::size_t& capacity)
+{
+  std::size_t index = 0;
+  std::size_t base = minSize;
+  while(base * 2 <= size)
+  {
+    base *= 2;
+    index += 4;
+  }
+  capacity = base;
+  while(capacity < size)
+  {
+    capacity += base / 4;
+    ++index;
+  }
+  return index;
+}
+
+std::size_t ImageBufferPool::getCapacity(std::size_t sizeClass)
+{
+  const std::size_t base = minSize << (sizeClass / 4);
+  return base + sizeClass % 4 * (base / 4);
+}
+
+void* ImageBufferPool::acquire(std::size_t size, std::size_t& capacity)
+{
+  const std::size_t sizeClass = getSizeClass(size, capacity);
+  if(destroyed)
+    return Memory::hugePageMalloc(capacity);
+
+  ImageBufferPool& pool = instance;
+  if(sizeClass < numOfSizeClasses && !pool.freeBuffers[sizeClass].empty())
+  {
+    void* buffer = pool.freeBuffers[sizeClass].back();
+    pool.freeBuffers[sizeClass].pop_back();
+    pool.statistics.cachedBytes -= capacity;
+    ++pool.statistics.hits;
+    return buffer;
+  }
+
+  ++pool.statistics.misses;
+  void* buffer = Memory::hugePageMalloc(capacity);
+  ASSERT(buffer);
+  return buffer;
+}
+
+void ImageBufferPool::release(void* buffer, std::size_t capacity)
+{
+  if(!buffer)
+    return;
+  else if(destroyed)
+  {
+    Memory::hugePageFree(buffer, capacity);
+    return;
+  }
+
+  ImageBufferPool& pool = instance;
+  std::size_t classCapacity;
+  const std::size_t sizeClass = getSizeClass(capacity, classCapacity);
+  ASSERT(classCapacity == capacity);
+  if(sizeClass < numOfSizeClasses && pool.statistics.cachedBytes + capacity <= maxCachedBytes)
+  {
+    pool.freeBuffers[sizeClass].push_back(buffer);
+    pool.statistics.cachedBytes += capacity;
+  }
+  else
+    Memory::hugePageFree(buffer, capacity);
+}
+
+ImageBufferPool::Statistics ImageBufferPool::getStatistics()
+{
+  return destroyed ? Statistics() : instance.statistics;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file ImageBufferPool.h
+ *
+ * This file declares a per-thread pool of uninitialized, aligned buffers for
+ * image data. Buffers are grouped into size classes (four per power of two),
+ * so that images of similar sizes can reuse each other's memory. Buffers can
+ * be returned to the pool of any thread. Large buffers are backed by huge
+ * pages if possible (see Memory::hugePageMalloc).
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+class ImageBufferPool
+{
+public:
+  static constexpr std::size_t alignment = 32; /**< The alignment of all buffers. */
+
+  /** The usage of the pool of a thread. */
+  struct Statistics
+  {
+    std::size_t hits = 0; /**< The number of buffers taken from the pool so far. */
+    std::size_t misses = 0; /**< The number of buffers that had to be allocated so far. */
+    std::size_t cachedBytes = 0; /**< The number of bytes in buffers that are currently unused. */
+  };
+
+private:
+  static constexpr std::size_t minSize = 1024; /**< The smallest size class. */
+  static constexpr std::size_t maxCachedBytes = 64 * 1024 * 1024; /**< Unused memory beyond this limit is freed. */
+  static constexpr std::size_t numOfSizeClasses = 4 * 40; /**< Four classes per power of two. */
+
+  static thread_local ImageBufferPool instance; /**< The pool of the current thread. */
+  static thread_local bool destroyed; /**< Was the pool of this thread already destroyed, e.g. during thread exit? */
+
+  std::array<std::vector<void*>, numOfSizeClasses> freeBuffers; /**< The unused buffers per size class. */
+  Statistics statistics; /**< The hits, misses, and cached bytes of this pool. */
+
+  ~ImageBufferPool();
+
+  /**
+   * Determines the size class that can hold a certain number of bytes.
+   * @param size The number of bytes requested.
+   * @param capacity The size of buffers in the size class is returned here.
+   * @return The index of the size class.
+   */
+  static std::size_t getSizeClass(std::size_t size, std::size_t& capacity);
+
+  /**
+   * Determines the size of the buffers in a size class.
+   * @param sizeClass The index of the size class.
+   * @return The size of its buffers in bytes.
+   */
+  static std::size_t getCapacity(std::size_t sizeClass);
+
+public:
+  /**
+   * Provides an uninitialized buffer.
+   * @param size The minimum size of the buffer in bytes.
+   * @param capacity The actual size of the buffer is returned here. It must
+   *                 be passed to release().
+   * @return The buffer, aligned to ImageBufferPool::alignment bytes.
+   */
+  static void* acquire(std::size_t size, std::size_t& capacity);
+
+  /**
+   * Returns a buffer to the pool of the current thread.
+   * @param buffer The buffer. nullptr is ignored.
+   * @param capacity The capacity returned when the buffer was acquired.
+   */
+  static void release(void* buffer, std::size_t capacity);
+
+  /**
+   * Returns the usage of the pool of the current thread.
+   * @return The hits and misses since the thread was started and the bytes
+   *         currently cached.
+   */
+  static Statistics getStatistics();
+};
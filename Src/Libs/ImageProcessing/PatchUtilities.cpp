@@ -7,8 +7,12 @@
 #include "Debugging/Stopwatch.h"
 #include "PatchUtilities.h"
 #include "ImageProcessing/ImageTransform.h"
+#include "ImageProcessing/SIMD.h"
+#include <algorithm>
+#include <array>
 #include <iostream>
 #include <cmath>
+#include <cstring>
 
 Matrix3f PatchUtilities::calcInverseTransformation(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize)
 {
@@ -45,7 +49,7 @@ void PatchUtilities::getInterpolatedImageSection(const Vector2i& center, const V
 }
 
 template<typename OutType, bool interpolate>
-void PatchUtilities::getImageSection(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* output)
+void PatchUtilities::getImageSection(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* output, unsigned* histogram)
 {
   const Vector2i upperLeft = (center.array() - inSize.array() / 2).matrix();
   const Vector2f stepSize = (inSize.cast<float>().array() / outSize.cast<float>().array()).matrix();
@@ -85,97 +89,137 @@ void PatchUtilities::getImageSection(const Vector2i& center, const Vector2i& inS
   {
     static constexpr unsigned char fillColor = 128;
     std::fill_n(output, outSize.x() * outSize.y(), static_cast<OutType>(fillColor));
+    if(histogram)
+      histogram[fillColor] += outSize.x() * outSize.y() - xSteps * ySteps;
+  }
+  if(!xSteps || !ySteps)
+    return;
+
+  // All rows are sampled at the same columns, so the column indices and weights are only computed once.
+  // They are accumulated exactly like the row positions to keep rounding identical in both directions.
+  thread_local std::vector<int> xIndices;
+  thread_local std::vector<float> xWeights;
+  xIndices.resize(xSteps);
+  if(interpolate)
+    xWeights.resize(xSteps);
+  float xImage = xImageOffset;
+  for(int i = 0; i < xSteps; xImage += stepSize.x(), ++i)
+  {
+    xIndices[i] = static_cast<int>(xImage);
+    if(interpolate)
+      xWeights[i] = xImage - static_cast<float>(xIndices[i]);
   }
 
   // Copy the patch
-  OutType* dest = output + yPatchOffset * outSize.x(); // Check x or y
-  if(xSteps < outSize.x())
+  OutType* dest = output + yPatchOffset * outSize.x() + xPatchOffset;
+  for(; ySteps; yImage += stepSize.y(), --ySteps, dest += outSize.x())
   {
-    const size_t xPatchSkip = outSize.x() - xSteps - xPatchOffset;
+    const size_t yIndex = static_cast<size_t>(yImage);
     if(!interpolate)
-    {
-      for(; ySteps; yImage += stepSize.y(), --ySteps)
-      {
-        const PixelTypes::GrayscaledPixel* row = src[static_cast<size_t>(yImage)];
+      sampleRow(src[yIndex], xIndices.data(), xSteps, dest, histogram);
+    else
+      sampleRow(src[yIndex], src[yIndex + 1], yImage - static_cast<float>(yIndex), xIndices.data(), xWeights.data(), xSteps, dest, histogram);
+  }
+}
 
-        dest += xPatchOffset;
-        float xImage = xImageOffset;
-        for(size_t n = xSteps; n; xImage += stepSize.x(), --n)
-          * dest++ = static_cast<OutType>(row[static_cast<size_t>(xImage)]);
-        dest += xPatchSkip;
-      }
-    }
+template<typename OutType>
+void PatchUtilities::sampleRow(const PixelTypes::GrayscaledPixel* row, const int* xIndices, int xSteps, OutType* dest, unsigned* histogram)
+{
+  for(int i = 0; i < xSteps; ++i)
+    dest[i] = static_cast<OutType>(row[xIndices[i]]);
+  if(histogram)
+    for(int i = 0; i < xSteps; ++i)
+      ++histogram[row[xIndices[i]]];
+}
+
+template<typename OutType>
+void PatchUtilities::sampleRow(const PixelTypes::GrayscaledPixel* row0, const PixelTypes::GrayscaledPixel* row1, float yWeight1, const int* xIndices, const float* xWeights, int xSteps, OutType* dest, unsigned* histogram)
+{
+  const float yWeight0 = 1 - yWeight1;
+  const __m128 yWeight0s = _mm_set1_ps(yWeight0);
+  const __m128 yWeight1s = _mm_set1_ps(yWeight1);
+  const __m128 ones = _mm_set1_ps(1.f);
+  const __m128 maxValues = _mm_set1_ps(255.f);
+
+  // Four pixels at once. The pixels must be gathered individually, but the weighting is done in parallel
+  // with the same order of operations as in the scalar code below.
+  int i = 0;
+  for(; i + 4 <= xSteps; i += 4)
+  {
+    const int* x = xIndices + i;
+    const __m128 p00 = _mm_setr_ps(row0[x[0]], row0[x[1]], row0[x[2]], row0[x[3]]);
+    const __m128 p01 = _mm_setr_ps(row0[x[0] + 1], row0[x[1] + 1], row0[x[2] + 1], row0[x[3] + 1]);
+    const __m128 p10 = _mm_setr_ps(row1[x[0]], row1[x[1]], row1[x[2]], row1[x[3]]);
+    const __m128 p11 = _mm_setr_ps(row1[x[0] + 1], row1[x[1] + 1], row1[x[2] + 1], row1[x[3] + 1]);
+    const __m128 xWeight1 = _mm_loadu_ps(xWeights + i);
+    const __m128 xWeight0 = _mm_sub_ps(ones, xWeight1);
+    const __m128 values = _mm_min_ps(maxValues,
+                                     _mm_add_ps(_mm_mul_ps(yWeight0s, _mm_add_ps(_mm_mul_ps(p00, xWeight0), _mm_mul_ps(p01, xWeight1))),
+                                                _mm_mul_ps(yWeight1s, _mm_add_ps(_mm_mul_ps(p10, xWeight0), _mm_mul_ps(p11, xWeight1)))));
+    if constexpr(std::is_same<OutType, float>::value)
+      _mm_storeu_ps(dest + i, values);
     else
     {
-      for(; ySteps; yImage += stepSize.y(), --ySteps)
-      {
-        const size_t yIndex = static_cast<size_t>(yImage);
-        const float yWeight1 = yImage - static_cast<float>(yIndex);
-        const float yWeight0 = 1 - yWeight1;
-        const PixelTypes::GrayscaledPixel* row0 = src[yIndex];
-        const PixelTypes::GrayscaledPixel* row1 = src[yIndex + 1];
-
-        dest += xPatchOffset;
-        float xImage = xImageOffset;
-        for(size_t n = xSteps; n; xImage += stepSize.x(), --n)
-        {
-          const size_t xIndex = static_cast<size_t>(xImage);
-          const float xWeight1 = xImage - static_cast<float>(xIndex);
-          const float xWeight0 = 1 - xWeight1;
-
-          *dest++ = static_cast<OutType>(
-                      std::min(
-                        255.f,
-                        yWeight0 * (static_cast<float>(row0[xIndex]) * xWeight0 + static_cast<float>(row0[xIndex + 1]) * xWeight1)
-                        + yWeight1 * (static_cast<float>(row1[xIndex]) * xWeight0 + static_cast<float>(row1[xIndex + 1]) * xWeight1)
-                      )
-                    );
-        }
-        dest += xPatchSkip;
-      }
+      static_assert(std::is_same<OutType, unsigned char>::value);
+      const __m128i ints = _mm_cvttps_epi32(values);
+      const int packed = _mm_cvtsi128_si32(_mm_packus_epi16(_mm_packs_epi32(ints, ints), _mm_setzero_si128()));
+      std::memcpy(dest + i, &packed, 4);
     }
   }
-  else
+
+  for(; i < xSteps; ++i)
   {
-    if(!interpolate)
-    {
-      for(; ySteps; yImage += stepSize.y(), --ySteps)
-      {
-        const PixelTypes::GrayscaledPixel* row = src[static_cast<size_t>(yImage)];
+    const int xIndex = xIndices[i];
+    const float xWeight1 = xWeights[i];
+    const float xWeight0 = 1 - xWeight1;
+    dest[i] = static_cast<OutType>(
+                std::min(
+                  255.f,
+                  yWeight0 * (static_cast<float>(row0[xIndex]) * xWeight0 + static_cast<float>(row0[xIndex + 1]) * xWeight1)
+                  + yWeight1 * (static_cast<float>(row1[xIndex]) * xWeight0 + static_cast<float>(row1[xIndex + 1]) * xWeight1)
+                )
+              );
+  }
 
-        float xImage = xImageOffset;
-        for(size_t n = xSteps; n; xImage += stepSize.x(), --n)
-          * dest++ = static_cast<OutType>(row[static_cast<size_t>(xImage)]);
-      }
-    }
-    else
-    {
-      for(; ySteps; yImage += stepSize.y(), --ySteps)
-      {
-        const size_t yIndex = static_cast<size_t>(yImage);
-        const float yWeight1 = yImage - static_cast<float>(yIndex);
-        const float yWeight0 = 1 - yWeight1;
-        const PixelTypes::GrayscaledPixel* row0 = src[yIndex];
-        const PixelTypes::GrayscaledPixel* row1 = src[yIndex + 1];
-
-        float xImage = xImageOffset;
-        for(size_t n = xSteps; n; xImage += stepSize.x(), --n)
-        {
-          const size_t xIndex = static_cast<size_t>(xImage);
-          const float xWeight1 = xImage - static_cast<float>(xIndex);
-          const float xWeight0 = 1 - xWeight1;
-
-          *dest++ = static_cast<OutType>(
-                      std::min(
-                        255.f,
-                        yWeight0 * (static_cast<float>(row0[xIndex]) * xWeight0 + static_cast<float>(row0[xIndex + 1]) * xWeight1)
-                        + yWeight1 * (static_cast<float>(row1[xIndex]) * xWeight0 + static_cast<float>(row1[xIndex + 1]) * xWeight1)
-                      )
-                    );
-        }
-      }
-    }
+  // Only integral outputs are counted (see extractPatch).
+  if constexpr(std::is_same<OutType, unsigned char>::value)
+    if(histogram)
+      for(i = 0; i < xSteps; ++i)
+        ++histogram[dest[i]];
+}
+
+template<typename OutType>
+void PatchUtilities::normalize(OutType* output, const Vector2i& size, const unsigned* histogram, const NormalizationMode normalization, const float percent)
+{
+  const int numOfPixels = size.x() * size.y();
+  if(numOfPixels == 0 || normalization == noNormalization)
+    return;
+
+  // Returns the value at a certain position in the ascendingly sorted pixels.
+  auto valueAt = [histogram](int rank)
+  {
+    int value = 0;
+    for(int count = static_cast<int>(histogram[0]); count <= rank; count += static_cast<int>(histogram[++value]));
+    return value;
+  };
+
+  std::array<OutType, 256> table;
+  if(normalization == contrastNormalization)
+  {
+    const int min = valueAt(static_cast<int>(static_cast<float>(numOfPixels - 1) * percent));
+    const int max = valueAt(static_cast<int>(static_cast<float>(numOfPixels - 1) * (1.f - percent)));
+    for(int value = 0; value < 256; ++value)
+      table[value] = max == min ? 0 : static_cast<OutType>(static_cast<float>(std::clamp(value, min, max) - min) * 255.f / static_cast<float>(max - min));
+  }
+  else
+  {
+    const int max = valueAt(numOfPixels - 1 - static_cast<int>(static_cast<float>(numOfPixels - 1) * percent));
+    for(int value = 0; value < 256; ++value)
+      table[value] = max == 0 ? 0 : static_cast<OutType>(static_cast<float>(std::min(value, max)) * 255.f / static_cast<float>(max));
   }
+
+  for(OutType* end = output + numOfPixels; output != end; ++output)
+    *output = table[static_cast<unsigned char>(*output)];
 }
 
 void PatchUtilities::normalizeContrast(GrayscaledImage& output, const float percent)
@@ -186,16 +230,31 @@ void PatchUtilities::normalizeContrast(GrayscaledImage& output, const float perc
 template<typename OutType>
 void PatchUtilities::normalizeContrast(OutType* output, const Vector2i& size, const float percent)
 {
-  Eigen::Map<Eigen::Matrix<OutType, Eigen::Dynamic, Eigen::Dynamic>> patch(output, size.x(), size.y());
-  Eigen::Matrix<OutType, Eigen::Dynamic, 1> sorted = Eigen::Map<Eigen::Matrix<OutType, Eigen::Dynamic, 1>>(patch.data(), size.x() * size.y());
-  std::sort(sorted.data(), sorted.data() + sorted.size());
-
-  OutType min = sorted(static_cast<int>((sorted.size() - 1) * percent));
-  OutType max = sorted(static_cast<int>((sorted.size() - 1) * (1.f - percent)));
-  if(max == 0)
-    patch.setConstant(0);
+  if constexpr(std::is_same<OutType, unsigned char>::value)
+  {
+    std::array<unsigned, 256> histogram;
+    calcHistogram(output, size, histogram.data());
+    normalize(output, size, histogram.data(), contrastNormalization, percent);
+  }
   else
-    patch.array() = ((patch.array().max(min).min(max) - min).template cast<float>() * 255.f / (static_cast<float>(max - min))).template cast<OutType>();
+  {
+    Eigen::Map<Eigen::Matrix<OutType, Eigen::Dynamic, Eigen::Dynamic>> patch(output, size.x(), size.y());
+    Eigen::Matrix<OutType, Eigen::Dynamic, 1> sorted = Eigen::Map<Eigen::Matrix<OutType, Eigen::Dynamic, 1>>(patch.data(), size.x() * size.y());
+    if(sorted.size() == 0)
+      return;
+
+    // Only two ranks are needed, so a full sort is not necessary.
+    OutType* const minPos = sorted.data() + static_cast<int>((sorted.size() - 1) * percent);
+    OutType* const maxPos = sorted.data() + static_cast<int>((sorted.size() - 1) * (1.f - percent));
+    std::nth_element(sorted.data(), minPos, sorted.data() + sorted.size());
+    const OutType min = *minPos;
+    std::nth_element(minPos, maxPos, sorted.data() + sorted.size());
+    const OutType max = *maxPos;
+    if(max == 0 || max == min)
+      patch.setConstant(0);
+    else
+      patch.array() = ((patch.array().max(min).min(max) - min).template cast<float>() * 255.f / (static_cast<float>(max - min))).template cast<OutType>();
+  }
 }
 
 template void PatchUtilities::normalizeContrast<float>(float* output, const Vector2i& size, const float percent);
@@ -209,24 +268,40 @@ void PatchUtilities::normalizeBrightness(GrayscaledImage& output, const float pe
 template<typename OutType>
 void PatchUtilities::normalizeBrightness(OutType* output, const Vector2i& size, const float percent)
 {
-  Eigen::Map<Eigen::Matrix<OutType, Eigen::Dynamic, Eigen::Dynamic>> patch(output, size.x(), size.y());
-  Eigen::Matrix<OutType, Eigen::Dynamic, 1> sorted = Eigen::Map<Eigen::Matrix<OutType, Eigen::Dynamic, 1>>(patch.data(), size.x() * size.y());
-  if(sorted.size() == 0)
-    return;
+  if constexpr(std::is_same<OutType, unsigned char>::value)
+  {
+    std::array<unsigned, 256> histogram;
+    calcHistogram(output, size, histogram.data());
+    normalize(output, size, histogram.data(), brightnessNormalization, percent);
+  }
+  else
+  {
+    Eigen::Map<Eigen::Matrix<OutType, Eigen::Dynamic, Eigen::Dynamic>> patch(output, size.x(), size.y());
+    Eigen::Matrix<OutType, Eigen::Dynamic, 1> sorted = Eigen::Map<Eigen::Matrix<OutType, Eigen::Dynamic, 1>>(patch.data(), size.x() * size.y());
+    if(sorted.size() == 0)
+      return;
 
-  std::partial_sort(sorted.data(), sorted.data() + static_cast<size_t>((sorted.size() - 1) * percent) + 1,
-                    sorted.data() + sorted.size(), std::greater<>());
+    OutType* const maxPos = sorted.data() + static_cast<size_t>((sorted.size() - 1) * percent);
+    std::nth_element(sorted.data(), maxPos, sorted.data() + sorted.size(), std::greater<>());
 
-  OutType max = sorted(static_cast<int>((sorted.size() - 1) * percent));
-  if(max == 0)
-    patch.setConstant(0);
-  else
-    patch.array() = (patch.array().min(max).template cast<float>() * 255.f / static_cast<float>(max)).template cast<OutType>();
+    const OutType max = *maxPos;
+    if(max == 0)
+      patch.setConstant(0);
+    else
+      patch.array() = (patch.array().min(max).template cast<float>() * 255.f / static_cast<float>(max)).template cast<OutType>();
+  }
 }
 
 template void PatchUtilities::normalizeBrightness<float>(float* output, const Vector2i& size, const float percent);
 template void PatchUtilities::normalizeBrightness<unsigned char>(unsigned char* output, const Vector2i& size, const float percent);
 
+void PatchUtilities::calcHistogram(const unsigned char* patch, const Vector2i& size, unsigned* histogram)
+{
+  std::fill_n(histogram, 256, 0u);
+  for(const unsigned char* end = patch + size.x() * size.y(); patch != end; ++patch)
+    ++histogram[*patch];
+}
+
 void PatchUtilities::extractPatch(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, GrayscaledImage& dest, const ExtractionMode mode)
 {
   dest.setResolution(static_cast<unsigned int>(outSize(0)), static_cast<unsigned int>(outSize(1)));
@@ -253,6 +328,49 @@ void PatchUtilities::extractPatch(const Vector2i& center, const Vector2i& inSize
 template void PatchUtilities::extractPatch<float>(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, float* dest, const ExtractionMode mode);
 template void PatchUtilities::extractPatch<unsigned char>(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, unsigned char* dest, const ExtractionMode mode);
 
+template<typename OutType>
+void PatchUtilities::extractPatch(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* dest, const ExtractionMode mode,
+                                  const NormalizationMode normalization, const float percent)
+{
+  // The histogram can only be collected during sampling if all values written are integral.
+  if(normalization == noNormalization || mode == interpolated || (mode == fastInterpolated && !std::is_same<OutType, unsigned char>::value))
+  {
+    extractPatch(center, inSize, outSize, src, dest, mode);
+    if(normalization == contrastNormalization)
+      normalizeContrast(dest, outSize, percent);
+    else if(normalization == brightnessNormalization)
+      normalizeBrightness(dest, outSize, percent);
+  }
+  else
+  {
+    std::array<unsigned, 256> histogram;
+    histogram.fill(0);
+    if(mode == fast)
+      getImageSection<OutType, false>(center, inSize, outSize, src, dest, histogram.data());
+    else
+      getImageSection<OutType, true>(center, inSize, outSize, src, dest, histogram.data());
+    normalize(dest, outSize, histogram.data(), normalization, percent);
+  }
+}
+
+template void PatchUtilities::extractPatch<float>(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, float* dest, const ExtractionMode mode, const NormalizationMode normalization, const float percent);
+template void PatchUtilities::extractPatch<unsigned char>(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, unsigned char* dest, const ExtractionMode mode, const NormalizationMode normalization, const float percent);
+
+template<typename OutType>
+void PatchUtilities::extractPatches(const std::vector<PatchRegion>& regions, const Vector2i& outSize, const GrayscaledImage& src, OutType* dest, const ExtractionMode mode,
+                                    const NormalizationMode normalization, const float percent)
+{
+  const int patchSize = outSize.x() * outSize.y();
+  for(const PatchRegion& region : regions)
+  {
+    extractPatch(region.center, region.inSize, outSize, src, dest, mode, normalization, percent);
+    dest += patchSize;
+  }
+}
+
+template void PatchUtilities::extractPatches<float>(const std::vector<PatchRegion>& regions, const Vector2i& outSize, const GrayscaledImage& src, float* dest, const ExtractionMode mode, const NormalizationMode normalization, const float percent);
+template void PatchUtilities::extractPatches<unsigned char>(const std::vector<PatchRegion>& regions, const Vector2i& outSize, const GrayscaledImage& src, unsigned char* dest, const ExtractionMode mode, const NormalizationMode normalization, const float percent);
+
 void PatchUtilities::extractPatch(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const YUYVImage& src, YUVImage& dest)
 {
   dest.setResolution(static_cast<unsigned int>(outSize(0)), static_cast<unsigned int>(outSize(1)));
@@ -9,6 +9,7 @@
 #include "ImageProcessing/Image.h"
 #include "Math/Eigen.h"
 #include "Streaming/Enum.h"
+#include <vector>
 
 class PatchUtilities
 {
@@ -20,6 +21,20 @@ public:
     interpolated,
   });
 
+  ENUM(NormalizationMode,
+  {,
+    noNormalization,
+    contrastNormalization,
+    brightnessNormalization,
+  });
+
+  /** An area of an image from which a patch is extracted. */
+  struct PatchRegion
+  {
+    Vector2i center; /**< The center of the area in image coordinates. */
+    Vector2i inSize; /**< The size of the area in the image. */
+  };
+
   template<typename OutType>
   static void normalizeContrast(OutType* output, const Vector2i& size, const float percent = 0.02f);
   static void normalizeContrast(GrayscaledImage& output, const float percent = 0.02f);
@@ -32,6 +47,25 @@ public:
   static void extractPatch(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* dest, const ExtractionMode mode = fast);
   static void extractPatch(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, GrayscaledImage& dest, const ExtractionMode mode = fast);
 
+  /**
+   * Extracts a patch and normalizes it. In the modes fast and fastInterpolated (the latter only
+   * for unsigned char), the histogram for the normalization is collected while sampling, so that
+   * no additional sorting pass over the patch is required. The result is the same as extracting
+   * the patch and calling normalizeContrast or normalizeBrightness afterwards.
+   */
+  template<typename OutType>
+  static void extractPatch(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* dest, const ExtractionMode mode,
+                           const NormalizationMode normalization, const float percent = 0.02f);
+
+  /**
+   * Extracts multiple patches of the same output size from an image. The patches are written
+   * one after another to dest, which must provide space for regions.size() * outSize.x() * outSize.y()
+   * values, i.e. the layout of a batched network input.
+   */
+  template<typename OutType>
+  static void extractPatches(const std::vector<PatchRegion>& regions, const Vector2i& outSize, const GrayscaledImage& src, OutType* dest, const ExtractionMode mode = fast,
+                             const NormalizationMode normalization = noNormalization, const float percent = 0.02f);
+
   // This methods only work correctly if the image dimensions are multiples of the patch size.
   template<typename OutType, bool grayscale>
   static void extractInput(const YUYVImage& cameraImage, const Vector2i& patchSize, OutType* input);
@@ -39,8 +73,28 @@ public:
 
   static void extractPatch(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const YUYVImage& src, YUVImage& dest);
 private:
+  /**
+   * Samples an image section. Values are copied from the nearest pixel or interpolated bilinearly.
+   * If the results of the interpolation are written as float, they are not counted in the histogram.
+   * @param histogram If not nullptr, the histogram of all values written is added to this array of 256 entries.
+   */
   template<typename OutType, bool interpolate = false>
-  static void getImageSection(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* output);
+  static void getImageSection(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* output, unsigned* histogram = nullptr);
+
+  /** Copies the nearest pixels of a row at the given columns. */
+  template<typename OutType>
+  static void sampleRow(const PixelTypes::GrayscaledPixel* row, const int* xIndices, int xSteps, OutType* dest, unsigned* histogram);
+
+  /** Interpolates bilinearly between two rows at the given columns. */
+  template<typename OutType>
+  static void sampleRow(const PixelTypes::GrayscaledPixel* row0, const PixelTypes::GrayscaledPixel* row1, float yWeight1, const int* xIndices, const float* xWeights, int xSteps,
+                        OutType* dest, unsigned* histogram);
+
+  /** Maps the values of a patch with a lookup table computed from its histogram. All values must be integral. */
+  template<typename OutType>
+  static void normalize(OutType* output, const Vector2i& size, const unsigned* histogram, const NormalizationMode normalization, const float percent);
+
+  static void calcHistogram(const unsigned char* patch, const Vector2i& size, unsigned* histogram);
 
   template<typename OutType>
   static void getInterpolatedImageSection(const Vector2i& center, const Vector2i& inSize, const Vector2i& outSize, const GrayscaledImage& src, OutType* output);
@@ -14,6 +14,7 @@
 #pragma once
 
 #include "LogPlayer.h"
+#include <cstring>
 
 class Log
 {
@@ -89,7 +90,7 @@ public:
      */
     template<typename T> operator const T&() const
     {
-      ASSERT(TypeRegistry::getEnumName(id()) + 2 == TypeRegistry::demangle(typeid(T).name()));
+      ASSERT(std::strcmp(TypeRegistry::getEnumName(id()) + 2, TypeRegistry::getName<T>()) == 0);
       if(!representation)
       {
         representation = new T;
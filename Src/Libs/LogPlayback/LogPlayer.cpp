@@ -511,3 +511,12 @@ std::string LogPlayer::threadOf(size_t frame) const
   }
   return thread;
 }
+
+std::vector<std::string> LogPlayer::threads() const
+{
+  std::vector<std::string> threads;
+  for(const auto& [threadName, _] : statsPerThread)
+    if(!threadName.empty())
+      threads.push_back(threadName);
+  return threads;
+}
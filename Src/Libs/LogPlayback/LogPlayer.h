@@ -222,6 +222,14 @@ public:
    */
   void playBack(size_t frame);
 
+  /**
+   * Sets the number of the frame that is regarded as the one that was played
+   * back last without actually playing it back. This is used if the state of
+   * the replay was restored otherwise.
+   * @param frame The number of the frame or \c size_t(-1).
+   */
+  void setFrame(size_t frame) {currentFrame = frame;}
+
   /**
    * Returns the next frame containing an image after a certain frame.
    * If \c cycle is true, this might wrap around the end of the log.
@@ -248,6 +256,12 @@ public:
    */
   std::string threadOf(size_t frame) const;
 
+  /**
+   * Returns the names of all threads that have frames in the log.
+   * @return The names of the threads.
+   */
+  std::vector<std::string> threads() const;
+
   /** Request that the type information will be inserted into the target queue. */
   void requestTypeInfo() {typeInfoRequested = true;}
 };
@@ -22,6 +22,24 @@ template<typename T, int N> struct EigenMatrixRow
   T elems[N]; /**< The elements of the row or column. */
 };
 
+/** The names of the Eigen types have integral template parameters. */
+namespace Streaming
+{
+  template<typename T, int N> struct TypeName<EigenMatrixRow<T, N>>
+    : TypeNameWithValues<EigenMatrixRow<T, N>, T, N> {};
+
+  template<typename T, int ROWS, int COLS, int OPTIONS, int MAX_ROWS, int MAX_COLS>
+  struct TypeName<Eigen::Matrix<T, ROWS, COLS, OPTIONS, MAX_ROWS, MAX_COLS>>
+    : TypeNameWithValues<Eigen::Matrix<T, ROWS, COLS, OPTIONS, MAX_ROWS, MAX_COLS>, T, ROWS, COLS, OPTIONS, MAX_ROWS, MAX_COLS> {};
+
+  template<typename T, int ROWS, int COLS, int OPTIONS, int MAX_ROWS, int MAX_COLS>
+  struct TypeName<Eigen::Array<T, ROWS, COLS, OPTIONS, MAX_ROWS, MAX_COLS>>
+    : TypeNameWithValues<Eigen::Array<T, ROWS, COLS, OPTIONS, MAX_ROWS, MAX_COLS>, T, ROWS, COLS, OPTIONS, MAX_ROWS, MAX_COLS> {};
+
+  template<typename T, int OPTIONS> struct TypeName<Eigen::Quaternion<T, OPTIONS>>
+    : TypeNameWithValues<Eigen::Quaternion<T, OPTIONS>, T, OPTIONS> {};
+}
+
 /**
  * Register an Eigen matrix row.
  * @tparam T The type of the elements.
@@ -160,7 +178,7 @@ In& operator>>(In& stream, Eigen::Matrix<T, ROWS, COLS, OPTIONS, MAX_ROWS, MAX_C
 template<typename T, int ROWS, int COLS, int OPTIONS> void regMatrix1()
 {
   REG_CLASS(Eigen::Matrix<T, ROWS, COLS, OPTIONS, ROWS, COLS>);
-  REG(T (*)[ROWS > COLS ? ROWS : COLS], elems);
+  REG(T (*)[(ROWS > COLS ? ROWS : COLS)], elems);
 }
 
 /**
@@ -5,6 +5,78 @@
 #else
 #include <cstdlib>
 #endif
+#ifdef __linux__
+#include <cstdint>
+#include <sys/mman.h>
+#endif
+
+#ifdef CHECK_ALLOCATIONS
+#include "Platform/BHAssert.h"
+#include <new>
+
+/** The number of NoAllocationScopes the current thread is in. */
+static thread_local unsigned noAllocationDepth = 0;
+
+/**
+ * Allocates memory and aborts if this is not allowed in the current thread.
+ * @param size The number of bytes to allocate.
+ * @param alignment The alignment of the memory returned.
+ * @return The memory allocated.
+ */
+static void* checkedAlloc(size_t size, size_t alignment)
+{
+  if(noAllocationDepth)
+  {
+    noAllocationDepth = 0; // Reporting might allocate itself.
+    Assert::print(__FILE__, __LINE__, "Heap allocation of %u bytes in a NoAllocationScope", static_cast<unsigned>(size));
+    Assert::abort();
+  }
+  void* ptr = Memory::alignedMalloc(size ? size : 1, alignment < alignof(std::max_align_t) ? alignof(std::max_align_t) : alignment);
+  if(!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void* operator new(size_t size) {return checkedAlloc(size, alignof(std::max_align_t));}
+void* operator new[](size_t size) {return checkedAlloc(size, alignof(std::max_align_t));}
+void* operator new(size_t size, std::align_val_t alignment) {return checkedAlloc(size, static_cast<size_t>(alignment));}
+void* operator new[](size_t size, std::align_val_t alignment) {return checkedAlloc(size, static_cast<size_t>(alignment));}
+void operator delete(void* ptr) noexcept {Memory::alignedFree(ptr);}
+void operator delete[](void* ptr) noexcept {Memory::alignedFree(ptr);}
+void operator delete(void* ptr, size_t) noexcept {Memory::alignedFree(ptr);}
+void operator delete[](void* ptr, size_t) noexcept {Memory::alignedFree(ptr);}
+void operator delete(void* ptr, std::align_val_t) noexcept {Memory::alignedFree(ptr);}
+void operator delete[](void* ptr, std::align_val_t) noexcept {Memory::alignedFree(ptr);}
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept {Memory::alignedFree(ptr);}
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept {Memory::alignedFree(ptr);}
+
+Memory::NoAllocationScope::NoAllocationScope()
+{
+  ++noAllocationDepth;
+}
+
+Memory::NoAllocationScope::~NoAllocationScope()
+{
+  if(noAllocationDepth)
+    --noAllocationDepth;
+}
+
+Memory::AllowAllocationScope::AllowAllocationScope() :
+  depth(noAllocationDepth)
+{
+  noAllocationDepth = 0;
+}
+
+Memory::AllowAllocationScope::~AllowAllocationScope()
+{
+  noAllocationDepth = depth;
+}
+#else
+Memory::NoAllocationScope::NoAllocationScope() = default;
+Memory::NoAllocationScope::~NoAllocationScope() = default;
+Memory::AllowAllocationScope::AllowAllocationScope() = default;
+Memory::AllowAllocationScope::~AllowAllocationScope() = default;
+#endif
 
 void* Memory::alignedMalloc(size_t size, size_t alignment)
 {
@@ -27,3 +99,65 @@ void Memory::alignedFree(void* ptr)
   free(ptr);
 #endif
 }
+
+/** The size of a huge page on x86-64 and on ARM with 4 KiB pages. */
+static constexpr size_t hugePageSize = 2 * 1024 * 1024;
+
+/**
+ * Is a buffer backed by huge pages? Smaller buffers would waste too much memory.
+ * @param size The size of the buffer in bytes.
+ * @return Is it allocated with mmap rather than from the heap?
+ */
+static bool usesHugePages(size_t size)
+{
+#ifdef __linux__
+  return size >= hugePageSize / 2;
+#else
+  static_cast<void>(size);
+  return false;
+#endif
+}
+
+void* Memory::hugePageMalloc(size_t size)
+{
+  if(!usesHugePages(size))
+    return alignedMalloc(size, 64);
+#ifdef __linux__
+  const size_t roundedSize = (size + hugePageSize - 1) & ~(hugePageSize - 1);
+
+  // Explicit huge pages only exist if the system reserved them.
+  void* ptr = mmap(nullptr, roundedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if(ptr != MAP_FAILED)
+    return ptr;
+
+  // Otherwise, a region aligned to the huge page size is mapped, so that the
+  // kernel can back it with transparent huge pages if they are enabled.
+  char* region = static_cast<char*>(mmap(nullptr, roundedSize + hugePageSize, PROT_READ | PROT_WRITE,
+                                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+  if(region == MAP_FAILED)
+    return nullptr;
+  char* aligned = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(region) + hugePageSize - 1) & ~(hugePageSize - 1));
+  if(aligned > region)
+    munmap(region, aligned - region);
+  if(aligned < region + hugePageSize)
+    munmap(aligned + roundedSize, region + hugePageSize - aligned);
+#ifdef MADV_HUGEPAGE
+  madvise(aligned, roundedSize, MADV_HUGEPAGE);
+#endif
+  return aligned;
+#else
+  return nullptr;
+#endif
+}
+
+void Memory::hugePageFree(void* ptr, size_t size)
+{
+  if(!ptr)
+    return;
+  else if(!usesHugePages(size))
+    alignedFree(ptr);
+#ifdef __linux__
+  else
+    munmap(ptr, (size + hugePageSize - 1) & ~(hugePageSize - 1));
+#endif
+}
@@ -9,4 +9,59 @@ namespace Memory
 
   /** Free aligned memory. */
   void alignedFree(void* ptr);
+
+  /**
+   * Allocate a large buffer that lives long and is accessed often. On Linux,
+   * buffers of at least 1 MiB are backed by huge pages if possible to reduce
+   * TLB misses: explicit huge pages if the system reserved some
+   * (vm.nr_hugepages), otherwise transparent huge pages are requested. The
+   * memory is then rounded up to multiples of 2 MiB. Smaller buffers and
+   * other platforms use normal aligned memory.
+   * @param size The size of the buffer in bytes.
+   * @return The buffer, aligned to at least 64 bytes, or nullptr if no memory is left.
+   */
+  void* hugePageMalloc(size_t size);
+
+  /**
+   * Free a buffer allocated by hugePageMalloc.
+   * @param ptr The buffer. nullptr is ignored.
+   * @param size The size that was passed to hugePageMalloc.
+   */
+  void hugePageFree(void* ptr, size_t size);
+
+  /**
+   * While an object of this class exists, the current thread must not allocate
+   * memory from the heap. This is only checked if CHECK_ALLOCATIONS is defined
+   * when compiling this library (CMake option CHECK_ALLOCATIONS), which
+   * replaces the global operator new. Any
+   * allocation is then reported and the program is aborted. Otherwise, the
+   * class does nothing.
+   */
+  class NoAllocationScope
+  {
+  public:
+    NoAllocationScope();
+    ~NoAllocationScope();
+    NoAllocationScope(const NoAllocationScope&) = delete;
+    NoAllocationScope& operator=(const NoAllocationScope&) = delete;
+  };
+
+  /**
+   * While an object of this class exists, the current thread may allocate memory
+   * from the heap again, even inside a NoAllocationScope. This is meant for code
+   * that is not part of the regular cycle, e.g. reporting errors or registering
+   * debug requests when they are reached for the first time.
+   */
+  class AllowAllocationScope
+  {
+#ifdef CHECK_ALLOCATIONS
+    unsigned depth; /**< The number of NoAllocationScopes the thread was in. */
+#endif
+
+  public:
+    AllowAllocationScope();
+    ~AllowAllocationScope();
+    AllowAllocationScope(const AllowAllocationScope&) = delete;
+    AllowAllocationScope& operator=(const AllowAllocationScope&) = delete;
+  };
 }
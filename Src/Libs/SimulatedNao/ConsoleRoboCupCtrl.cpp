@@ -1068,6 +1068,7 @@ void ConsoleRoboCupCtrl::createCompletion()
     "log backward image",
     "log repeat",
     "log goto",
+    "log checkpoints",
     "mr modules",
     "mr save",
     "msg off",
@@ -27,7 +27,7 @@ public:
    */
   ControllerRobot(const Settings& settings, const std::string& name, ConsoleRoboCupCtrl* ctrl, const std::string& logFile = std::string()) :
     Robot(settings, name),
-    robotConsole(new LocalConsole(settings, name, ctrl, logFile, static_cast<Debug*>(front())))
+    robotConsole(new LocalConsole(settings, name, ctrl, logFile, static_cast<Debug*>(front()), getReplayBarrier()))
   {
     push_back(robotConsole);
   }
@@ -17,12 +17,14 @@
 #include "Representations/Sensing/GroundContactState.h"
 #include "Framework/Debug.h"
 
-LocalConsole::LocalConsole(const Settings& settings, const std::string& robotName, ConsoleRoboCupCtrl* ctrl, const std::string& logFile, Debug* debug) :
+LocalConsole::LocalConsole(const Settings& settings, const std::string& robotName, ConsoleRoboCupCtrl* ctrl, const std::string& logFile, Debug* debug,
+                           LogReplayBarrier& replayBarrier) :
   RobotConsole(settings, robotName, ctrl,
                logFile.empty() ? SystemCall::simulatedRobot : logFile == "remote" ? SystemCall::remoteRobot : SystemCall::logFileReplay,
                connectReceiverWithRobot(debug), connectSenderWithRobot(debug)),
   updatedSignal(1)
 {
+  this->replayBarrier = &replayBarrier;
   addPerRobotViews();
 
   if(mode == SystemCall::remoteRobot)
@@ -183,16 +185,7 @@ void LocalConsole::update()
     }
     else if(mode == SystemCall::logFileReplay)
     {
-      if(logPlayer.state == LogPlayer::playing && (logPlayer.cycle || logPlayer.frame() + 1 < logPlayer.frames()))
-      {
-        const std::string threadName = logPlayer.threadOf(logPlayer.frame() +  1);
-        if(threadName != "" && threadData[threadName].logAcknowledged)
-        {
-          logPlayer.playBack(logPlayer.frame() + 1);
-          threadData[threadName].currentFrame = logPlayer.frame();
-          threadData[threadName].logAcknowledged = false;
-        }
-      }
+      continueLogReplay();
       if(simulatedRobot)
       {
         if(RobotConsole::jointSensorData.timestamp)
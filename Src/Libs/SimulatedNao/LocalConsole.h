@@ -61,8 +61,10 @@ public:
    * @param ctrl A pointer to the controller object.
    * @param logFile The log file name to replay or an empty string to create a simulated robot.
    * @param debug The debug connection of the robot with the simulator.
+   * @param replayBarrier The barrier that synchronizes the threads of the robot during log replay.
    */
-  LocalConsole(const Settings& settings, const std::string& robotName, ConsoleRoboCupCtrl* ctrl, const std::string& logFile, Debug* debug);
+  LocalConsole(const Settings& settings, const std::string& robotName, ConsoleRoboCupCtrl* ctrl, const std::string& logFile, Debug* debug,
+               LogReplayBarrier& replayBarrier);
 
   /**
    * The function is called once before the first main().
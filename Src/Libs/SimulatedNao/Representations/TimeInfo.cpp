@@ -75,6 +75,23 @@ bool TimeInfo::handleMessage(MessageQueue::Message message, bool justReadNames)
 
     lastFrameNo = frameNo;
     lastStartTime = threadStartTime;
+
+    // Statistics of memoized functions (not in older log files)
+    if(!stream.eof())
+    {
+      unsigned short callsCount;
+      stream >> callsCount;
+      for(int i = 0; i < callsCount; ++i)
+      {
+        unsigned short watchId;
+        unsigned hits, calls;
+        stream >> watchId >> hits >> calls;
+        Info& info = infos[watchId];
+        info.hits.push_front(static_cast<float>(hits));
+        info.calls.push_front(static_cast<float>(calls));
+        info.timestamp = Time::getCurrentSystemTime();
+      }
+    }
     return true;
   }
   else
@@ -88,6 +105,11 @@ void TimeInfo::getStatistics(const Info& info, float& minTime, float& maxTime, f
   maxTime = info.maximum() / 1000.0f;
 }
 
+float TimeInfo::getHitRate(const Info& info) const
+{
+  return info.calls.sum() > 0.f ? info.hits.sum() * 100.f / info.calls.sum() : -1.f;
+}
+
 void TimeInfo::getThreadStatistics(float& outAvgFreq, float& outMin, float& outMax) const
 {
   outAvgFreq = threadDeltas.sum() != 0.f ? 1000.0f / threadDeltas.average() : 0.f;
@@ -18,6 +18,8 @@ class InfoWithTimestamp : public RingBufferWithSum<float, 100>
 {
 public:
   unsigned int timestamp = 0;
+  RingBufferWithSum<float, 100> hits; /**< Calls of a memoized function answered from its cache per frame. */
+  RingBufferWithSum<float, 100> calls; /**< Calls of a memoized function per frame. */
 };
 
 /**
@@ -70,6 +72,14 @@ public:
    */
   void getStatistics(const Info& info, float& outMinTime, float& outMaxTime, float& outAvgTime) const;
 
+  /**
+   * The function returns the hit rate of a memoized function.
+   * @param info Information on the stop watch to query.
+   * @return The ratio of calls answered from the cache in percent or -1 if
+   *         the stop watch does not belong to a memoized function.
+   */
+  float getHitRate(const Info& info) const;
+
   /**
    * Returns the frequency of the process attached to this time info.
    */
@@ -11,6 +11,7 @@
 #include "ConsoleRoboCupCtrl.h"
 #include "Debugging/DebugDataStreamer.h"
 #include "Framework/LoggingTools.h"
+#include "Framework/LogReplayBarrier.h"
 #include "Framework/Settings.h"
 #include "LogPlayback/ImageExport.h"
 #include "Platform/File.h"
@@ -860,16 +861,46 @@ bool RobotConsole::handleMessage(MessageQueue::Message message)
     {
       if(polled[idDrawingManager] && !waitingFor[idDrawingManager]) // drawing manager not up-to-date
       {
+        // Older versions send every shape in a separate message.
         ThreadData& data = threadData[threadName];
         char shapeType, id;
         stream >> shapeType >> id;
         const char* name = data.drawingManager.getDrawingName(id); // const char* is required here
-        std::string type = data.drawingManager.getDrawingType(name);
+        const std::string type = data.drawingManager.getDrawingType(name);
 
-        if(type == "drawingOnImage")
-          incompleteImageDrawings[name].addShapeFromQueue(stream, static_cast<::Drawings::ShapeType>(shapeType));
-        else if(type == "drawingOnField")
-          incompleteFieldDrawings[name].addShapeFromQueue(stream, static_cast<::Drawings::ShapeType>(shapeType));
+        DebugDrawing* drawing = type == "drawingOnImage" ? &incompleteImageDrawings[name]
+                                : type == "drawingOnField" ? &incompleteFieldDrawings[name] : nullptr;
+        if(drawing)
+        {
+          drawing->addToHash(message.data(), message.size());
+          drawing->addShapeFromQueue(stream, static_cast<::Drawings::ShapeType>(shapeType));
+        }
+      }
+      return true;
+    }
+    case idDebugDrawingShapes:
+    {
+      if(polled[idDrawingManager] && !waitingFor[idDrawingManager]) // drawing manager not up-to-date
+      {
+        // A message contains all shapes of a single drawing from one frame.
+        ThreadData& data = threadData[threadName];
+        char id;
+        stream >> id;
+        const char* name = data.drawingManager.getDrawingName(id); // const char* is required here
+        const std::string type = data.drawingManager.getDrawingType(name);
+
+        DebugDrawing* drawing = type == "drawingOnImage" ? &incompleteImageDrawings[name]
+                                : type == "drawingOnField" ? &incompleteFieldDrawings[name] : nullptr;
+        if(drawing)
+        {
+          drawing->addToHash(message.data(), message.size());
+          while(!stream.eof())
+          {
+            char shapeType;
+            stream >> shapeType;
+            drawing->addShapeFromQueue(stream, static_cast<::Drawings::ShapeType>(shapeType));
+          }
+        }
       }
       return true;
     }
@@ -932,9 +963,6 @@ bool RobotConsole::handleMessage(MessageQueue::Message message)
       --waitingFor[idDrawingManager3D];
       return true;
     }
-    case idLogResponse:
-      threadData[threadName].logAcknowledged = true;
-      return true;
     case idModuleTable:
     {
       SYNC_WITH(*ctrl);
@@ -948,16 +976,37 @@ bool RobotConsole::handleMessage(MessageQueue::Message message)
     }
     case idPlot:
     {
-      std::string id;
+      // A single value, e.g. from older versions or STOPWATCH.
       float value;
-      stream >> id >> value;
-      Plot& plot = threadData[threadName].plots[ctrl->translate(id)];
-      plot.points.push_back(value);
-      while(plot.points.size() > maxPlotSize)
-        plot.points.pop_front();
+      stream >> plotId >> value;
+      Plot& plot = threadData[threadName].plots[ctrl->translate(plotId)];
+      plot.points.setCapacity(maxPlotSize);
+      plot.points.add(value);
       plot.timestamp = Time::getCurrentSystemTime();
       return true;
     }
+    case idPlotValues:
+    {
+      ThreadData& data = threadData[threadName];
+      const unsigned timestamp = Time::getCurrentSystemTime();
+      while(!stream.eof())
+      {
+        unsigned numOfValues;
+        stream >> plotId >> numOfValues;
+        Plot*& plot = data.plotsById[plotId];
+        if(!plot)
+          plot = &data.plots[ctrl->translate(plotId)];
+        plot->points.setCapacity(maxPlotSize);
+        for(unsigned i = 0; i < numOfValues; ++i)
+        {
+          float value;
+          stream >> value;
+          plot->points.add(value);
+        }
+        plot->timestamp = timestamp;
+      }
+      return true;
+    }
     case idRobotName:
     {
       stream >> Global::getSettings().headName
@@ -1016,6 +1065,104 @@ void RobotConsole::updateAnnotationsFromLog()
   }
 }
 
+void RobotConsole::continueLogReplay()
+{
+  if(checkpointToRestore != static_cast<size_t>(-1))
+  {
+    // Restore only after all threads processed their frames, because frames
+    // they did not process yet would be applied to the restored states.
+    const std::vector<std::string> threads = logPlayer.threads();
+    for(const std::string& thread : threads)
+      if(!replayBarrier->mayFeed(thread))
+        return;
+    for(const std::string& thread : threads)
+    {
+      debugSender->bin(idThread) << thread;
+      debugSender->bin(idLogCheckpoint) << true << static_cast<unsigned>(checkpointToRestore);
+    }
+    logPlayer.setFrame(checkpointToRestore - 1);
+    checkpointToRestore = -1;
+    checkpointInProgress = -1;
+    replayConsistent = true;
+  }
+
+  const bool seeking = seekTarget != static_cast<size_t>(-1);
+  while(seeking ? logPlayer.frame() != seekTarget
+        : logPlayer.state == LogPlayer::playing && (logPlayer.cycle || logPlayer.frame() + 1 < logPlayer.frames()))
+  {
+    const size_t frame = logPlayer.frame() + 1 < logPlayer.frames() ? logPlayer.frame() + 1 : 0;
+
+    // Start each pass through the log with the states the modules had at its beginning.
+    if(frame == 0 && checkpoints.count(0) && (logPlayer.frame() != static_cast<size_t>(-1) || !replayConsistent))
+    {
+      checkpointToRestore = 0;
+      return;
+    }
+
+    // Frames are fed in the order of the log as long as their threads are ready for them.
+    const std::string threadName = logPlayer.threadOf(frame);
+    if(threadName.empty() || !replayBarrier->mayFeed(threadName))
+      break;
+
+    if(frame == 0)
+      replayConsistent = true;
+    if(replayConsistent && checkpointInterval && frame % checkpointInterval == 0 && !checkpoints.count(frame))
+    {
+      // A checkpoint still in progress is abandoned, because some thread did not run since.
+      checkpointInProgress = frame;
+      const std::vector<std::string> threads = logPlayer.threads();
+      threadsToCheckpoint = std::unordered_set<std::string>(threads.begin(), threads.end());
+    }
+
+    // Each thread saves the checkpoint before it processes its first frame that is not before the checkpoint.
+    if(checkpointInProgress != static_cast<size_t>(-1) && threadsToCheckpoint.erase(threadName))
+    {
+      debugSender->bin(idThread) << threadName;
+      debugSender->bin(idLogCheckpoint) << false << static_cast<unsigned>(checkpointInProgress);
+      if(threadsToCheckpoint.empty())
+      {
+        checkpoints.insert(checkpointInProgress);
+        checkpointInProgress = -1;
+      }
+    }
+
+    logPlayer.playBack(frame);
+    threadData[threadName].currentFrame = logPlayer.frame();
+    replayBarrier->feed(threadName);
+  }
+
+  if(seeking && logPlayer.frame() == seekTarget)
+    seekTarget = -1;
+}
+
+void RobotConsole::seekLogFrame(size_t targetFrame)
+{
+  seekTarget = -1;
+  checkpointToRestore = -1;
+  if(!logPlayer.frames())
+    return;
+
+  targetFrame = std::min(targetFrame, logPlayer.frames() - 1);
+  auto checkpoint = checkpoints.upper_bound(targetFrame);
+  if(checkpoint != checkpoints.begin())
+  {
+    // Continue from the current frame if this is not slower than from the checkpoint.
+    --checkpoint;
+    const size_t nextFrame = logPlayer.frame() + 1;
+    if(!replayConsistent || targetFrame < nextFrame || *checkpoint > nextFrame)
+      checkpointToRestore = *checkpoint;
+    seekTarget = targetFrame;
+  }
+  else
+  {
+    // Without a checkpoint, only a few frames before the target are replayed.
+    size_t frame = logPlayer.prevImageFrame(logPlayer.prevImageFrame(targetFrame));
+    while(frame <= targetFrame)
+      logPlayer.playBack(frame++);
+    replayConsistent = false;
+  }
+}
+
 bool RobotConsole::poll(MessageID id)
 {
   if(moduleRequestChanged && (id == idDebugResponse || id == idDrawingManager || id == idDrawingManager3D))
@@ -1513,7 +1660,11 @@ bool RobotConsole::log(In& stream)
       SYNC;
       logPlayer.state = LogPlayer::stopped;
       if(mode == SystemCall::logFileReplay)
+      {
         logPlayer.playBack(-1);
+        seekTarget = -1;
+        replayConsistent = false;
+      }
     }
     else if(command == "clear" && mode != SystemCall::logFileReplay)
     {
@@ -1800,6 +1951,9 @@ bool RobotConsole::log(In& stream)
           {
             logFile = option;
             updateAnnotationsFromLog();
+            checkpoints.clear();
+            checkpointInProgress = seekTarget = checkpointToRestore = -1;
+            replayConsistent = false;
           }
           else
             return false;
@@ -1809,10 +1963,22 @@ bool RobotConsole::log(In& stream)
         logPlayer.cycle = true;
       else if(command == "once")
         logPlayer.cycle = false;
+      else if(command == "checkpoints")
+      {
+        checkpointInterval = option == "off" ? 0 : std::stoul(option);
+        checkpointInProgress = -1;
+      }
       else
       {
         auto state = logPlayer.state;
         logPlayer.state = LogPlayer::stopped;
+        seekTarget = -1;
+        if(command != "goto" && command != "pause")
+        {
+          // Frames played back without waiting for the robot code might be skipped by it.
+          replayConsistent = false;
+          checkpointInProgress = -1;
+        }
         if(command == "forward" && option == "fast")
           logPlayer.playBack(logPlayer.frame() + 100);
         else if(command == "forward" && option == "image")
@@ -1828,12 +1994,7 @@ bool RobotConsole::log(In& stream)
         else if(command == "repeat")
           logPlayer.playBack(logPlayer.frame());
         else if(command == "goto")
-        {
-          const size_t targetFrame = std::stoul(option);
-          size_t frame = logPlayer.prevImageFrame(logPlayer.prevImageFrame(targetFrame));
-          while(frame <= targetFrame)
-            logPlayer.playBack(frame++);
-        }
+          seekLogFrame(std::stoul(option));
         else if(command != "pause")
         {
           logPlayer.state = state;
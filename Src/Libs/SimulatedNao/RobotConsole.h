@@ -36,12 +36,16 @@
 #include "Visualization/DebugDrawing3D.h"
 #include "Visualization/DebugDrawing3DAdapter.h"
 #include "Visualization/DebugImageConverter.h"
+#include "Visualization/PlotHistory.h"
 
 #include <QString>
 #include <list>
+#include <set>
+#include <unordered_set>
 
 class ConsoleRoboCupCtrl;
 class ImageView;
+class LogReplayBarrier;
 class SimulatedRobot;
 
 /**
@@ -87,7 +91,7 @@ public:
 
   struct Plot
   {
-    std::list<float> points;
+    PlotHistory points;
     unsigned timestamp = 0;
   };
 
@@ -109,12 +113,12 @@ public:
     Drawings fieldDrawings; /**< Drawings on the field. */
     DrawingAdapters3D drawings3D; /**< Drawings in the scene view. */
     Plots plots; /**< Buffers for plots. */
+    std::unordered_map<std::string, Plot*> plotsById; /**< Plots by their untranslated names as sent by the thread. */
     AnnotationInfo annotationInfo; /**< Annotations collected so far or all from a log file. */
     DebugRequestTable debugRequestTable; /**< Debug requests available in this thread. */
     DebugDataInfos debugDataInfos; /**< All debug data information in this thread. */
     std::unordered_map<std::string, DataView*> dataViews; /**< The map of all data views for this thread. */
     std::string getOrSetWaitsFor; /**< The name of the representation get or set are waiting for. If empty, they are not waiting for any. */
-    bool logAcknowledged = true; /**< The flag is true whenever log data sent to the robot code was processed. */
     size_t currentFrame = 0; /**< The last frame that was played back for this thread (log replay only). */
   };
 
@@ -174,6 +178,7 @@ public:
 
 protected:
   LogPlayer logPlayer; /**< The log player to record and replay log files. */
+  LogReplayBarrier* replayBarrier = nullptr; /**< Synchronizes feeding log frames with the threads replaying them (local robots only). */
   const char* pollingFor = nullptr; /**< The information the console is waiting for. */
   bool jointCalibrationChanged = false; /**< Was the joint calibration changed since setting it for the local robot? */
 
@@ -215,6 +220,16 @@ private:
   // Helpers
   LogExtractor logExtractor; /**< The log extractor to extract things from log files. */
   unsigned maxPlotSize = 0; /**< The maximum number of data points to remember for plots. */
+  std::string plotId; /**< A buffer for the names of plots received, reused to avoid allocations. */
+
+  // Log replay checkpoints
+  size_t checkpointInterval = 1000; /**< The states of the modules are saved every this many frames of the log (0: never). */
+  std::set<size_t> checkpoints; /**< The frames of the log for which all threads saved the states of their modules. */
+  size_t checkpointInProgress = -1; /**< The frame of the checkpoint that is currently saved or -1 if there is none. */
+  std::unordered_set<std::string> threadsToCheckpoint; /**< The threads that still have to save the checkpoint in progress. */
+  size_t checkpointToRestore = -1; /**< The checkpoint restored as soon as all threads processed their frames or -1 if there is none. */
+  size_t seekTarget = -1; /**< The frame the replay fast-forwards to or -1 if not seeking. */
+  bool replayConsistent = false; /**< Were all frames up to the current one played back in sequence since the states of the modules were known? */
   int imageSaveNumber = 0; /**< A counter for generating image file names. */
   int mrCounter = 0; /**< Counts the number of mr commands. */
   unsigned currentFrame = 1; /**< Counts frames for assigning them to annotations. */
@@ -324,6 +339,15 @@ protected:
   /** Retrieves all annotations from the log player. */
   void updateAnnotationsFromLog();
 
+  /**
+   * Continues the replay of a log file. Frames are played back in order as
+   * long as the replay barrier reports that the threads they belong to are
+   * ready for them, i.e. they and all threads depending on their previous
+   * frames accepted those. During a consistent replay, the states of the
+   * modules are saved at regular intervals. Seeking restores them.
+   */
+  void continueLogReplay();
+
 private:
   /** The function adds all per-thread views, but not. */
   void addPerThreadViews();
@@ -419,6 +443,14 @@ private:
   bool joystickMaps(In&);
   bool joystickSpeeds(In&);
   bool log(In&);
+
+  /**
+   * Seeks a frame of the log. If possible, the states of the modules are
+   * restored from the nearest checkpoint and the remaining frames are played
+   * back by \c continueLogReplay.
+   * @param targetFrame The frame to seek.
+   */
+  void seekLogFrame(size_t targetFrame);
   bool moduleRequest(In&, std::string threadName);
   bool moveBall(In&);
   bool moveRobot(In&);
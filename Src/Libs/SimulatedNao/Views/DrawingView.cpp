@@ -221,23 +221,91 @@ void DrawingWidget::updateTransform(QPainter& painter)
 void DrawingWidget::paintDrawings(QPainter& painter)
 {
   const QTransform baseTrans(painter.transform());
+  const qreal pixelRatio = painter.device()->devicePixelRatioF();
+  const QSize imageSize(qRound(painter.device()->width() * pixelRatio), qRound(painter.device()->height() * pixelRatio));
   std::unordered_map<std::string, QTransform> transforms;
+  std::unordered_map<std::string, std::size_t> hashes;
+  std::vector<std::pair<std::string, const DebugDrawing*>> unchangedDrawings;
+  std::size_t numOfLayers = 0;
+
+  const auto hashTransform = [](std::size_t hash, const QTransform& transform)
+  {
+    for(const qreal value : {transform.m11(), transform.m12(), transform.m21(), transform.m22(), transform.dx(), transform.dy()})
+      hash = hash * 31 + std::hash<qreal>()(value);
+    return hash;
+  };
+
+  // Each thread continues with the origin the previous drawing of the same thread ended with.
+  const auto paint = [&](QPainter& target, const std::string& threadName, const DebugDrawing& debugDrawing)
+  {
+    QTransform& transform = transforms.emplace(threadName, baseTrans).first->second;
+    target.setTransform(transform);
+    PaintMethods::paintDebugDrawing(target, debugDrawing, baseTrans);
+    transform = target.transform();
+  };
+
+  const auto paintUnchangedDrawings = [&]
+  {
+    if(unchangedDrawings.empty())
+      return;
+
+    std::size_t key = hashTransform(0, baseTrans);
+    for(const auto& [threadName, debugDrawing] : unchangedDrawings)
+    {
+      const auto transform = transforms.find(threadName);
+      key = hashTransform(key * 31 + debugDrawing->hash, transform == transforms.end() ? baseTrans : transform->second);
+    }
+
+    if(numOfLayers == layers.size())
+      layers.emplace_back();
+    Layer& layer = layers[numOfLayers++];
+    if(layer.key != key || layer.image.size() != imageSize)
+    {
+      if(layer.image.size() != imageSize)
+      {
+        layer.image = QImage(imageSize, QImage::Format_ARGB32_Premultiplied);
+        layer.image.setDevicePixelRatio(pixelRatio);
+      }
+      layer.image.fill(Qt::transparent);
+      QPainter layerPainter(&layer.image);
+      layerPainter.setRenderHints(painter.renderHints());
+      for(const auto& [threadName, debugDrawing] : unchangedDrawings)
+        paint(layerPainter, threadName, *debugDrawing);
+      layer.key = key;
+      layer.transforms.clear();
+      for(const auto& [threadName, _] : unchangedDrawings)
+        layer.transforms.emplace_back(threadName, transforms[threadName]);
+    }
+    else
+      for(const auto& [threadName, transform] : layer.transforms)
+        transforms[threadName] = transform;
+
+    painter.setTransform(QTransform());
+    painter.drawImage(QPointF(), layer.image);
+    unchangedDrawings.clear();
+  };
+
+  // While the view is dragged or zoomed, rasterizing layers would not pay off.
+  const bool useLayers = baseTrans == lastTransform;
   for(const std::string& drawing : drawings)
     for(auto& [threadName, debugDrawing] : getDrawings(drawing))
     {
-      auto transform = transforms.find(threadName);
-      if(transform == transforms.end())
+      const std::string id = threadName + ":" + drawing;
+      const auto lastHash = lastDrawingHashes.find(id);
+      if(useLayers && lastHash != lastDrawingHashes.end() && lastHash->second == debugDrawing->hash)
+        unchangedDrawings.emplace_back(threadName, debugDrawing);
+      else
       {
-        transforms.emplace(threadName, baseTrans);
-        transform = transforms.find(threadName);
+        paintUnchangedDrawings();
+        paint(painter, threadName, *debugDrawing);
       }
-      painter.setTransform(transform->second);
-      PaintMethods::paintDebugDrawing(painter, *debugDrawing, baseTrans);
-      transform->second = painter.transform();
-      if(debugDrawing->timestamp > lastDrawingsTimestamp)
-        lastDrawingsTimestamp = debugDrawing->timestamp;
+      hashes[id] = debugDrawing->hash;
     }
+  paintUnchangedDrawings();
 
+  layers.resize(numOfLayers);
+  lastDrawingHashes.swap(hashes);
+  lastTransform = baseTrans;
   painter.setTransform(baseTrans);
 }
 
@@ -245,12 +313,18 @@ bool DrawingWidget::needsRepaint() const
 {
   SYNC_WITH(view.console);
 
+  std::size_t numOfDrawings = 0;
   for(const std::string& drawing : drawings)
-    for(const auto& [_, debugDrawing] : getDrawings(drawing))
-      if(debugDrawing && debugDrawing->timestamp > lastDrawingsTimestamp)
-        return true;
+    for(const auto& [threadName, debugDrawing] : getDrawings(drawing))
+      if(debugDrawing)
+      {
+        const auto lastHash = lastDrawingHashes.find(threadName + ":" + drawing);
+        if(lastHash == lastDrawingHashes.end() || lastHash->second != debugDrawing->hash)
+          return true;
+        ++numOfDrawings;
+      }
 
-  return false;
+  return numOfDrawings != lastDrawingHashes.size();
 }
 
 void DrawingWidget::window2viewport(QPointF& point)
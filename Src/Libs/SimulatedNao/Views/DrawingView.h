@@ -9,12 +9,15 @@
 #pragma once
 
 #include <QIcon>
+#include <QImage>
 #include <QMouseEvent>
 #include <QPainter>
 #include <QString>
 #include <QWidget>
 #include <SimRobot.h>
 #include <functional>
+#include <unordered_map>
+#include <vector>
 #include "SimulatedNao/RobotConsole.h"
 
 /** The view as it is maintained by SimRobot. */
@@ -128,13 +131,15 @@ protected:
   void updateTransform(QPainter& painter);
 
   /**
-   * Paint all drawings that are active.
+   * Paint all drawings that are active. Consecutive drawings that did not
+   * change since they were painted the last time are rasterized into a
+   * layer, which is reused as long as its drawings and the transformation
+   * stay the same.
    * @param painter The graphics context to paint to.
-   * @param drawings The names of the drawings to paint.
    */
   void paintDrawings(QPainter& painter);
 
-  /** @return Is it necessary to repaint this view? */
+  /** @return Is it necessary to repaint this view, i.e. did any drawing change? */
   virtual bool needsRepaint() const;
 
   /**
@@ -168,7 +173,7 @@ protected:
   const QPointF origin; /**< The initial offset . */
   const std::list<std::string>& drawings; /**< The drawings shown by this view. */
   QSize viewSize; /**< The logical size of the view. Must be set by by the derived class. */
-  unsigned int lastDrawingsTimestamp = 0; /**< The timestamp of the newest debug drawing that was already drawn. */
+  std::unordered_map<std::string, std::size_t> lastDrawingHashes; /**< The hashes of the drawings painted the last time per "thread:drawing". */
   QPainter painter; /**< The graphics context used for painting. */
   QPointF dragStart; /**< The position in window coordinates where dragging started. (-1, -1) if currently not dragging. **/
   QPointF dragStartOffset; /**< The value of \c offset when dragging started. */
@@ -177,6 +182,17 @@ protected:
   QPointF offset; /**< The offset of the content relative to the window in logical coordinates. */
 
 private:
+  /** A sequence of drawings that was rasterized into an image. */
+  struct Layer
+  {
+    std::size_t key = 0; /**< A hash of the drawings and transformations the image was rasterized from. */
+    QImage image; /**< The rasterized drawings in device pixels. */
+    std::vector<std::pair<std::string, QTransform>> transforms; /**< The transformations of the threads involved after painting the drawings. */
+  };
+
+  std::vector<Layer> layers; /**< The layers in the order in which they were painted. */
+  QTransform lastTransform; /**< The transformation the drawings were painted with the last time. */
+
   static constexpr Rangef zoomRange{0.1f, 500.f}; /**< The range to which \c zoom is clamped. */
   static constexpr float offsetStepRatio = 0.02f; /**< The step size for moving the content using the cursor key relative to the size of the view. */
 };
@@ -248,18 +248,35 @@ void PlotWidget::paint(QPainter& painter)
     for(const RobotConsole::Layer& layer : plotList)
       for(const RobotConsole::Plot* plot : getPlots(layer.layer))
       {
-        size_t numOfPoints = std::min(plot->points.size(), static_cast<size_t>(view.plotSize));
-        if(numOfPoints > 1)
+        const size_t numOfValues = std::min(plot->points.size(), static_cast<size_t>(view.plotSize));
+        if(numOfValues > 1)
         {
-          std::list<float>::const_iterator k = plot->points.end();
-          for(size_t i = 0; i < numOfPoints; ++i)
-            view.points[i].ry() = *(--k);
+          // Use the coarsest level of the pyramid whose blocks are not wider than a pixel column.
+          // Each block is represented by its minimum and maximum.
+          const float valuesPerPixel = static_cast<float>(numOfValues) / static_cast<float>(plotRect.width());
+          size_t level = PlotHistory::numOfLevels;
+          while(level > 0 && static_cast<float>(PlotHistory::getBlockSize(level - 1)) > valuesPerPixel)
+            --level;
+
+          view.points.clear();
+          if(level == 0)
+            for(size_t i = 0; i < numOfValues; ++i)
+              view.points.emplace_back(static_cast<qreal>(i), plot->points[i]);
+          else
+            plot->points.forEachBlock(level - 1, numOfValues, [&](size_t newest, size_t oldest, const PlotHistory::Range& range)
+            {
+              // Alternate the order of minimum and maximum to draw a continuous envelope.
+              const qreal x = static_cast<qreal>(newest + oldest) * 0.5;
+              const bool minFirst = view.points.size() % 4 == 0;
+              view.points.emplace_back(x, minFirst ? range.min : range.max);
+              view.points.emplace_back(x, minFirst ? range.max : range.min);
+            });
 
           const ColorRGBA& color = layer.color;
           QPen pen = color == ColorRGBA::black ? blackPen : QPen(QColor(color.r, color.g, color.b));
           pen.setWidth(0);
           painter.setPen(pen);
-          painter.drawPolyline(view.points, static_cast<int>(numOfPoints));
+          painter.drawPolyline(view.points.data(), static_cast<int>(view.points.size()));
         }
         lastTimestamp = std::max(lastTimestamp, plot->timestamp);
         if(drawLegend)
@@ -314,13 +331,12 @@ void PlotWidget::determineMinMaxValue()
     for(const auto& layer : plotList)
       for(const RobotConsole::Plot* plot : getPlots(layer.layer))
       {
-        int numOfPoints = std::min(static_cast<int>(plot->points.size()), static_cast<int>(view.plotSize));
-        if(numOfPoints > 1)
+        const size_t numOfValues = std::min(plot->points.size(), static_cast<size_t>(view.plotSize));
+        if(numOfValues > 1)
         {
-          std::list<float>::const_iterator k = plot->points.begin();
-          for(int j = view.plotSize - numOfPoints; j < static_cast<int>(view.plotSize); ++j)
+          for(size_t i = 0; i < numOfValues; ++i)
           {
-            const float& value(*(k++));
+            const float value = plot->points[i];
             if(started)
             {
               if(value < view.minValue)
@@ -411,9 +427,8 @@ void PlotWidget::exportAsGnuplot()
     for(const RobotConsole::Layer& layer : plotList)
       for(const RobotConsole::Plot* plot : getPlots(layer.layer))
       {
-        std::list<float>::const_reverse_iterator k = plot->points.rbegin();
         for(int j = numOfPoints - 1; j >= 0; --j)
-          data[j][currentPlot] = *(k++);
+          data[j][currentPlot] = plot->points[numOfPoints - 1 - j];
         ++currentPlot;
       }
   }
@@ -541,17 +556,9 @@ PlotView::PlotView(const QString& fullName, RobotConsole& console, const std::st
   icon.setIsMask(true);
 }
 
-PlotView::~PlotView()
-{
-  delete[] points;
-}
-
 void PlotView::setParameters(unsigned int plotSize, float minValue, float maxValue, const std::string& yUnit, const std::string& xUnit, float xScale)
 {
-  delete[] points;
-  points = new QPointF[plotSize];
-  for(unsigned int i = 0; i < plotSize; ++i)
-    points[i].rx() = i;
+  points.reserve(plotSize);
 
   this->plotSize = plotSize;
   this->minValue = minValue;
@@ -13,6 +13,7 @@
 #include <QPainter>
 #include <QIcon>
 #include <string>
+#include <vector>
 #include <SimRobot.h>
 
 class RobotConsole;
@@ -36,8 +37,6 @@ public:
    */
   PlotView(const QString& fullName, RobotConsole& console, const std::string& name, const std::string& threadName);
 
-  ~PlotView();
-
   /**
    * Changes the parameters of the plot.
    * @param plotSize The number of entries in a plot.
@@ -64,7 +63,7 @@ private:
   std::string yUnit; /**< The name of the y-axis. */
   std::string xUnit; /**< The name of the x-axis. */
   float xScale; /**< A scale factor for the x-axis. */
-  QPointF* points = nullptr; /**< A buffer for drawing points. */
+  std::vector<QPointF> points; /**< A buffer for drawing points. */
 
   /**
    * The method returns a new instance of a widget for this direct view.
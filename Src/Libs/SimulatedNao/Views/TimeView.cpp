@@ -39,6 +39,7 @@ struct Row
   NumberTableWidgetItem* min;
   NumberTableWidgetItem* max;
   NumberTableWidgetItem* avg;
+  NumberTableWidgetItem* hits;
 };
 
 TimeWidget::TimeWidget(TimeView& timeView) : timeView(timeView)
@@ -46,14 +47,14 @@ TimeWidget::TimeWidget(TimeView& timeView) : timeView(timeView)
   setFocusPolicy(Qt::StrongFocus);
 
   table = new QTableWidget();
-  table->setColumnCount(4);
+  table->setColumnCount(5);
   QStringList headerNames;
-  headerNames << "Stopwatch" << "Min" << "Max" << "Avg";
+  headerNames << "Stopwatch" << "Min" << "Max" << "Avg" << "Hits %";
   table->setHorizontalHeaderLabels(headerNames);
   table->verticalHeader()->setVisible(false);
   table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
   table->verticalHeader()->setDefaultSectionSize(15);
-  table->horizontalHeader()->setSectionResizeMode(3, QHeaderView::Stretch);
+  table->horizontalHeader()->setSectionResizeMode(4, QHeaderView::Stretch);
   table->setEditTriggers(QAbstractItemView::NoEditTriggers);
   table->setAlternatingRowColors(true);
   table->setSortingEnabled(true);
@@ -150,12 +151,14 @@ void TimeWidget::update()
         currentRow->max = new NumberTableWidgetItem();
         currentRow->min = new NumberTableWidgetItem();
         currentRow->name = new QTableWidgetItem();
+        currentRow->hits = new NumberTableWidgetItem();
         const int rowCount = table->rowCount();
         table->setRowCount(rowCount + 1);
         table->setItem(rowCount, 0, currentRow->name);
         table->setItem(rowCount, 1, currentRow->min);
         table->setItem(rowCount, 2, currentRow->max);
         table->setItem(rowCount, 3, currentRow->avg);
+        table->setItem(rowCount, 4, currentRow->hits);
         items[id] = currentRow;
       }
       float minTime = -1, maxTime = -1, avgTime = -1;
@@ -166,6 +169,8 @@ void TimeWidget::update()
       currentRow->avg->setText(QString::number(avgTime));
       currentRow->min->setText(QString::number(minTime));
       currentRow->max->setText(QString::number(maxTime));
+      const float hitRate = timeView.info.getHitRate(info);
+      currentRow->hits->setText(hitRate < 0.f ? QString() : QString::number(hitRate, 'f', 1));
       currentRow->name->setText(QString(name.c_str())); //refresh name every time to eliminate unknown
     }
   }
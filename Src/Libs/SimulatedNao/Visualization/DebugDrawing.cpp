@@ -11,6 +11,7 @@
 #include "Platform/Time.h"
 #include <cstring>
 #include <limits>
+#include <string_view>
 
 DebugDrawing::DebugDrawing()
 {
@@ -25,6 +26,7 @@ const DebugDrawing& DebugDrawing::operator=(const DebugDrawing& other)
   timestamp = other.timestamp;
   threadName = other.threadName;
   *this += other;
+  hash = other.hash;
   return *this;
 }
 
@@ -57,6 +59,7 @@ const DebugDrawing& DebugDrawing::operator+=(const DebugDrawing& other)
 
   if(other.lastOrigin != -1)
     lastOrigin = offset + other.lastOrigin;
+  hash = hash * 31 + other.hash;
   return *this;
 }
 
@@ -83,6 +86,7 @@ DebugDrawing::~DebugDrawing()
 void DebugDrawing::reset()
 {
   timestamp = Time::getCurrentSystemTime();
+  hash = 0;
   usedSize = 0;
   firstTip = -1;
   firstSpot = -1;
@@ -599,6 +603,11 @@ bool DebugDrawing::addShapeFromQueue(In& stream, Drawings::ShapeType shapeType)
   return true;
 }
 
+void DebugDrawing::addToHash(const void* data, std::size_t size)
+{
+  hash = hash * 31 + std::hash<std::string_view>()(std::string_view(static_cast<const char*>(data), size));
+}
+
 void DebugDrawing::reserve(int size)
 {
   if(usedSize + size > reservedSize)
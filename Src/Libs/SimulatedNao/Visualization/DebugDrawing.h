@@ -162,6 +162,7 @@ public:
 
   unsigned timestamp; /**< The time when this drawing was created. */
   std::string threadName; /**< The thread this drawing belongs to. */
+  std::size_t hash = 0; /**< A hash of the data this drawing was created from. Drawings with the same contents have the same hash. */
 
   DebugDrawing();
   DebugDrawing(const DebugDrawing& other);
@@ -308,6 +309,15 @@ public:
   void gridRectangleRGBA(int x, int y, int width, int height, int cellsX, int cellsY, ColorRGBA* cells);
 
   bool addShapeFromQueue(In& stream, Drawings::ShapeType shapeType);
+
+  /**
+   * Adds data the contents of this drawing were created from to its hash.
+   * The elements themselves are not hashed, because they contain padding.
+   * @param data The data, e.g. the message the shapes were read from.
+   * @param size The size of the data in bytes.
+   */
+  void addToHash(const void* data, std::size_t size);
+
   /**
    * The function returns a pointer to the first drawing element.
    * @return A pointer to the first drawing element or 0 if the drawing is empty.
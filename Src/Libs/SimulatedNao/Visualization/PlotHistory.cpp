@@ -0,0 +1,53 @@
+/**
+ * @file Visualization/PlotHistory.cpp
+ * Implementation of class PlotHistory.
+ */
+
+#include "PlotHistory.h"
+
+void PlotHistory::setCapacity(std::size_t capacity)
+{
+  if(capacity == values.size())
+    return;
+
+  std::vector<float> oldValues(std::min(size(), capacity));
+  for(std::size_t i = 0; i < oldValues.size(); ++i)
+    oldValues[i] = (*this)[oldValues.size() - 1 - i];
+
+  values.resize(capacity);
+  for(std::size_t level = 0; level < numOfLevels; ++level)
+    levels[level].resize(capacity / getBlockSize(level) + 2);
+  count = 0;
+  for(float value : oldValues)
+    add(value);
+}
+
+void PlotHistory::add(float value)
+{
+  if(values.empty())
+    return;
+
+  values[count % values.size()] = value;
+  std::size_t blockSize = 1;
+  for(std::vector<Range>& blocks : levels)
+  {
+    blockSize *= blockFactor;
+    Range& range = blocks[(count / blockSize) % blocks.size()];
+    if(count % blockSize == 0)
+      range = {value, value};
+    else
+    {
+      range.min = std::min(range.min, value);
+      range.max = std::max(range.max, value);
+    }
+  }
+  ++count;
+}
+
+std::size_t PlotHistory::getBlockSize(std::size_t level)
+{
+  std::size_t blockSize = blockFactor;
+  while(level--)
+    blockSize *= blockFactor;
+  return blockSize;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file Visualization/PlotHistory.h
+ * Declaration of class PlotHistory.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/**
+ * The recent values of a plot, stored in a ring buffer. In addition, the
+ * minima and maxima of blocks of consecutive values are maintained in a
+ * pyramid of coarser ring buffers, so that a plot covering more values than
+ * it has pixels can be drawn with a few points per pixel column.
+ */
+class PlotHistory
+{
+public:
+  static constexpr std::size_t blockFactor = 4; /**< The number of blocks of a level that form a block of the next level. */
+  static constexpr std::size_t numOfLevels = 6; /**< The number of levels of the pyramid (block sizes 4 .. 4096). */
+
+  /** The value range of a block of consecutive values. */
+  struct Range
+  {
+    float min;
+    float max;
+  };
+
+  /**
+   * Sets the number of values that are remembered. Existing values are kept
+   * as far as they fit.
+   * @param capacity The new number of values.
+   */
+  void setCapacity(std::size_t capacity);
+
+  /** Returns the number of values that can be remembered. */
+  std::size_t capacity() const { return values.size(); }
+
+  /** Returns the number of values remembered. */
+  std::size_t size() const { return std::min(count, values.size()); }
+
+  /**
+   * Adds a value. If the capacity is reached, the oldest value is dropped.
+   * @param value The new value.
+   */
+  void add(float value);
+
+  /**
+   * Returns a value.
+   * @param age The age of the value, i.e. 0 is the newest. Must be less than size().
+   * @return The value.
+   */
+  float operator[](std::size_t age) const { return values[(count - 1 - age) % values.size()]; }
+
+  /**
+   * Returns the number of values that form a block of a level.
+   * @param level The level, i.e. 0 .. numOfLevels - 1.
+   * @return The block size.
+   */
+  static std::size_t getBlockSize(std::size_t level);
+
+  /**
+   * Visits the blocks of a level that cover the newest values, newest first.
+   * @param level The level, i.e. 0 .. numOfLevels - 1.
+   * @param numOfValues The number of newest values to cover. Must not be greater than size().
+   * @param visit A function that is called with the age of the newest and the
+   *              oldest value of each block (clipped to the values covered) and
+   *              the range of the block.
+   */
+  template<typename Visitor>
+  void forEachBlock(std::size_t level, std::size_t numOfValues, Visitor visit) const
+  {
+    if(!numOfValues)
+      return;
+    const std::size_t blockSize = getBlockSize(level);
+    const std::vector<Range>& blocks = levels[level];
+    for(std::size_t block = (count - 1) / blockSize + 1; block-- > (count - numOfValues) / blockSize;)
+    {
+      const std::size_t newest = count - 1 - std::min(count - 1, block * blockSize + blockSize - 1);
+      const std::size_t oldest = std::min(numOfValues - 1, count - 1 - block * blockSize);
+      visit(newest, oldest, blocks[block % blocks.size()]);
+    }
+  }
+
+private:
+  std::vector<float> values; /**< The ring buffer of values. */
+  std::array<std::vector<Range>, numOfLevels> levels; /**< The ring buffers of block ranges per level. */
+  std::size_t count = 0; /**< The number of values ever added since the capacity was set. */
+};
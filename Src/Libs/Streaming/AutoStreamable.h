@@ -258,7 +258,7 @@
 #define _STREAM_DECL_I(...) _STREAM_VAR(__VA_ARGS__) _STREAM_DROP(_STREAM_DROP(
 
 /** Generate type registration code from declaration. */
-#define _STREAM_REG(seq) TypeRegistry::addAttribute(_type, typeid(decltype(Streaming::TypeWrapper<_STREAM_DECL_I seq))>::type)).name(), #seq);
+#define _STREAM_REG(seq) TypeRegistry::addAttribute(_type, TypeRegistry::addType<decltype(Streaming::TypeWrapper<_STREAM_DECL_I seq))>::type)>(), #seq);
 
 /** Generate the initialization code from the declaration if required. */
 #define _STREAM_INIT(seq) _STREAM_JOIN(_STREAM_INIT_I_, _STREAM_SEQ_SIZE(seq))(seq)
@@ -295,8 +295,8 @@
   private: \
     static void _reg() \
     { \
-      const char* _type = typeid(theName).name(); \
-      TypeRegistry::addClass(_type, typeid(base) == typeid(Streamable) ? nullptr : typeid(base).name()); \
+      const char* _type = TypeRegistry::addType<theName>(); \
+      TypeRegistry::addClass(_type, std::is_same<base, Streamable>::value ? nullptr : TypeRegistry::addType<base>()); \
       _STREAM_ATTR_##n params3 \
     } \
   }
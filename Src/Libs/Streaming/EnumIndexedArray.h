@@ -61,6 +61,6 @@ private:
   {
     REG_CLASS(EnumIndexedArray);
     for(int i = 0; i < EnumInfo::numOfElements; ++i)
-      TypeRegistry::addAttribute(_type, typeid(Elem).name(), TypeRegistry::getEnumName(static_cast<Enum>(i)));
+      TypeRegistry::addAttribute(_type, TypeRegistry::addType<Elem>(), TypeRegistry::getEnumName(static_cast<Enum>(i)));
   }
 };
@@ -118,7 +118,7 @@ ENUM(MessageID,
   idConsole = numOfDataMessageIDs,
   idDebugDataChangeRequest,
   idDebugDataResponse,
-  idDebugDrawing,
+  idDebugDrawing, /**< A single shape of a debug drawing. Only sent by older versions. */
   idDebugDrawing3D,
   idDebugImage,
   idDebugRequest,
@@ -128,10 +128,15 @@ ENUM(MessageID,
   idLogResponse,
   idModuleRequest,
   idModuleTable,
-  idPlot,
+  idPlot, /**< A single value of a plot. */
   idRobotName,
   idText,
   idThread,
   idTypeInfo,
   idTypeInfoRequest,
+
+  // Appended so that the ids above stay compatible with older versions
+  idDebugDrawingShapes, /**< All shapes of a debug drawing from one frame. */
+  idLogCheckpoint, /**< Asks a thread to save or restore the states of its modules during log replay. */
+  idPlotValues, /**< All values of the plots of a thread from one frame. */
 });
@@ -7,6 +7,37 @@
  */
 
 #include "MessageQueue.h"
+#include "Platform/Memory.h"
+
+/**
+ * Allocates a buffer owned by a queue. On the robot, buffers never grow, so
+ * the large ones can be backed by huge pages.
+ * @param capacity The size of the buffer in bytes.
+ * @return The buffer or nullptr if no memory is left.
+ */
+static char* allocate(size_t capacity)
+{
+#ifdef TARGET_ROBOT
+  return static_cast<char*>(Memory::hugePageMalloc(capacity));
+#else
+  return static_cast<char*>(malloc(capacity));
+#endif
+}
+
+/**
+ * Frees a buffer owned by a queue.
+ * @param buffer The buffer.
+ * @param capacity The size it was allocated with.
+ */
+static void deallocate(char* buffer, size_t capacity)
+{
+#ifdef TARGET_ROBOT
+  Memory::hugePageFree(buffer, capacity);
+#else
+  static_cast<void>(capacity);
+  free(buffer);
+#endif
+}
 
 void MessageQueue::OutQueue::open(MessageID id, MessageQueue& queue)
 {
@@ -44,9 +75,11 @@ void MessageQueue::OutQueue::writeToStream(const void* p, size_t size)
 size_t MessageQueue::calcMaxCapacity(MessageID id) const
 {
   constexpr unsigned unprotected = bit(idDebugDrawing - numOfDataMessageIDs)
+    | bit(idDebugDrawingShapes - numOfDataMessageIDs)
     | bit(idDebugDrawing3D - numOfDataMessageIDs)
     | bit(idDebugImage - numOfDataMessageIDs)
     | bit(idPlot - numOfDataMessageIDs)
+    | bit(idPlotValues - numOfDataMessageIDs)
     | bit(idText - numOfDataMessageIDs);
 
   return id <= idFrameFinished || (id >= numOfDataMessageIDs && !(bit(id - numOfDataMessageIDs) & unprotected))
@@ -140,17 +173,17 @@ MessageQueue::MessageQueue()
 MessageQueue::~MessageQueue()
 {
   if(ownBuffer)
-    free(buffer);
+    deallocate(buffer, capacity);
 }
 
 MessageQueue& MessageQueue::operator=(const MessageQueue& other)
 {
   if(ownBuffer)
-    free(buffer);
+    deallocate(buffer, capacity);
   ownBuffer = true;
   used = capacity = other.used;
   maxCapacity = other.maxCapacity;
-  buffer = static_cast<char*>(malloc(capacity));
+  buffer = allocate(capacity);
   std::memcpy(buffer, other.buffer, used);
   return *this;
 }
@@ -182,7 +215,7 @@ void MessageQueue::clear()
   if(!ownBuffer && !capacity)
   {
     capacity = 16384;
-    buffer = static_cast<char*>(malloc(capacity));
+    buffer = allocate(capacity);
     ownBuffer = true;
   }
 }
@@ -197,7 +230,7 @@ void MessageQueue::reserve(size_t capacity, size_t protectedCapacity)
 {
 #ifdef TARGET_ROBOT
   ASSERT(!buffer);
-  VERIFY(buffer = static_cast<char*>(malloc(capacity)));
+  VERIFY(buffer = allocate(capacity));
   this->capacity = capacity;
 #else
   ASSERT(capacity >= used);
@@ -220,7 +253,7 @@ void MessageQueue::setBuffer(const char* buffer, size_t size)
 void MessageQueue::setBuffer(char* buffer, size_t size, size_t capacity)
 {
   if(ownBuffer)
-    free(this->buffer);
+    deallocate(this->buffer, this->capacity);
   this->buffer = buffer;
   used = size;
   this->capacity = capacity;
@@ -175,6 +175,12 @@ public:
      */
     size_t size() const {return reinterpret_cast<const MessageHeader*>(buffer)->size;}
 
+    /**
+     * Returns the message's payload.
+     * @return The address of the first byte after the \c MessageHeader .
+     */
+    const char* data() const {return buffer + sizeof(MessageHeader);}
+
     /**
      * Returns a stream that allows reading the message in binary format.
      * @return The binary stream.
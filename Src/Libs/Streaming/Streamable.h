@@ -19,7 +19,7 @@
 
 /** Register the class that is specified as parameter. */
 #define REG_CLASS(...) \
-  const char* _type = typeid(__VA_ARGS__).name(); \
+  const char* _type = TypeRegistry::addType<__VA_ARGS__>(); \
   const __VA_ARGS__* _class = nullptr; \
   static_cast<void>(_class); \
   TypeRegistry::addClass(_type)
@@ -30,10 +30,10 @@
  * @param ... The base class. It can contain commas.
  */
 #define REG_CLASS_WITH_BASE(class, ...) \
-  const char* _type = typeid(class).name(); \
+  const char* _type = TypeRegistry::addType<class>(); \
   const class* _class = nullptr; \
   static_cast<void>(_class); \
-  TypeRegistry::addClass(_type, typeid(__VA_ARGS__).name())
+  TypeRegistry::addClass(_type, TypeRegistry::addType<__VA_ARGS__>())
 
 /** Concatenate the two parameters. */
 #define _REG_JOIN(a, b) _REG_JOIN_I(a, b)
@@ -53,7 +53,7 @@
 #define REG(...) _REG_I(_REG_TUPLE_SIZE(__VA_ARGS__), __VA_ARGS__)
 #define _REG_I(n, ...) _REG_II(n, (__VA_ARGS__))
 #define _REG_II(n, args) _REG_II_##n args
-#define _REG_II_1(attribute) TypeRegistry::addAttribute(_type, typeid(decltype(_class->attribute)).name(), #attribute)
+#define _REG_II_1(attribute) TypeRegistry::addAttribute(_type, TypeRegistry::addType<decltype(_class->attribute)>(), #attribute)
 #define _REG_II_2(a0, a1) _REG_III(a1, a0)
 #define _REG_II_3(a0, a1, a2) _REG_III(a2, a0, a1)
 #define _REG_II_4(a0, a1, a2, a3) _REG_III(a3, a0, a1, a2)
@@ -63,13 +63,13 @@
 #define _REG_II_8(a0, a1, a2, a3, a4, a5, a6, a7) _REG_III(a7, a0, a1, a2, a3, a4, a5, a6)
 #define _REG_II_9(a0, a1, a2, a3, a4, a5, a6, a7, a8) _REG_III(a8, a0, a1, a2, a3, a4, a5, a6, a7)
 #define _REG_II_10(a0, a1, a2, a3, a4, a5, a6, a7, a8, a9) _REG_III(a9, a0, a1, a2, a3, a4, a5, a6, a7, a8)
-#define _REG_III(attribute, ...) TypeRegistry::addAttribute(_type, typeid(__VA_ARGS__).name(), #attribute)
+#define _REG_III(attribute, ...) TypeRegistry::addAttribute(_type, TypeRegistry::addType<__VA_ARGS__>(), #attribute)
 
 /**
  * Registers an enumeration type. The constants must be registered afterwards.
  */
 #define REG_ENUM(...) \
-  const char* _type = typeid(__VA_ARGS__).name(); \
+  const char* _type = TypeRegistry::addType<__VA_ARGS__>(); \
   TypeRegistry::addEnum(_type)
 
 /**
@@ -0,0 +1,278 @@
+/**
+ * @file Streaming/TypeName.h
+ *
+ * This file declares a template that determines the platform independent name
+ * of a type at compile time. The names follow the conventions of the
+ * TypeRegistry: Template arguments are separated by commas without spaces,
+ * std::string is called "std::string", a std::array of n elements of type T is
+ * called "T[n]", and std::vector, std::list, and std::optional with elements
+ * of type T are called "T*". The names of other types are taken from the
+ * signature of a function template instantiated for them. Class templates
+ * with non-type parameters cannot be named generically and need a
+ * specialization of Streaming::TypeName (see Math/Eigen.h). Otherwise, their
+ * name is not valid.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Streaming
+{
+  /**
+   * A string with a maximum length that can be built at compile time.
+   * @tparam N The maximum length.
+   */
+  template<std::size_t N> struct TypeNameString
+  {
+    std::array<char, N + 1> chars{}; /**< The characters, terminated by a zero. */
+    std::size_t length = 0; /**< The number of characters. */
+    bool valid = true; /**< Could the name be determined? */
+
+    /** Appends a string. */
+    constexpr void append(std::string_view string)
+    {
+      for(const char c : string)
+        chars[length++] = c;
+    }
+
+    /** Appends another name. It is only valid if both are. */
+    template<std::size_t M> constexpr void append(const TypeNameString<M>& name)
+    {
+      append(name.view());
+      valid &= name.valid;
+    }
+
+    /** Appends the decimal representation of a number. */
+    constexpr void append(long long number)
+    {
+      if(number < 0)
+      {
+        chars[length++] = '-';
+        number = -number;
+      }
+      std::array<char, 20> digits{};
+      std::size_t count = 0;
+      do
+        digits[count++] = static_cast<char>('0' + number % 10);
+      while(number /= 10);
+      while(count)
+        chars[length++] = digits[--count];
+    }
+
+    constexpr std::string_view view() const {return {chars.data(), length};}
+  };
+
+  /** The signature of a function that contains the name of the type T. */
+  template<typename T> constexpr const char* typeNameSignature()
+  {
+#ifdef _MSC_VER
+    return __FUNCSIG__;
+#else
+    return __PRETTY_FUNCTION__;
+#endif
+  }
+
+  /** The name of a type as the compiler writes it. */
+  template<typename T> constexpr std::string_view rawTypeName()
+  {
+    const std::string_view signature = typeNameSignature<T>();
+#ifdef _MSC_VER
+    const std::size_t begin = signature.find("typeNameSignature<") + 18;
+    return signature.substr(begin, signature.rfind(">(void)") - begin);
+#else
+    const std::size_t begin = signature.find("T = ") + 4;
+    return signature.substr(begin, signature.size() - 1 - begin);
+#endif
+  }
+
+  /**
+   * Appends a type name or template name written by the compiler. Inline
+   * namespaces of the standard library and keywords MSVC puts in front of
+   * names are removed. Anonymous namespaces are named as the demangler does.
+   * @param name The name is appended to this one.
+   * @param raw The name written by the compiler.
+   */
+  template<std::size_t N> constexpr void appendRawTypeName(TypeNameString<N>& name, std::string_view raw)
+  {
+    constexpr std::array<std::string_view, 4> keywords = {"class ", "struct ", "enum ", "union "};
+    constexpr std::array<std::string_view, 2> namespaces = {"::__1", "::__cxx11"};
+    bool wordBegins = true;
+    while(!raw.empty())
+    {
+      bool skipped = false;
+      if(wordBegins)
+        for(const std::string_view keyword : keywords)
+          if(!skipped && raw.starts_with(keyword))
+          {
+            raw.remove_prefix(keyword.size());
+            skipped = true;
+          }
+      for(const std::string_view space : namespaces)
+        if(!skipped && raw.starts_with(space) && (raw.size() == space.size() || raw[space.size()] == ':'))
+        {
+          raw.remove_prefix(space.size());
+          skipped = true;
+        }
+      if(!skipped && wordBegins && raw.starts_with("__int64"))
+      {
+        name.append("long long");
+        raw.remove_prefix(7);
+        skipped = true;
+      }
+      if(!skipped && raw.starts_with("{anonymous}"))
+      {
+        name.append("(anonymous namespace)");
+        raw.remove_prefix(11);
+        skipped = true;
+      }
+      if(!skipped)
+      {
+        const char c = raw.front();
+        wordBegins = !((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_');
+        name.append(std::string_view(&c, 1));
+        raw.remove_prefix(1);
+      }
+    }
+  }
+
+  /**
+   * The name of a type that is not a template instance. Class templates
+   * without a specialization end up here if they have non-type parameters.
+   * Their names are not valid.
+   */
+  template<typename T> struct TypeName
+  {
+    static constexpr auto value = []
+    {
+      constexpr std::string_view raw = rawTypeName<T>();
+      TypeNameString<2 * raw.size()> name;
+      name.valid = raw.find('<') == std::string_view::npos;
+      appendRawTypeName(name, raw);
+      return name;
+    }();
+  };
+
+  /** The name of an instance of a class template that only has type parameters. */
+  template<template<typename...> class C, typename... A> struct TypeName<C<A...>>
+  {
+    static constexpr auto value = []
+    {
+      constexpr std::string_view raw = rawTypeName<C<A...>>();
+      TypeNameString<2 * raw.size() + (TypeName<A>::value.length + ... + 0) + sizeof...(A) + 2> name;
+      appendRawTypeName(name, raw.substr(0, raw.find('<')));
+      name.append("<");
+      std::size_t index = 0;
+      ((name.append(index++ ? "," : ""), name.append(TypeName<A>::value)), ...);
+      name.append(">");
+      return name;
+    }();
+  };
+
+  /** Constant types are named as the demangler does it. */
+  template<typename T> struct TypeName<const T>
+  {
+    static constexpr auto value = []
+    {
+      TypeNameString<TypeName<T>::value.length + 6> name;
+      name.append(TypeName<T>::value);
+      name.append(" const");
+      return name;
+    }();
+  };
+
+  /** Creates a name from a string literal. */
+  template<std::size_t N> constexpr TypeNameString<N - 1> fixedTypeName(const char (&string)[N])
+  {
+    TypeNameString<N - 1> name;
+    name.append(std::string_view(string, N - 1));
+    return name;
+  }
+
+  // The compilers disagree about the names of these types.
+  template<> struct TypeName<short> {static constexpr auto value = fixedTypeName("short");};
+  template<> struct TypeName<unsigned short> {static constexpr auto value = fixedTypeName("unsigned short");};
+  template<> struct TypeName<long> {static constexpr auto value = fixedTypeName("long");};
+  template<> struct TypeName<unsigned long> {static constexpr auto value = fixedTypeName("unsigned long");};
+  template<> struct TypeName<long long> {static constexpr auto value = fixedTypeName("long long");};
+  template<> struct TypeName<unsigned long long> {static constexpr auto value = fixedTypeName("unsigned long long");};
+  template<> struct TypeName<std::string> {static constexpr auto value = fixedTypeName("std::string");};
+
+  /** The name of a dynamic array, i.e. its element type followed by an asterisk. */
+  template<typename T> struct DynamicArrayTypeName
+  {
+    static constexpr auto value = []
+    {
+      TypeNameString<TypeName<T>::value.length + 1> name;
+      name.append(TypeName<T>::value);
+      name.append("*");
+      return name;
+    }();
+  };
+
+  template<typename T> struct TypeName<std::vector<T, std::allocator<T>>> : DynamicArrayTypeName<T> {};
+  template<typename T> struct TypeName<std::list<T, std::allocator<T>>> : DynamicArrayTypeName<T> {};
+  template<typename T> struct TypeName<std::optional<T>> : DynamicArrayTypeName<T> {};
+
+  /** C arrays are named like std::array, but multidimensional ones in declaration order. */
+  template<typename T, std::size_t N> struct TypeName<T[N]>
+  {
+    static constexpr auto value = []
+    {
+      constexpr auto& element = TypeName<std::remove_all_extents_t<T>>::value;
+      TypeNameString<TypeName<T>::value.length + 22> name;
+      name.append(element);
+      name.append("[");
+      name.append(static_cast<long long>(N));
+      name.append("]");
+      name.append(TypeName<T>::value.view().substr(element.length));
+      return name;
+    }();
+  };
+
+  /** Pointers to arrays are registered for arrays whose size is only known at compile time. */
+  template<typename T, std::size_t N> struct TypeName<T(*)[N]> : TypeName<T[N]> {};
+
+  template<typename T, std::size_t N> struct TypeName<std::array<T, N>>
+  {
+    static constexpr auto value = []
+    {
+      TypeNameString<TypeName<T>::value.length + 22> name;
+      name.append(TypeName<T>::value);
+      name.append("[");
+      name.append(static_cast<long long>(N));
+      name.append("]");
+      return name;
+    }();
+  };
+
+  /**
+   * The name of an instance of a class template with a type parameter followed
+   * by integral ones, e.g. "Eigen::Matrix<float,2,1,0,2,1>". Such templates
+   * can use it to specialize TypeName.
+   * @tparam C The instance.
+   * @tparam T Its type argument.
+   * @tparam V Its integral arguments.
+   */
+  template<typename C, typename T, long long... V> struct TypeNameWithValues
+  {
+    static constexpr auto value = []
+    {
+      constexpr std::string_view raw = rawTypeName<C>();
+      TypeNameString<2 * raw.size() + TypeName<T>::value.length + 21 * sizeof...(V) + 2> name;
+      appendRawTypeName(name, raw.substr(0, raw.find('<')));
+      name.append("<");
+      name.append(TypeName<T>::value);
+      ((name.append(","), name.append(V)), ...);
+      name.append(">");
+      return name;
+    }();
+  };
+}
@@ -21,6 +21,7 @@
 #endif
 #include <iostream>
 #include <list>
+#include <mutex>
 #include <regex>
 #include <unordered_map>
 #include <unordered_set>
@@ -57,26 +58,44 @@ struct Class
   std::vector<Attribute> attributes; /**< The list of attribute in the order they are defined. */
 };
 
+/**
+ * The platform independent names of all types, indexed by the names returned
+ * by typeid().name(). Types are added during static initialization, so the
+ * map is created on first use.
+ */
+static std::unordered_map<const char*, const char*>& names()
+{
+  static std::unordered_map<const char*, const char*> names;
+  return names;
+}
+
 /** All primitive data types. */
 static std::unordered_set<const char*> primitives(
 {
-  typeid(bool).name(),
-  typeid(char).name(),
-  typeid(signed char).name(),
-  typeid(unsigned char).name(),
-  typeid(short).name(),
-  typeid(unsigned short).name(),
-  typeid(int).name(),
-  typeid(unsigned int).name(),
-  typeid(float).name(),
-  typeid(double).name(),
-  typeid(std::string).name(),
-  typeid(Angle).name()
+  TypeRegistry::addType<bool>(),
+  TypeRegistry::addType<char>(),
+  TypeRegistry::addType<signed char>(),
+  TypeRegistry::addType<unsigned char>(),
+  TypeRegistry::addType<short>(),
+  TypeRegistry::addType<unsigned short>(),
+  TypeRegistry::addType<int>(),
+  TypeRegistry::addType<unsigned int>(),
+  TypeRegistry::addType<float>(),
+  TypeRegistry::addType<double>(),
+  TypeRegistry::addType<std::string>(),
+  TypeRegistry::addType<Angle>()
 });
 
 static std::unordered_map<const char*, Enum> enums; /**< All enumeration types. */
 static std::unordered_map<const char*, Class> classes; /**< All classes and structures. */
 
+const char* TypeRegistry::addType(const char* type, const char* name)
+{
+  if(name)
+    names().emplace(type, name);
+  return type;
+}
+
 void TypeRegistry::addEnum(const char* enumeration)
 {
   enums[enumeration].byOrder.clear();
@@ -153,6 +172,28 @@ int TypeRegistry::getEnumValue(const char* enumeration, const std::string& name)
   return -1;
 }
 
+const char* TypeRegistry::getName(const char* type)
+{
+  const auto name = names().find(type);
+  if(name != names().end())
+    return name->second;
+
+  // Types without a compile time name are demangled once. Unlike the names
+  // registered at startup, this can happen in any thread.
+  static std::mutex mutex;
+  static std::unordered_map<const char*, std::string> demangled;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto entry = demangled.find(type);
+  if(entry == demangled.end())
+    entry = demangled.emplace(type, demangle(type)).first;
+  return entry->second.c_str();
+}
+
+std::vector<std::pair<const char*, const char*>> TypeRegistry::getNames()
+{
+  return {names().begin(), names().end()};
+}
+
 #ifdef WINDOWS
 static std::regex matchClass("\\bclass ");
 static std::regex matchEnum("\\benum ");
@@ -219,12 +260,12 @@ std::string TypeRegistry::demangle(std::string type)
 
 void TypeRegistry::print()
 {
-  for(const std::string& p : primitives)
-    std::cout << demangle(p) << std::endl;
+  for(const char* p : primitives)
+    std::cout << getName(p) << std::endl;
 
   for(const auto& [name, constants] : enums)
   {
-    std::cout << "enum " << demangle(name) << " {";
+    std::cout << "enum " << getName(name) << " {";
     for(const std::string& c : constants.byOrder)
       std::cout << (&c == constants.byOrder.data() ? "" : ", ") << c;
     std::cout << "}" << std::endl;
@@ -232,9 +273,9 @@ void TypeRegistry::print()
 
   for(const auto& [name, info] : classes)
   {
-    std::cout << "class " << demangle(name) << (info.base ? " : " + demangle(info.base) : "") << " {";
+    std::cout << "class " << getName(name) << (info.base ? std::string(" : ") + getName(info.base) : "") << " {";
     for(const Attribute& a : info.attributes)
-      std::cout << (&a == info.attributes.data() ? "" : " ") << demangle(a.type) << " " << a.name << ";";
+      std::cout << (&a == info.attributes.data() ? "" : " ") << getName(a.type) << " " << a.name << ";";
     std::cout << "}" << std::endl;
   }
 }
@@ -242,11 +283,11 @@ void TypeRegistry::print()
 void TypeRegistry::fill(TypeInfo& typeInfo)
 {
   for(const char* primitive : primitives)
-    typeInfo.primitives.insert(demangle(primitive));
+    typeInfo.primitives.insert(getName(primitive));
 
   for(const auto& [name, constants] : enums)
   {
-    std::vector<std::string>& targetConstants = typeInfo.enums[demangle(name)];
+    std::vector<std::string>& targetConstants = typeInfo.enums[getName(name)];
     targetConstants.reserve(constants.byOrder.size());
     for(const std::string& constant : constants.byOrder)
       targetConstants.emplace_back(constant);
@@ -254,13 +295,13 @@ void TypeRegistry::fill(TypeInfo& typeInfo)
 
   for(const auto& [name, _] : classes)
   {
-    std::vector<TypeInfo::Attribute>& attributes = typeInfo.classes[demangle(name)];
+    std::vector<TypeInfo::Attribute>& attributes = typeInfo.classes[getName(name)];
     std::list<const char*> hierarchy;
     hierarchy.push_front(name);
     while(classes[hierarchy.front()].base)
       hierarchy.push_front(classes[hierarchy.front()].base);
     for(const auto& entry : hierarchy)
       for(const auto& attribute : classes[entry].attributes)
-        attributes.emplace_back(demangle(attribute.type), attribute.name);
+        attributes.emplace_back(getName(attribute.type), attribute.name);
   }
 }
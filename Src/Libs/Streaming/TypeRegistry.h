@@ -12,14 +12,40 @@
 
 #pragma once
 
+#include "Streaming/TypeName.h"
 #include <string>
+#include <type_traits>
 #include <typeinfo>
+#include <utility>
+#include <vector>
 
 struct TypeInfo;
 
 class TypeRegistry
 {
+  /**
+   * Add the platform independent name of a type to the registry.
+   * @param type The name of the type as returned by typeid().name().
+   * @param name The platform independent name or nullptr if it could not be
+   *             determined at compile time.
+   * @return The parameter type.
+   */
+  static const char* addType(const char* type, const char* name);
+
 public:
+  /**
+   * Add the platform independent name of a type to the registry that was
+   * determined at compile time. All registration macros use this function
+   * to obtain the name of a type they pass to the other functions.
+   * @tparam T The type.
+   * @return The name of the type as returned by typeid().name().
+   */
+  template<typename T> static const char* addType()
+  {
+    constexpr auto& name = Streaming::TypeName<std::remove_cv_t<T>>::value;
+    return addType(typeid(T).name(), name.valid ? name.chars.data() : nullptr);
+  }
+
   /**
    * Add the name of an enumeration to the registry.
    * Must only be called once for each enumeration type.
@@ -83,8 +109,37 @@ public:
    */
   static int getEnumValue(const char* enumeration, const std::string& name);
 
+  /**
+   * Determine the platform independent name of a type.
+   * @param type The name of the type as returned by typeid().name().
+   * @return The name determined at compile time. If there is none, the
+   *         type is demangled once.
+   */
+  static const char* getName(const char* type);
+
+  /**
+   * Determine the platform independent name of a type.
+   * @tparam T The type.
+   * @return The name determined at compile time. If there is none, the
+   *         type is demangled once.
+   */
+  template<typename T> static const char* getName()
+  {
+    constexpr auto& name = Streaming::TypeName<std::remove_cv_t<T>>::value;
+    return name.valid ? name.chars.data() : getName(typeid(T).name());
+  }
+
+  /**
+   * Returns all names added that were determined at compile time.
+   * @return Pairs of the names returned by typeid().name() and the
+   *         platform independent names.
+   */
+  static std::vector<std::pair<const char*, const char*>> getNames();
+
   /**
    * Converts a string returned by typeid().name() into a platform independent one.
+   * This is only required for types whose names cannot be determined at compile
+   * time (see Streaming/TypeName.h).
    * @param type A type name created on this platform.
    * @return A platform independent, human-readable type name.
    */
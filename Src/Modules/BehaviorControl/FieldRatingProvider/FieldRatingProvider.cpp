@@ -55,14 +55,7 @@ void FieldRatingProvider::update(FieldRating& fieldRating)
 {
   ASSERT(interpolationZoneInOwnHalf > 0.f);
 
-  fieldRating.potentialFieldOnly = [this](const float x, const float y, const bool calculateFieldDirection)
-  {
-    PotentialValue pv;
-    pv += getFieldBorderPotential(x, y, calculateFieldDirection);
-    pv += getGoalPotential(x, y, calculateFieldDirection);
-    pv += getGoalAnglePotential(x, y, calculateFieldDirection);
-    return pv;
-  };
+  fieldRating.potentialFieldOnly = std::ref(potentialFieldOnly);
 
   fieldRating.getObstaclePotential = [this](PotentialValue& pv, const float x, const float y, const bool calculateFieldDirection)
   {
@@ -17,6 +17,7 @@
 #include "Representations/Modeling/GlobalTeammatesModel.h"
 #include "Representations/Modeling/ObstacleModel.h"
 #include "Representations/Modeling/RobotPose.h"
+#include "Framework/MemoizedFunction.h"
 #include "Framework/Module.h"
 #include <vector>
 #include "Debugging/ColorRGBA.h"
@@ -114,6 +115,18 @@ public:
   FieldRatingProvider();
 
 private:
+  /** The potential of the field without obstacles. It is requested many times per frame for the same positions. */
+  MemoizedFunction<PotentialValue(const float x, const float y, const bool calculateFieldDirection)> potentialFieldOnly
+  {
+    "FieldRating:potentialFieldOnly", [this](const float x, const float y, const bool calculateFieldDirection)
+    {
+      PotentialValue pv;
+      pv += getFieldBorderPotential(x, y, calculateFieldDirection);
+      pv += getGoalPotential(x, y, calculateFieldDirection);
+      pv += getGoalAnglePotential(x, y, calculateFieldDirection);
+      return pv;
+    }
+  };
 
   bool fieldBorderDrawing = false;
   bool goalDrawing = false;
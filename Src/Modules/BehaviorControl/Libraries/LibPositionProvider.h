@@ -17,7 +17,7 @@ MODULE(LibPositionProvider,
 {,
   REQUIRES(FieldDimensions),
   REQUIRES(RobotPose),
-  PROVIDES(LibPosition),
+  PROVIDES_ONCE(LibPosition),
 });
 
 class LibPositionProvider : public LibPositionProviderBase
@@ -43,12 +43,12 @@ struct TeamMessage
 void TeamMessageHandler::regTeamMessage()
 {
   PUBLISH(regTeamMessage);
-  const char* name = typeid(TeamMessage).name();
+  const char* name = TypeRegistry::addType<TeamMessage>();
   TypeRegistry::addClass(name, nullptr);
 #define REGISTER_TEAM_MESSAGE_REPRESENTATION(x) \
-  TypeRegistry::addAttribute(name, (std::string(#x) == "Whistle" ? typeid(WhistleCompact) : typeid(x)).name(), "the" #x)
+  TypeRegistry::addAttribute(name, std::string(#x) == "Whistle" ? TypeRegistry::addType<WhistleCompact>() : TypeRegistry::addType<x>(), "the" #x)
 
-  TypeRegistry::addAttribute(name, typeid(RobotPoseCompact).name(), "theRobotPose");
+  TypeRegistry::addAttribute(name, TypeRegistry::addType<RobotPoseCompact>(), "theRobotPose");
   FOREACH_TEAM_MESSAGE_REPRESENTATION(REGISTER_TEAM_MESSAGE_REPRESENTATION);
 }
 
@@ -74,8 +74,11 @@ void TeamMessageHandler::update(BHumanMessageOutputGenerator& outputGenerator)
 {
   DECLARE_PLOT("module:TeamMessageHandler:messageLength");
   DECLARE_PLOT("module:TeamMessageHandler:budgetLimit");
+  DECLARE_PLOT("module:TeamMessageHandler:informationValue");
+  DECLARE_PLOT("module:TeamMessageHandler:messagePrice");
   DECLARE_DEBUG_RESPONSE("module:TeamMessageHandler:statistics");
   MODIFY("module:TeamMessageHandler:statistics", statistics);
+  MODIFY("module:TeamMessageHandler:evaluation", evaluation);
 
   DEBUG_RESPONSE("module:TeamMessageHandler:budgetLimit")
   {
@@ -115,6 +118,8 @@ void TeamMessageHandler::update(BHumanMessageOutputGenerator& outputGenerator)
   if(!globalBearingsChanged(theRobotPose, ballEndPosition, theRobotPose, teamBallEndPosition, mapToRange(ballEndPosition.norm(), teamBallDistanceInterpolationRange.min, teamBallDistanceInterpolationRange.max, positionThreshold, teamBallMaxPositionThreshold)))
     timeWhenBallWasNearTeamBall = theFrameInfo.time;
 
+  updateEvaluation();
+
   outputGenerator.sendThisFrame = [this]
   {
     bool alwaysSend = this->alwaysSend;
@@ -129,7 +134,8 @@ void TeamMessageHandler::update(BHumanMessageOutputGenerator& outputGenerator)
     const bool indirectKickChangedSend = theGameState.isPlaying() && withinPriorityBudget() && indirectKickChanged();
     const bool canSendPriorityMessage = stateAllowsSending && (alwaysSendAllowed || alwaysSendPlaying || signalDetectedSend || whistleDetectedSend || indirectKickChangedSend || returnFromPenalty);
     const bool normalChangeDetected = stateAllowsSending && enoughTimePassed() && theGameState.isPlaying() && robotPoseValid() && withinOverallBudget() &&
-    (behaviorStatusChanged() || robotStatusChanged() || strategyStatusChanged() || robotPoseChanged() || ballModelChanged() || teamBallOld());
+    (useInformationValue ? informationValue() >= minInformationValue * messagePrice()
+     : behaviorStatusChanged() || robotStatusChanged() || strategyStatusChanged() || robotPoseChanged() || ballModelChanged() || teamBallOld());
 
     if(!canSendPriorityMessage && !normalChangeDetected)
       setTimeDelay();
@@ -151,6 +157,8 @@ void TeamMessageHandler::update(BHumanMessageOutputGenerator& outputGenerator)
       return;
     wasPenalized = false;
     theTeamMessageChannel.send();
+    if(theGameState.isPlaying())
+      ++evaluation.messages;
     setTimeDelay();
     ownModeledBudget -= std::min(ownModeledBudget, 1u);
 
@@ -631,3 +639,78 @@ bool TeamMessageHandler::indirectKickChanged() const
 {
   return theIndirectKick.lastKickTimestamp > lastSent.theIndirectKick.lastKickTimestamp && !theIndirectKick.allowDirectKick && lastSent.theIndirectKick.lastKickTimestamp < theIndirectKick.lastSetPlayTime; // lastSetPlayTime checks every GameState change
 }
+
+float TeamMessageHandler::poseError() const
+{
+  const Vector2f estimatedPosition = Teammate::getEstimatedPosition(lastSent.theRobotPose,
+                                                                    lastSent.theBehaviorStatus.walkingTo,
+                                                                    lastSent.theBehaviorStatus.speed,
+                                                                    theFrameInfo.getTimeSince(lastSent.theFrameInfo.time));
+  return (theRobotPose.translation - estimatedPosition).norm();
+}
+
+float TeamMessageHandler::ballError() const
+{
+  const Vector2f ballEndPosition = BallPhysics::getEndPosition(theBallModel.estimate.position,
+                                                               theBallModel.estimate.velocity,
+                                                               theBallSpecification.friction);
+  const Vector2f oldBallEndPosition = BallPhysics::getEndPosition(lastSent.theBallModel.estimate.position,
+                                                                  lastSent.theBallModel.estimate.velocity,
+                                                                  theBallSpecification.friction);
+  return (theRobotPose * ballEndPosition - lastSent.theRobotPose * oldBallEndPosition).norm();
+}
+
+float TeamMessageHandler::informationValue() const
+{
+  // The own position is only relevant if teammates would actually see the difference.
+  float value = robotPoseChanged() ? poseError() / positionThreshold : 0.f;
+
+  // Balls are only worth reporting if they are new and the team does not agree on them already.
+  if((theFrameInfo.getTimeSince(theBallModel.timeWhenDisappeared) < disappearedThreshold) !=
+     (lastSent.theFrameInfo.getTimeSince(lastSent.theBallModel.timeWhenDisappeared) < disappearedThreshold))
+    value += statusChangeValue;
+  else if(theBallModel.timeWhenLastSeen != lastSent.theBallModel.timeWhenLastSeen &&
+          (!theTeamBallModel.isValid || theFrameInfo.getTimeSince(timeWhenBallWasNearTeamBall) > minTimeBallIsNotNearTeamBall))
+  {
+    const float distance = BallPhysics::getEndPosition(theBallModel.estimate.position, theBallModel.estimate.velocity,
+                                                       theBallSpecification.friction).norm();
+    value += ballError() / mapToRange(distance, teamBallDistanceInterpolationRange.min, teamBallDistanceInterpolationRange.max,
+                                      positionThreshold, teamBallMaxPositionThreshold);
+  }
+
+  if(behaviorStatusChanged() || robotStatusChanged() || strategyStatusChanged())
+    value += statusChangeValue;
+  if(teamBallOld())
+    value += teamBallOldValue;
+
+  PLOT("module:TeamMessageHandler:informationValue", value);
+  return value;
+}
+
+float TeamMessageHandler::messagePrice() const
+{
+  const float nominalSendInterval = (durationOfHalf + maxOvertime) * 2.f / (overallMessageBudget - normalMessageReserve);
+  const float messagesNeeded = TeamMessageHandler::remainingTime(0) / nominalSendInterval;
+  const float price = ownModeledBudget > normalMessageReserve ? messagesNeeded / (ownModeledBudget - normalMessageReserve)
+                      : std::numeric_limits<float>::max();
+
+  PLOT("module:TeamMessageHandler:messagePrice", std::min(price, 100.f));
+  return price;
+}
+
+void TeamMessageHandler::updateEvaluation()
+{
+  const int timePassed = theFrameInfo.getTimeSince(timeWhenLastEvaluated);
+  timeWhenLastEvaluated = theFrameInfo.time;
+  if(!theGameState.isPlaying() || theGameState.isPenalized() || timePassed <= 0 || timePassed > 1000)
+    return;
+
+  evaluation.playingTime += timePassed;
+  const float weight = static_cast<float>(timePassed) / evaluation.playingTime;
+  const float poseError = TeamMessageHandler::poseError();
+  evaluation.meanPoseError += (poseError - evaluation.meanPoseError) * weight;
+  evaluation.maxPoseError = std::max(evaluation.maxPoseError, poseError);
+  if(theFrameInfo.getTimeSince(theBallModel.timeWhenLastSeen) < disappearedThreshold)
+    evaluation.meanBallError += (ballError() - evaluation.meanBallError) * weight;
+  evaluation.messagesPerMinute = evaluation.messages * 60000.f / evaluation.playingTime;
+}
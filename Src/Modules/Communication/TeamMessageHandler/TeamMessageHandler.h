@@ -103,6 +103,10 @@ MODULE(TeamMessageHandler,
     (bool) dropUnsynchronizedMessages, /**< Whether messages in which timestamps cannot be converted should be dropped. */
     (bool) alwaysSend, /**< Send every second. */
     (bool) alwaysSendInPlaying, /**< Send every second. */
+    (bool) useInformationValue, /**< Decide on normal messages by the value of the information teammates lack rather than by individual change triggers. */
+    (float) minInformationValue, /**< The information value required for sending a normal message if the budget is spent at the nominal rate. */
+    (float) statusChangeValue, /**< The information value of a changed behavior, robot, or strategy status. */
+    (float) teamBallOldValue, /**< The information value of a ball that the team has not communicated for a while. */
   }),
 });
 
@@ -176,11 +180,28 @@ private:
     std::map<std::string, unsigned> counters; /**< The counters. */
   };
 
+  /**
+   * Measures how much of the budget is used and how well the teammates know the
+   * state of this robot. It is accumulated while playing, e.g. when replaying a
+   * log, to compare different settings for sending messages.
+   */
+  STREAMABLE(Evaluation,
+  {,
+    (unsigned)(0) messages, /**< The number of messages sent while playing. */
+    (unsigned)(0) playingTime, /**< The time spent playing (in ms). */
+    (float)(0.f) messagesPerMinute, /**< The average send rate while playing. */
+    (float)(0.f) meanPoseError, /**< The average error of the position teammates assume for this robot (in mm). */
+    (float)(0.f) meanBallError, /**< The average error of the ball teammates last got from this robot (in mm). */
+    (float)(0.f) maxPoseError, /**< The maximum error of the position teammates assume for this robot (in mm). */
+  });
+
   TeamMessageChannel::Container inTeamMessage;
   TeamMessageChannel::Container outTeamMessage;
   TeamMessageChannel theTeamMessageChannel;
 
   Statistics statistics; /**< The change statistics. */
+  Evaluation evaluation; /**< The budget use and the error of the teammates' model of this robot. */
+  unsigned timeWhenLastEvaluated = 0; /**< The time when the evaluation was last updated. */
   SentTeamMessage lastSent; /**< Last team message that was sent. */
 
   GameControllerRBS theGameControllerRBS;
@@ -363,6 +384,37 @@ private:
   /** Is the team ball old and we know better? */
   bool teamBallOld() const;
 
+  /**
+   * Returns how far the position teammates assume for this robot is off.
+   * They extrapolate it from the last message sent.
+   * @return The distance between the assumed and the actual position (in mm).
+   */
+  float poseError() const;
+
+  /**
+   * Returns how far the ball end position last sent is off from the current one.
+   * @return The distance between both global end positions (in mm).
+   */
+  float ballError() const;
+
+  /**
+   * Estimates the value of the information teammates would get from a message now.
+   * Errors are measured relative to their thresholds, i.e. a value of 1 corresponds
+   * to an error that has just become relevant.
+   * @return The information value.
+   */
+  float informationValue() const;
+
+  /**
+   * Returns the price of a message, i.e. the ratio between the messages needed to
+   * send at the nominal rate for the rest of the game and the messages left.
+   * @return The price. It is 1 if the budget is spent as planned.
+   */
+  float messagePrice() const;
+
+  /** Accumulates the budget use and the errors of the teammates' model while playing. */
+  void updateEvaluation();
+
   /** Did LastKickTimestamp from IndirectKick.h change? */
   bool indirectKickChanged() const;
 
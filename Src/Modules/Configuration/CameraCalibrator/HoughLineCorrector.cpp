@@ -11,10 +11,11 @@
 #include "HoughLineCorrector.h"
 #include "Debugging/DebugDrawings.h"
 #include "Math/Geometry.h"
+#include "ImageProcessing/SIMD.h"
 #include "Tools/Math/Transformation.h"
 #include <algorithm>
 #include <cmath>
-#include <limits>
+#include <cstring>
 
 MAKE_MODULE(HoughLineCorrector);
 
@@ -118,12 +119,12 @@ bool HoughLineCorrector::fitLine(LineCorrector::Line& cline) const
 
   // Calculate the values in the hough space
   const int dMax = static_cast<int>(std::ceil(std::hypot(sobelImage.height, sobelImage.width)));
-  std::vector<std::vector<int>> houghSpace(numOfAngles, std::vector<int>(2 * dMax + 1, 0));
-  calcHoughSpace(sobelImage, minIndex, maxIndex, dMax, houghSpace);
+  HoughSpace houghSpace(minIndex, (maxIndex - minIndex + numOfAngles) % numOfAngles, 2 * dMax + 1);
+  calcHoughSpace(sobelImage, dMax, houghSpace);
 
   // Determine the local maxima in the hough space
   std::vector<Maximum> localMaxima;
-  determineLocalMaxima(houghSpace, minIndex, maxIndex, localMaxima);
+  determineLocalMaxima(houghSpace, localMaxima);
 
   if(localMaxima.size() > 1)
   {
@@ -164,83 +165,124 @@ bool HoughLineCorrector::fitLine(LineCorrector::Line& cline) const
 void HoughLineCorrector::extractImagePatch(const Vector2i& start, const Vector2i& size, Sobel::Image1D& grayImage) const
 {
   const ECImage& theECImage = *theOptionalECImage.image;
-  int currentY = start.y();
-  for(int y = 0; y < size.y(); ++y, ++currentY)
-  {
-    if(currentY >= theCameraInfo.height || currentY < 0)
-      continue;
 
-    int currentX = start.x();
-    const PixelTypes::GrayscaledPixel* pix = theECImage.grayscaled[currentY];
-    for(int x = 0; x < size.x(); ++x, ++currentX)
+  // Only the part inside the camera image is copied. The patch is not
+  // initialized, so the rest is set to zero.
+  const int minX = std::clamp(-start.x(), 0, size.x());
+  const int maxX = std::clamp(theCameraInfo.width - start.x(), minX, size.x());
+  const int minY = std::clamp(-start.y(), 0, size.y());
+  const int maxY = std::clamp(theCameraInfo.height - start.y(), minY, size.y());
+  for(int y = 0; y < size.y(); ++y)
+    if(y < minY || y >= maxY || minX == maxX)
+      std::memset(grayImage[y], 0, size.x());
+    else
     {
-      if(currentX < theCameraInfo.width && currentX >= 0)
-        grayImage[y][x] = *(pix + currentX);
+      std::memset(grayImage[y], 0, minX);
+      std::memcpy(grayImage[y] + minX, theECImage.grayscaled[start.y() + y] + start.x() + minX, maxX - minX);
+      std::memset(grayImage[y] + maxX, 0, size.x() - maxX);
     }
-  }
 }
 
-unsigned int HoughLineCorrector::determineSobelThresh(const Sobel::SobelImage& sobelImage) const
+void HoughLineCorrector::determineEdgePixels(const Sobel::SobelImage& sobelImage, const HoughSpace& houghSpace,
+                                             std::vector<float>& xs, std::vector<float>& ys) const
 {
-  unsigned int thresh = 0;
-  for(unsigned int y = 1; y < sobelImage.height - 1; ++y)
-    for(unsigned int x = 1; x < sobelImage.width - 1; ++x)
+  // Compute all squared gradient magnitudes once. They are needed for the threshold and the selection of the edge pixels.
+  const unsigned int width = sobelImage.width - 2;
+  const unsigned int height = sobelImage.height - 2;
+  std::vector<int> magnitudes(width * height);
+  int maxMagnitude = 0;
+  for(unsigned int y = 0; y < height; ++y)
+  {
+    const Sobel::SobelPixel* pixel = sobelImage[y + 1] + 1;
+    int* magnitude = magnitudes.data() + y * width;
+    for(unsigned int x = 0; x < width; ++x)
     {
-      const Sobel::SobelPixel& pixel = sobelImage[y][x];
-      const unsigned int value = pixel.x * pixel.x + pixel.y * pixel.y;
-      if(value > thresh) thresh = value;
+      magnitude[x] = pixel[x].x * pixel[x].x + pixel[x].y * pixel[x].y;
+      maxMagnitude = std::max(maxMagnitude, magnitude[x]);
     }
-  return static_cast<unsigned int>(static_cast<float>(thresh) * sqr(sobelThreshValue));
-}
+  }
+  const int thresh = static_cast<int>(static_cast<float>(maxMagnitude) * sqr(sobelThreshValue));
 
-void HoughLineCorrector::calcHoughSpace(const Sobel::SobelImage& sobelImage, const unsigned int minIndex, const unsigned int maxIndex, const unsigned int dMax, std::vector<std::vector<int> >& houghSpace) const
-{
-  const int thresh = determineSobelThresh(sobelImage);
-  for(unsigned int y = 1; y < sobelImage.height - 1; ++y)
-    for(unsigned int x = 1; x < sobelImage.width - 1; ++x)
-    {
-      const Sobel::SobelPixel& pixel = sobelImage[y][x];
-      if(pixel.x * pixel.x + pixel.y * pixel.y >= thresh)
+  // The gradient of an edge pixel is parallel to the normal of the line it belongs to.
+  // Pixels whose gradient does not fit to any of the angles searched can only contribute noise.
+  const Angle halfRange = static_cast<float>(houghSpace.numOfRows) * 90_deg / static_cast<float>(numOfAngles);
+  const bool checkDirection = maxGradientDeviation + halfRange < 90_deg;
+  const unsigned int centerIndex = (houghSpace.minIndex + houghSpace.numOfRows / 2) % numOfAngles;
+  const float centerCos = cosAngles[centerIndex];
+  const float centerSin = sinAngles[centerIndex];
+  const float sqrMinCos = sqr(std::cos(maxGradientDeviation + halfRange));
+
+  xs.clear();
+  ys.clear();
+  for(unsigned int y = 0; y < height; ++y)
+  {
+    const int* magnitude = magnitudes.data() + y * width;
+    for(unsigned int x = 0; x < width; ++x)
+      if(magnitude[x] >= thresh)
       {
-        for(unsigned int index = minIndex; index != maxIndex; ++index)
+        if(checkDirection)
         {
-          const int d = static_cast<int>(std::ceil(x * cosAngles[index] + y * sinAngles[index]));
-          ++houghSpace[index][d + dMax];
-          if(minIndex > maxIndex && index == numOfAngles - 1)
-            index = std::numeric_limits<unsigned int>::max();
+          const Sobel::SobelPixel& pixel = sobelImage[y + 1][x + 1];
+          if(sqr(pixel.x * centerCos + pixel.y * centerSin) < sqrMinCos * static_cast<float>(magnitude[x]))
+            continue;
         }
+        xs.push_back(static_cast<float>(x + 1));
+        ys.push_back(static_cast<float>(y + 1));
       }
-    }
+  }
 }
 
-void HoughLineCorrector::determineLocalMaxima(const std::vector<std::vector<int> >& houghSpace, const unsigned int minIndex, const unsigned int maxIndex, std::vector<Maximum>& localMaxima) const
+void HoughLineCorrector::calcHoughSpace(const Sobel::SobelImage& sobelImage, const unsigned int dMax, HoughSpace& houghSpace) const
 {
-  const int maxDisIndex = static_cast<int>(houghSpace[0].size());
-  auto localMaximum = [&houghSpace, maxDisIndex](const int value, const int angleIndex, const int distanceIndex, const int numOfAngles) -> bool
+  std::vector<float> xs, ys;
+  determineEdgePixels(sobelImage, houghSpace, xs, ys);
+  const size_t numOfPixels = xs.size();
+  const size_t numOfPixels4 = numOfPixels & ~size_t(3);
+
+  alignas(16) int distances[4];
+  for(unsigned int row = 0; row < houghSpace.numOfRows; ++row)
   {
-    for(int i = -1; i <= 1; ++i)
+    const unsigned int index = (houghSpace.minIndex + row) % numOfAngles;
+    const float cosAngle = cosAngles[index];
+    const float sinAngle = sinAngles[index];
+    int* votes = houghSpace[row] + dMax;
+
+    // d = ceil(x * cos + y * sin) for four pixels at once. Ceil is emulated by rounding towards zero and
+    // adding one where this rounded down, which gives exactly the same results as std::ceil.
+    const __m128 cos4 = _mm_set1_ps(cosAngle);
+    const __m128 sin4 = _mm_set1_ps(sinAngle);
+    for(size_t i = 0; i < numOfPixels4; i += 4)
     {
-      int index = ((angleIndex + i) + numOfAngles) % numOfAngles;
-      for(int j = std::max(0, distanceIndex - 1); j <= std::min(maxDisIndex - 1, distanceIndex + 1); ++j)
-      {
-        if(index == angleIndex && j == distanceIndex)
-          continue;
-        if(houghSpace[index][j] > value)
-          return false;
-      }
+      const __m128 d = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(xs.data() + i), cos4), _mm_mul_ps(_mm_loadu_ps(ys.data() + i), sin4));
+      const __m128i truncated = _mm_cvttps_epi32(d);
+      _mm_store_si128(reinterpret_cast<__m128i*>(distances),
+                      _mm_sub_epi32(truncated, _mm_castps_si128(_mm_cmplt_ps(_mm_cvtepi32_ps(truncated), d))));
+      ++votes[distances[0]];
+      ++votes[distances[1]];
+      ++votes[distances[2]];
+      ++votes[distances[3]];
     }
-    return true;
-  };
+    for(size_t i = numOfPixels4; i < numOfPixels; ++i)
+      ++votes[static_cast<int>(std::ceil(xs[i] * cosAngle + ys[i] * sinAngle))];
+  }
+}
 
-  for(unsigned int angleIndex = minIndex; angleIndex != maxIndex; ++angleIndex)
+void HoughLineCorrector::determineLocalMaxima(const HoughSpace& houghSpace, std::vector<Maximum>& localMaxima) const
+{
+  const int numOfDistances = static_cast<int>(houghSpace.numOfDistances);
+  for(int row = 0; row < static_cast<int>(houghSpace.numOfRows); ++row)
   {
-    for(int distanceIndex = 0; distanceIndex < maxDisIndex; ++distanceIndex)
+    const int* above = houghSpace[row - 1];
+    const int* current = houghSpace[row];
+    const int* below = houghSpace[row + 1];
+    for(int distanceIndex = 0; distanceIndex < numOfDistances; ++distanceIndex)
     {
-      int value = houghSpace[angleIndex][distanceIndex];
-      if(value != 0 && localMaximum(value, angleIndex, distanceIndex, numOfAngles))
-        localMaxima.push_back({ static_cast<unsigned>(value), static_cast<unsigned>(angleIndex), static_cast<unsigned>(distanceIndex) });
+      const int value = current[distanceIndex];
+      if(value != 0
+         && above[distanceIndex - 1] <= value && above[distanceIndex] <= value && above[distanceIndex + 1] <= value
+         && current[distanceIndex - 1] <= value && current[distanceIndex + 1] <= value
+         && below[distanceIndex - 1] <= value && below[distanceIndex] <= value && below[distanceIndex + 1] <= value)
+        localMaxima.push_back({static_cast<unsigned>(value), (houghSpace.minIndex + row) % numOfAngles, static_cast<unsigned>(distanceIndex)});
     }
-    if(minIndex > maxIndex && angleIndex == numOfAngles - 1)
-      angleIndex = -1;
   }
 }
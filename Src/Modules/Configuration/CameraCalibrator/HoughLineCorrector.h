@@ -36,6 +36,7 @@ MODULE(HoughLineCorrector,
     (float)(0.25f) sobelThreshValue, /**< The minimum ratio of the maximum pixel value in the Sobel image for a pixel to be considered an edge pixel. */
     (float)(2000.f) maxLineLength, /**< If detected lines are too long, the fitting algorithm could fit them wrong and end up not parallel to the real line. */
     (int)(2) minDisImage, /**< Minimum distance that lines in hough space should have in the image. */
+    (Angle)(90_deg) maxGradientDeviation, /**< Edge pixels only vote if their gradient direction deviates at most this much from the range of angles searched (90° = all pixels vote). */
   }),
 });
 
@@ -53,6 +54,27 @@ private:
     unsigned int distanceIndex; /**< The distance index of the local maximum in the hough space. */
   };
 
+  /**
+   * The accumulator of the hough lines transformation. It only contains the range of angles
+   * searched and is surrounded by a border of zeros, so that the neighbors of each cell can be
+   * accessed without range checks.
+   */
+  struct HoughSpace
+  {
+    unsigned int minIndex; /**< The angle index of the first row. */
+    unsigned int numOfRows; /**< The number of angles searched. */
+    unsigned int numOfDistances; /**< The number of distance indices per angle. */
+    std::vector<int> accumulator; /**< All cells row by row, including the border. */
+
+    HoughSpace(unsigned int minIndex, unsigned int numOfRows, unsigned int numOfDistances)
+      : minIndex(minIndex), numOfRows(numOfRows), numOfDistances(numOfDistances),
+        accumulator((numOfRows + 2) * (numOfDistances + 2), 0) {}
+
+    /** Returns the first cell of a row, i.e. the one with distance index 0. */
+    int* operator[](int row) { return accumulator.data() + (row + 1) * (numOfDistances + 2) + 1; }
+    const int* operator[](int row) const { return accumulator.data() + (row + 1) * (numOfDistances + 2) + 1; }
+  };
+
   void update(LineCorrector& lineCorrector) override;
 
   /** Fills the sine/cosine lookup tables. */
@@ -76,32 +98,33 @@ private:
   void extractImagePatch(const Vector2i& start, const Vector2i& size, Sobel::Image1D& grayImage) const;
 
   /**
-   * Determines a suitable threshold at which a pixel in the hough transformation is assumed to be an edge given the Sobel image.
+   * Determines the edge pixels in the Sobel image. A pixel is assumed to be an edge if its squared
+   * gradient magnitude exceeds a ratio of the maximum one and if its gradient direction roughly fits
+   * the range of angles searched.
    * @param sobelImage The Sobel image used in the hough transformation.
-   * @return The selected threshold value.
+   * @param houghSpace The hough space that defines the range of angles searched.
+   * @param xs The x coordinates of the edge pixels are returned here.
+   * @param ys The y coordinates of the edge pixels are returned here.
    */
-  unsigned int determineSobelThresh(const Sobel::SobelImage& sobelImage) const;
+  void determineEdgePixels(const Sobel::SobelImage& sobelImage, const HoughSpace& houghSpace,
+                           std::vector<float>& xs, std::vector<float>& ys) const;
 
   /**
    * Performs the hough lines transformation to find lines in the given Sobel image.
+   * The transformation is done angle by angle, so that only a single row of the hough
+   * space is accessed at a time, and the distances for four pixels are computed at once.
    * @param sobelImage The Sobel image in which lines should be searched.
-   * @param minIndex The minimum angle index to be considered.
-   * @param maxIndex The maximum angle index to be considered.
    * @param dMax The maximum distance a line can possibly have in the given Sobel image.
    * @param houghSpace The hough space to be calculated.
    */
-  void calcHoughSpace(const Sobel::SobelImage& sobelImage, unsigned int minIndex, unsigned int maxIndex,
-                      unsigned int dMax, std::vector<std::vector<int> >& houghSpace) const;
+  void calcHoughSpace(const Sobel::SobelImage& sobelImage, unsigned int dMax, HoughSpace& houghSpace) const;
 
   /**
    * Searches the hough space for local maxima.
    * @param houghSpace The hough space to be searched.
-   * @param minIndex The minimum angle index from which the hough space is to be considered.
-   * @param maxIndex The maximum angle index up to which the hough space is to be considered.
    * @param localMaxima The Container in which the local maxima should be stored.
    */
-  void determineLocalMaxima(const std::vector<std::vector<int> >& houghSpace, unsigned int minIndex,
-                            unsigned int maxIndex, std::vector<Maximum>& localMaxima) const;
+  void determineLocalMaxima(const HoughSpace& houghSpace, std::vector<Maximum>& localMaxima) const;
 
   std::vector<float> cosAngles, sinAngles; /**< The sine/cosine lookup tables used in the hough lines transformation. */
 };
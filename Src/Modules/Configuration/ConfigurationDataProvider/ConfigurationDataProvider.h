@@ -109,7 +109,7 @@ private:
   {
     ASSERT(!theRepresentation);
     theRepresentation = std::make_unique<T>();
-    loadModuleParameters(*theRepresentation, TypeRegistry::demangle(typeid(T).name()).c_str(), fileName);
+    loadModuleParameters(*theRepresentation, TypeRegistry::getName<T>(), fileName);
   }
 
 public:
@@ -129,13 +129,13 @@ void RealSenseProvider::Settings::reg()
       case autoExposure:
       case autoWhiteBalance:
       case autoExposurePriority:
-        TypeRegistry::addAttribute(_type, typeid(bool).name(), TypeRegistry::getEnumName(setting));
+        TypeRegistry::addAttribute(_type, TypeRegistry::addType<bool>(), TypeRegistry::getEnumName(setting));
         break;
       case powerLineFrequency:
-        TypeRegistry::addAttribute(_type, typeid(PowerLineFrequency).name(), TypeRegistry::getEnumName(setting));
+        TypeRegistry::addAttribute(_type, TypeRegistry::addType<PowerLineFrequency>(), TypeRegistry::getEnumName(setting));
         break;
       default:
-        TypeRegistry::addAttribute(_type, typeid(int).name(), TypeRegistry::getEnumName(setting));
+        TypeRegistry::addAttribute(_type, TypeRegistry::addType<int>(), TypeRegistry::getEnumName(setting));
     }
 }
 
@@ -2,7 +2,11 @@
  * @file PerceptionProviders.cpp
  *
  * This file implements all modules that provide representations from perception
- * for the current Cognition frame.
+ * for the current Cognition frame. If the frame fuses the frames of both
+ * cameras, the percepts used for modeling also contain those from the older
+ * image. They are moved to the time of the newer image based on the odometry
+ * between both. Image coordinates still refer to the older image, whose view
+ * is provided as OtherCameraView.
  *
  * @author Thomas Röfer
  */
@@ -12,6 +16,7 @@
 #include "Representations/Infrastructure/CameraInfo.h"
 #include "Representations/Infrastructure/CameraStatus.h"
 #include "Representations/Infrastructure/JPEGImage.h"
+#include "Representations/MotionControl/OdometryData.h"
 #include "Representations/Perception/BallPercepts/BallPercept.h"
 #include "Representations/Perception/FieldPercepts/CirclePercept.h"
 #include "Representations/Perception/FieldPercepts/FieldLines.h"
@@ -23,9 +28,11 @@
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
 #include "Representations/Perception/ImagePreprocessing/ECImage.h"
 #include "Representations/Perception/ImagePreprocessing/FieldBoundary.h"
+#include "Representations/Perception/ImagePreprocessing/OtherCameraView.h"
 #include "Representations/Perception/ObstaclesPercepts/ObstaclesFieldPercept.h"
 #include "Representations/Perception/ObstaclesPercepts/ObstaclesImagePercept.h"
 #include "Threads/Cognition.h"
+#include "Tools/Modeling/PerceptFusion.h"
 
 // The perception threads already draw these representations
 #undef _MODULE_DRAW
@@ -103,21 +110,119 @@ MAKE_MODULE(UpperFrameInfoProvider);
   \
   ALIAS_MODULE(Representation)
 
+// The odometry at the times of both images is needed to fuse them
+DECLARE(OdometryData);
+
+// Define an alias module that also adds the percepts from the older image in fused frames
+#define FUSED_ALIAS(Representation) \
+  DECLARE(Representation); \
+  \
+  MODULE(Perception##Representation##Provider, \
+  {, \
+    REQUIRES(LowerOdometryData), \
+    REQUIRES(UpperOdometryData), \
+    SELECTS(Representation), \
+  }); \
+  \
+  class Perception##Representation##Provider : public Perception##Representation##ProviderBase \
+  { \
+    void update(Representation& the##Representation) override \
+    { \
+      if(Cognition::isUpper) \
+        the##Representation = theUpper##Representation; \
+      else \
+        the##Representation = theLower##Representation; \
+      if(Cognition::fused) \
+        PerceptFusion::fuse(the##Representation, \
+                            Cognition::isUpper ? static_cast<const Representation&>(theLower##Representation) : theUpper##Representation, \
+                            Cognition::isUpper ? PerceptFusion::olderToNewer(theUpperOdometryData, theLowerOdometryData) \
+                                               : PerceptFusion::olderToNewer(theLowerOdometryData, theUpperOdometryData)); \
+    } \
+  }; \
+  \
+  MAKE_MODULE(Perception##Representation##Provider)
+
 ALIAS_MODULE(FrameInfo);
-ALIAS(BallPercept);
+FUSED_ALIAS(BallPercept);
 ALIAS(BodyContour);
 ALIAS(CameraInfo);
 ALIAS(CameraMatrix);
 ALIAS(CameraStatus);
-ALIAS(CirclePercept);
+FUSED_ALIAS(CirclePercept);
 ALIAS(FieldBoundary);
-ALIAS(FieldLines);
-ALIAS(FieldLineIntersections);
+FUSED_ALIAS(FieldLines);
+FUSED_ALIAS(FieldLineIntersections);
 ALIAS(IntersectionsPercept);
 ALIAS(JPEGImage);
 ALIAS(LinesPercept);
-ALIAS(ObstaclesFieldPercept);
+FUSED_ALIAS(ObstaclesFieldPercept);
 ALIAS(ObstaclesImagePercept);
 ALIAS(OptionalECImage);
-ALIAS(PenaltyMarkPercept);
+FUSED_ALIAS(PenaltyMarkPercept);
 ALIAS(RobotCameraMatrix);
+
+MODULE(PerceptionOtherCameraViewProvider,
+{,
+  REQUIRES(LowerBallPercept),
+  REQUIRES(LowerCameraInfo),
+  REQUIRES(LowerCameraMatrix),
+  REQUIRES(LowerFieldBoundary),
+  REQUIRES(LowerImageCoordinateSystem),
+  REQUIRES(LowerObstaclesImagePercept),
+  REQUIRES(LowerOdometryData),
+  REQUIRES(UpperBallPercept),
+  REQUIRES(UpperCameraInfo),
+  REQUIRES(UpperCameraMatrix),
+  REQUIRES(UpperFieldBoundary),
+  REQUIRES(UpperImageCoordinateSystem),
+  REQUIRES(UpperObstaclesImagePercept),
+  REQUIRES(UpperOdometryData),
+  PROVIDES(OtherCameraView),
+});
+
+class PerceptionOtherCameraViewProvider : public PerceptionOtherCameraViewProviderBase
+{
+  void update(OtherCameraView& theOtherCameraView) override
+  {
+    theOtherCameraView.isValid = Cognition::fused;
+    if(!Cognition::fused)
+      theOtherCameraView.providesBallPercept = false;
+    else if(Cognition::isUpper)
+      update(theOtherCameraView, theLowerBallPercept, theUpperBallPercept, theLowerCameraInfo, theLowerCameraMatrix,
+             theLowerImageCoordinateSystem, theLowerFieldBoundary, theLowerObstaclesImagePercept,
+             PerceptFusion::olderToNewer(theUpperOdometryData, theLowerOdometryData));
+    else
+      update(theOtherCameraView, theUpperBallPercept, theLowerBallPercept, theUpperCameraInfo, theUpperCameraMatrix,
+             theUpperImageCoordinateSystem, theUpperFieldBoundary, theUpperObstaclesImagePercept,
+             PerceptFusion::olderToNewer(theLowerOdometryData, theUpperOdometryData));
+  }
+
+  /**
+   * Sets the view of the camera that took the older image. All parameters
+   * except for the ball percept from the newer image stem from the older image.
+   * @param view The view that is set.
+   * @param olderBallPercept The ball percept from the older image.
+   * @param newerBallPercept The ball percept from the newer image.
+   * @param cameraInfo The camera that took the older image.
+   * @param cameraMatrix The camera matrix of the older image.
+   * @param imageCoordinateSystem The image coordinate system of the older image.
+   * @param fieldBoundary The field boundary in the older image.
+   * @param obstaclesImagePercept The obstacles in the older image.
+   * @param offset The offset between both images.
+   */
+  static void update(OtherCameraView& view, const BallPercept& olderBallPercept, const BallPercept& newerBallPercept,
+                     const CameraInfo& cameraInfo, const CameraMatrix& cameraMatrix,
+                     const ImageCoordinateSystem& imageCoordinateSystem, const FieldBoundary& fieldBoundary,
+                     const ObstaclesImagePercept& obstaclesImagePercept, const Pose2f& offset)
+  {
+    view.providesBallPercept = PerceptFusion::isBetter(olderBallPercept, newerBallPercept);
+    view.cameraInfo = cameraInfo;
+    view.cameraMatrix = PerceptFusion::moveToNewer(cameraMatrix, offset);
+    view.imageCoordinateSystem = imageCoordinateSystem;
+    view.imageCoordinateSystem.cameraInfo = cameraInfo;
+    view.fieldBoundary = fieldBoundary;
+    view.obstaclesImagePercept = obstaclesImagePercept;
+  }
+};
+
+MAKE_MODULE(PerceptionOtherCameraViewProvider);
@@ -12,8 +12,11 @@
 #include "Debugging/Debugging.h"
 #include "Debugging/DebugImages.h"
 #include "Debugging/Plot.h"
+#include "Framework/LogReplayBarrier.h"
 #include "Framework/ModuleContainer.h"
 #include "Streaming/Global.h"
+#include "Streaming/InStreams.h"
+#include "Streaming/OutStreams.h"
 #include "Streaming/Streamable.h"
 
 #include <algorithm>
@@ -137,6 +140,30 @@ void LogDataProvider::readMessage(MessageQueue::Message message, Streamable& rep
   }
 }
 
+void LogDataProvider::handleCheckpoint(MessageQueue::Message message)
+{
+  bool restore;
+  unsigned frame;
+  message.bin() >> restore >> frame;
+  if(restore)
+  {
+    const auto checkpoint = checkpoints.find(frame);
+    if(checkpoint == checkpoints.end())
+      OUTPUT_WARNING("No checkpoint for frame " << frame << " available");
+    else
+    {
+      InBinaryMemory stream(checkpoint->second.data(), checkpoint->second.size());
+      ModuleGraphRunner::getInstance().readCheckpoint(stream);
+    }
+  }
+  else
+  {
+    OutBinaryMemory stream;
+    ModuleGraphRunner::getInstance().writeCheckpoint(stream);
+    checkpoints[frame].assign(stream.data(), stream.data() + stream.size());
+  }
+}
+
 bool LogDataProvider::handleMessage(MessageQueue::Message message)
 {
   return theInstance && theInstance->handleMessage2(message);
@@ -152,8 +179,7 @@ bool LogDataProvider::isFrameDataComplete(bool ack)
   {
     if(ack)
     {
-      if(SystemCall::getMode() == SystemCall::logFileReplay)
-        OUTPUT(idLogResponse, bin, '\0');
+      LogReplayBarrier::accept();
       theInstance->frameDataComplete = false;
     }
     return true;
@@ -236,6 +262,10 @@ bool LogDataProvider::handleMessage2(MessageQueue::Message message)
       frameDataComplete = true;
       return true;
 
+    case idLogCheckpoint:
+      handleCheckpoint(message);
+      return true;
+
     case idStopwatch:
     {
       DEBUG_RESPONSE_NOT("timing")
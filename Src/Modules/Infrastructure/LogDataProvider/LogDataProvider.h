@@ -88,7 +88,9 @@
 #include "Framework/Module.h"
 #include "Framework/ModuleGraphRunner.h"
 #include "Streaming/TypeInfo.h"
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 // No verify when replaying logfiles
 #ifndef NDEBUG
@@ -200,6 +202,7 @@ private:
   TypeInfo* logTypeInfo = nullptr; /**< The specifications of all the types from the log file. */
   bool frameDataComplete; /**< Were all messages of the current frame received? */
   OdometryData lastOdometryData; /**< The last odometry data that was provided. Used for computing offset. */
+  std::unordered_map<unsigned, std::vector<char>> checkpoints; /**< The states of the modules of this thread saved per frame of the log. */
 
   // No-op update stubs
   void update(ActivationGraph&) override {}
@@ -300,6 +303,13 @@ private:
    */
   void readMessage(MessageQueue::Message message, Streamable& representation);
 
+  /**
+   * Saves or restores the states of the modules of this thread.
+   * @param message The message requesting this. It contains whether the
+   *                states are restored and the frame of the log they belong to.
+   */
+  void handleCheckpoint(MessageQueue::Message message);
+
   /**
    * The method is called for every incoming debug message by handleMessage.
    * @param message An interface to read the message from the queue.
@@ -357,7 +367,7 @@ public:
 
   /**
    * The method returns whether idFrameFinished was received.
-   * @param ack Acknowledge to the log player that the frame was received.
+   * @param ack Acknowledge to the log replay barrier that the frame was received.
    * @return Were all messages of the current frame received?
    */
   static bool isFrameDataComplete(bool ack = true);
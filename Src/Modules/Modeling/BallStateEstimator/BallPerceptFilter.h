@@ -34,6 +34,7 @@
 #include "Representations/MotionControl/MotionInfo.h"
 #include "Representations/Perception/BallPercepts/BallPercept.h"
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
+#include "Representations/Perception/ImagePreprocessing/OtherCameraView.h"
 #include "Representations/Perception/ObstaclesPercepts/ObstaclesImagePercept.h"
 #include "Representations/Sensing/IMUValueState.h"
 #include "Framework/Module.h"
@@ -51,6 +52,7 @@ MODULE(BallPerceptFilter,
   REQUIRES(MotionInfo),
   REQUIRES(ObstaclesImagePercept),
   REQUIRES(Odometer),
+  REQUIRES(OtherCameraView),
   REQUIRES(TeamData),
   REQUIRES(TeamBallModel),
   REQUIRES(WorldModelPrediction),
@@ -102,6 +104,9 @@ private:
   RingBuffer<FilteredBallPercept, 10> bufferedBalls;     /**< A buffer for all guessed and seen balls, used for accepting moving guessed balls. */
   unsigned int timeOfLastFilteredPercept;                /**< Point of time when the last percept has been added to the module's output representation */
   float shakiness;                                       /**< Indicates, how much the robot currently appears to shake around its y axis */
+  const CameraInfo* ballCameraInfo = nullptr;            /**< The camera that took the image the ball percept stems from. */
+  const CameraMatrix* ballCameraMatrix = nullptr;        /**< The camera matrix of the image the ball percept stems from. */
+  const ObstaclesImagePercept* ballObstaclesImagePercept = nullptr; /**< The obstacles in the image the ball percept stems from. */
 
 
   /** Check, if the percept is outside the field
@@ -41,6 +41,12 @@ void BallPerceptFilterRollingBallChallenge::update(FilteredBallPercepts& filtere
   // Reset percept:
   filteredBallPercepts.percepts.clear();
 
+  // In frames that fuse the images of both cameras, the ball percept might stem from the older image.
+  const bool fromOtherCamera = theOtherCameraView.providesBallPercept;
+  ballCameraInfo = fromOtherCamera ? &theOtherCameraView.cameraInfo : &theCameraInfo;
+  ballCameraMatrix = fromOtherCamera ? &theOtherCameraView.cameraMatrix : &theCameraMatrix;
+  ballObstaclesImagePercept = fromOtherCamera ? &theOtherCameraView.obstaclesImagePercept : &theObstaclesImagePercept;
+
   // Update and plot shakiness information
   shakiness = 0.9f * shakiness + 0.1f * theIMUValueState.gyroValues.deviation.y();
   PLOT("module:BallPerceptFilterRollingBallChallenge:shakiness", shakiness);
@@ -86,9 +92,9 @@ void BallPerceptFilterRollingBallChallenge::update(FilteredBallPercepts& filtere
   {
     const float usedShakiness = shakiness > 0.5f ? 0.5f : shakiness;
     float sizeFactor = mapToRange(usedShakiness, 0.f, 0.5f, 0.f, 1.f);
-    sizeFactor *= std::cos(std::min(pi_2, std::atan2(theCameraMatrix.translation.z(), perceivedBallPosition.norm()) * pi_2 / correctBallDistanceByPerceivedSize));
+    sizeFactor *= std::cos(std::min(pi_2, std::atan2(ballCameraMatrix->translation.z(), perceivedBallPosition.norm()) * pi_2 / correctBallDistanceByPerceivedSize));
     float angleFactor = 1.f - sizeFactor;
-    const float sizeBasedDistance = 1.1f * Projection::getDistanceBySize(theCameraInfo, theBallSpecification.radius, theBallPercept.radiusInImage); // Multiply by 1.1, as size-based distance seems to underestimate the real distance. Hacky! ;-)
+    const float sizeBasedDistance = 1.1f * Projection::getDistanceBySize(*ballCameraInfo, theBallSpecification.radius, theBallPercept.radiusInImage); // Multiply by 1.1, as size-based distance seems to underestimate the real distance. Hacky! ;-)
     Vector2f sizeBasedBallPosition(theBallPercept.positionOnField);
     sizeBasedBallPosition.normalize();
     sizeBasedBallPosition *= sizeBasedDistance;
@@ -98,7 +104,7 @@ void BallPerceptFilterRollingBallChallenge::update(FilteredBallPercepts& filtere
   // ***** Workaround for ball on a ramp: Use ball percept position based on perceived size, if it appears to be closer than
   // the normal projection-based position (which is too far away, as long as the ball is on the ramp).
   const float distanceToBallProjectionBased = perceivedBallPosition.norm();
-  const float distanceToBallSizeBased = Projection::getDistanceBySize(theCameraInfo, theBallSpecification.radius, theBallPercept.radiusInImage,
+  const float distanceToBallSizeBased = Projection::getDistanceBySize(*ballCameraInfo, theBallSpecification.radius, theBallPercept.radiusInImage,
                                                                       theBallPercept.positionInImage.x(), theBallPercept.positionInImage.y());
   if(distanceToBallSizeBased < distanceToBallProjectionBased)
     perceivedBallPosition.normalize(distanceToBallSizeBased);
@@ -131,7 +137,7 @@ void BallPerceptFilterRollingBallChallenge::update(FilteredBallPercepts& filtere
 
     // If we saw a ball in the lower camera recently, we ignore far away balls in the upper camera for a while.
     // However, these balls are still buffered.
-    if(theCameraInfo.camera == CameraInfo::upper &&
+    if(ballCameraInfo->camera == CameraInfo::upper &&
        theFrameInfo.getTimeSince(timeBallWasBeenSeenInLowerCameraImage) < farBallIgnoreTimeout &&
        theBallPercept.positionOnField.norm() > farBallIgnoreDistance)
       return;
@@ -156,7 +162,7 @@ void BallPerceptFilterRollingBallChallenge::update(FilteredBallPercepts& filtere
     timeOfLastFilteredPercept = theFrameInfo.time;
 
     // Update timestamp, if the ball was seen in the lower camera:
-    if(theCameraInfo.camera == CameraInfo::lower)
+    if(ballCameraInfo->camera == CameraInfo::lower)
       timeBallWasBeenSeenInLowerCameraImage = theFrameInfo.time;
   }
   plotAndDraw();
@@ -186,10 +192,10 @@ bool BallPerceptFilterRollingBallChallenge::perceptIsInsideTeammateAndCanBeExclu
 {
   // First perform some checks in image coordinates that cover the most typical cases for false positives.
   // These should avoid to exclude real balls that fulfill the following conditions (which unfortunately happens quite often):
-  if(((theCameraInfo.camera == CameraInfo::lower && theBallPercept.positionInImage.y() > theBallPercept.radiusInImage) || // Percept does not intersect upper border of image from lower camera
-      (theCameraInfo.camera == CameraInfo::upper && theBallPercept.positionInImage.y() + theBallPercept.radiusInImage < theCameraInfo.height)) && // Percept does not intersect lower border of image from upper camera
+  if(((ballCameraInfo->camera == CameraInfo::lower && theBallPercept.positionInImage.y() > theBallPercept.radiusInImage) || // Percept does not intersect upper border of image from lower camera
+      (ballCameraInfo->camera == CameraInfo::upper && theBallPercept.positionInImage.y() + theBallPercept.radiusInImage < ballCameraInfo->height)) && // Percept does not intersect lower border of image from upper camera
      (theBallPercept.positionInImage.x() > theBallPercept.radiusInImage) && // Percept does not intersect left border of image
-     (theBallPercept.positionInImage.x() + theBallPercept.radiusInImage < theCameraInfo.width) && // Percept does not intersect right border of image
+     (theBallPercept.positionInImage.x() + theBallPercept.radiusInImage < ballCameraInfo->width) && // Percept does not intersect right border of image
      !ballPerceptIntersectsObstaclesPercept()) // Percept does not intersect with any robot seen in this frame
   {
     // The ball appears to be at a position in the image that is has a low likelihood for causing any false positives.
@@ -229,7 +235,7 @@ bool BallPerceptFilterRollingBallChallenge::perceptIsInsideTeammateAndCanBeExclu
 
 bool BallPerceptFilterRollingBallChallenge::ballPerceptIntersectsObstaclesPercept()
 {
-  for(const auto& o : theObstaclesImagePercept.obstacles)
+  for(const auto& o : ballObstaclesImagePercept->obstacles)
   {
     // Two opposing corners of the obstacle rectangle:
     const Vector2f topLeft(o.left, o.top);
@@ -448,11 +454,11 @@ float BallPerceptFilterRollingBallChallenge::computeStdDevOfMovingBallHypothesis
 
 void BallPerceptFilterRollingBallChallenge::plotAndDraw()
 {
-  if(theBallPercept.status == BallPercept::seen && theCameraInfo.camera == CameraInfo::upper)
+  if(theBallPercept.status == BallPercept::seen && ballCameraInfo->camera == CameraInfo::upper)
   {
     const float angleBasedDistance = theBallPercept.positionOnField.norm();
     PLOT("module:BallPerceptFilterRollingBallChallenge:angleBasedDistance", angleBasedDistance);
-    const float sizeBasedDistance = 1.1f * Projection::getDistanceBySize(theCameraInfo, theBallSpecification.radius, theBallPercept.radiusInImage);
+    const float sizeBasedDistance = 1.1f * Projection::getDistanceBySize(*ballCameraInfo, theBallSpecification.radius, theBallPercept.radiusInImage);
     PLOT("module:BallPerceptFilterRollingBallChallenge:sizeBasedDistance", sizeBasedDistance);
 
     const float usedShakiness = shakiness > 0.5f ? 0.5f : shakiness;
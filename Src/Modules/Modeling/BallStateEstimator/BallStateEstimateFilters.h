@@ -82,6 +82,18 @@ public:
    * @return The velocity of the ball (on the field, relative to the robot), (0,0) by default
    */
   const virtual Vector2f getVelocity() const { return Vector2f::Zero(); }
+
+  /** Writes the state of this estimate, e.g. for log checkpoints. */
+  void writeState(Out& stream) const
+  {
+    stream << radius << numOfMeasurements << nllOfMeasurements << nllWeighting << lastPosition << timeOfLastCollision;
+  }
+
+  /** Restores the state of this estimate that was written by writeState. */
+  void readState(In& stream)
+  {
+    stream >> radius >> numOfMeasurements >> nllOfMeasurements >> nllWeighting >> lastPosition >> timeOfLastCollision;
+  }
 };
 
 /**
@@ -142,6 +154,20 @@ public:
     x += correction;
     P -= K * P;
   }
+
+  /** Writes the state of this filter, e.g. for log checkpoints. */
+  void writeState(Out& stream) const
+  {
+    BallStateEstimate::writeState(stream);
+    stream << x << P;
+  }
+
+  /** Restores the state of this filter that was written by writeState. */
+  void readState(In& stream)
+  {
+    BallStateEstimate::readState(stream);
+    stream >> x >> P;
+  }
 };
 
 /**
@@ -256,4 +282,18 @@ public:
     sbkf.nllWeighting = nllWeighting;
     return sbkf;
   }
+
+  /** Writes the state of this filter, e.g. for log checkpoints. */
+  void writeState(Out& stream) const
+  {
+    BallStateEstimate::writeState(stream);
+    stream << x << P;
+  }
+
+  /** Restores the state of this filter that was written by writeState. */
+  void readState(In& stream)
+  {
+    BallStateEstimate::readState(stream);
+    stream >> x >> P;
+  }
 };
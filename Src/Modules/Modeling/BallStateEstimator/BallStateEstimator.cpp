@@ -514,3 +514,75 @@ void BallStateEstimator::plotAndDraw()
            Drawings::solidPen, ColorRGBA::red, Drawings::solidBrush, ColorRGBA::red);
   }
 }
+
+int BallStateEstimator::indexOf(const BallStateEstimate* state) const
+{
+  for(size_t i = 0; i < stationaryBalls.size(); ++i)
+    if(state == &stationaryBalls[i])
+      return static_cast<int>(i);
+  for(size_t i = 0; i < rollingBalls.size(); ++i)
+    if(state == &rollingBalls[i])
+      return static_cast<int>(stationaryBalls.size() + i);
+  return -1;
+}
+
+BallStateEstimate* BallStateEstimator::stateAt(int index)
+{
+  if(index < 0)
+    return nullptr;
+  else if(index < static_cast<int>(stationaryBalls.size()))
+    return &stationaryBalls[index];
+  else
+    return &rollingBalls[index - stationaryBalls.size()];
+}
+
+void BallStateEstimator::writeCheckpoint(Out& stream) const
+{
+  stream << lastFrameTime << ballWasSeenInThisFrame << timeWhenBallFirstDisappeared << ballNotSeenButShouldBeSeenCounter
+         << lastBallPercept << penaltyBallModelingStartTime << averagePenaltyBallPosition << useAveragePenaltyBallPosition;
+  stream << static_cast<unsigned>(seenStats.size());
+  for(size_t i = seenStats.size(); i-- > 0;)
+    stream << seenStats[i];
+  stream << static_cast<unsigned>(penaltyBallPositions.size());
+  for(const Vector2f& position : penaltyBallPositions)
+    stream << position;
+  stream << static_cast<unsigned>(stationaryBalls.size());
+  for(const StationaryBallKalmanFilter& state : stationaryBalls)
+    state.writeState(stream);
+  stream << static_cast<unsigned>(rollingBalls.size());
+  for(const RollingBallKalmanFilter& state : rollingBalls)
+    state.writeState(stream);
+  stream << indexOf(bestState) << indexOf(bestMovingState);
+}
+
+void BallStateEstimator::readCheckpoint(In& stream)
+{
+  stream >> lastFrameTime >> ballWasSeenInThisFrame >> timeWhenBallFirstDisappeared >> ballNotSeenButShouldBeSeenCounter
+         >> lastBallPercept >> penaltyBallModelingStartTime >> averagePenaltyBallPosition >> useAveragePenaltyBallPosition;
+  unsigned size;
+  stream >> size;
+  seenStats.clear();
+  for(unsigned i = 0; i < size; ++i)
+  {
+    unsigned short seen;
+    stream >> seen;
+    seenStats.push_front(seen);
+  }
+  stream >> size;
+  penaltyBallPositions.resize(size);
+  for(Vector2f& position : penaltyBallPositions)
+    stream >> position;
+  reset();
+  stream >> size;
+  stationaryBalls.resize(size);
+  for(StationaryBallKalmanFilter& state : stationaryBalls)
+    state.readState(stream);
+  stream >> size;
+  rollingBalls.resize(size);
+  for(RollingBallKalmanFilter& state : rollingBalls)
+    state.readState(stream);
+  int bestIndex, bestMovingIndex;
+  stream >> bestIndex >> bestMovingIndex;
+  bestState = stateAt(bestIndex);
+  bestMovingState = stateAt(bestMovingIndex);
+}
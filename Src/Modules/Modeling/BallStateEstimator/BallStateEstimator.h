@@ -36,6 +36,7 @@
 #include "Representations/Perception/ImagePreprocessing/BodyContour.h"
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
 #include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
+#include "Framework/Checkpointable.h"
 #include "Framework/Module.h"
 #include "Math/RingBufferWithSum.h"
 
@@ -75,7 +76,7 @@ MODULE(BallStateEstimator,
  *
  * Estimation of ball position and velocity based on a set of Kalman filters
  */
-class BallStateEstimator : public BallStateEstimatorBase
+class BallStateEstimator : public BallStateEstimatorBase, public Checkpointable
 {
 public:
   /** Constructor */
@@ -129,4 +130,21 @@ private:
    * @param ballModel The ball model, exactly!
    */
   void update(BallModel& ballModel) override;
+
+  /**
+   * Returns the index of a hypothesis, counting the stationary ones first.
+   * @param state The hypothesis or nullptr.
+   * @return The index or -1 for nullptr.
+   */
+  int indexOf(const BallStateEstimate* state) const;
+
+  /**
+   * Returns the hypothesis with an index returned by indexOf.
+   * @param index The index or -1.
+   * @return The hypothesis or nullptr.
+   */
+  BallStateEstimate* stateAt(int index);
+
+  void writeCheckpoint(Out& stream) const override;
+  void readCheckpoint(In& stream) override;
 };
@@ -140,3 +140,13 @@ float GlobalOpponentsHypothesis::squaredMahalanobis(const GlobalOpponentsHypothe
   const Eigen::Matrix<float, 2, 2> combinedCovs = (covariance + other.covariance) * .5f;
   return meanDiff.transpose() * combinedCovs.inverse() * meanDiff;
 }
+
+void GlobalOpponentsHypothesis::writeState(Out& stream) const
+{
+  stream << static_cast<const Obstacle&>(*this) << team << upright << seenCount << notSeenButShouldSeenCount;
+}
+
+void GlobalOpponentsHypothesis::readState(In& stream)
+{
+  stream >> static_cast<Obstacle&>(*this) >> team >> upright >> seenCount >> notSeenButShouldSeenCount;
+}
@@ -91,4 +91,16 @@ class GlobalOpponentsHypothesis : public Obstacle
 
   /** Calculates the squared Mahalanobis distances to the other obstacle. */
   float squaredMahalanobis(const GlobalOpponentsHypothesis& other) const;
+
+  /**
+   * Writes the state of this hypothesis, e.g. for log checkpoints.
+   * @param stream The stream the state is written to.
+   */
+  void writeState(Out& stream) const;
+
+  /**
+   * Restores the state of this hypothesis that was written by writeState.
+   * @param stream The stream the state is read from.
+   */
+  void readState(In& stream);
 };
@@ -12,6 +12,7 @@
 #pragma once
 
 #include "GlobalOpponentsHypothesis.h"
+#include "Framework/Checkpointable.h"
 
 #include "Representations/Configuration/FieldDimensions.h"
 #include "Representations/Configuration/RobotDimensions.h"
@@ -24,6 +25,7 @@
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
 #include "Representations/Perception/ImagePreprocessing/FieldBoundary.h"
 #include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
+#include "Representations/Perception/ImagePreprocessing/OtherCameraView.h"
 #include "Representations/Perception/ObstaclesPercepts/ObstaclesFieldPercept.h"
 #include "Representations/Sensing/ArmContactModel.h"
 #include "Representations/Sensing/FallDownState.h"
@@ -49,6 +51,7 @@ MODULE(GlobalOpponentsTracker,
   REQUIRES(MotionInfo),
   REQUIRES(ObstaclesFieldPercept),
   REQUIRES(Odometer),
+  REQUIRES(OtherCameraView),
   REQUIRES(RobotDimensions),
   REQUIRES(RobotModel),
   REQUIRES(RobotPose),
@@ -98,7 +101,7 @@ MODULE(GlobalOpponentsTracker,
  *
  * An implementation that aims to keep track of the opponent robots that are currently on the pitch.
  */
-class GlobalOpponentsTracker : public GlobalOpponentsTrackerBase
+class GlobalOpponentsTracker : public GlobalOpponentsTrackerBase, public Checkpointable
 {
 public:
   /** Constructor */
@@ -165,8 +168,15 @@ private:
 
   /** The function will merge overlapping hypotheses to one hypotheses. */
   void mergeOverlapping();
-  /** The function increases the attribute notSeenButShouldSeenCount of obstacles that should be seen but wasn't seen recently. */
-  void shouldBeSeen();
+  /**
+   * The function increases the attribute notSeenButShouldSeenCount of obstacles that should be seen but wasn't seen recently.
+   * @param cameraInfo The camera that took the image.
+   * @param cameraMatrix The camera matrix of the image.
+   * @param imageCoordinateSystem The image coordinate system of the image.
+   * @param fieldBoundary The field boundary in the image.
+   */
+  void shouldBeSeen(const CameraInfo& cameraInfo, const CameraMatrix& cameraMatrix,
+                    const ImageCoordinateSystem& imageCoordinateSystem, const FieldBoundary& fieldBoundary);
 
   /**
    * The function checks if any other obstacle is in the shadow of the obstacle closer.
@@ -174,8 +184,11 @@ private:
    * @param i The index of the obstacle closer in the list obstacleHypotheses.
    * @param cameraAngleLeft The left camera angle.
    * @param cameraAngleRight The right camera angle.
+   * @param cameraInfo The camera that took the image.
+   * @param cameraMatrix The camera matrix of the image.
    */
-  bool isAnyObstacleInShadow(GlobalOpponentsHypothesis* closer, const std::size_t i, const float cameraAngleLeft, const float cameraAngleRight);
+  bool isAnyObstacleInShadow(GlobalOpponentsHypothesis* closer, const std::size_t i, const float cameraAngleLeft, const float cameraAngleRight,
+                             const CameraInfo& cameraInfo, const CameraMatrix& cameraMatrix);
 
   /**
    * Computes a merge radius for a given measurement. The farther the measurement, the higher the radius.
@@ -199,4 +212,7 @@ private:
    * goal keeper is walking in at the beginning of the half.
    */
   bool shouldIgnore(const GlobalOpponentsHypothesis& obstacle) const;
+
+  void writeCheckpoint(Out& stream) const override;
+  void readCheckpoint(In& stream) override;
 };
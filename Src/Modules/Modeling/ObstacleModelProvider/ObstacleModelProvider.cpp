@@ -45,7 +45,10 @@ void ObstacleModelProvider::update(ObstacleModel& obstacleModel)
   for(auto& obstacle : obstacleHypotheses)
     obstacle.setLeftRight((obstacle.left - obstacle.right).norm() * .5f);
 
-  shouldBeSeen(); // Mark obstacles that should be seen but weren't seen recently.
+  shouldBeSeen(theCameraInfo, theCameraMatrix, theImageCoordinateSystem, theFieldBoundary); // Mark obstacles that should be seen but weren't seen recently.
+  if(theOtherCameraView.isValid) // The obstacles from the older image of a fused frame were also perceived.
+    shouldBeSeen(theOtherCameraView.cameraInfo, theOtherCameraView.cameraMatrix,
+                 theOtherCameraView.imageCoordinateSystem, theOtherCameraView.fieldBoundary);
   STOPWATCH("ObstacleModel:calculateVelocity")
     calculateVelocity(); // Calculate velocity.
   // Update obstacles from valid hypotheses.
@@ -378,14 +381,15 @@ void ObstacleModelProvider::mergeOverlapping()
   }
 }
 
-void ObstacleModelProvider::shouldBeSeen()
+void ObstacleModelProvider::shouldBeSeen(const CameraInfo& cameraInfo, const CameraMatrix& cameraMatrix,
+                                        const ImageCoordinateSystem& imageCoordinateSystem, const FieldBoundary& fieldBoundary)
 {
   if(obstacleHypotheses.empty())
     return;
 
-  const float cameraAngle = theCameraMatrix.rotation.getZAngle();
-  const float cameraAngleLeft = cameraAngle + theCameraInfo.openingAngleWidth * cameraAngleFactor,
-              cameraAngleRight = cameraAngle - theCameraInfo.openingAngleWidth * cameraAngleFactor;
+  const float cameraAngle = cameraMatrix.rotation.getZAngle();
+  const float cameraAngleLeft = cameraAngle + cameraInfo.openingAngleWidth * cameraAngleFactor,
+              cameraAngleRight = cameraAngle - cameraInfo.openingAngleWidth * cameraAngleFactor;
 
   COMPLEX_DRAWING("module:ObstacleModelProvider:cameraAngle")
   {
@@ -394,7 +398,7 @@ void ObstacleModelProvider::shouldBeSeen()
     Vector2f camRight(static_cast<float>(maxDistance), 0.f);
     camLeft = camLeft.rotate(cameraAngleLeft);
     camRight = camRight.rotate(cameraAngleRight);
-    const ColorRGBA cameraColor = theCameraInfo.camera == CameraInfo::upper ? ColorRGBA::blue : ColorRGBA::yellow;
+    const ColorRGBA cameraColor = cameraInfo.camera == CameraInfo::upper ? ColorRGBA::blue : ColorRGBA::yellow;
     LINE("module:ObstacleModelProvider:cameraAngle", 0, 0, camLeft.x(), camLeft.y(), 10, Drawings::solidPen, cameraColor);
     LINE("module:ObstacleModelProvider:cameraAngle", 0, 0, camRight.x(), camRight.y(), 10, Drawings::solidPen, cameraColor);
   }
@@ -408,23 +412,23 @@ void ObstacleModelProvider::shouldBeSeen()
 
     // Continue with next obstacle if obstacle was seen in the last 300ms or is not in sight
     if(theFrameInfo.getTimeSince(closer->lastSeen) < recentlySeenTime || !closer->isBetween(cameraAngleLeft, cameraAngleRight) ||
-       !closer->isInImage(centerInImage, theCameraInfo, theCameraMatrix))
+       !closer->isInImage(centerInImage, cameraInfo, cameraMatrix))
       continue;
 
     COMPLEX_DRAWING("module:ObstacleModelProvider:obstacleNotSeen")
     {
       Vector2f leftInImage, rightInImage;
-      if(Transformation::robotToImage(closer->left, theCameraMatrix, theCameraInfo, leftInImage))
+      if(Transformation::robotToImage(closer->left, cameraMatrix, cameraInfo, leftInImage))
         LARGE_DOT("module:ObstacleModelProvider:obstacleNotSeen", closer->left.x(), closer->left.y(), ColorRGBA::violet, ColorRGBA::black);
       LARGE_DOT("module:ObstacleModelProvider:obstacleNotSeen", centerInImage.x(), centerInImage.y(), ColorRGBA::violet, ColorRGBA::black);
-      if(Transformation::robotToImage(closer->right, theCameraMatrix, theCameraInfo, rightInImage))
+      if(Transformation::robotToImage(closer->right, cameraMatrix, cameraInfo, rightInImage))
         LARGE_DOT("module:ObstacleModelProvider:obstacleNotSeen", rightInImage.x(), rightInImage.y(), ColorRGBA::violet, ColorRGBA::black);
     }
 
     // Increase notSeenButShouldSeen and continue with next obstacle if any other obstacle is in the shadow of the obstacle
     // or the field boundary is further as the obstacle
-    if(isAnyObstacleInShadow(closer, i, cameraAngleLeft, cameraAngleRight) || (theFieldBoundary.isValid &&
-        closer->isFieldBoundaryFurtherAsObstacle(theCameraInfo, theCameraMatrix, theImageCoordinateSystem, theFieldBoundary)))
+    if(isAnyObstacleInShadow(closer, i, cameraAngleLeft, cameraAngleRight, cameraInfo, cameraMatrix) || (fieldBoundary.isValid &&
+        closer->isFieldBoundaryFurtherAsObstacle(cameraInfo, cameraMatrix, imageCoordinateSystem, fieldBoundary)))
     {
       closer->notSeenButShouldSeenCount += std::max(1u, notSeenThreshold / 10);
       continue;
@@ -435,7 +439,8 @@ void ObstacleModelProvider::shouldBeSeen()
   }
 }
 
-bool ObstacleModelProvider::isAnyObstacleInShadow(ObstacleHypothesis* closer, const std::size_t i, const float cameraAngleLeft, const float cameraAngleRight)
+bool ObstacleModelProvider::isAnyObstacleInShadow(ObstacleHypothesis* closer, const std::size_t i, const float cameraAngleLeft, const float cameraAngleRight,
+                                                  const CameraInfo& cameraInfo, const CameraMatrix& cameraMatrix)
 {
   for(std::size_t j = obstacleHypotheses.size() - 1; j > i; --j)
   {
@@ -445,7 +450,7 @@ bool ObstacleModelProvider::isAnyObstacleInShadow(ObstacleHypothesis* closer, co
     Vector2f centerInImage;
     if(further->lastSeen != theFrameInfo.time
        && further->isBetween(cameraAngleLeft, cameraAngleRight)
-       && further->isInImage(centerInImage, theCameraInfo, theCameraMatrix))
+       && further->isInImage(centerInImage, cameraInfo, cameraMatrix))
     {
       // Swap further and closer if further obstacle is closer than closer obstacle
       if(further->center.squaredNorm() < closer->center.squaredNorm())
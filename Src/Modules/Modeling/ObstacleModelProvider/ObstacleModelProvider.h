@@ -24,6 +24,7 @@
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
 #include "Representations/Perception/ImagePreprocessing/FieldBoundary.h"
 #include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
+#include "Representations/Perception/ImagePreprocessing/OtherCameraView.h"
 #include "Representations/Perception/MeasurementCovariance.h"
 #include "Representations/Perception/ObstaclesPercepts/ObstaclesFieldPercept.h"
 #include "Representations/Sensing/ArmContactModel.h"
@@ -49,6 +50,7 @@ MODULE(ObstacleModelProvider,
   REQUIRES(MotionInfo),
   REQUIRES(ObstaclesFieldPercept),
   REQUIRES(Odometer),
+  REQUIRES(OtherCameraView),
   REQUIRES(ReceivedTeamMessages),
   REQUIRES(RobotDimensions),
   REQUIRES(RobotModel),
@@ -168,8 +170,15 @@ class ObstacleModelProvider : public ObstacleModelProviderBase
   void considerTeammates();
   /** The function will merge overlapping hypotheses to one hypotheses. */
   void mergeOverlapping();
-  /** The function increases the attribute notSeenButShouldSeenCount of obstacles that should be seen but wasn't seen recently. */
-  void shouldBeSeen();
+  /**
+   * The function increases the attribute notSeenButShouldSeenCount of obstacles that should be seen but wasn't seen recently.
+   * @param cameraInfo The camera that took the image.
+   * @param cameraMatrix The camera matrix of the image.
+   * @param imageCoordinateSystem The image coordinate system of the image.
+   * @param fieldBoundary The field boundary in the image.
+   */
+  void shouldBeSeen(const CameraInfo& cameraInfo, const CameraMatrix& cameraMatrix,
+                    const ImageCoordinateSystem& imageCoordinateSystem, const FieldBoundary& fieldBoundary);
 
   /**
    * The function checks if any other obstacle is in the shadow of the obstacle closer.
@@ -177,8 +186,11 @@ class ObstacleModelProvider : public ObstacleModelProviderBase
    * @param i The index of the obstacle closer in the list obstacleHypotheses.
    * @param cameraAngleLeft The left camera angle.
    * @param cameraAngleRight The right camera angle.
+   * @param cameraInfo The camera that took the image.
+   * @param cameraMatrix The camera matrix of the image.
    */
-  bool isAnyObstacleInShadow(ObstacleHypothesis* closer, const std::size_t i, const float cameraAngleLeft, const float cameraAngleRight);
+  bool isAnyObstacleInShadow(ObstacleHypothesis* closer, const std::size_t i, const float cameraAngleLeft, const float cameraAngleRight,
+                             const CameraInfo& cameraInfo, const CameraMatrix& cameraMatrix);
 
   float calculateMergeRadius(const Vector2f center, const unsigned maxRadius) const
   {
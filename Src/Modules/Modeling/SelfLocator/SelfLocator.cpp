@@ -851,4 +851,23 @@ bool SelfLocator::isMirrorCloser(const Pose2f& currentPose, const Pose2f& lastPo
   return result;
 }
 
+void SelfLocator::writeCheckpoint(Out& stream) const
+{
+  stream << lastTimeJumpSound << timeOfLastReturnFromPenalty << nextSampleNumber << idOfLastBestSample
+         << averageWeighting << lastAlternativePoseTimestamp << lastGroundTruthRobotPose
+         << sumOfPerceivedLandmarks << sumOfPerceivedLines << sumOfUsedLandmarks << sumOfUsedLines;
+  for(int i = 0; i < samples->size(); ++i)
+    samples->at(i).writeState(stream);
+}
+
+void SelfLocator::readCheckpoint(In& stream)
+{
+  stream >> lastTimeJumpSound >> timeOfLastReturnFromPenalty >> nextSampleNumber >> idOfLastBestSample
+         >> averageWeighting >> lastAlternativePoseTimestamp >> lastGroundTruthRobotPose
+         >> sumOfPerceivedLandmarks >> sumOfPerceivedLines >> sumOfUsedLandmarks >> sumOfUsedLines;
+  // The number of samples is a parameter that might have changed since the checkpoint was written.
+  for(int i = 0; i < samples->size() && !stream.eof(); ++i)
+    samples->at(i).readState(stream);
+}
+
 MAKE_MODULE(SelfLocator);
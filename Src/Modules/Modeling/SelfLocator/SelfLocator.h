@@ -29,6 +29,7 @@
 #include "Representations/Configuration/SetupPoses.h"
 #include "Representations/Configuration/StaticInitialPose.h"
 #include "Tools/Modeling/SampleSet.h"
+#include "Framework/Checkpointable.h"
 #include "Framework/Module.h"
 
 MODULE(SelfLocator,
@@ -100,7 +101,7 @@ MODULE(SelfLocator,
  * A module for self-localization, based on a particle filter with each particle having
  * an Unscented Kalman Filter.
  */
-class SelfLocator : public SelfLocatorBase
+class SelfLocator : public SelfLocatorBase, public Checkpointable
 {
 private:
   SampleSet<UKFRobotPoseHypothesis>* samples;   /**< Container for all samples. */
@@ -238,6 +239,9 @@ private:
    */
   void draw(const RobotPose& robotPose);
 
+  void writeCheckpoint(Out& stream) const override;
+  void readCheckpoint(In& stream) override;
+
 public:
   /** Default constructor */
   SelfLocator();
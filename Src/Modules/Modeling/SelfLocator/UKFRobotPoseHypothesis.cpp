@@ -9,8 +9,10 @@
 
 #include "UKFRobotPoseHypothesis.h"
 #include "Math/Covariance.h"
+#include "Math/Eigen.h"
 #include "Math/Geometry.h"
 #include "Math/Probabilistics.h"
+#include "Streaming/InOut.h"
 
 void UKFRobotPoseHypothesis::init(const Pose2f& pose, const Pose2f& poseDeviation, int id, float validity)
 {
@@ -124,3 +126,13 @@ void UKFRobotPoseHypothesis::updateByPose(const RegisteredAbsolutePoseMeasuremen
                              pose.absolutePoseOnField.rotation);
   poseSensorUpdate(measurement, pose.covariance);
 }
+
+void UKFRobotPoseHypothesis::writeState(Out& stream) const
+{
+  stream << mean << cov << weighting << validity << id;
+}
+
+void UKFRobotPoseHypothesis::readState(In& stream)
+{
+  stream >> mean >> cov >> weighting >> validity >> id;
+}
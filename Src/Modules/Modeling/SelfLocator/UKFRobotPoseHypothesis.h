@@ -13,6 +13,9 @@
 #include "Representations/MotionControl/MotionInfo.h"
 #include "Tools/Modeling/UKFPose2D.h"
 
+class In;
+class Out;
+
 /**
  * @class UKFRobotPoseHypothesis
  *
@@ -80,4 +83,14 @@ public:
    * @param pose The computed pose
    */
   void updateByPose(const RegisteredAbsolutePoseMeasurement& pose);
+
+  /** Writes the state of this sample (e.g. for a checkpoint of the SelfLocator).
+   * @param stream The stream the state is written to.
+   */
+  void writeState(Out& stream) const;
+
+  /** Restores the state of this sample that was written by writeState.
+   * @param stream The stream the state is read from.
+   */
+  void readState(In& stream);
 };
@@ -25,12 +25,10 @@ MAKE_MODULE(WhistleDetector);
 static DECLARE_SYNC;
 
 WhistleDetector::WhistleDetector()
-  : currentFreq(freq),
-    detector(&Global::getAsmjitRuntime())
+  : currentFreq(freq)
 {
   // Load the model.
-  model = std::make_unique<NeuralNetworkONNX::Model>(std::string(File::getBHDir()) + "/" + whistleNetPath);
-  detector.compile(*model);
+  detector.load(std::string(File::getBHDir()) + "/" + whistleNetPath);
 
   ASSERT(detector.numOfInputs() == 1);
   ASSERT(detector.numOfOutputs() == 1);
@@ -20,9 +20,9 @@
 #include "Representations/Modeling/Whistle.h"
 #include "Math/Range.h"
 #include "Math/RingBufferWithSum.h"
+#include "Tools/Inference/InferenceEngine.h"
 
 #include <fftw3.h>
-#include <CompiledNN2ONNX/CompiledNN.h>
 
 MODULE(WhistleDetector,
 {,
@@ -75,8 +75,7 @@ class WhistleDetector : public WhistleDetectorBase
   bool allDeafAlert = false; /**< Already informed that all microphones are broken? */
 
   Range<unsigned> currentFreq; /**< The frequency window in which it is searched for the whistle. */
-  NeuralNetworkONNX::CompiledNN detector; /**< The neural whistle detector. */
-  std::unique_ptr<NeuralNetworkONNX::Model> model; /**< The model loaded into the detector. */
+  InferenceEngine detector; /**< The neural whistle detector. */
 
   unsigned lastTimeCandidateDetected = 0; /**< The last time an individual detection had a sufficient confidence. */
   unsigned detectionCount = 0; /**< The number of detections that a sufficient confidence for a single whistle. */
@@ -63,3 +63,15 @@ void WorldModelPredictor::update(WorldModelPrediction& worldModelPrediction)
   ballSpeedAtLastExecution = worldModelPrediction.ballVelocity.norm();
   odometryOfLastFrame = theOdometryData;
 }
+
+void WorldModelPredictor::writeCheckpoint(Out& stream) const
+{
+  stream << timeOfLastExecution << timeWhenLastKicked << ballSpeedAtLastExecution
+         << lastUsedBallModel << odometryOfLastFrame << lastUsedBallModelOdometry;
+}
+
+void WorldModelPredictor::readCheckpoint(In& stream)
+{
+  stream >> timeOfLastExecution >> timeWhenLastKicked >> ballSpeedAtLastExecution
+         >> lastUsedBallModel >> odometryOfLastFrame >> lastUsedBallModelOdometry;
+}
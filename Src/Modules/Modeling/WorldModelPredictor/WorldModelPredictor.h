@@ -18,6 +18,7 @@
 #include "Representations/Modeling/RobotPose.h"
 #include "Representations/Modeling/WorldModelPrediction.h"
 #include "Representations/MotionControl/OdometryData.h"
+#include "Framework/Checkpointable.h"
 #include "Framework/Module.h"
 
 MODULE(WorldModelPredictor,
@@ -33,7 +34,7 @@ MODULE(WorldModelPredictor,
   PROVIDES(WorldModelPrediction),
 });
 
-class WorldModelPredictor : public WorldModelPredictorBase
+class WorldModelPredictor : public WorldModelPredictorBase, public Checkpointable
 {
   unsigned timeOfLastExecution = 0;     /**< The point of time this module was executed the last time, i.e. time of last frame */
   unsigned timeWhenLastKicked = 0;      /**< The point of time, when the last kick was detected (by having an increased ball velocity) */
@@ -46,4 +47,7 @@ class WorldModelPredictor : public WorldModelPredictorBase
    * @param worldModelPrediction The struct that is updated.
    */
   void update(WorldModelPrediction& worldModelPrediction) override;
+
+  void writeCheckpoint(Out& stream) const override;
+  void readCheckpoint(In& stream) override;
 };
@@ -16,6 +16,11 @@
 
 MAKE_MODULE(FallEngine);
 
+FallEngine::FallEngine()
+{
+  MotionPhase::preallocate<FallPhase>();
+}
+
 void FallEngine::update(FallGenerator& fallGenerator)
 {
   fallGenerator.shouldCatchFall = [this](const MotionRequest& motionRequest)
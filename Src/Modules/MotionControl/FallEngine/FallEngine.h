@@ -49,6 +49,10 @@ MODULE(FallEngine,
 
 class FallEngine : public FallEngineBase
 {
+public:
+  FallEngine();
+
+private:
   void update(FallGenerator& fallGenerator) override;
 };
 
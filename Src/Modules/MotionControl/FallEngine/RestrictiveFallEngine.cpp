@@ -16,6 +16,11 @@
 
 MAKE_MODULE(RestrictiveFallEngine);
 
+RestrictiveFallEngine::RestrictiveFallEngine()
+{
+  MotionPhase::preallocate<RestrictiveFallPhase>();
+}
+
 void RestrictiveFallEngine::update(FallGenerator& fallGenerator)
 {
   fallGenerator.shouldCatchFall = [this](const MotionRequest& motionRequest)
@@ -48,6 +48,10 @@ MODULE(RestrictiveFallEngine,
 
 class RestrictiveFallEngine : public RestrictiveFallEngineBase
 {
+public:
+  RestrictiveFallEngine();
+
+private:
   void update(FallGenerator& fallGenerator) override;
 };
 
@@ -12,6 +12,11 @@
 
 MAKE_MODULE(FreezeEngine);
 
+FreezeEngine::FreezeEngine()
+{
+  MotionPhase::preallocate<FreezePhase>();
+}
+
 void FreezeEngine::update(FreezeGenerator& theFreezeGenerator)
 {
   theFreezeGenerator.shouldHandleBodyDisconnect = [this](const MotionPhase& currentPhase)
@@ -36,6 +36,10 @@ MODULE(FreezeEngine,
 
 class FreezeEngine : public FreezeEngineBase
 {
+public:
+  FreezeEngine();
+
+private:
   void update(FreezeGenerator& theFreezeGenerator) override;
 };
 
@@ -25,6 +25,8 @@ KeyframeMotionEngine::KeyframeMotionEngine()
   ASSERT(static_cast<std::size_t>(KeyframeMotionListID::genuflectStandDefender) == static_cast<std::size_t>(KeyframeMotionID::sitDown + 4) + offset);
   ASSERT(static_cast<std::size_t>(KeyframeMotionListID::demoBannerWave) == static_cast<std::size_t>(KeyframeMotionID::sitDown + 5) + offset);
   ASSERT(static_cast<std::size_t>(KeyframeMotionListID::demoBannerWaveInitial) == static_cast<std::size_t>(KeyframeMotionID::sitDown + 6) + offset);
+
+  MotionPhase::preallocate<KeyframePhase>();
 }
 
 KeyframePhase::KeyframePhase(KeyframeMotionEngine& engine, const KeyframeMotionRequest& keyframeMotionRequest, const MotionPhase& lastPhase) :
@@ -20,6 +20,7 @@ MAKE_MODULE(KickEngine);
 
 KickEngine::KickEngine()
 {
+  MotionPhase::preallocate<KickPhase>();
   params.reserve(10);
 
   try
@@ -10,12 +10,14 @@
 #include "Debugging/Annotation.h"
 #include "Framework/Settings.h"
 #include "Platform/BHAssert.h"
+#include "Platform/Memory.h"
 #include "Platform/SystemCall.h"
 #include "Debugging/Debugging.h"
 #include "Math/BHMath.h"
 #include "Math/Rotation.h"
 #include "Tools/Motion/MotionUtilities.h"
 #include "Modules/Infrastructure/InterThreadProviders/PerceptionProviders.h"
+#include <array>
 
 MAKE_MODULE(MotionEngine);
 
@@ -51,6 +53,7 @@ MotionEngine::MotionEngine()
   generators[MotionRequest::photoMode] = &thePhotoModeGenerator;
   generators[MotionRequest::freeBallHolding] = &theFreeBallHoldingGenerator;
 
+  MotionPhase::preallocate<PlayDeadPhase>();
   phase = std::make_unique<PlayDeadPhase>(*this);
 }
 
@@ -58,6 +61,10 @@ void MotionEngine::update(JointRequest& jointRequest)
 {
   ASSERT(phase);
 
+  // Motion runs at the highest rate, so its cycle must not wait for the allocator (checked if CHECK_ALLOCATIONS is defined).
+  // This includes switching phases, which take their memory from pools that were filled in advance.
+  Memory::NoAllocationScope noAllocationScope;
+
   const JointRequest lastRequest = jointRequest;
 
   //1. update the current MotionPhase
@@ -65,10 +72,8 @@ void MotionEngine::update(JointRequest& jointRequest)
   phase->update();
 
   // Get oldest timestamp of lower, upper and cognition. If one thread stopped, the robot shall sit down
-  std::vector<unsigned> behaviorTimeStamps = { theCognitionFrameInfo.time, theUpperFrameInfo.time };
-  if(Global::getSettings().robotType == Settings::RobotType::nao)
-    behaviorTimeStamps.push_back(theLowerFrameInfo.time);
-  const unsigned int oldestBehaviorTimestamp = *std::min_element(std::begin(behaviorTimeStamps), std::end(behaviorTimeStamps));
+  const std::array<unsigned, 3> behaviorTimeStamps = { theCognitionFrameInfo.time, theUpperFrameInfo.time, theLowerFrameInfo.time };
+  const unsigned int oldestBehaviorTimestamp = *std::min_element(behaviorTimeStamps.begin(), behaviorTimeStamps.end() - (Global::getSettings().robotType == Settings::RobotType::nao ? 0 : 1));
 
   // Check if Cognition stopped or the IMU has an offset.
   if(oldestBehaviorTimestamp != lastCognitionTime && !theGyroOffset.isIMUBad && theGyroOffset.offsetCheckFinished)
@@ -80,6 +85,7 @@ void MotionEngine::update(JointRequest& jointRequest)
             theFrameInfo.getTimeSince(oldestBehaviorTimestamp) > emergencySitDownDelay))) // No new camera images
   {
     forceSitDown = true;
+    Memory::AllowAllocationScope allowAllocationScope; // Reporting the error may allocate.
     if(!theGyroOffset.isIMUBad)
     {
       OUTPUT_ERROR("No data from Cognition to Motion for more than " << ((emergencySitDownDelay + 500) / 1000) << " seconds.");
@@ -125,6 +131,7 @@ void MotionEngine::update(JointRequest& jointRequest)
       ASSERT(motionInfo.lastKickType < KickInfo::numOfKickTypes);
       if(motionInfo.lastKickType >= KickInfo::numOfKickTypes)
       {
+        Memory::AllowAllocationScope allowAllocationScope; // Reporting the error may allocate.
         ANNOTATION("MotionEngine", "Invalid Kick Type");
         OUTPUT_ERROR("MotionEngine: Invalid Kick Type");
       }
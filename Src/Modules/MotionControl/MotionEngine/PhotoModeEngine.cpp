@@ -15,6 +15,7 @@ MAKE_MODULE(PhotoModeEngine);
 
 PhotoModeEngine::PhotoModeEngine()
 {
+  MotionPhase::preallocate<PhotoModePhase>();
 }
 
 void PhotoModeEngine::update(PhotoModeGenerator& photoModeGenerator)
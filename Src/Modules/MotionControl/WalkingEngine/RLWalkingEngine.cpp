@@ -10,9 +10,9 @@
 
 MAKE_MODULE(RLWalkingEngine);
 
-RLWalkingEngine::RLWalkingEngine():
-  network(&Global::getAsmjitRuntime())
+RLWalkingEngine::RLWalkingEngine()
 {
+  MotionPhase::preallocate<RLWalkPhase>();
   compile(false);
   // https://github.com/BoosterRobotics/booster_gym/blob/main/deploy/configs/T1.yaml#L19
   offset.angles[Joints::lHipPitch] = -0.2f;
@@ -82,7 +82,7 @@ void RLWalkingEngine::compile(bool output)
   else
     ASSERT(std::filesystem::exists(modelPath + walkNeuronalNetworkParameters.modelName));
 
-  network.compile(Model(modelPath + walkNeuronalNetworkParameters.modelName));
+  network.load(modelPath + walkNeuronalNetworkParameters.modelName);
   ASSERT(network.valid());
 
   // Input shape: (47)
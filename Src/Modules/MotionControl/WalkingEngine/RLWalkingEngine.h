@@ -30,9 +30,7 @@
 #include "Tools/Motion/MotionPhase.h"
 
 #include "Platform/File.h"
-#include <CompiledNN2ONNX/CompiledNN.h>
-
-using namespace NeuralNetworkONNX;
+#include "Tools/Inference/InferenceEngine.h"
 
 STREAMABLE(BoosterArmParameters,
 {,
@@ -136,7 +134,7 @@ public:
   RLWalkingEngine();
   const float motionCycleTime = Global::getSettings().motionCycleTime;
   RingBuffer<JointAngles, 10> lastMeasurements;
-  CompiledNN network; /**< The compiled neural network. */
+  InferenceEngine network; /**< The neural network. */
   JointAngles offset;
 
   std::vector<Joints::Joint> boosterJoints;
@@ -1345,8 +1345,9 @@ std::unique_ptr<MotionPhase> WalkKickEngine::createPhaseWithNextPhase(const Moti
   kickVariant.kickIndex++;
   kickVariant.ballEstimationTime = std::max(0.f, kickVariant.ballEstimationTime - stepDuration / 1000.f);
 
+  // Only capture this, so that the callback is stored inside the std::function without a heap allocation.
   auto phase = theWalkGenerator.createPhaseWithNextPhase(kickStep,
-                                                         lastPhase, std::bind(&WalkKickEngine::createPhaseWithNextPhase, this, std::placeholders::_1, std::placeholders::_2), kickVariant.delayParams.kickIndex == kickVariant.kickIndex - 1 ? kickVariant.delayParams.delay : 0.f);
+                                                         lastPhase, [this](const MotionPhase& previousPhase, const WalkKickStep& step) {return createPhaseWithNextPhase(previousPhase, step);}, kickVariant.delayParams.kickIndex == kickVariant.kickIndex - 1 ? kickVariant.delayParams.delay : 0.f);
 
   phase->kickType = kickVariant.kickType;
   return phase;
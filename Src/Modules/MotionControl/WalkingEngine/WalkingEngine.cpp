@@ -35,6 +35,10 @@ WalkingEngine::WalkingEngine()
   if(stream.exists())
     stream >> static_cast<WalkingEngineCommon&>(*this);
 
+  MotionPhase::preallocate<WalkPhase>();
+  MotionPhase::preallocate<WalkDelayPhase>();
+  MotionPhase::preallocate<WalkHipShiftPhase>();
+
   const DummyPhase dummy(MotionPhase::playDead);
   WalkPhase phase(*this, Pose2f(), dummy);
 
@@ -61,6 +61,8 @@ MODULE(BallSpotsProvider,
  */
 class BallSpotsProvider : public BallSpotsProviderBase
 {
+  ECImageRequest ecImageRequest{{ECImageRequest::grayscaled, ECImageRequest::saturated}};
+
   /**
    * The main method of this module.
    * @param ballSpots The percept that is filled by this module.
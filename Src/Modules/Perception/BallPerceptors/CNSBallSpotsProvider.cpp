@@ -62,13 +62,15 @@ void CNSBallSpotsProvider::update(BallSpots& ballSpots)
   {
     updateSearchSpace();
 
+    const CNSMaxPyramid pyramid(theCNSImage);
+
     for(const Boundaryi& region : theBallRegions.regions)
     {
       spec.blockX = region.x.getSize();
       spec.blockY = region.y.getSize();
       detector.setSearchSpecification(spec);
       ObjectCNSStereoDetector::IsometryWithResponses newObjects;
-      detector.searchBlockAllPoses(newObjects, theCNSImage, region.x.min, region.y.min);
+      detector.searchBlockAllPoses(newObjects, theCNSImage, pyramid, region.x.min, region.y.min);
 
       if(spec.nRefineIterations > 0)
         for(IsometryWithResponse& object : newObjects)
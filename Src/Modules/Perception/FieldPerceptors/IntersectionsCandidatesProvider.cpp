@@ -27,6 +27,8 @@ IntersectionsCandidatesProvider::IntersectionsCandidatesProvider() = default;
 void IntersectionsCandidatesProvider::update(IntersectionCandidates& intersectionCandidates)
 {
   intersectionCandidates.intersections.clear();
+  patchRegions.clear();
+  std::vector<Vector2f> intersectionsOnImage;
 
   DECLARE_DEBUG_DRAWING("module:IntersectionsCandidatesProvider:field", "drawingOnField");
   DECLARE_DEBUG_DRAWING("module:IntersectionsCandidatesProvider:image", "drawingOnImage");
@@ -108,19 +110,11 @@ void IntersectionsCandidatesProvider::update(IntersectionCandidates& intersectio
       // the position of the intersection on the field needs to be recalculated again as the transformation is not linear so the maxima of the distribution (previous value of intersection) may not be at the same location as the expected value
       theMeasurementCovariance.transformPointWithCov(intersectionOnImage, 0.f, intersectionOnFieldRelativeRobot, cov);
 
-      Image<PixelTypes::GrayscaledPixel> patch(patchSize, patchSize);
-      if(!generatePatch(intersectionOnImage, intersectionOnField, patch))
-        continue;
+      // The patches of all candidates are extracted together after all candidates were found.
+      patchRegions.push_back(getPatchRegion(intersectionOnImage, intersectionOnField));
+      intersectionsOnImage.push_back(intersectionOnImage);
 
       int robotToIntersectionDistance = static_cast<int>(intersectionOnFieldRelativeRobot.norm());
-      if(savePatches)
-      {
-        savePatchOnDisk(patch, type, robotToIntersectionDistance);
-        Image<PixelTypes::GrayscaledPixel> noneIntersectionPatch(patchSize, patchSize);
-        int robotToNoneIntersectionDistance = 0;
-        if(calculateNoneIntersection(intersectionOnImage, noneIntersectionPatch, robotToNoneIntersectionDistance))
-          savePatchOnDisk(noneIntersectionPatch, "none", robotToNoneIntersectionDistance);
-      }
 
       Vector2f fieldCoords = theRobotPose * intersectionOnFieldRelativeRobot;
       COMPLEX_DRAWING("module:IntersectionsCandidatesProvider:field")
@@ -137,7 +131,25 @@ void IntersectionsCandidatesProvider::update(IntersectionCandidates& intersectio
 
       intersectionCandidates.intersections.emplace_back(type, intersectionOnFieldRelativeRobot, intersectionOnField, cov, theLinesPercept.lines[i].line.direction,
                                                         theLinesPercept.lines[j].line.direction, i, j, line1CloserEnd, line2CloserEnd,
-                                                        line1FurtherEnd, line2FurtherEnd, static_cast<float>(robotToIntersectionDistance) / normFactor, patch);
+                                                        line1FurtherEnd, line2FurtherEnd, static_cast<float>(robotToIntersectionDistance) / normFactor,
+                                                        Image<PixelTypes::GrayscaledPixel>(patchSize, patchSize));
+    }
+  }
+
+  const unsigned unstretchedSize = patchSize * stretchingFactor;
+  unstretchedPatches.resize(patchRegions.size() * unstretchedSize * unstretchedSize);
+  PatchUtilities::extractPatches(patchRegions, Vector2i(unstretchedSize, unstretchedSize), theECImage.grayscaled, unstretchedPatches.data());
+  for(size_t i = 0; i < intersectionCandidates.intersections.size(); ++i)
+  {
+    IntersectionCandidates::IntersectionCandidate& intersection = intersectionCandidates.intersections[i];
+    stretchPatch(unstretchedPatches.data() + i * unstretchedSize * unstretchedSize, intersection.imagePatch);
+    if(savePatches)
+    {
+      savePatchOnDisk(intersection.imagePatch, intersection.type, static_cast<int>(intersection.pos.norm()));
+      Image<PixelTypes::GrayscaledPixel> noneIntersectionPatch(patchSize, patchSize);
+      int robotToNoneIntersectionDistance = 0;
+      if(calculateNoneIntersection(intersectionsOnImage[i], noneIntersectionPatch, robotToNoneIntersectionDistance))
+        savePatchOnDisk(noneIntersectionPatch, "none", robotToNoneIntersectionDistance);
     }
   }
 
@@ -147,36 +159,45 @@ void IntersectionsCandidatesProvider::update(IntersectionCandidates& intersectio
 }
 
 bool IntersectionsCandidatesProvider::generatePatch(const Vector2f interImg, const Vector2f& interField, Image<PixelTypes::GrayscaledPixel>& patch) const
+{
+  const PatchUtilities::PatchRegion region = getPatchRegion(interImg, interField);
+  const unsigned int tempOutputSize = patchSize * stretchingFactor; // Size of the patch that gets stretched
+  Image<PixelTypes::GrayscaledPixel> firstPatch(tempOutputSize, tempOutputSize);
+
+  // extract patch
+  PatchUtilities::extractPatch(region.center, region.inSize, Vector2i(tempOutputSize, tempOutputSize), theECImage.grayscaled, firstPatch);
+  stretchPatch(firstPatch[0], patch);
+  return true;
+}
+
+PatchUtilities::PatchRegion IntersectionsCandidatesProvider::getPatchRegion(const Vector2f interImg, const Vector2f& interField) const
 {
   DECLARE_DEBUG_DRAWING("module:IntersectionsCandidatesProvider:PatchFrame", "drawingOnImage");
   RECTANGLE("module:IntersectionsCandidatesProvider:PatchFrame", interImg.x() - patchSize / 2, interImg.y() - patchSize / 2, interImg.x() + patchSize / 2, interImg.y() + patchSize / 2, 3, Drawings::solidPen, ColorRGBA::blue);
 
   const float distanceToIntersection = interField.norm();
-  const unsigned int stretchingFactor = 2; // Stretch the patch along the y-Axis by this factor
-  const unsigned int maxCutoutFactor = 8; // max factor of patchSize for image cutout
   // take bigger image cutout around intersection for down sampling to patchSize
-  ASSERT(maxCutoutFactor >= stretchingFactor);
+  static_assert(maxCutoutFactor >= stretchingFactor);
   const unsigned int inputResize = std::clamp(static_cast<unsigned>(ceilf(normFactor / distanceToIntersection)), stretchingFactor, maxCutoutFactor);
   const unsigned int inputSize = patchSize * inputResize; // This is so that distant intersections do not appear too small in the patch
-  const unsigned int tempOutputSize = patchSize * stretchingFactor; // Size of the patch that gets stretched
-  const Vector2f center(interImg.x(), interImg.y());
-
-  Image<PixelTypes::GrayscaledPixel> firstPatch(tempOutputSize, tempOutputSize);
+  return {interImg.cast<int>(), Vector2i(inputSize, inputSize)};
+}
 
-  // extract patch
-  PatchUtilities::extractPatch(center.cast<int>(), Vector2i(inputSize, inputSize), Vector2i(tempOutputSize, tempOutputSize), theECImage.grayscaled, firstPatch);
+void IntersectionsCandidatesProvider::stretchPatch(const PixelTypes::GrayscaledPixel* unstretchedPatch, Image<PixelTypes::GrayscaledPixel>& patch) const
+{
+  const unsigned int tempOutputSize = patchSize * stretchingFactor;
 
   // The patch height is 64p. But we need a 32x32 patch. So we cut off the first and last 16 pixels to get the center.
   const unsigned int pixelToCutOff = (tempOutputSize - patchSize) / 2;
-  for(unsigned int i = pixelToCutOff; i < firstPatch.height - pixelToCutOff; i++)
+  for(unsigned int i = pixelToCutOff; i < tempOutputSize - pixelToCutOff; i++)
   {
-    for(unsigned int j = 0; j < firstPatch.width; j += stretchingFactor)
+    const PixelTypes::GrayscaledPixel* row = unstretchedPatch + i * tempOutputSize;
+    for(unsigned int j = 0; j < tempOutputSize; j += stretchingFactor)
     {
       // Corrected indices for resizedPatch because we only take half of the height and every other value of the width.
-      patch[i - pixelToCutOff][j - j / stretchingFactor] = firstPatch[i][j];
+      patch[i - pixelToCutOff][j - j / stretchingFactor] = row[j];
     }
   }
-  return true;
 }
 
 // copied from IntersectionsProvider
@@ -23,8 +23,6 @@
 #include "Representations/Perception/FieldPercepts/LinesPercept.h"
 #include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
 #include "Representations/Perception/ImagePreprocessing/ECImage.h"
-#include <CompiledNN/CompiledNN.h>
-#include <CompiledNN/Model.h>
 
 MODULE(IntersectionsCandidatesProvider,
 {,
@@ -57,6 +55,13 @@ public:
   IntersectionsCandidatesProvider();
 
 private:
+  static constexpr unsigned stretchingFactor = 2; /**< Stretch the patch along the y-Axis by this factor. */
+  static constexpr unsigned maxCutoutFactor = 8; /**< Max factor of patchSize for image cutout. */
+
+  ECImageRequest ecImageRequest{{ECImageRequest::grayscaled}};
+  std::vector<PatchUtilities::PatchRegion> patchRegions; /**< The image areas of the patches of all candidates in this frame. */
+  std::vector<PixelTypes::GrayscaledPixel> unstretchedPatches; /**< The patches of all candidates before they are stretched. */
+
   void update(IntersectionCandidates& intersectionCandidates) override;
 
   /**
@@ -68,6 +73,21 @@ private:
    */
   bool generatePatch(const Vector2f interImg, const Vector2f& interField, Image<PixelTypes::GrayscaledPixel>& patch) const;
 
+  /**
+   * Determines the image area from which the patch of an intersection is extracted.
+   * @param interImg image coordinates of the intersection
+   * @param interField field coordinates of the intersection
+   * @return The image area, which is extracted to a patch of patchSize * stretchingFactor pixels.
+   */
+  PatchUtilities::PatchRegion getPatchRegion(const Vector2f interImg, const Vector2f& interField) const;
+
+  /**
+   * Stretches an extracted patch along the y-axis by keeping its center rows and every other column.
+   * @param unstretchedPatch The patch extracted from the area returned by getPatchRegion.
+   * @param[out] patch The patch of patchSize x patchSize pixels.
+   */
+  void stretchPatch(const PixelTypes::GrayscaledPixel* unstretchedPatch, Image<PixelTypes::GrayscaledPixel>& patch) const;
+
   /**
    * Returns the distance of the closer point to target.
    * @param[out] closer the point closer to the target
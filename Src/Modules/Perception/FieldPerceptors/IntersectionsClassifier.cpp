@@ -12,11 +12,10 @@
 
 MAKE_MODULE(IntersectionsClassifier);
 
-IntersectionsClassifier::IntersectionsClassifier() : network(&Global::getAsmjitRuntime())
+IntersectionsClassifier::IntersectionsClassifier()
 {
   // Initialize model for the neural net
-  model = std::make_unique<NeuralNetwork::Model>(std::string(File::getBHDir()) + "/Config/NeuralNets/IntersectionsClassifier/distanceUpdatedModel.h5");
-  network.compile(*model);
+  network.load(std::string(File::getBHDir()) + "/Config/NeuralNets/IntersectionsClassifier/distanceUpdatedModel.h5");
 }
 
 void IntersectionsClassifier::update(IntersectionsPercept& theIntersectionsPercept)
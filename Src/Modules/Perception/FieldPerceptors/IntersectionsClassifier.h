@@ -15,8 +15,7 @@
 #include "Representations/Modeling/RobotPose.h"
 #include "Representations/Perception/FieldPercepts/IntersectionCandidates.h"
 #include "Representations/Perception/FieldPercepts/IntersectionsPercept.h"
-#include <CompiledNN/CompiledNN.h>
-#include <CompiledNN/Model.h>
+#include "Tools/Inference/InferenceEngine.h"
 
 MODULE(IntersectionsClassifier,
 {,
@@ -59,6 +58,5 @@ private:
   /** enforces that horizontal is +90° of vertical */
   void enforceTIntersectionDirections(const Vector2f& vertical, Vector2f& horizontal) const;
 
-  NeuralNetwork::CompiledNN network;
-  std::unique_ptr<NeuralNetwork::Model> model;
+  InferenceEngine network;
 };
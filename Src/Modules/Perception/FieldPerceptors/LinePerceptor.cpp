@@ -11,6 +11,7 @@
 
 #include "Debugging/Annotation.h"
 #include "Debugging/DebugDrawings.h"
+#include "Framework/FrameArena.h"
 #include "ImageProcessing/PixelTypes.h"
 #include "Math/BHMath.h"
 #include "Math/Deviation.h"
@@ -644,9 +645,9 @@ void LinePerceptor::trimLine(LinesPercept::Line& line) const
 
   if(start != line.firstImg || end != line.lastImg)
   {
-    std::vector<Vector2i> spotsInImgTrimmed;
+    FrameVector<Vector2i> spotsInImgTrimmed;
     spotsInImgTrimmed.reserve(line.spotsInImg.size());
-    std::vector<Vector2f> spotsInFieldTrimmed;
+    FrameVector<Vector2f> spotsInFieldTrimmed;
     spotsInFieldTrimmed.reserve(line.spotsInField.size());
     for(unsigned int i = 0; i < line.spotsInImg.size(); ++i)
     {
@@ -657,8 +658,8 @@ void LinePerceptor::trimLine(LinesPercept::Line& line) const
         spotsInFieldTrimmed.emplace_back(line.spotsInField.at(i));
       }
     }
-    line.spotsInImg = spotsInImgTrimmed;
-    line.spotsInField = spotsInFieldTrimmed;
+    line.spotsInImg.assign(spotsInImgTrimmed.begin(), spotsInImgTrimmed.end());
+    line.spotsInField.assign(spotsInFieldTrimmed.begin(), spotsInFieldTrimmed.end());
   }
 }
 
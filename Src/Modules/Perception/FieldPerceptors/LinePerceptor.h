@@ -88,6 +88,7 @@ MODULE(LinePerceptor,
 class LinePerceptor : public LinePerceptorBase
 {
 private:
+  ECImageRequest ecImageRequest{{ECImageRequest::grayscaled, ECImageRequest::saturated}};
   /**
    * Structure for a line spot.
    */
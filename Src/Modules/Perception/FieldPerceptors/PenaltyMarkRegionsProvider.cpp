@@ -12,6 +12,7 @@
 #include "PenaltyMarkRegionsProvider.h"
 #include "Tools/Math/InImageSizeCalculations.h"
 #include "ImageProcessing/PixelTypes.h"
+#include "Framework/FrameArena.h"
 
 MAKE_MODULE(PenaltyMarkRegionsProvider);
 
@@ -126,7 +127,7 @@ void PenaltyMarkRegionsProvider::unionFind(int xStep)
 
 void PenaltyMarkRegionsProvider::analyzeRegions(unsigned short upperBound, int xStep, std::vector<Boundaryi>& searchRegions)
 {
-  std::vector<Region*> mergedRegions;
+  FrameVector<Region*> mergedRegions;
   mergedRegions.reserve(100);
   for(Region& region : regions)
     if(region.parent == &region)
@@ -152,7 +153,7 @@ void PenaltyMarkRegionsProvider::analyzeRegions(unsigned short upperBound, int x
     int xExtent;
     int yExtent;
   } candidate;
-  std::vector<Candidate> candidates;
+  FrameVector<Candidate> candidates;
   for(Region* region : mergedRegions)
     if(region->upper >= upperBound && region->lower < lowerBound)
     {
@@ -26,6 +26,8 @@ MODULE(CNSImageProvider,
 
 class CNSImageProvider : public CNSImageProviderBase
 {
+  ECImageRequest ecImageRequest{{ECImageRequest::grayscaled}, fullImage ? ECImageRequest::fullImage : 0};
+
   /**
    * Computes the cns image from the grayscale image.
    * If \c doBlur is true, the source image is blurred by a 3*3 Gaussian before computing
@@ -6,41 +6,96 @@
 
 #include "ECImageProvider.h"
 #include "Streaming/Global.h"
+#include "Tools/Math/Projection.h"
 #include <asmjit/asmjit.h>
+#include <algorithm>
 
 MAKE_MODULE(ECImageProvider);
 
-#if !defined __arm64__ && !defined __aarch64__
-
 void ECImageProvider::update(ECImage& ecImage)
 {
-  ecImage.grayscaled.setResolution(theCameraInfo.width, theCameraInfo.height);
-  ecImage.saturated.setResolution(theCameraInfo.width, theCameraInfo.height);
-  ecImage.hued.setResolution(theCameraInfo.width, theCameraInfo.height);
-  ecImage.blueChromaticity.setResolution(theCameraInfo.width / 2, theCameraInfo.height / 2);
-  ecImage.redChromaticity.setResolution(theCameraInfo.width / 2, theCameraInfo.height / 2);
+  std::array<int, ECImageRequest::numOfPlanes> rowsAboveHorizon = ECImageRequest::getUnion();
 
-  if(theCameraImage.timestamp > 10 && static_cast<int>(theCameraImage.width) == theCameraInfo.width / 2)
+  // The samples for the camera calibration contain the whole image.
+  if(theCalibrationRequest.targetState == CameraCalibrationStatus::State::recordSamples)
+    rowsAboveHorizon.fill(ECImageRequest::fullImage);
+
+  // Planes shown as debug images are computed completely.
+  DEBUG_RESPONSE("debug images:GrayscaledImage")
+    rowsAboveHorizon[ECImageRequest::grayscaled] = ECImageRequest::fullImage;
+  DEBUG_RESPONSE("debug images:SaturatedImage")
+    rowsAboveHorizon[ECImageRequest::saturated] = ECImageRequest::fullImage;
+  DEBUG_RESPONSE("debug images:HuedImage")
+    rowsAboveHorizon[ECImageRequest::hued] = ECImageRequest::fullImage;
+  DEBUG_RESPONSE("debug images:BlueChromaticityImage")
+    rowsAboveHorizon[ECImageRequest::chromaticity] = ECImageRequest::fullImage;
+  DEBUG_RESPONSE("debug images:RedChromaticityImage")
+    rowsAboveHorizon[ECImageRequest::chromaticity] = ECImageRequest::fullImage;
+
+  // The color kernels also compute the grayscaled plane.
+  const bool colors = rowsAboveHorizon[ECImageRequest::saturated] != ECImageRequest::notRequested
+                      || rowsAboveHorizon[ECImageRequest::hued] != ECImageRequest::notRequested;
+  const bool grayscaled = colors || rowsAboveHorizon[ECImageRequest::grayscaled] != ECImageRequest::notRequested;
+  const bool chroma = rowsAboveHorizon[ECImageRequest::chromaticity] != ECImageRequest::notRequested;
+  const unsigned width = theCameraInfo.width;
+  const unsigned height = theCameraInfo.height;
+  ecImage.grayscaled.setResolution(grayscaled ? width : 0, grayscaled ? height : 0);
+  ecImage.saturated.setResolution(colors ? width : 0, colors ? height : 0);
+  ecImage.hued.setResolution(colors ? width : 0, colors ? height : 0);
+  ecImage.blueChromaticity.setResolution(chroma ? width / 2 : 0, chroma ? height / 2 : 0);
+  ecImage.redChromaticity.setResolution(chroma ? width / 2 : 0, chroma ? height / 2 : 0);
+
+  if(theCameraImage.timestamp > 10 && theCameraImage.width == width / 2)
   {
-    if(disableColor)
-    {
-      if(!eFunc)
-        compileE();
-      eFunc(theCameraInfo.width * theCameraInfo.height / 16, theCameraImage[0], ecImage.grayscaled[0]);
-    }
-    else
-    {
-      if(!ecFunc)
-        compileEC();
-
-      ecFunc(theCameraInfo.width * theCameraInfo.height / 16, theCameraImage[0], ecImage.grayscaled[0], ecImage.saturated[0], ecImage.hued[0]);
-    }
-    if(extractChroma)
-      extractChromaticity(ecImage);
+    const unsigned colorsFrom = colors && !disableColor
+                                ? std::min(firstRow(rowsAboveHorizon[ECImageRequest::saturated]), firstRow(rowsAboveHorizon[ECImageRequest::hued]))
+                                : height;
+    const unsigned grayscaledFrom = std::min(firstRow(rowsAboveHorizon[ECImageRequest::grayscaled]), colorsFrom);
+    if(grayscaledFrom < colorsFrom)
+      computeGrayscaled(ecImage, grayscaledFrom, colorsFrom);
+    if(colorsFrom < height)
+      computeColors(ecImage, colorsFrom, height);
+    const unsigned chromaFrom = firstRow(rowsAboveHorizon[ECImageRequest::chromaticity]);
+    if(chromaFrom < height)
+      extractChromaticity(ecImage, chromaFrom);
     ecImage.timestamp = theCameraImage.timestamp;
   }
 }
 
+unsigned ECImageProvider::firstRow(int rowsAboveHorizon) const
+{
+  if(rowsAboveHorizon == ECImageRequest::notRequested)
+    return theCameraInfo.height;
+
+  // Without a valid camera matrix or if the camera is upside down, the field might be anywhere.
+  if(rowsAboveHorizon == ECImageRequest::fullImage || !theCameraMatrix.isValid
+     || (theCameraMatrix.rotation * Vector3f(0, 0, 1)).z() < 0)
+    return 0;
+
+  // The upper end of the horizon limits the rows below it.
+  const Geometry::Line horizon = Projection::calculateHorizon(theCameraMatrix, theCameraInfo);
+  const float top = horizon.base.y() - std::abs(horizon.direction.y()) * 0.5f - static_cast<float>(rowsAboveHorizon + horizonMargin);
+
+  // The kernels and the chromaticity need rows that start at a multiple of 4.
+  return static_cast<unsigned>(std::clamp(top, 0.f, static_cast<float>(theCameraInfo.height))) & ~3u;
+}
+
+#if !defined __arm64__ && !defined __aarch64__
+
+void ECImageProvider::computeGrayscaled(ECImage& ecImage, unsigned from, unsigned to)
+{
+  if(!eFunc)
+    compileE();
+  eFunc(theCameraInfo.width * (to - from) / 16, theCameraImage[from], ecImage.grayscaled[from]);
+}
+
+void ECImageProvider::computeColors(ECImage& ecImage, unsigned from, unsigned to)
+{
+  if(!ecFunc)
+    compileEC();
+  ecFunc(theCameraInfo.width * (to - from) / 16, theCameraImage[from], ecImage.grayscaled[from], ecImage.saturated[from], ecImage.hued[from]);
+}
+
 using namespace asmjit;
 
 void ECImageProvider::compileE()
@@ -327,23 +382,23 @@ ECImageProvider::~ECImageProvider()
 
 #include "ImageProcessing/YHSColorConversion.h"
 
-template<bool aligned, bool avx>
+template<bool aligned, bool avx, bool colors>
 void updateSSE(const PixelTypes::YUYVPixel* const srcImage, const int srcWidth, const int srcHeight,
-               Image<PixelTypes::GrayscaledPixel>& grayscaled,
-               Image<PixelTypes::HuePixel>& hued, Image<PixelTypes::GrayscaledPixel>& saturated)
+               PixelTypes::GrayscaledPixel* const grayscaled,
+               PixelTypes::HuePixel* const hued, PixelTypes::GrayscaledPixel* const saturated)
 {
   ASSERT(srcWidth % 32 == 0);
 
-  __m_auto_i* grayscaledDest = reinterpret_cast<__m_auto_i*>(grayscaled[0]) - 1;
-  __m_auto_i* saturatedDest = reinterpret_cast<__m_auto_i*>(saturated[0]) - 1;
-  __m_auto_i* huedDest = reinterpret_cast<__m_auto_i*>(hued[0]) - 1;
+  __m_auto_i* grayscaledDest = reinterpret_cast<__m_auto_i*>(grayscaled) - 1;
+  __m_auto_i* saturatedDest = reinterpret_cast<__m_auto_i*>(saturated) - 1;
+  __m_auto_i* huedDest = reinterpret_cast<__m_auto_i*>(hued) - 1;
   const __m_auto_i* const imageEnd = reinterpret_cast<const __m_auto_i*>(srcImage + srcWidth * srcHeight) - 1;
 
   static const __m_auto_i c_128 = _mmauto_set1_epi8(char(128));
   static const __m_auto_i channelMask = _mmauto_set1_epi16(0x00FF);
 
   const char* prefetchSrc = reinterpret_cast<const char*>(srcImage) + (avx ? 128 : 64);
-  const char* prefetchGrayscaledDest = reinterpret_cast<const char*>(grayscaled[0]) + (avx ? 64 : 32);
+  const char* prefetchGrayscaledDest = reinterpret_cast<const char*>(grayscaled) + (avx ? 64 : 32);
 
   const __m_auto_i* src = reinterpret_cast<__m_auto_i const*>(srcImage) - 1;
   while(src < imageEnd)
@@ -367,61 +422,66 @@ void updateSSE(const PixelTypes::YUYVPixel* const srcImage, const int srcWidth,
     _mm_prefetch(prefetchGrayscaledDest += 32, _MM_HINT_T0);
     if(avx) _mm_prefetch(prefetchGrayscaledDest += 32, _MM_HINT_T0);
 
-    // Compute saturation
-    const __m_auto_i uv0 = _mmauto_sub_epi8(_mmauto_correct_256op(_mmauto_packus_epi16(_mmauto_and_si_all(_mmauto_srli_si_all(p0, 1), channelMask), _mmauto_and_si_all(_mmauto_srli_si_all(p1, 1), channelMask))), c_128);
-    const __m_auto_i uv1 = _mmauto_sub_epi8(_mmauto_correct_256op(_mmauto_packus_epi16(_mmauto_and_si_all(_mmauto_srli_si_all(p2, 1), channelMask), _mmauto_and_si_all(_mmauto_srli_si_all(p3, 1), channelMask))), c_128);
-
-    const __m_auto_i sat0 = YHSColorConversion::computeLightingIndependentSaturation<avx>(y0, uv0);
-    const __m_auto_i sat1 = YHSColorConversion::computeLightingIndependentSaturation<avx>(y1, uv1);
-    _mmauto_streamt_si_all<true>(++saturatedDest, sat0);
-    _mmauto_streamt_si_all<true>(++saturatedDest, sat1);
-
-    // Compute hue
-    const __m_auto_i hue = YHSColorConversion::computeHue<avx>(uv0, uv1);
-    __m_auto_i hue0 = hue;
-    __m_auto_i hue1 = hue;
-    _mmauto_unpacklohi_epi8(hue0, hue1);
-    _mmauto_streamt_si_all<true>(++huedDest, hue0);
-    _mmauto_streamt_si_all<true>(++huedDest, hue1);
+    if constexpr(colors)
+    {
+      // Compute saturation
+      const __m_auto_i uv0 = _mmauto_sub_epi8(_mmauto_correct_256op(_mmauto_packus_epi16(_mmauto_and_si_all(_mmauto_srli_si_all(p0, 1), channelMask), _mmauto_and_si_all(_mmauto_srli_si_all(p1, 1), channelMask))), c_128);
+      const __m_auto_i uv1 = _mmauto_sub_epi8(_mmauto_correct_256op(_mmauto_packus_epi16(_mmauto_and_si_all(_mmauto_srli_si_all(p2, 1), channelMask), _mmauto_and_si_all(_mmauto_srli_si_all(p3, 1), channelMask))), c_128);
+
+      const __m_auto_i sat0 = YHSColorConversion::computeLightingIndependentSaturation<avx>(y0, uv0);
+      const __m_auto_i sat1 = YHSColorConversion::computeLightingIndependentSaturation<avx>(y1, uv1);
+      _mmauto_streamt_si_all<true>(++saturatedDest, sat0);
+      _mmauto_streamt_si_all<true>(++saturatedDest, sat1);
+
+      // Compute hue
+      const __m_auto_i hue = YHSColorConversion::computeHue<avx>(uv0, uv1);
+      __m_auto_i hue0 = hue;
+      __m_auto_i hue1 = hue;
+      _mmauto_unpacklohi_epi8(hue0, hue1);
+      _mmauto_streamt_si_all<true>(++huedDest, hue0);
+      _mmauto_streamt_si_all<true>(++huedDest, hue1);
+    }
   }
 }
 
-void ECImageProvider::update(ECImage& ecImage)
+template<bool colors>
+void convert(const CameraImage& cameraImage, ECImage& ecImage, unsigned from, unsigned to)
 {
-  ecImage.grayscaled.setResolution(theCameraInfo.width, theCameraInfo.height);
-  ecImage.saturated.setResolution(theCameraInfo.width, theCameraInfo.height);
-  ecImage.hued.setResolution(theCameraInfo.width, theCameraInfo.height);
-  ecImage.blueChromaticity.setResolution(theCameraInfo.width / 2, theCameraInfo.height / 2);
-  ecImage.redChromaticity.setResolution(theCameraInfo.width / 2, theCameraInfo.height / 2);
+  const PixelTypes::YUYVPixel* const src = cameraImage[from];
+  PixelTypes::HuePixel* const hued = colors ? ecImage.hued[from] : nullptr;
+  PixelTypes::GrayscaledPixel* const saturated = colors ? ecImage.saturated[from] : nullptr;
+  if(simdAligned<_supportsAVX2>(src))
+    updateSSE<true, _supportsAVX2, colors>(src, cameraImage.width, to - from, ecImage.grayscaled[from], hued, saturated);
+  else
+    updateSSE<false, _supportsAVX2, colors>(src, cameraImage.width, to - from, ecImage.grayscaled[from], hued, saturated);
+}
 
-  if(theCameraImage.timestamp > 10 && static_cast<int>(theCameraImage.width) == theCameraInfo.width / 2)
-  {
-    const PixelTypes::YUYVPixel* const src = reinterpret_cast<const PixelTypes::YUYVPixel* const>(theCameraImage[0]);
-    if(simdAligned<_supportsAVX2>(src))
-      updateSSE<true, _supportsAVX2>(src, theCameraImage.width, theCameraImage.height, ecImage.grayscaled, ecImage.hued, ecImage.saturated);
-    else
-      updateSSE<false, _supportsAVX2>(src, theCameraImage.width, theCameraImage.height, ecImage.grayscaled, ecImage.hued, ecImage.saturated);
-    if(extractChroma)
-      extractChromaticity(ecImage);
-    ecImage.timestamp = theCameraImage.timestamp;
-  }
+void ECImageProvider::computeGrayscaled(ECImage& ecImage, unsigned from, unsigned to)
+{
+  convert<false>(theCameraImage, ecImage, from, to);
+}
+
+void ECImageProvider::computeColors(ECImage& ecImage, unsigned from, unsigned to)
+{
+  convert<true>(theCameraImage, ecImage, from, to);
 }
 
 ECImageProvider::~ECImageProvider() {}
 
 #endif
 
-void ECImageProvider::extractChromaticity(ECImage& eCImage)
+void ECImageProvider::extractChromaticity(ECImage& eCImage, unsigned from)
 {
   ASSERT(theCameraImage.width == static_cast<unsigned int>(theCameraInfo.width / 2));
+  ASSERT(from % 2 == 0);
   STOPWATCH("module:ECImageProvider:extractChromaticity")
   {
-    PixelTypes::GrayscaledPixel* uPos = eCImage.blueChromaticity[0];
-    PixelTypes::GrayscaledPixel* vPos = eCImage.redChromaticity[0];
-    const PixelTypes::YUYVPixel* yuyvUpperRowPos = theCameraImage[0];
-    const PixelTypes::YUYVPixel* yuyvLowerRowPos = theCameraImage[0] + theCameraImage.width;
+    PixelTypes::GrayscaledPixel* uPos = eCImage.blueChromaticity[from / 2];
+    PixelTypes::GrayscaledPixel* vPos = eCImage.redChromaticity[from / 2];
+    const PixelTypes::YUYVPixel* yuyvUpperRowPos = theCameraImage[from];
+    const PixelTypes::YUYVPixel* yuyvLowerRowPos = theCameraImage[from] + theCameraImage.width;
     // += theCameraImage.width to alternate iterating and skipping rows
-    for(unsigned int yPos = 0; yPos < theCameraImage.height; yPos += 2, yuyvUpperRowPos += theCameraImage.width, yuyvLowerRowPos += theCameraImage.width)
+    for(unsigned int yPos = from; yPos < theCameraImage.height; yPos += 2, yuyvUpperRowPos += theCameraImage.width, yuyvLowerRowPos += theCameraImage.width)
     {
       for(unsigned int xPos = 0; xPos < theCameraImage.width; ++xPos, ++yuyvUpperRowPos, ++yuyvLowerRowPos, ++uPos, ++vPos)
       {
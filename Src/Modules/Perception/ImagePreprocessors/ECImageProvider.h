@@ -9,6 +9,7 @@
 #include "Representations/Configuration/CalibrationRequest.h"
 #include "Representations/Infrastructure/CameraImage.h"
 #include "Representations/Infrastructure/CameraInfo.h"
+#include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
 #include "Representations/Perception/ImagePreprocessing/ECImage.h"
 #include "Framework/Module.h"
 
@@ -17,18 +18,20 @@ MODULE(ECImageProvider,
   REQUIRES(CalibrationRequest),
   REQUIRES(CameraInfo),
   REQUIRES(CameraImage),
+  REQUIRES(CameraMatrix),
   REQUIRES(ECImage),
   PROVIDES(ECImage),
   PROVIDES(OptionalECImage),
   LOADS_PARAMETERS(
   {,
     (bool) disableColor,
-    (bool) extractChroma,
+    (int) horizonMargin, /**< Rows above the horizon always computed for requested planes, covering the rolling shutter and head motion. */
   }),
 });
 
 /**
  * @class ECImageProvider
+ * Computes the planes of the ECImage requested by the modules of this thread.
  */
 class ECImageProvider : public ECImageProviderBase
 {
@@ -41,6 +44,31 @@ private:
 
   void update(ECImage& ecImage) override;
   void update(OptionalECImage& theOptionalECImage) override;
+
+  /**
+   * Determines the first row that must be computed for a plane.
+   * @param rowsAboveHorizon The number of rows above the horizon requested.
+   * @return The first row, which is a multiple of 4, or the image height if
+   *         no rows are requested.
+   */
+  unsigned firstRow(int rowsAboveHorizon) const;
+
+  /**
+   * Computes the grayscaled plane for a range of rows.
+   * @param ecImage The image the plane of which is computed.
+   * @param from The first row.
+   * @param to The row after the last one.
+   */
+  void computeGrayscaled(ECImage& ecImage, unsigned from, unsigned to);
+
+  /**
+   * Computes the grayscaled, saturated, and hued planes for a range of rows.
+   * @param ecImage The image the planes of which are computed.
+   * @param from The first row.
+   * @param to The row after the last one.
+   */
+  void computeColors(ECImage& ecImage, unsigned from, unsigned to);
+
   void compileE();
   void compileEC();
   /**
@@ -49,8 +77,9 @@ private:
    * the extracted image get provided in half resolution (width and height).
    * Therefore the values are linearly interpolated in the height dimension.
    * @param eCImage
+   * @param from The first row in full resolution. Must be even.
    */
-  void extractChromaticity(ECImage& eCImage);
+  void extractChromaticity(ECImage& eCImage, unsigned from);
 
 public:
   ~ECImageProvider();
@@ -14,19 +14,17 @@
 #include "Platform/BHAssert.h"
 #include "Platform/File.h"
 #include "Debugging/DebugDrawings.h"
-#include "Streaming/Global.h"
+#include "Framework/FrameArena.h"
 #include "ImageProcessing/PatchUtilities.h"
 #include "Tools/Math/Transformation.h"
 
 MAKE_MODULE(FieldBoundaryProvider);
 
-FieldBoundaryProvider::FieldBoundaryProvider() :
-  network(&Global::getAsmjitRuntime())
+FieldBoundaryProvider::FieldBoundaryProvider()
 {
-  model = std::make_unique<NeuralNetwork::Model>(std::string(File::getBHDir()) + ((theCameraInfo.camera == CameraInfo::upper) ? "/Config/NeuralNets/FieldBoundary/net.h5" : "/Config/NeuralNets/FieldBoundary/net-uncertainty.h5"));
-  model->setInputUInt8(0);
-
-  network.compile(*model);
+  InferenceEngine::Options options;
+  options.uint8Inputs = {0};
+  network.load(std::string(File::getBHDir()) + ((theCameraInfo.camera == CameraInfo::upper) ? "/Config/NeuralNets/FieldBoundary/net.h5" : "/Config/NeuralNets/FieldBoundary/net-uncertainty.h5"), options);
 
   ASSERT(network.valid());
 
@@ -100,8 +98,15 @@ void FieldBoundaryProvider::validatePrediction(FieldBoundary& fieldBoundary, std
         if(s.inImage.y() > top)
           newSpots.push_back(s);
       }
+      std::vector<Spot> model;
       STOPWATCH("FieldBoundaryProvider:fitBoundaryRansac")
-        fitBoundaryRansac(newSpots, fieldBoundary);
+        ransacFitting.fit(newSpots, {maxNumberOfIterations, maxSquaredError, spotAbovePenaltyFactor, acceptanceRatio, warmStart},
+                          theCameraMatrix, theCameraInfo, theImageCoordinateSystem, theOdometryData, model);
+      for(const Spot& spot : model)
+      {
+        fieldBoundary.boundaryInImage.emplace_back(spot.inImage);
+        fieldBoundary.boundaryOnField.emplace_back(spot.onField);
+      }
     }
     else if(fittingMethod == notRansac)
     {
@@ -129,16 +134,20 @@ void FieldBoundaryProvider::validatePrediction(FieldBoundary& fieldBoundary, std
 void FieldBoundaryProvider::projectPrevious(FieldBoundary& fieldBoundary)
 {
   const Pose2f invOdometryOffset = theOdometryData.inverse() * theOtherOdometryData;
+  FrameVector<Vector2f> spotsInImage;
   for(Vector2f spotOnField : theOtherFieldBoundary.boundaryOnField)
   {
     Vector2f spotInImage;
     spotOnField = invOdometryOffset * spotOnField;
     if(Transformation::robotToImage(spotOnField, theCameraMatrix, theCameraInfo, spotInImage))
     {
-      fieldBoundary.boundaryInImage.emplace_back(theImageCoordinateSystem.fromCorrected(spotInImage).cast<int>());
+      spotsInImage.emplace_back(spotInImage);
       fieldBoundary.boundaryOnField.emplace_back(spotOnField);
     }
   }
+  theImageCoordinateSystem.getCorrection().fromCorrected(spotsInImage.data(), spotsInImage.data(), spotsInImage.size());
+  for(const Vector2f& spotInImage : spotsInImage)
+    fieldBoundary.boundaryInImage.emplace_back(spotInImage.cast<int>());
   fieldBoundary.extrapolated = true;
 }
 
@@ -237,93 +246,6 @@ bool FieldBoundaryProvider::boundaryIsOdd(const std::vector<Spot>& spots) const
     return false;
 }
 
-void FieldBoundaryProvider::fitBoundaryRansac(const std::vector<Spot>& spots, FieldBoundary& fieldBoundary)
-{
-  std::vector<Spot> fbModel;
-  fbModel.reserve(3);
-
-  int minError = std::numeric_limits<int>::max();
-  const int goodEnough = static_cast<int>(static_cast<float>(maxSquaredError * spots.size()) * acceptanceRatio);
-
-  for(int i = 0; i < maxNumberOfIterations && minError > goodEnough; ++i)
-  {
-    // Draw three unique samples sorted by their x-coordinate.
-    const size_t middleIndex = Random::uniformInt(static_cast<size_t>(1), spots.size() - 2);
-    const Spot& leftSpot = spots[Random::uniformInt(middleIndex - 1)];
-    const Spot& middleSpot = spots[middleIndex];
-    const Spot& rightSpot = spots[Random::uniformInt(middleIndex + 1, spots.size() - 1)];
-
-    // Construct lines, second is perpendicular to first one on the field.
-    Vector2f dirOnField = middleSpot.onField - leftSpot.onField;
-    const Geometry::Line leftOnField(leftSpot.onField, dirOnField);
-    const Geometry::Line rightOnField(rightSpot.onField, dirOnField.rotateLeft()); // Changes dirOnField!
-
-    // Compute hypothetical corner in field coordinates.
-    Vector2f inImage;
-    Spot corner;
-    if(Geometry::getIntersectionOfLines(leftOnField, rightOnField, corner.onField)
-       && Transformation::robotToImage(corner.onField, theCameraMatrix, theCameraInfo, inImage))
-    {
-      corner.inImage = theImageCoordinateSystem.fromCorrected(inImage).cast<int>();
-
-      // Corner must be right of left spot, left of the right spot, and above connecting line.
-      if(corner.inImage.x() <= leftSpot.inImage.x() || corner.inImage.x() >= rightSpot.inImage.x()
-         || corner.inImage.y() >= leftSpot.inImage.y() + (corner.inImage.x() - leftSpot.inImage.x())
-         * (rightSpot.inImage.y() - leftSpot.inImage.y()) / (rightSpot.inImage.x() - leftSpot.inImage.x()))
-        corner.inImage.x() = theCameraInfo.width; // It is not -> ignore
-    }
-    else
-      corner.inImage.x() = theCameraInfo.width; // Corner invalid -> ignore
-
-    const Vector2i dirLeft = middleSpot.inImage - leftSpot.inImage;
-    const Vector2i dirRight = rightSpot.inImage - corner.inImage;
-
-    size_t j = 0;
-
-    // Accumulate errors in image coordinates for left line.
-    int errorLeft = 0;
-    while(j < spots.size() && spots[j].inImage.x() < corner.inImage.x() && errorLeft < minError)
-    {
-      const Vector2i& s = spots[j++].inImage;
-      errorLeft += effectiveError(leftSpot.inImage.y() + dirLeft.y() * (s.x() - leftSpot.inImage.x()) / dirLeft.x() - s.y());
-    }
-
-    // Accumulate errors in image coordinates, assuming both a continuing left line and a separate right line.
-    int errorRightLine = 0; // Assuming a separate line on the right.
-    int errorRightStraight = 0; // Assuming left line continues.
-    const int abortError = minError - errorLeft;
-    while(j < spots.size() && std::min(errorRightLine, errorRightStraight) < abortError)
-    {
-      const Vector2i& s = spots[j++].inImage;
-      errorRightLine += effectiveError(corner.inImage.y() + dirRight.y() * (s.x() - corner.inImage.x()) / dirRight.x() - s.y());
-      errorRightStraight += effectiveError(leftSpot.inImage.y() + dirLeft.y() * (s.x() - leftSpot.inImage.x()) / dirLeft.x() - s.y());
-    }
-
-    // Update model if it is better than the best found so far.
-    const int error = errorLeft + std::min(errorRightLine, errorRightStraight);
-    if(error < minError)
-    {
-      minError = error;
-      fbModel.clear();
-      fbModel.emplace_back(leftSpot);
-
-      if(errorRightLine < errorRightStraight)
-      {
-        fbModel.emplace_back(corner);
-        fbModel.emplace_back(rightSpot);
-      }
-      else
-        fbModel.emplace_back(middleSpot);
-    }
-  }
-
-  for(const Spot& spot : fbModel)
-  {
-    fieldBoundary.boundaryInImage.emplace_back(spot.inImage);
-    fieldBoundary.boundaryOnField.emplace_back(spot.onField);
-  }
-}
-
 void FieldBoundaryProvider::fitBoundaryNotRansac(const std::vector<Spot>& spots, FieldBoundary& fieldBoundary)
 {
   struct TwoLineModel
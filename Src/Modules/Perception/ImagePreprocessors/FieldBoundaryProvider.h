@@ -18,8 +18,8 @@
 #include "Math/Geometry.h"
 #include "Math/LeastSquares.h"
 #include "Framework/Module.h"
-#include <CompiledNN/CompiledNN.h>
-#include <memory>
+#include "Tools/Inference/InferenceEngine.h"
+#include "Tools/Perception/FieldBoundaryRansac.h"
 
 ENUM(FittingMethod,
 {,
@@ -54,6 +54,7 @@ MODULE(FieldBoundaryProvider,
     (float) uncertaintyLimit, /**< maximum average uncertainty of the non top spots to be not considered as odd */
     (int) maxPointsUnderBorder, /**< how much the points are allowed to be below the lower end on average */
     (bool) useOtherFieldBoundary, /**< Allow using the field boundary of the other camera. */
+    (bool) warmStart, /**< Start RANSAC with a sample near the model of the previous frame, moved by the odometry since then. */
   }),
 });
 
@@ -64,16 +65,7 @@ public:
   FieldBoundaryProvider();
 
 private:
-  /** A boundary spot both in image and field coordinates. */
-  struct Spot
-  {
-    Vector2i inImage; /**< The spot in image coordinates. */
-    Vector2f onField; /**< The spot in robot-relative field coordinates. */
-    float uncertainty; /**<uncertainty of the network for this spot 0 if the network do not provide it */
-
-    Spot() = default;
-    Spot(const Vector2i& inImage, const Vector2f& onField, const float u) : inImage(inImage), onField(onField), uncertainty(u) {}
-  };
+  using Spot = FieldBoundaryRansac::Spot;
 
   struct LineCandidate
   {
@@ -125,29 +117,9 @@ private:
    */
   bool boundaryIsOdd(const std::vector<Spot>& spots) const;
 
-  /**
-   * Return a weighted, squared, and saturated error between boundary spots and a
-   * boundary line.
-   * @param error The vertical pixel offset between spot and line. Positive if the
-   *              spot is above the line.
-   */
-  int effectiveError(int error) const
-  {
-    return std::min(sqr(error), maxSquaredError) * (error < 0 ? 1 : spotAbovePenaltyFactor);
-  }
-
-  /**
-   * Calculate the field boundary using the RANSAC approach. The method always constructs a
-   * model from three sample points and considers a straight line between the first two points
-   * or also a perpendicular line (in field coordinates) to the third point.
-   * @param spots The boundary spots that are sampled.
-   * @param fieldBoundary The field boundary that is filled.
-   */
-  void fitBoundaryRansac(const std::vector<Spot>& spots, FieldBoundary& fieldBoundary);
-
   void fitBoundaryNotRansac(const std::vector<Spot>& spots, FieldBoundary& fieldBoundary);
 
-  std::unique_ptr<NeuralNetwork::Model> model; /**< The model of the neural network. */
-  NeuralNetwork::CompiledNN network; /**< The compiled neural network. */
+  InferenceEngine network; /**< The neural network. */
   Vector2i patchSize;  /**< The width and height of the neural network input image. */
+  FieldBoundaryRansac ransacFitting; /**< The RANSAC fitting, which remembers the previous model. */
 };
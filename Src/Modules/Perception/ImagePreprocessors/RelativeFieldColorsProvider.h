@@ -25,6 +25,8 @@ MODULE(RelativeFieldColorsProvider,
 
 class RelativeFieldColorsProvider : public RelativeFieldColorsProviderBase
 {
+  ECImageRequest ecImageRequest{{ECImageRequest::grayscaled, ECImageRequest::saturated}};
+
   /**
    * Updates the RelativeFieldColors.
    * @param theRelativeFieldColors The provided representation.
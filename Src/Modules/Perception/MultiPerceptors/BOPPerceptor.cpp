@@ -11,7 +11,6 @@
 #include "Platform/BHAssert.h"
 #include "Platform/File.h"
 #include "Debugging/DebugImages.h"
-#include "Streaming/Global.h"
 #include "ImageProcessing/Image.h"
 #include "Tools/Math/InImageSizeCalculations.h"
 #include "Tools/Math/Transformation.h"
@@ -21,16 +20,11 @@
 
 MAKE_MODULE(BOPPerceptor);
 
-BOPPerceptor::BOPPerceptor() :
-  network(&Global::getAsmjitRuntime())
+BOPPerceptor::BOPPerceptor()
 {
-  model = std::make_unique<NeuralNetwork::Model>(std::string(File::getBHDir()) + "/Config/NeuralNets/BOP/net.h5");
-  model->setInputUInt8(0);
-  NeuralNetwork::CompilationSettings settings;
-#if defined MACOS && defined __arm64__
-  settings.useCoreML = true;
-#endif
-  network.compile(*model, settings);
+  InferenceEngine::Options options;
+  options.uint8Inputs = {0};
+  network.load(std::string(File::getBHDir()) + "/Config/NeuralNets/BOP/net.h5", options);
 
   ASSERT(network.valid());
 
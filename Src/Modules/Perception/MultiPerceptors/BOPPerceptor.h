@@ -21,8 +21,7 @@
 #include "Math/Boundary.h"
 #include "Math/Eigen.h"
 #include "Framework/Module.h"
-#include <CompiledNN/CompiledNN.h>
-#include <memory>
+#include "Tools/Inference/InferenceEngine.h"
 #include <vector>
 
 MODULE(BOPPerceptor,
@@ -70,8 +69,7 @@ private:
   static constexpr std::size_t obstaclesIndex = 2; /**< Index of the obstacles channel. */
   static constexpr std::size_t numOfChannels = 4; /**< Number of channels per neural network output pixel. */
 
-  std::unique_ptr<NeuralNetwork::Model> model; /**< The model of the neural network. */
-  NeuralNetwork::CompiledNN network; /**< The compiled neural network. */
+  InferenceEngine network; /**< The neural network. */
   Vector2i inputSize; /**< Input size of the neural network. */
   Vector2i outputSize; /**< Output size of the neural network. */
   Vector2i scale; /**< Scale of the neural network (input size / output size). */
@@ -15,15 +15,13 @@
 #include "Platform/SystemCall.h"
 #include "Debugging/DebugDrawings.h"
 #include "Debugging/Stopwatch.h"
-#include "Streaming/Global.h"
 #include "Tools/Math/Projection.h"
 #include "Tools/Math/Transformation.h"
 #include <filesystem>
 
 MAKE_MODULE(BallAndPenaltyMarkPerceptor);
 
-BallAndPenaltyMarkPerceptor::BallAndPenaltyMarkPerceptor() :
-  multihead(&Global::getAsmjitRuntime())
+BallAndPenaltyMarkPerceptor::BallAndPenaltyMarkPerceptor()
 {
   compile();
 }
@@ -183,17 +181,19 @@ std::pair<float, float> BallAndPenaltyMarkPerceptor::apply(const Vector2i& ballS
 
   RECTANGLE("module:BallAndPenaltyMarkPerceptor:spots", static_cast<int>(ballSpot.x() - ballArea / 2), static_cast<int>(ballSpot.y() - ballArea / 2), static_cast<int>(ballSpot.x() + ballArea / 2), static_cast<int>(ballSpot.y() + ballArea / 2), 2, Drawings::PenStyle::solidPen, ColorRGBA::black);
 
+  // The grayscale network extracts its normalized input directly, so the separate patches are only needed otherwise.
   Image<PixelTypes::GrayscaledPixel> grayscaledPatch, blueChromaPatch, redChromaPatch;
-  PatchUtilities::extractPatch(ballSpot, Vector2i(ballArea, ballArea), Vector2i(patchSize, patchSize), theECImage.grayscaled, grayscaledPatch, extractionMode);
-
-
-  Vector2i chromaCenter = (ballSpot.array() / 2).matrix();
+  if(savePatches || !useGrayScaledImage)
+  {
+    PatchUtilities::extractPatch(ballSpot, Vector2i(ballArea, ballArea), Vector2i(patchSize, patchSize), theECImage.grayscaled, grayscaledPatch, extractionMode);
 
-  Vector2i chromaInsize = (Vector2i(ballArea, ballArea).array() / 2).matrix();
+    Vector2i chromaCenter = (ballSpot.array() / 2).matrix();
 
+    Vector2i chromaInsize = (Vector2i(ballArea, ballArea).array() / 2).matrix();
 
-  PatchUtilities::extractPatch(chromaCenter, chromaInsize, Vector2i(patchSize, patchSize), theECImage.blueChromaticity, blueChromaPatch, extractionMode);
-  PatchUtilities::extractPatch(chromaCenter, chromaInsize, Vector2i(patchSize, patchSize), theECImage.redChromaticity, redChromaPatch, extractionMode);
+    PatchUtilities::extractPatch(chromaCenter, chromaInsize, Vector2i(patchSize, patchSize), theECImage.blueChromaticity, blueChromaPatch, extractionMode);
+    PatchUtilities::extractPatch(chromaCenter, chromaInsize, Vector2i(patchSize, patchSize), theECImage.redChromaticity, redChromaPatch, extractionMode);
+  }
 
   if(savePatches)
   {
@@ -224,9 +224,9 @@ std::pair<float, float> BallAndPenaltyMarkPerceptor::apply(const Vector2i& ballS
 
   if(useGrayScaledImage)
   {
-    //PatchUtilities::extractPatch(ballSpot, Vector2i(ballArea, ballArea), Vector2i(32, 32), theECImage.grayscaled, multihead.input(0).data(), extractionMode);
-    std::memcpy(multihead.input(0).data(), grayscaledPatch[0], grayscaledPatch.width * grayscaledPatch.height * sizeof(PixelTypes::GrayscaledPixel));
-    PatchUtilities::normalizeBrightness(reinterpret_cast<unsigned char*>(multihead.input(0).data()), Vector2i(patchSize, patchSize), normalizationOutlierRatio);
+    PatchUtilities::extractPatch(ballSpot, Vector2i(ballArea, ballArea), Vector2i(patchSize, patchSize), theECImage.grayscaled,
+                                 reinterpret_cast<unsigned char*>(multihead.input(0).data()), extractionMode,
+                                 PatchUtilities::brightnessNormalization, normalizationOutlierRatio);
   }
   else
   {
@@ -309,14 +309,13 @@ void BallAndPenaltyMarkPerceptor::savePatch(std::vector<float>& grayData, std::v
 void BallAndPenaltyMarkPerceptor::compile()
 {
   const std::string baseDir = std::string(File::getBHDir()) + "/Config/NeuralNets/BallAndPenaltyMarkPerceptor/";
-  multiheadModel = std::make_unique<NeuralNetwork::Model>(baseDir + multiheadName);
-
+  InferenceEngine::Options options;
   if(!useFloat)
   {
-    multiheadModel->setInputUInt8(0);
+    options.uint8Inputs = {0};
   }
 
-  multihead.compile(*multiheadModel);
+  multihead.load(baseDir + multiheadName, options);
 
   ASSERT(multihead.numOfInputs() == 1); //TODO
 
@@ -30,8 +30,7 @@
 #include "ImageProcessing/PatchUtilities.h"
 #include "Math/Eigen.h"
 #include "Framework/Module.h"
-#include <CompiledNN/CompiledNN.h>
-#include <CompiledNN/Model.h>
+#include "Tools/Inference/InferenceEngine.h"
 
 MODULE(BallAndPenaltyMarkPerceptor,
 {,
@@ -76,9 +75,8 @@ public:
   BallAndPenaltyMarkPerceptor();
 
 private:
-  NeuralNetwork::CompiledNN multihead;
-
-  std::unique_ptr<NeuralNetwork::Model> multiheadModel;
+  ECImageRequest ecImageRequest{{ECImageRequest::grayscaled, ECImageRequest::chromaticity}};
+  InferenceEngine multihead;
 
 
   float bestRadius, bestProbPenalty, bestProbBall;
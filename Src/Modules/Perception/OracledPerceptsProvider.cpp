@@ -173,6 +173,7 @@ void OracledPerceptsProvider::update(BallPercept& ballPercept)
   ballPercept.status = BallPercept::notSeen;
   if(!theCameraMatrix.isValid || theGroundTruthWorldState.balls.size() == 0)
     return;
+  updateVisibility();
 
   if(Random::bernoulli(ballFalsePositiveRate))
     falseBallPercept(ballPercept);
@@ -182,11 +183,10 @@ void OracledPerceptsProvider::update(BallPercept& ballPercept)
 
 void OracledPerceptsProvider::trueBallPercept(BallPercept& ballPercept)
 {
-  const Vector2f ballOnField = theGroundTruthWorldState.balls[0].position.head<2>();
-  Vector2f ballOffset = theGroundTruthWorldState.ownPose.inverse() * ballOnField;
-  if(ballOffset.norm() > ballMaxVisibleDistance || isPointBehindObstacle(ballOnField))
+  const Vector2f& ballOffset = projectedBall.relativePosition;
+  if(projectedBall.distance > ballMaxVisibleDistance || projectedBall.occluded)
     return;
-  if(Random::bernoulli(1. - ballRecognitionRate))
+  if(!isRecognized(ballRecognitionRate, projectedBall.distance, ballMaxVisibleDistance))
     return;
   Geometry::Circle circle;
   if(Projection::calculateBallInImage(ballOffset, theCameraMatrix, theCameraInfo, theBallSpecification.radius, circle))
@@ -218,13 +218,12 @@ void OracledPerceptsProvider::trueBallPercept(BallPercept& ballPercept)
 void OracledPerceptsProvider::falseBallPercept(BallPercept& ballPercept)
 {
   std::vector<BallPercept> possiblePercepts;
-  const Pose2f robotPoseInv = theGroundTruthWorldState.ownPose.inverse();
 
-  auto addPercept = [&](const Vector2f& positionOnField)
+  auto addPercept = [&](const ProjectedPoint& projected)
   {
-    if(isPointBehindObstacle(positionOnField))
+    if(projected.occluded)
       return;
-    const Vector2f relativePosition = robotPoseInv * positionOnField;
+    const Vector2f& relativePosition = projected.relativePosition;
     Geometry::Circle circle;
     if(Projection::calculateBallInImage(relativePosition, theCameraMatrix, theCameraInfo, theBallSpecification.radius, circle))
     {
@@ -243,16 +242,16 @@ void OracledPerceptsProvider::falseBallPercept(BallPercept& ballPercept)
     }
   };
 
-  for(size_t i = 0; i < goalPosts.size(); i++)
-    addPercept(goalPosts[i]);
-  for(size_t i = 0; i < theGroundTruthWorldState.ownTeamPlayers.size(); ++i)
-    addPercept(theGroundTruthWorldState.ownTeamPlayers[i].pose.translation);
-  for(size_t i = 0; i < theGroundTruthWorldState.opponentTeamPlayers.size(); ++i)
-    addPercept(theGroundTruthWorldState.opponentTeamPlayers[i].pose.translation);
-  for(size_t i = 0; i < intersections.size(); ++i)
-    addPercept(intersections[i].pos);
-  for(size_t i = 0; i < penaltyMarks.size(); ++i)
-    addPercept(penaltyMarks[i]);
+  for(const ProjectedPoint& projected : projectedGoalPosts)
+    addPercept(projected);
+  for(const ProjectedPoint& projected : projectedOwnTeamPlayers)
+    addPercept(projected);
+  for(const ProjectedPoint& projected : projectedOpponentTeamPlayers)
+    addPercept(projected);
+  for(const ProjectedPoint& projected : projectedIntersections)
+    addPercept(projected);
+  for(const ProjectedPoint& projected : projectedPenaltyMarks)
+    addPercept(projected);
 
   if(possiblePercepts.size())
   {
@@ -270,21 +269,22 @@ void OracledPerceptsProvider::update(LinesPercept& linesPercept)
 
   if(!theCameraMatrix.isValid)
     return;
-  updateViewPolygon();
-  const Pose2f robotPoseInv = theGroundTruthWorldState.ownPose.inverse();
+  updateVisibility();
 
   // Find lines:
   for(unsigned int i = 0; i < lines.size(); i++)
   {
-    if(Random::bernoulli(1. - lineRecognitionRate))
-      continue;
     Vector2f start, end;
     if(partOfLineIsVisible(lines[i], start, end))
     {
       LinesPercept::Line line;
       line.firstField = robotPoseInv * start;
       line.lastField = robotPoseInv * end;
-      if(line.firstField.norm() > lineMaxVisibleDistance || line.lastField.norm() > lineMaxVisibleDistance)
+      const float firstDistance = line.firstField.norm();
+      const float lastDistance = line.lastField.norm();
+      if(firstDistance > lineMaxVisibleDistance || lastDistance > lineMaxVisibleDistance)
+        continue;
+      if(!isRecognized(lineRecognitionRate, std::min(firstDistance, lastDistance), lineMaxVisibleDistance))
         continue;
       Vector2f pImg;
       if(Transformation::robotToImage(line.firstField, theCameraMatrix, theCameraInfo, pImg))
@@ -324,26 +324,21 @@ void OracledPerceptsProvider::update(CirclePercept& circlePercept)
   if(!theCameraMatrix.isValid)
     return;
 
-  // Find center circle (at least one out of five center circle points must be inside the current image)
-  const Pose2f robotPoseInv = theGroundTruthWorldState.ownPose.inverse();
+  updateVisibility();
+
+  // Find center circle (at least one out of five center circle points must be visible in the current image)
+  const float distance = projectedCCPoints[0].distance;
   bool pointFound = false;
-  if((theGroundTruthWorldState.ownPose.translation.norm() <= centerCircleMaxVisibleDistance) &&
-     Random::bernoulli(centerCircleRecognitionRate))
-  {
-    for(unsigned int i = 0; i < ccPoints.size(); ++i)
-    {
-      const Vector2f relPos = robotPoseInv * ccPoints[i];
-      Vector2f posInImage;
-      if(Projection::pointIsInImage(theCameraMatrix, theCameraInfo, relPos, posInImage))
+  if(distance <= centerCircleMaxVisibleDistance && isRecognized(centerCircleRecognitionRate, distance, centerCircleMaxVisibleDistance))
+    for(const ProjectedPoint& projected : projectedCCPoints)
+      if(projected.inImage && !projected.occluded)
       {
         pointFound = true;
         break;
       }
-    }
-  }
   if(pointFound)
   {
-    Vector2f circlePos(robotPoseInv * Vector2f::Zero());
+    Vector2f circlePos = projectedCCPoints[0].relativePosition;
     // Add some noise:
     if(applyCenterCircleNoise)
     {
@@ -369,13 +364,12 @@ void OracledPerceptsProvider::update(PenaltyMarkPercept& penaltyMarkPercept)
   penaltyMarkPercept.wasSeen = false;
   if(!theCameraMatrix.isValid)
     return;
-  const Pose2f robotPoseInv = theGroundTruthWorldState.ownPose.inverse();
-  for(auto& pos : penaltyMarks)
+  updateVisibility();
+  for(const ProjectedPoint& projected : projectedPenaltyMarks)
   {
-    Vector2f relativeMarkPos = robotPoseInv * pos;
-    if(relativeMarkPos.norm() > penaltyMarkMaxVisibleDistance || isPointBehindObstacle(pos))
+    if(projected.distance > penaltyMarkMaxVisibleDistance || projected.occluded)
       continue;
-    if(Random::bernoulli(1. - penaltyMarkRecognitionRate))
+    if(!isRecognized(penaltyMarkRecognitionRate, projected.distance, penaltyMarkMaxVisibleDistance))
       continue;
     else if(Random::bernoulli(penaltyMarkFalsePositiveRate))
     {
@@ -383,9 +377,9 @@ void OracledPerceptsProvider::update(PenaltyMarkPercept& penaltyMarkPercept)
       continue;
     }
 
-    Vector2f penaltyMarkInImage;
-    if(Projection::pointIsInImage(theCameraMatrix, theCameraInfo, relativeMarkPos, penaltyMarkInImage))
+    if(projected.inImage)
     {
+      Vector2f penaltyMarkInImage = projected.positionInImage;
       if(applyPenaltyMarkNoise)
         applyNoise(penaltyMarkPosInImageStdDev, penaltyMarkInImage);
 
@@ -400,7 +394,7 @@ void OracledPerceptsProvider::update(PenaltyMarkPercept& penaltyMarkPercept)
 
 void OracledPerceptsProvider::falsePenaltyMarkPercept(PenaltyMarkPercept& penaltyMarkPercept)
 {
-  Vector2f falseMarkPos = theGroundTruthWorldState.ownPose.inverse() * penaltyMarks[0];
+  Vector2f falseMarkPos = robotPoseInv * penaltyMarks[0];
   falseMarkPos.y() *= Random::bernoulli(0.5) ? -penaltyMarkFalseDeviationFactor : penaltyMarkFalseDeviationFactor;
   if(Random::bernoulli(0.5))
     falseMarkPos.x() *= penaltyMarkFalseDeviationFactor;
@@ -419,12 +413,13 @@ void OracledPerceptsProvider::update(ObstaclesImagePercept& obstaclesImagePercep
   if(!theCameraMatrix.isValid || !Global::settingsExist())
     return;
 
+  updateVisibility();
   for(unsigned int i = 0; i < theGroundTruthWorldState.ownTeamPlayers.size(); ++i)
-    if(!isPointBehindObstacle(theGroundTruthWorldState.ownTeamPlayers[i].pose.translation))
-      createPlayerBox(theGroundTruthWorldState.ownTeamPlayers[i], obstaclesImagePercept);
+    if(!projectedOwnTeamPlayers[i].occluded)
+      createPlayerBox(theGroundTruthWorldState.ownTeamPlayers[i], projectedOwnTeamPlayers[i], obstaclesImagePercept);
   for(unsigned int i = 0; i < theGroundTruthWorldState.opponentTeamPlayers.size(); ++i)
-    if(!isPointBehindObstacle(theGroundTruthWorldState.opponentTeamPlayers[i].pose.translation))
-      createPlayerBox(theGroundTruthWorldState.opponentTeamPlayers[i], obstaclesImagePercept);
+    if(!projectedOpponentTeamPlayers[i].occluded)
+      createPlayerBox(theGroundTruthWorldState.opponentTeamPlayers[i], projectedOpponentTeamPlayers[i], obstaclesImagePercept);
 }
 
 void OracledPerceptsProvider::update(ObstaclesFieldPercept& obstaclesFieldPercept)
@@ -433,12 +428,13 @@ void OracledPerceptsProvider::update(ObstaclesFieldPercept& obstaclesFieldPercep
   if(!theCameraMatrix.isValid || !Global::settingsExist())
     return;
 
+  updateVisibility();
   for(unsigned int i = 0; i < theGroundTruthWorldState.ownTeamPlayers.size(); ++i)
-    if(!isPointBehindObstacle(theGroundTruthWorldState.ownTeamPlayers[i].pose.translation))
-      createPlayerOnField(theGroundTruthWorldState.ownTeamPlayers[i], false, obstaclesFieldPercept);
+    if(!projectedOwnTeamPlayers[i].occluded)
+      createPlayerOnField(theGroundTruthWorldState.ownTeamPlayers[i], projectedOwnTeamPlayers[i], false, obstaclesFieldPercept);
   for(unsigned int i = 0; i < theGroundTruthWorldState.opponentTeamPlayers.size(); ++i)
-    if(!isPointBehindObstacle(theGroundTruthWorldState.opponentTeamPlayers[i].pose.translation))
-      createPlayerOnField(theGroundTruthWorldState.opponentTeamPlayers[i], true, obstaclesFieldPercept);
+    if(!projectedOpponentTeamPlayers[i].occluded)
+      createPlayerOnField(theGroundTruthWorldState.opponentTeamPlayers[i], projectedOpponentTeamPlayers[i], true, obstaclesFieldPercept);
 }
 
 void OracledPerceptsProvider::update(FieldBoundary& fieldBoundary)
@@ -455,8 +451,7 @@ void OracledPerceptsProvider::update(FieldBoundary& fieldBoundary)
     fieldBoundary.isValid = false;
     return;
   }
-  updateViewPolygon();
-  const Pose2f robotPoseInv = theGroundTruthWorldState.ownPose.inverse();
+  updateVisibility();
 
   // Find boundary lines:
   for(unsigned int i = 0; i < fieldBoundaryLines.size(); i++)
@@ -486,17 +481,16 @@ void OracledPerceptsProvider::update(FieldBoundary& fieldBoundary)
   }
 }
 
-void OracledPerceptsProvider::createPlayerBox(const GroundTruthWorldState::GroundTruthPlayer& player, ObstaclesImagePercept& obstaclesImagePercept)
+void OracledPerceptsProvider::createPlayerBox(const GroundTruthWorldState::GroundTruthPlayer& player, const ProjectedPoint& projectedPlayer, ObstaclesImagePercept& obstaclesImagePercept)
 {
-  const Pose2f robotPoseInv = theGroundTruthWorldState.ownPose.inverse();
-  Vector2f relativePlayerPos = robotPoseInv * player.pose.translation;
-  if(relativePlayerPos.norm() > playerMaxVisibleDistance)
+  Vector2f relativePlayerPos = projectedPlayer.relativePosition;
+  if(projectedPlayer.distance > playerMaxVisibleDistance)
     return;
-  if(Random::bernoulli(1. - playerRecognitionRate))
+  if(!isRecognized(playerRecognitionRate, projectedPlayer.distance, playerMaxVisibleDistance))
     return;
-  Vector2f playerInImage;
-  if(Projection::pointIsInImage(theCameraMatrix, theCameraInfo, relativePlayerPos, playerInImage))
+  if(projectedPlayer.inImage)
   {
+    Vector2f playerInImage = projectedPlayer.positionInImage;
     bool success = true;
     if(applyPlayerNoise)
     {
@@ -515,23 +509,24 @@ void OracledPerceptsProvider::createPlayerBox(const GroundTruthWorldState::Groun
   }
 }
 
-void OracledPerceptsProvider::createPlayerOnField(const GroundTruthWorldState::GroundTruthPlayer& player, bool isOpponent, ObstaclesFieldPercept& obstaclesFieldPercept)
+void OracledPerceptsProvider::createPlayerOnField(const GroundTruthWorldState::GroundTruthPlayer& player, const ProjectedPoint& projectedPlayer, bool isOpponent, ObstaclesFieldPercept& obstaclesFieldPercept)
 {
-  const Pose2f robotPoseInv = theGroundTruthWorldState.ownPose.inverse();
-  Vector2f relativePlayerPos = robotPoseInv * player.pose.translation;
-  if(relativePlayerPos.norm() > playerMaxVisibleDistance)
+  Vector2f relativePlayerPos = projectedPlayer.relativePosition;
+  if(projectedPlayer.distance > playerMaxVisibleDistance)
     return;
-  if(Random::bernoulli(1. - playerRecognitionRate))
+  if(!isRecognized(playerRecognitionRate, projectedPlayer.distance, playerMaxVisibleDistance))
     return;
+  Vector2f playerInImage = projectedPlayer.positionInImage;
+  bool inImage = projectedPlayer.inImage;
   if(Random::bernoulli(playerFalsePositiveRate))
   {
     Vector2f falsePlayerTranslation;
     falsePlayerTranslation.x() = Random::uniform(theFieldDimensions.xPosOwnFieldBorder, theFieldDimensions.xPosOpponentFieldBorder);
     falsePlayerTranslation.y() = Random::uniform(theFieldDimensions.yPosRightFieldBorder, theFieldDimensions.yPosLeftFieldBorder);
     relativePlayerPos = robotPoseInv * falsePlayerTranslation;
+    inImage = Projection::pointIsInImage(theCameraMatrix, theCameraInfo, relativePlayerPos, playerInImage);
   }
-  Vector2f playerInImage;
-  if(Projection::pointIsInImage(theCameraMatrix, theCameraInfo, relativePlayerPos, playerInImage))
+  if(inImage)
   {
     bool success = true;
     if(applyPlayerNoise)
@@ -563,6 +558,108 @@ void OracledPerceptsProvider::createPlayerOnField(const GroundTruthWorldState::G
   }
 }
 
+void OracledPerceptsProvider::updateVisibility()
+{
+  if(theFrameInfo.time == lastVisibilityUpdate)
+    return;
+  lastVisibilityUpdate = theFrameInfo.time;
+
+  robotPoseInv = theGroundTruthWorldState.ownPose.inverse();
+  cameraMatrixInv = theCameraMatrix.inverse();
+  updateViewPolygon();
+
+  occluders.clear();
+  for(const GroundTruthWorldState::GroundTruthPlayer& player : theGroundTruthWorldState.ownTeamPlayers)
+    occluders.push_back({robotPoseInv * player.pose.translation, player.upright ? uprightObstacleHeight : fallenObstacleHeight});
+  for(const GroundTruthWorldState::GroundTruthPlayer& player : theGroundTruthWorldState.opponentTeamPlayers)
+    occluders.push_back({robotPoseInv * player.pose.translation, player.upright ? uprightObstacleHeight : fallenObstacleHeight});
+
+  if(!theGroundTruthWorldState.balls.empty())
+    project(theGroundTruthWorldState.balls[0].position.head<2>(), theGroundTruthWorldState.balls[0].position.z(), projectedBall);
+
+  auto projectAll = [this](const std::vector<Vector2f>& points, std::vector<ProjectedPoint>& projected)
+  {
+    projected.resize(points.size());
+    for(size_t i = 0; i < points.size(); ++i)
+      project(points[i], 0.f, projected[i]);
+  };
+  projectAll(penaltyMarks, projectedPenaltyMarks);
+  projectAll(ccPoints, projectedCCPoints);
+  projectAll(goalPosts, projectedGoalPosts);
+  projectedIntersections.resize(intersections.size());
+  for(size_t i = 0; i < intersections.size(); ++i)
+    project(intersections[i].pos, 0.f, projectedIntersections[i]);
+
+  // Players are visible if the center of their body can be seen. They do not occlude themselves.
+  const size_t numOfOwnTeamPlayers = theGroundTruthWorldState.ownTeamPlayers.size();
+  projectedOwnTeamPlayers.resize(numOfOwnTeamPlayers);
+  for(size_t i = 0; i < numOfOwnTeamPlayers; ++i)
+    project(theGroundTruthWorldState.ownTeamPlayers[i].pose.translation, occluders[i].height / 2.f, projectedOwnTeamPlayers[i], i);
+  projectedOpponentTeamPlayers.resize(theGroundTruthWorldState.opponentTeamPlayers.size());
+  for(size_t i = 0; i < projectedOpponentTeamPlayers.size(); ++i)
+    project(theGroundTruthWorldState.opponentTeamPlayers[i].pose.translation, occluders[numOfOwnTeamPlayers + i].height / 2.f,
+            projectedOpponentTeamPlayers[i], numOfOwnTeamPlayers + i);
+}
+
+void OracledPerceptsProvider::project(const Vector2f& pointOnField, float height, ProjectedPoint& projected, size_t occluderToIgnore) const
+{
+  projected.relativePosition = robotPoseInv * pointOnField;
+  projected.distance = projected.relativePosition.norm();
+
+  // Same as Projection::pointIsInImage, but with the inverse camera matrix computed only once.
+  const Vector3f pointInCamera = cameraMatrixInv * Vector3f(projected.relativePosition.x(), projected.relativePosition.y(), 0.f);
+  projected.inImage = false;
+  if(pointInCamera.x() > 0.f)
+  {
+    projected.positionInImage = theCameraInfo.opticalCenter - (pointInCamera.tail<2>() / pointInCamera.x()).cwiseProduct(Vector2f(theCameraInfo.focalLength, theCameraInfo.focalLengthHeight));
+    projected.inImage = projected.positionInImage.x() >= 0 && projected.positionInImage.x() < theCameraInfo.width
+                        && projected.positionInImage.y() >= 0 && projected.positionInImage.y() < theCameraInfo.height;
+  }
+
+  projected.occluded = isOccluded(Vector3f(projected.relativePosition.x(), projected.relativePosition.y(), height), occluderToIgnore);
+}
+
+bool OracledPerceptsProvider::isOccluded(const Vector3f& point, size_t occluderToIgnore) const
+{
+  const Vector3f& camera = theCameraMatrix.translation;
+  const Vector2f sightLine = point.head<2>() - camera.head<2>();
+  const float length = sightLine.norm();
+  if(length == 0.f)
+    return false;
+  const Vector2f direction = sightLine / length;
+  const float slope = (point.z() - camera.z()) / length;
+  const float sqrRadius = sqr(obstacleCoverageThickness);
+
+  for(size_t i = 0; i < occluders.size(); ++i)
+  {
+    if(i == occluderToIgnore)
+      continue;
+    const Vector2f toCenter = occluders[i].center - camera.head<2>();
+    const float closest = toCenter.dot(direction);
+    const float sqrDistanceToAxis = toCenter.squaredNorm() - sqr(closest);
+    if(sqrDistanceToAxis >= sqrRadius)
+      continue;
+
+    // The part of the sight line above the footprint of the cylinder.
+    const float halfChord = std::sqrt(sqrRadius - sqrDistanceToAxis);
+    const float enter = std::max(0.f, closest - halfChord);
+    const float leave = std::min(length, closest + halfChord);
+    if(enter >= leave)
+      continue;
+
+    // The height changes linearly along the sight line, so it is lowest at one of the ends of that part.
+    if(camera.z() + std::min(slope * enter, slope * leave) < occluders[i].height)
+      return true;
+  }
+  return false;
+}
+
+bool OracledPerceptsProvider::isRecognized(float recognitionRate, float distance, float maxVisibleDistance) const
+{
+  const float ratio = 1.f + (farRecognitionRatio - 1.f) * std::min(distance / maxVisibleDistance, 1.f);
+  return Random::bernoulli(recognitionRate * ratio);
+}
+
 void OracledPerceptsProvider::updateViewPolygon()
 {
   const Vector3f vectorToCenter(1, 0, 0);
@@ -728,35 +825,3 @@ void OracledPerceptsProvider::applyNoise(float standardDeviation, float& angle)
   const float error = Random::normal(standardDeviation);
   angle += error;
 }
-
-bool OracledPerceptsProvider::isPointBehindObstacle(const Vector2f& pointGlo) const
-{
-  const Pose2f robotPoseInv = theGroundTruthWorldState.ownPose.inverse();
-  const float sqrDistTopoint = (pointGlo - theGroundTruthWorldState.ownPose.translation).squaredNorm();
-  const Angle pointAngle = (robotPoseInv * pointGlo).angle();
-
-  auto isBehind = [&](const Vector2f& obstacle)
-  {
-    const float sqrDistToObstacle = (obstacle - theGroundTruthWorldState.ownPose.translation).squaredNorm();
-    if(sqrDistToObstacle < 10 || sqrDistTopoint <= sqrDistToObstacle)
-      return false;
-
-    const Vector2f obstacleRel = robotPoseInv * obstacle;
-    const Vector2f obstacleThickness = obstacleRel.normalized(obstacleCoverageThickness).rotate(pi_2);
-
-    const Angle leftPointAngle = (obstacleRel + obstacleThickness).angle();
-    const Angle rightPointAngle = (obstacleRel - obstacleThickness).angle();
-
-    return pointAngle < leftPointAngle && pointAngle > rightPointAngle; //would not work on behind the robot, but we can not see anything there too
-  };
-
-  for(const GroundTruthWorldState::GroundTruthPlayer& player : theGroundTruthWorldState.ownTeamPlayers)
-    if(player.upright && isBehind(player.pose.translation))
-      return true;
-
-  for(const GroundTruthWorldState::GroundTruthPlayer& player : theGroundTruthWorldState.opponentTeamPlayers)
-    if(player.upright && isBehind(player.pose.translation))
-      return true;
-
-  return false;
-}
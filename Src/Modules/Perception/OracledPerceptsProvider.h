@@ -13,6 +13,7 @@
 #include "Representations/Configuration/FieldDimensions.h"
 #include "Representations/Configuration/RobotDimensions.h"
 #include "Representations/Infrastructure/CameraInfo.h"
+#include "Representations/Infrastructure/FrameInfo.h"
 #include "Representations/Infrastructure/GroundTruthWorldState.h"
 #include "Representations/Perception/MeasurementCovariance.h"
 #include "Representations/Perception/BallPercepts/BallPercept.h"
@@ -32,6 +33,7 @@ MODULE(OracledPerceptsProvider,
   REQUIRES(CameraMatrix),
   REQUIRES(CameraInfo),
   REQUIRES(FieldDimensions),
+  REQUIRES(FrameInfo),
   REQUIRES(MeasurementCovariance),
   REQUIRES(RobotDimensions),
   PROVIDES(BallPercept),
@@ -68,6 +70,9 @@ MODULE(OracledPerceptsProvider,
     (float) penaltyMarkFalsePositiveRate,            /**< Likelihood of perceiving a false positive, when no penaltyMark was seen */
     (float) penaltyMarkFalseDeviationFactor,         /**< Factor of how much the false penalty mark deviates from its original position */
     (float) obstacleCoverageThickness,               /**< The obstacle radius assumed when computing whether another object is hidden behind it. */
+    (float) uprightObstacleHeight,                   /**< The height of a standing robot when computing whether another object is hidden behind it. */
+    (float) fallenObstacleHeight,                    /**< The height of a lying robot when computing whether another object is hidden behind it. */
+    (float) farRecognitionRatio,                     /**< The recognition rate at the maximum visible distance relative to the one close to the robot (linearly interpolated in between). */
   }),
 });
 
@@ -90,6 +95,35 @@ private:
   std::vector<std::pair<Vector2f, Vector2f>> fieldBoundaryLines; /**< The boundary of the field */
   Vector2f viewPolygon[4];                                       /**< A polygon that describes the currently visible area */
 
+  /** A ground truth point relative to the robot and its projection into the current camera image. */
+  struct ProjectedPoint
+  {
+    Vector2f relativePosition;                                   /**< The position relative to the robot. */
+    Vector2f positionInImage;                                    /**< The position in the image (only valid if inImage is true). */
+    float distance;                                              /**< The distance to the robot. */
+    bool inImage;                                                /**< Is the point inside the image? */
+    bool occluded;                                               /**< Is the line of sight from the camera to the point blocked by another robot? */
+  };
+
+  /** A vertical cylinder that approximates another robot when computing occlusions. */
+  struct Occluder
+  {
+    Vector2f center;                                             /**< The center relative to the robot. */
+    float height;                                                /**< The height of the cylinder. */
+  };
+
+  unsigned lastVisibilityUpdate = 0;                             /**< The time of the frame the projections below were computed for. */
+  Pose2f robotPoseInv;                                           /**< The inverse of the ground truth pose of this robot. */
+  Pose3f cameraMatrixInv;                                        /**< The inverse of the current camera matrix. */
+  std::vector<Occluder> occluders;                               /**< All other robots (first own team, then opponents). */
+  ProjectedPoint projectedBall;                                  /**< The first ball (only valid if there is one). */
+  std::vector<ProjectedPoint> projectedPenaltyMarks;             /**< The projections of penaltyMarks. */
+  std::vector<ProjectedPoint> projectedCCPoints;                 /**< The projections of ccPoints. */
+  std::vector<ProjectedPoint> projectedGoalPosts;                /**< The projections of goalPosts. */
+  std::vector<ProjectedPoint> projectedIntersections;            /**< The projections of intersections. */
+  std::vector<ProjectedPoint> projectedOwnTeamPlayers;           /**< The projections of the feet of the own team players. */
+  std::vector<ProjectedPoint> projectedOpponentTeamPlayers;      /**< The projections of the feet of the opponent team players. */
+
   /** One main function, might be called every cycle
    * @param ballPercept The data struct to be filled
    */
@@ -130,16 +164,18 @@ private:
 
   /** Converts a ground truth player to a perceived player and adds it to the percept
    * @param player The ground truth player
+   * @param projectedPlayer The projection of the player into the current image
    * @param obstaclesImagePercept The obstacles percept in the image (What else?)
    */
-  void createPlayerBox(const GroundTruthWorldState::GroundTruthPlayer& player, ObstaclesImagePercept& obstaclesImagePercept);
+  void createPlayerBox(const GroundTruthWorldState::GroundTruthPlayer& player, const ProjectedPoint& projectedPlayer, ObstaclesImagePercept& obstaclesImagePercept);
 
   /** Converts a ground truth player to a perceived player and adds it to the percept
    * @param player The ground truth player
+   * @param projectedPlayer The projection of the player into the current image
    * @param isOpponent true, if the perceived player belongs to the opponent team
    * @param obstaclesFieldPercept The obstacles percept on the field (What else?)
    */
-  void createPlayerOnField(const GroundTruthWorldState::GroundTruthPlayer& player, bool isOpponent, ObstaclesFieldPercept& obstaclesFieldPercept);
+  void createPlayerOnField(const GroundTruthWorldState::GroundTruthPlayer& player, const ProjectedPoint& projectedPlayer, bool isOpponent, ObstaclesFieldPercept& obstaclesFieldPercept);
 
   /** Computes some noise and adds it to the given position
    * @param standardDeviation The standard deviation of the pixel error
@@ -159,6 +195,43 @@ private:
    */
   void applyNoise(float standardDeviation, float& angle) const;
 
+  /**
+   * Projects all ground truth objects into the current image and determines
+   * which of them are occluded by other robots. This is only done once per
+   * frame, no matter how many percepts are requested.
+   */
+  void updateVisibility();
+
+  /**
+   * Projects a point on the field into the current image.
+   * @param pointOnField The point in field coordinates.
+   * @param height The height above the ground at which the line of sight to the point is checked for occlusions.
+   * @param projected The projection is returned here.
+   * @param occluderToIgnore The index of the entry in occluders that represents the object itself (if any).
+   */
+  void project(const Vector2f& pointOnField, float height, ProjectedPoint& projected, size_t occluderToIgnore = static_cast<size_t>(-1)) const;
+
+  /**
+   * Checks whether the line of sight from the camera to a point is blocked by
+   * one of the occluders. The test is analytic: The sight line is intersected with
+   * the circular footprint of each occluder and its height is compared to the one
+   * of the cylinder where the line enters and leaves it.
+   * @param point The point relative to the robot.
+   * @param occluderToIgnore The index of the entry in occluders that represents the object itself (if any).
+   * @return Is the point hidden?
+   */
+  bool isOccluded(const Vector3f& point, size_t occluderToIgnore) const;
+
+  /**
+   * Randomly decides whether an object is perceived. The recognition rate drops
+   * linearly with the distance to farRecognitionRatio at the maximum visible distance.
+   * @param recognitionRate The recognition rate close to the robot.
+   * @param distance The distance to the object.
+   * @param maxVisibleDistance The distance until which the object can be seen.
+   * @return Was the object perceived?
+   */
+  bool isRecognized(float recognitionRate, float distance, float maxVisibleDistance) const;
+
   /** Updates viewPolygon member */
   void updateViewPolygon();
 
@@ -169,6 +242,4 @@ private:
    * @return true, if at aleast a part of the line is visible
    */
   bool partOfLineIsVisible(const std::pair<Vector2f, Vector2f>& line, Vector2f& start, Vector2f& end) const;
-
-  bool isPointBehindObstacle(const Vector2f& point) const;
 };
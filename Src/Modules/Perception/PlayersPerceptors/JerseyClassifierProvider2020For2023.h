@@ -52,6 +52,8 @@ MODULE(JerseyClassifierProvider2020For2023,
 
 class JerseyClassifierProvider2020For2023 : public JerseyClassifierProvider2020For2023Base
 {
+  ECImageRequest ecImageRequest{{ECImageRequest::grayscaled, ECImageRequest::saturated, ECImageRequest::hued}, 64}; /**< Jerseys can be slightly above the horizon if the own camera is low. */
+
   /**
    * Updates the jersey classifier.
    * @param jerseyClassifier The updated representation.
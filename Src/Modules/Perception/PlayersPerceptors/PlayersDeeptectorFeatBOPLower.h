@@ -27,7 +27,6 @@
 #include "Representations/Perception/ObstaclesPercepts/ObstaclesPerceptorData.h"
 #include "Framework/Module.h"
 #include "Math/Eigen.h"
-#include <CompiledNN/CompiledNN.h>
 
 MODULE(PlayersDeeptectorFeatBOPLower,
 {,
@@ -72,6 +71,7 @@ public:
   PlayersDeeptectorFeatBOPLower();
 
 private:
+  ECImageRequest ecImageRequest{{ECImageRequest::grayscaled, ECImageRequest::saturated}};
   std::vector<ObstaclesImagePercept::Obstacle> obstaclesUpper, obstaclesLower;
 
   /** This struct represents an image region. */
@@ -10,7 +10,6 @@
  * @author Bernd Poppinga
  */
 
-#include "CompiledNN/Model.h"
 #include "Debugging/DebugDrawings.h"
 #include "Debugging/Stopwatch.h"
 #include "ImageProcessing/PatchUtilities.h"
@@ -19,24 +18,13 @@
 #include "Math/Eigen.h"
 #include "Platform/File.h"
 #include "RobotDetector.h"
-#include "Streaming/Global.h"
 #include "Tools/Math/Projection.h"
 #include "Tools/Math/Transformation.h"
 
 MAKE_MODULE(RobotDetector);
 
-RobotDetector::RobotDetector() :
-    cnnConvModel(&Global::getAsmjitRuntime()),
-    onnxConvModel(&Global::getAsmjitRuntime())
+RobotDetector::RobotDetector()
 {
-  NeuralNetwork::CompilationSettings settings;
-  settings.useExpApproxInSigmoid = false;
-  settings.useExpApproxInTanh = false;
-  NeuralNetworkONNX::CompilationSettings onnxSettings; // onnxSettings are effectively ignored, so no need to fill them
-#if defined MACOS && defined __arm64__
-  settings.useCoreML = true;
-#endif
-
   if(theCameraInfo.camera == CameraInfo::upper)
   {
     // Load model params
@@ -45,27 +33,16 @@ RobotDetector::RobotDetector() :
     stream >> networkParameters;
 
     ASSERT(networkParameters.inputChannels == 1 || networkParameters.inputChannels == 3); // single channel grayscale image or three channel YUV image
-    useOnnx = model_path.ends_with(".onnx");
-
-    // Model initialization
-    if(useOnnx)
-    {
-      onnxModel = std::make_unique<NeuralNetworkONNX::Model>(std::string(File::getBHDir()) + model_path);
-      initializeModel(onnxModel, onnxConvModel, onnxSettings);
-    }
-    else
-    {
-      cnnModel = std::make_unique<NeuralNetwork::Model>(std::string(File::getBHDir()) + model_path);
-      initializeModel(cnnModel, cnnConvModel, settings);
-    }
+    initializeModel();
   }
 }
 
-template<typename Model, typename ConvModel, typename CompilationSettings>
-void RobotDetector::initializeModel(const std::unique_ptr<Model>& model, ConvModel& convModel, const CompilationSettings& settings)
+void RobotDetector::initializeModel()
 {
-  model->setInputUInt8(0); // This converts the uint8 image to floats for the model
-  convModel.compile(*model, settings);
+  InferenceEngine::Options options;
+  options.uint8Inputs = {0}; // This converts the uint8 image to floats for the model
+  options.useExpApprox = false;
+  convModel.load(std::string(File::getBHDir()) + model_path, options);
   ASSERT(convModel.numOfInputs() == 1);
   ASSERT(convModel.input(0).rank() == 3);
   ASSERT(networkParameters.inputHeight == convModel.input(0).dims(HEIGHT_SHAPE_INDEX));
@@ -124,7 +101,7 @@ void RobotDetector::update(ObstaclesPerceptorData& theObstaclesPerceptorData)
 
 void RobotDetector::extractImageObstaclesFromNetwork(std::vector<ObstaclesImagePercept::Obstacle>& obstacles)
 {
-  if(useOnnx ? !onnxConvModel.valid() : !cnnConvModel.valid())
+  if(!convModel.valid())
     return;
 
   LabelImage labelImage;
@@ -134,10 +111,7 @@ void RobotDetector::extractImageObstaclesFromNetwork(std::vector<ObstaclesImageP
   else
     applyColorNetwork();
 
-  if(useOnnx)
-    STOPWATCH("module:RobotDetector:boundingBoxes") boundingBoxes(labelImage, onnxConvModel);
-  else
-    STOPWATCH("module:RobotDetector:boundingBoxes") boundingBoxes(labelImage, cnnConvModel);
+  STOPWATCH("module:RobotDetector:boundingBoxes") boundingBoxes(labelImage);
 
   STOPWATCH("module:RobotDetector:nonMaximumSuppression") labelImage.nonMaximumSuppression(nonMaximumSuppressionIoUThreshold);
   STOPWATCH("module:RobotDetector:bigBoxSuppression") labelImage.bigBoxSuppression();
@@ -194,24 +168,12 @@ void RobotDetector::applyGrayscaleNetwork()
   ASSERT(networkParameters.inputChannels == 1);
   fillGrayscaleThumbnail();
 
-  if(useOnnx)
-  {
-    // Copy image into input of the model
-    std::memcpy(reinterpret_cast<unsigned char*>(onnxConvModel.input(0).data()), grayscaleThumbnail[0], grayscaleThumbnail.width * grayscaleThumbnail.height * sizeof(unsigned char));
+  // Copy image into input of the model
+  std::memcpy(reinterpret_cast<unsigned char*>(convModel.input(0).data()), grayscaleThumbnail[0], grayscaleThumbnail.width * grayscaleThumbnail.height * sizeof(unsigned char));
 
-    STOPWATCH("module:RobotDetector:normalizeContrast") PatchUtilities::normalizeContrast<unsigned char>(
-          reinterpret_cast<unsigned char*>(onnxConvModel.input(0).data()), inputImageSize, 0.02f);
-    STOPWATCH("module:RobotDetector:apply") onnxConvModel.apply();
-  }
-  else
-  {
-    // Copy image into input of the model
-    std::memcpy(reinterpret_cast<unsigned char*>(cnnConvModel.input(0).data()), grayscaleThumbnail[0], grayscaleThumbnail.width * grayscaleThumbnail.height * sizeof(unsigned char));
-
-    STOPWATCH("module:RobotDetector:normalizeContrast") PatchUtilities::normalizeContrast<unsigned char>(
-          reinterpret_cast<unsigned char*>(cnnConvModel.input(0).data()), inputImageSize, 0.02f);
-    STOPWATCH("module:RobotDetector:apply") cnnConvModel.apply();
-  }
+  STOPWATCH("module:RobotDetector:normalizeContrast") PatchUtilities::normalizeContrast<unsigned char>(
+        reinterpret_cast<unsigned char*>(convModel.input(0).data()), inputImageSize, 0.02f);
+  STOPWATCH("module:RobotDetector:apply") convModel.apply();
 }
 
 void RobotDetector::applyColorNetwork()
@@ -223,11 +185,7 @@ void RobotDetector::applyColorNetwork()
   PixelTypes::GrayscaledPixel* yPos = grayscaleThumbnail[0];
   PixelTypes::GrayscaledPixel* uPos = redChromaThumbnail[0];
   PixelTypes::GrayscaledPixel* vPos = blueChromaThumbnail[0];
-  PixelTypes::GrayscaledPixel* inputPos;
-  if(useOnnx)
-    inputPos = reinterpret_cast<PixelTypes::GrayscaledPixel*>(onnxConvModel.input(0).data());
-  else
-    inputPos = reinterpret_cast<PixelTypes::GrayscaledPixel*>(cnnConvModel.input(0).data());
+  PixelTypes::GrayscaledPixel* inputPos = reinterpret_cast<PixelTypes::GrayscaledPixel*>(convModel.input(0).data());
 
   STOPWATCH("module:RobotDetector:copyYUVToInput")
   {
@@ -239,14 +197,10 @@ void RobotDetector::applyColorNetwork()
     }
   }
 
-  if(useOnnx)
-    STOPWATCH("module:RobotDetector:apply") onnxConvModel.apply();
-  else
-    STOPWATCH("module:RobotDetector:apply") cnnConvModel.apply();
+  STOPWATCH("module:RobotDetector:apply") convModel.apply();
 }
 
-template<typename ConvModel>
-void RobotDetector::boundingBoxes(LabelImage& labelImage, ConvModel& convModel)
+void RobotDetector::boundingBoxes(LabelImage& labelImage)
 {
   const float objectThreshold = logit(this->objectThreshold);
   for(unsigned y = 0; y < networkParameters.outputHeight; ++y)
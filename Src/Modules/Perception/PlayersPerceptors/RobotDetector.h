@@ -30,8 +30,7 @@
 #include "Framework/Module.h"
 #include "ImageProcessing/LabelImage.h"
 #include "Math/Eigen.h"
-#include "CompiledNN/CompiledNN.h"
-#include "CompiledNN2ONNX/CompiledNN.h"
+#include "Tools/Inference/InferenceEngine.h"
 
 STREAMABLE(NetworkParameters,
 {,
@@ -114,13 +113,10 @@ public:
   RobotDetector();
 
 private:
+  ECImageRequest networkRequest{{ECImageRequest::grayscaled, ECImageRequest::chromaticity}, ECImageRequest::fullImage}; /**< The network sees the whole image. */
+  ECImageRequest scanRequest{{ECImageRequest::saturated}}; /**< The scan stays below the field boundary. */
   Vector2i inputImageSize;
-  // Double structure to allow switching between CompiledNN- and ONNX models. Only one of each set will be used at a time.
-  std::unique_ptr<NeuralNetwork::Model> cnnModel;
-  NeuralNetwork::CompiledNN cnnConvModel;
-  std::unique_ptr<NeuralNetworkONNX::Model> onnxModel;
-  NeuralNetworkONNX::CompiledNN onnxConvModel;
-  bool useOnnx;
+  InferenceEngine convModel; /**< The network. The backend is selected by the InferenceEngine. */
   Image<PixelTypes::GrayscaledPixel> grayscaleThumbnail;
   // Splitting into three images and recombining them into one is probably a performance issue
   // We need to optimize this later
@@ -164,15 +160,8 @@ private:
 
   /**
    * Initialize/Compile the model.
-   * @tparam Model Either NeuralNetwork::Model or NeuralNetworkONNX::Model
-   * @tparam ConvModel Either NeuralNetwork::CompiledNN or NeuralNetworkONNX::CompiledNN
-   * @tparam CompilationSettings Either NeuralNetwork::CompilationSettings or NeuralNetworkONNX::CompilationSettings
-   * @param model the neural network model definition
-   * @param convModel the model inference object
-   * @param settings settings for inference
    */
-  template<typename Model, typename ConvModel, typename CompilationSettings>
-  void initializeModel(const std::unique_ptr<Model>& model, ConvModel& convModel, const CompilationSettings& settings);
+  void initializeModel();
 
   /**
    * This method is called when the representation provided needs to be updated.
@@ -211,23 +200,20 @@ private:
    void fillChromaThumbnails();
 
   /**
-   * Applies the cnnConvModel on the down-scaled grayscale image.
+   * Applies the convModel on the down-scaled grayscale image.
    */
   void applyGrayscaleNetwork();
 
   /**
-   * Applies the cnnConvModel on a down-scaled YUV image.
+   * Applies the convModel on a down-scaled YUV image.
    */
   void applyColorNetwork();
 
   /**
    * This method gets the bounding boxes from the network output.
-   * @tparam ConvModel Type of the network. Either NeuralNetwork::CompiledNN or NeuralNetworkONNX::CompiledNN
    * @param the bounding boxes
-   * @param convModel network model
    */
-  template<typename ConvModel>
-  void boundingBoxes(LabelImage& labelImage, ConvModel& convModel);
+  void boundingBoxes(LabelImage& labelImage);
 
   /**
    * Computes the bounding box position and size, given a prediction form the network.
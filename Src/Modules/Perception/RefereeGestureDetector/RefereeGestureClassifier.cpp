@@ -13,11 +13,11 @@
 
 MAKE_MODULE(RefereeGestureClassifier);
 
-RefereeGestureClassifier::RefereeGestureClassifier() : networkKickIn(&Global::getAsmjitRuntime()), networkStandby(&Global::getAsmjitRuntime())
+RefereeGestureClassifier::RefereeGestureClassifier()
 {
-  // Compile neural networks for kick-in and standby gestures
-  networkKickIn.compile(NeuralNetwork::Model(std::string(File::getBHDir()) + "/Config/NeuralNets/RefereeGestureClassifier/kick_in_without_softmax.h5"));
-  networkStandby.compile(NeuralNetwork::Model(std::string(File::getBHDir()) + "/Config/NeuralNets/RefereeGestureClassifier/standby_without_softmax.h5"));
+  // Load neural networks for kick-in and standby gestures
+  networkKickIn.load(std::string(File::getBHDir()) + "/Config/NeuralNets/RefereeGestureClassifier/kick_in_without_softmax.h5");
+  networkStandby.load(std::string(File::getBHDir()) + "/Config/NeuralNets/RefereeGestureClassifier/standby_without_softmax.h5");
 
   ASSERT(networkKickIn.numOfInputs() == 2);
   ASSERT(networkKickIn.input(0).dims(0) == patchSize);
@@ -61,7 +61,7 @@ void RefereeGestureClassifier::update(RefereeGesture& theRefereeGesture)
   STOPWATCH("module:RefereeGestureClassifier:extractPatch") PatchUtilities::extractPatch(Vector2i(centerX, centerY), Vector2i(inWidth, inHeight), Vector2i(width, height), theCameraImage, img);
   SEND_DEBUG_IMAGE("module:RefereeGestureClassifier:patch", img);
 
-  NeuralNetwork::CompiledNN& network = theGameState.isKickIn() ? networkKickIn : networkStandby;
+  InferenceEngine& network = theGameState.isKickIn() ? networkKickIn : networkStandby;
   STOPWATCH("module:RefereeGestureClassifier:copyPatchToinput") copyPatchToInput(img, network.input(0).data());
 
   *network.input(1).data() = normalizedDistance;
@@ -18,8 +18,7 @@
 #include "Representations/Modeling/RobotPose.h"
 #include "Representations/Perception/ImagePreprocessing/OptionalCameraImage.h"
 #include "Representations/Perception/RefereeGestures/RefereeGesture.h"
-#include <CompiledNN/CompiledNN.h>
-#include <CompiledNN/Model.h>
+#include "Tools/Inference/InferenceEngine.h"
 
 STREAMABLE_WITH_BASE(UpperCameraInfo, CameraInfo, {,});
 
@@ -57,8 +56,8 @@ class RefereeGestureClassifier : public RefereeGestureClassifierBase
 
   void softmaxNetworkOutput(const Vector3f& networkOutput, const bool useThirdOutput, RefereeGesture& theRefereeGesture);
 
-  NeuralNetwork::CompiledNN networkKickIn;
-  NeuralNetwork::CompiledNN networkStandby;
+  InferenceEngine networkKickIn;
+  InferenceEngine networkStandby;
 
 public:
   /** Constructor. */
@@ -6,6 +6,7 @@
  */
 
 #include "ScanGridProvider.h"
+#include "Debugging/Plot.h"
 #include "Tools/Math/Projection.h"
 #include "Tools/Math/Transformation.h"
 #include <algorithm>
@@ -15,24 +16,93 @@ MAKE_MODULE(ScanGridProvider);
 
 void ScanGridProvider::update(ScanGrid& scanGrid)
 {
+  DECLARE_PLOT("module:ScanGridProvider:cacheHitRatio");
+
   scanGrid.clear();
 
   if(!theCameraMatrix.isValid || !theFieldBoundary.isValid)
     return; // Cannot compute grid without camera matrix
 
-  scanGrid.fieldLimit = calcFieldLimit();
-  if(scanGrid.fieldLimit < 0)
+  const GridTemplate& grid = getGridTemplate();
+  PLOT("module:ScanGridProvider:cacheHitRatio", static_cast<float>(cacheHits) / static_cast<float>(cacheHits + cacheMisses));
+
+  scanGrid.fieldLimit = grid.fieldLimit;
+  if(scanGrid.fieldLimit < 0 || !grid.lowerCornersValid)
+    return; // No grid in image or cannot project lower image border to field
+
+  scanGrid.fullResY = grid.fullResY;
+  if(!scanGrid.fullResY.empty())
+  {
+    scanGrid.lowResHorizontalLines.reserve(grid.lowResY.size());
+    for(const int y : grid.lowResY)
+      addLowResHorizontalLine(scanGrid, y);
+    addVerticalLines(scanGrid, grid);
+  }
+}
+
+const ScanGridProvider::GridTemplate& ScanGridProvider::getGridTemplate()
+{
+  // The grid only depends on the camera pose relative to the yaw-rotated robot frame and the camera intrinsics.
+  // The intrinsics are compared exactly, because they only change when the camera calibration changes.
+  const float yaw = theCameraMatrix.rotation.getZAngle();
+  const RotationMatrix rotation = RotationMatrix::aroundZ(-yaw) * theCameraMatrix.rotation;
+  const Vector3f translation = RotationMatrix::aroundZ(-yaw) * theCameraMatrix.translation;
+  const GridKey key =
+  {
+    static_cast<int>(std::lround(translation.x() / translationQuantization)),
+    static_cast<int>(std::lround(translation.y() / translationQuantization)),
+    static_cast<int>(std::lround(translation.z() / translationQuantization)),
+    static_cast<int>(std::lround(rotation.getYAngle() / rotationQuantization)),
+    static_cast<int>(std::lround(rotation.getXAngle() / rotationQuantization)),
+    theCameraInfo.width,
+    theCameraInfo.height,
+    theCameraInfo.focalLength,
+    theCameraInfo.focalLengthHeight,
+    theCameraInfo.opticalCenter
+  };
+
+  ++frameCounter;
+  for(GridTemplate& grid : cache)
+    if(grid.key == key)
+    {
+      ++cacheHits;
+      grid.lastUsed = frameCounter;
+      return grid;
+    }
+
+  ++cacheMisses;
+  GridTemplate* grid;
+  if(cache.size() < std::max(cacheSize, 1u))
+    grid = &cache.emplace_back();
+  else
+    grid = &*std::min_element(cache.begin(), cache.end(), [](const GridTemplate& a, const GridTemplate& b) {return a.lastUsed < b.lastUsed;});
+  grid->key = key;
+  grid->lastUsed = frameCounter;
+  calcGridTemplate(*grid);
+  return *grid;
+}
+
+void ScanGridProvider::calcGridTemplate(GridTemplate& grid) const
+{
+  grid.fullResY.clear();
+  grid.lowResY.clear();
+  grid.verticalLines.clear();
+  grid.lowerCornersValid = false;
+
+  grid.fieldLimit = calcFieldLimit();
+  if(grid.fieldLimit < 0)
     return;
 
   ImageCornersOnField lowerImageCornersOnField = calcImageCornersOnField(VerticalBoundary::LOWER);
   if(!lowerImageCornersOnField.valid)
     return; // Cannot project lower image border to field -> no grid
+  grid.lowerCornersValid = true;
 
-  setFullResY(scanGrid, lowerImageCornersOnField);
-  if(!scanGrid.fullResY.empty())
+  setFullResY(grid, lowerImageCornersOnField);
+  if(!grid.fullResY.empty())
   {
-    setLowResHorizontalLines(scanGrid);
-    setVerticalLines(scanGrid, lowerImageCornersOnField);
+    setLowResY(grid);
+    setVerticalLines(grid, lowerImageCornersOnField);
   }
 }
 
@@ -66,16 +136,16 @@ ScanGridProvider::ImageCornersOnField ScanGridProvider::calcImageCornersOnField(
   return imageCornersOnField;
 }
 
-void ScanGridProvider::setFullResY(ScanGrid& scanGrid, ScanGridProvider::ImageCornersOnField& lowerImageCornersOnField) const
+void ScanGridProvider::setFullResY(GridTemplate& grid, ScanGridProvider::ImageCornersOnField& lowerImageCornersOnField) const
 {
   Vector2f verticalViewCenterPointOnField = (lowerImageCornersOnField.leftOnField + lowerImageCornersOnField.rightOnField) / 2.f;
-  scanGrid.fullResY.reserve(theCameraInfo.height);
+  grid.fullResY.reserve(theCameraInfo.height);
   const float fieldStep = theFieldDimensions.fieldLinesWidth * lineWidthRatio;
   bool singleSteps = false;
   int y;
-  for(y = theCameraInfo.height - 1; y > scanGrid.fieldLimit;)
+  for(y = theCameraInfo.height - 1; y > grid.fieldLimit;)
   {
-    scanGrid.fullResY.emplace_back(y);
+    grid.fullResY.emplace_back(y);
     if(singleSteps)
       --y;
     else
@@ -89,33 +159,33 @@ void ScanGridProvider::setFullResY(ScanGrid& scanGrid, ScanGridProvider::ImageCo
       singleSteps = y2 - 1 == y;
     }
   }
-  if(y < 0 && !scanGrid.fullResY.empty() && scanGrid.fullResY.back() != 0)
-    scanGrid.fullResY.emplace_back(0);
+  if(y < 0 && !grid.fullResY.empty() && grid.fullResY.back() != 0)
+    grid.fullResY.emplace_back(0);
 }
 
-void ScanGridProvider::setLowResHorizontalLines(ScanGrid& scanGrid) const
+void ScanGridProvider::setLowResY(GridTemplate& grid) const
 {
-  scanGrid.lowResHorizontalLines.reserve((theCameraInfo.height / minHorizontalLowResStepSize) + 1);
+  grid.lowResY.reserve((theCameraInfo.height / minHorizontalLowResStepSize) + 1);
   bool minSteps = false;
   size_t fullResIndex = 0;
-  for(int y = scanGrid.fullResY[fullResIndex]; y > scanGrid.fieldLimit;)
+  for(int y = grid.fullResY[fullResIndex]; y > grid.fieldLimit;)
   {
-    addLowResHorizontalLine(scanGrid, y);
+    grid.lowResY.emplace_back(y);
     if(minSteps)
       y -= minHorizontalLowResStepSize;
     else
     {
       ++fullResIndex;
-      if(fullResIndex >= scanGrid.fullResY.size())
+      if(fullResIndex >= grid.fullResY.size())
         break;
       const int y2 = y;
-      y = std::min(y2 - minHorizontalLowResStepSize, scanGrid.fullResY[fullResIndex]);
+      y = std::min(y2 - minHorizontalLowResStepSize, grid.fullResY[fullResIndex]);
       minSteps = y2 - minHorizontalLowResStepSize == y;
     }
   }
 }
 
-void ScanGridProvider::setVerticalLines(ScanGrid& scanGrid, ImageCornersOnField& lowerImageCornersOnField) const
+void ScanGridProvider::setVerticalLines(GridTemplate& grid, ImageCornersOnField& lowerImageCornersOnField) const
 {
   // Determine the maximum distance between scan lines at the bottom of the image not to miss the ball.
   const int xStepUpperBound = theCameraInfo.width / minNumOfLowResScanLines;
@@ -160,16 +230,30 @@ void ScanGridProvider::setVerticalLines(ScanGrid& scanGrid, ImageCornersOnField&
 
   // Initialize the scan states and the regions.
   const int xStart = theCameraInfo.width % (theCameraInfo.width / minXStep - 1) / 2;
-  scanGrid.verticalLines.reserve((theCameraInfo.width - xStart) / minXStep);
+  grid.verticalLines.reserve((theCameraInfo.width - xStart) / minXStep);
   size_t i = yStarts2.size() / 2; // Start with the second-longest scan line.
   for(int x = xStart; x < theCameraInfo.width; x += minXStep)
   {
+    grid.verticalLines.emplace_back(x, std::min(yStarts2[i++], theCameraInfo.height));
+    i %= yStarts2.size();
+  }
+
+  // Set low resolution scan line info
+  grid.lowResStep = maxXStep2 / minXStep;
+  grid.lowResStart = grid.lowResStep / 2;
+}
+
+void ScanGridProvider::addVerticalLines(ScanGrid& scanGrid, const GridTemplate& grid) const
+{
+  scanGrid.verticalLines.reserve(grid.verticalLines.size());
+  for(const Vector2i& line : grid.verticalLines)
+  {
+    const int x = line.x();
     int yMin = std::max(scanGrid.fieldLimit, theFieldBoundary.getBoundaryY(x));
-    int yMax = std::min(yStarts2[i++], theCameraInfo.height);
+    int yMax = line.y();
     theBodyContour.clipBottom(x, yMax);
     yMax = std::max(1, yMax);
     yMin = std::min(yMin, yMax - 1);
-    i %= yStarts2.size();
     const size_t yMaxIndexUpperBound = std::upper_bound(scanGrid.fullResY.cbegin(), scanGrid.fullResY.cend(), yMax, std::greater_equal<>())
         - scanGrid.fullResY.cbegin();
     const size_t yMaxIndex = std::min(yMaxIndexUpperBound, scanGrid.fullResY.size() - 1);
@@ -182,8 +266,8 @@ void ScanGridProvider::setVerticalLines(ScanGrid& scanGrid, ImageCornersOnField&
   }
 
   // Set low resolution scan line info
-  scanGrid.lowResStep = maxXStep2 / minXStep;
-  scanGrid.lowResStart = scanGrid.lowResStep / 2;
+  scanGrid.lowResStep = grid.lowResStep;
+  scanGrid.lowResStart = grid.lowResStart;
 }
 
 void ScanGridProvider::addLowResHorizontalLine(ScanGrid& scanGrid, int y) const
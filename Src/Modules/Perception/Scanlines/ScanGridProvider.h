@@ -31,11 +31,59 @@ MODULE(ScanGridProvider,
     (int)(25) minNumOfLowResScanLines, /**< The minimum number of scan lines for low resolution. */
     (float)(0.9f) lineWidthRatio, /**< The ratio of field line width that is sampled when scanning the image. */
     (float)(0.8f) ballWidthRatio, /**< The ratio of ball width that is sampled when scanning the image. */
+    (float)(2.f) translationQuantization, /**< The camera position is rounded to multiples of this value for looking up cached grids (in mm). */
+    (Angle)(0.2_deg) rotationQuantization, /**< The camera pitch and roll are rounded to multiples of this value for looking up cached grids. */
+    (unsigned)(16) cacheSize, /**< The maximum number of grids cached. */
   }),
 });
 
 class ScanGridProvider : public ScanGridProviderBase
 {
+  /** The quantized camera pose, camera intrinsics, and image size a grid was computed for. */
+  struct GridKey
+  {
+    int x; /**< Camera x position relative to the yaw-rotated robot frame (quantized). */
+    int y; /**< Camera y position relative to the yaw-rotated robot frame (quantized). */
+    int z; /**< Camera height (quantized). */
+    int pitch; /**< Camera pitch (quantized). */
+    int roll; /**< Camera roll (quantized). */
+    int width; /**< Image width. */
+    int height; /**< Image height. */
+    float focalLength; /**< Horizontal focal length (in pixels). */
+    float focalLengthHeight; /**< Vertical focal length (in pixels). */
+    Vector2f opticalCenter; /**< Optical center (in pixels). */
+
+    bool operator==(const GridKey& other) const
+    {
+      return x == other.x && y == other.y && z == other.z && pitch == other.pitch && roll == other.roll
+             && width == other.width && height == other.height
+             && focalLength == other.focalLength && focalLengthHeight == other.focalLengthHeight
+             && opticalCenter == other.opticalCenter;
+    }
+  };
+
+  /**
+   * The part of the grid that only depends on the camera pose, i.e. before it is clipped
+   * by the field boundary and the body contour.
+   */
+  struct GridTemplate
+  {
+    GridKey key; /**< The pose this grid was computed for. */
+    unsigned lastUsed = 0; /**< The number of the frame in which this grid was last used. */
+    int fieldLimit = -1; /**< Upper bound for all scanLines (exclusive). Negative if there is no grid. */
+    bool lowerCornersValid = false; /**< Could the lower image corners be projected onto the field? */
+    std::vector<int> fullResY; /**< All heights for a full resolution scan. */
+    std::vector<int> lowResY; /**< The heights of the low resolution horizontal scan lines. */
+    std::vector<Vector2i> verticalLines; /**< The x coordinates and unclipped maximum y coordinates of the vertical scan lines. */
+    unsigned lowResStart = 0; /**< First index of low res grid. */
+    unsigned lowResStep = 1; /**< Steps between low res grid lines. */
+  };
+
+  std::vector<GridTemplate> cache; /**< Grids for recently seen camera poses. */
+  unsigned frameCounter = 0; /**< Counts the updates for deciding which cache entry to replace. */
+  unsigned cacheHits = 0; /**< The number of updates that found their grid in the cache. */
+  unsigned cacheMisses = 0; /**< The number of updates that had to compute their grid. */
+
   struct ImageCornersOnField {
     Vector2f leftOnField;
     Vector2f rightOnField;
@@ -49,6 +97,19 @@ class ScanGridProvider : public ScanGridProviderBase
 
   void update(ScanGrid& scanGrid) override;
 
+  /**
+   * Returns the grid template for the current camera pose, either from the cache or
+   * by computing it.
+   * @return The grid template.
+   */
+  const GridTemplate& getGridTemplate();
+
+  /**
+   * Computes the grid template for the current camera pose.
+   * @param grid The template that is filled. Its key is already set.
+   */
+  void calcGridTemplate(GridTemplate& grid) const;
+
   /**
    * Compute the furthest point away that could be part of the field given an unknown own position.
    * @return
@@ -57,16 +118,16 @@ class ScanGridProvider : public ScanGridProviderBase
 
   /**
    * Determine vertical sampling points of the grid.
-   * @param scanGrid
+   * @param grid The grid template. Its field limit must already be set.
    * @param lowerImageCornersOnField
    */
-  void setFullResY(ScanGrid& scanGrid, ImageCornersOnField& lowerImageCornersOnField) const;
+  void setFullResY(GridTemplate& grid, ImageCornersOnField& lowerImageCornersOnField) const;
 
   /**
-   * Determine vertical sampling points of the grid.
-   * @param scanGrid
+   * Determine the heights of the low resolution horizontal scan lines.
+   * @param grid The grid template. Its full resolution heights must already be set.
    */
-  void setLowResHorizontalLines(ScanGrid& scanGrid) const;
+  void setLowResY(GridTemplate& grid) const;
 
   /**
    *
@@ -76,11 +137,18 @@ class ScanGridProvider : public ScanGridProviderBase
   ImageCornersOnField calcImageCornersOnField(VerticalBoundary boundary) const;
 
   /**
-   *
-   * @param scanGrid
+   * Determine the positions and unclipped lengths of the vertical scan lines.
+   * @param grid The grid template.
    * @param lowerImageCornersOnField
    */
-  void setVerticalLines(ScanGrid& scanGrid, ImageCornersOnField& lowerImageCornersOnField) const;
+  void setVerticalLines(GridTemplate& grid, ImageCornersOnField& lowerImageCornersOnField) const;
+
+  /**
+   * Clip the vertical scan lines of a template by the field boundary and the body contour.
+   * @param scanGrid The grid to which the clipped lines are added. Its horizontal lines must already be set.
+   * @param grid The grid template.
+   */
+  void addVerticalLines(ScanGrid& scanGrid, const GridTemplate& grid) const;
 
   /**
    *
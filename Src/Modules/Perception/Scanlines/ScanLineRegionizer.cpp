@@ -15,7 +15,6 @@
 #include "Debugging/Annotation.h"
 
 #include <functional>
-#include <list>
 #include <vector>
 
 MAKE_MODULE(ScanLineRegionizer);
@@ -37,8 +36,8 @@ void ScanLineRegionizer::update(ColorScanLineRegionsHorizontal& colorScanLineReg
   approximateBaseSaturation();
 
   // 1. Define scan-lines
-  std::vector<unsigned short> yPerScanLine;  // heights of the scan-lines in the image
-  std::vector<std::vector<InternalRegion>> regionsPerScanLine;
+  FrameVector<unsigned short> yPerScanLine;  // heights of the scan-lines in the image
+  FrameVector<FrameVector<InternalRegion>> regionsPerScanLine;
 
   // find height in image up to which additional smoothing (5x5 filter) will be applied.
   // compute by projecting on-field distance into image
@@ -99,8 +98,8 @@ void ScanLineRegionizer::update(ColorScanLineRegionsVerticalClipped& colorScanLi
 
   // 1. Define scan-lines and limit scan-line ranges by field boundary (body contour is already excluded by ScanGrid)
   const std::size_t numOfScanLines = theScanGrid.verticalLines.size();
-  std::vector<unsigned short> xPerScanLine(numOfScanLines);
-  std::vector<std::vector<InternalRegion>> regionsPerScanLine(numOfScanLines);
+  FrameVector<unsigned short> xPerScanLine(numOfScanLines);
+  FrameVector<FrameVector<InternalRegion>> regionsPerScanLine(numOfScanLines);
 
   // find height in image up to which additional smoothing (5x5 filter) will be applied.
   // compute by projecting on-field distance into image
@@ -133,7 +132,7 @@ void ScanLineRegionizer::update(ColorScanLineRegionsVerticalClipped& colorScanLi
   emplaceInScanLineRegionsVertical(colorScanLineRegionsVerticalClipped, xPerScanLine, regionsPerScanLine);
 }
 
-void ScanLineRegionizer::scanHorizontal(unsigned int y, std::vector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX) const
+void ScanLineRegionizer::scanHorizontal(unsigned int y, FrameVector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX) const
 {
   if(y < 1 || y >= theECImage.grayscaled.height - 1)
     return;
@@ -234,7 +233,7 @@ void ScanLineRegionizer::scanHorizontal(unsigned int y, std::vector<InternalRegi
                        getHorizontalRepresentativeValue(theECImage.saturated, scanRun.leftScanEdgePosition, rightmostX, y));
 }
 
-void ScanLineRegionizer::scanHorizontalAdditionalSmoothing(unsigned int y, std::vector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX) const
+void ScanLineRegionizer::scanHorizontalAdditionalSmoothing(unsigned int y, FrameVector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX) const
 {
   if(y < 2 || y >= theECImage.grayscaled.height - 2)
     return;
@@ -326,7 +325,7 @@ void ScanLineRegionizer::scanHorizontalAdditionalSmoothing(unsigned int y, std::
                        getHorizontalRepresentativeValue(theECImage.saturated, scanRun.leftScanEdgePosition, rightmostX, y));
 }
 
-void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, int top, std::vector<InternalRegion>& regions) const
+void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, int top, FrameVector<InternalRegion>& regions) const
 {
   if(line.x < 1 || static_cast<unsigned int>(line.x + 1) >= theECImage.grayscaled.width || line.yMax <= std::max(2, top))
     return;
@@ -516,7 +515,7 @@ void ScanLineRegionizer::scanVertical(const ScanGrid::Line& line, int middle, in
 
 template <int filterSize>
 void ScanLineRegionizer::findEdgeInSubLineHorizontal(
-    std::vector<InternalRegion>& regions,
+    FrameVector<InternalRegion>& regions,
     ScanRun<filterSize>& scanRun,
     unsigned int startPos,
     unsigned int stopPos,
@@ -547,7 +546,7 @@ void ScanLineRegionizer::findEdgeInSubLineHorizontal(
 
 template <int filterSize>
 void ScanLineRegionizer::findEdgeInSubLineVertical(
-    std::vector<InternalRegion>& regions,
+    FrameVector<InternalRegion>& regions,
     ScanRun<filterSize>& scanRun,
     unsigned int startPos,
     unsigned int stopPos,
@@ -576,13 +575,13 @@ void ScanLineRegionizer::findEdgeInSubLineVertical(
   MID_DOT("module:ScanLineRegionizer:verticalRegionSplit", scanRun.scanLinePosition, edgeYMax, ColorRGBA::magenta, ColorRGBA::magenta);
 }
 
-void ScanLineRegionizer::uniteHorizontalFieldRegions(const std::vector<unsigned short>& y, std::vector<std::vector<InternalRegion>>& regions) const
+void ScanLineRegionizer::uniteHorizontalFieldRegions(const FrameVector<unsigned short>& y, FrameVector<FrameVector<InternalRegion>>& regions) const
 {
   ASSERT(y.size() == regions.size());
   for(std::size_t lineIndex = 0; lineIndex < y.size(); ++lineIndex)
   {
     std::size_t nextLineIndex = lineIndex + 1;
-    std::vector<InternalRegion>::iterator nextLineRegion;
+    FrameVector<InternalRegion>::iterator nextLineRegion;
     if(nextLineIndex < regions.size())
       nextLineRegion = regions[nextLineIndex].begin();
 
@@ -624,7 +623,7 @@ void ScanLineRegionizer::uniteHorizontalFieldRegions(const std::vector<unsigned
   }
 }
 
-void ScanLineRegionizer::uniteVerticalFieldRegions(const std::vector<unsigned short>& x, std::vector<std::vector<InternalRegion>>& regions) const
+void ScanLineRegionizer::uniteVerticalFieldRegions(const FrameVector<unsigned short>& x, FrameVector<FrameVector<InternalRegion>>& regions) const
 {
   ASSERT(x.size() == regions.size());
   for(std::size_t lineIndex = 0; lineIndex < regions.size(); ++lineIndex)
@@ -635,7 +634,7 @@ void ScanLineRegionizer::uniteVerticalFieldRegions(const std::vector<unsigned sh
     unsigned short lineRangeFrom = regions[lineIndex][regions[lineIndex].size() - 1].range.from;
     const unsigned short lineRangeTo = regions[lineIndex][0].range.to;
     ASSERT(lineRangeFrom < lineRangeTo);
-    std::list<std::pair<InternalRegion*, unsigned short>> nextLinesRegions;
+    FrameVector<std::pair<InternalRegion*, unsigned short>> nextLinesRegions;
     for(std::size_t nextLineIndex = lineIndex + 1; nextLineIndex < regions.size() && nextLineIndex <= lineIndex + 4; ++nextLineIndex)
     {
       if(lineRangeFrom >= lineRangeTo)
@@ -653,7 +652,7 @@ void ScanLineRegionizer::uniteVerticalFieldRegions(const std::vector<unsigned sh
         }
       }
     }
-    std::list<std::pair<InternalRegion*, unsigned short>>::iterator nextLineRegion;
+    FrameVector<std::pair<InternalRegion*, unsigned short>>::iterator nextLineRegion;
     if(!nextLinesRegions.empty())
       nextLineRegion = nextLinesRegions.begin();
 
@@ -707,7 +706,7 @@ bool ScanLineRegionizer::areSimilar(InternalRegion& a, InternalRegion& b) const
   return false;
 }
 
-void ScanLineRegionizer::classifyFieldRegions(const std::vector<unsigned short>& xy, std::vector<std::vector<InternalRegion>>& regions, bool horizontal)
+void ScanLineRegionizer::classifyFieldRegions(const FrameVector<unsigned short>& xy, FrameVector<FrameVector<InternalRegion>>& regions, bool horizontal)
 {
   unsigned char minHue = 255;
   unsigned char maxHue = 0;
@@ -775,7 +774,7 @@ void ScanLineRegionizer::classifyFieldRegions(const std::vector<unsigned short>&
   }
 }
 
-void ScanLineRegionizer::classifyFieldHorizontal(const std::vector<unsigned short>& y, std::vector<std::vector<InternalRegion>>& regions) const
+void ScanLineRegionizer::classifyFieldHorizontal(const FrameVector<unsigned short>& y, FrameVector<FrameVector<InternalRegion>>& regions) const
 {
   ASSERT(y.size() == regions.size());
   for(size_t lineIndex = 0; lineIndex < regions.size(); ++lineIndex)
@@ -788,7 +787,7 @@ void ScanLineRegionizer::classifyFieldHorizontal(const std::vector<unsigned shor
   }
 }
 
-void ScanLineRegionizer::classifyFieldVertical(std::vector<std::vector<InternalRegion>>& regions) const
+void ScanLineRegionizer::classifyFieldVertical(FrameVector<FrameVector<InternalRegion>>& regions) const
 {
   for(auto& line : regions)
   {
@@ -860,7 +859,7 @@ bool ScanLineRegionizer::regionIsField(const InternalRegion* const region) const
   return false;
 }
 
-void ScanLineRegionizer::classifyWhiteRegionsWithThreshold(std::vector<std::vector<InternalRegion>>& regions, bool horizontal) const
+void ScanLineRegionizer::classifyWhiteRegionsWithThreshold(FrameVector<FrameVector<InternalRegion>>& regions, bool horizontal) const
 {
   unsigned char minWhiteLuminance = static_cast<unsigned char>(
                                       std::min(std::min(static_cast<int>(estimatedFieldColor.maxLuminance), static_cast<int>(theRelativeFieldColorsParameters.maxFieldLuminance)),
@@ -924,7 +923,7 @@ bool ScanLineRegionizer::prelabelWhiteNeighborCheck(const InternalRegion& checke
          static_cast<int>(thresholdModifier * static_cast<float>(luminanceSimilarityThreshold + saturationSimilarityThreshold));
 }
 
-void ScanLineRegionizer::stitchUpHoles(std::vector<std::vector<InternalRegion>>& regions, bool horizontal) const
+void ScanLineRegionizer::stitchUpHoles(FrameVector<FrameVector<InternalRegion>>& regions, bool horizontal) const
 {
   ScanLineRegion::Color lastColor = ScanLineRegion::none;
   ScanLineRegion::Color currentColor = ScanLineRegion::none;
@@ -984,8 +983,8 @@ void ScanLineRegionizer::stitchUpHoles(std::vector<std::vector<InternalRegion>>&
 }
 
 void ScanLineRegionizer::emplaceInScanLineRegionsHorizontal(ColorScanLineRegionsHorizontal& colorScanLineRegionsHorizontal,
-                                        const std::vector<unsigned short>& yPerScanLine,
-                                        const std::vector<std::vector<InternalRegion>>& regionsPerScanLine)
+                                        const FrameVector<unsigned short>& yPerScanLine,
+                                        const FrameVector<FrameVector<InternalRegion>>& regionsPerScanLine)
 {
   ASSERT(yPerScanLine.size() == regionsPerScanLine.size());
   const std::size_t numOfScanLines = yPerScanLine.size();
@@ -993,7 +992,7 @@ void ScanLineRegionizer::emplaceInScanLineRegionsHorizontal(ColorScanLineRegions
   for(std::size_t i = 0; i < numOfScanLines; ++i)
   {
     colorScanLineRegionsHorizontal.scanLines.emplace_back(yPerScanLine[i]);
-    const std::vector<InternalRegion>& regions = regionsPerScanLine[i];
+    const FrameVector<InternalRegion>& regions = regionsPerScanLine[i];
     std::vector<ScanLineRegion>& newRegions = colorScanLineRegionsHorizontal.scanLines[i].regions;
     for(std::size_t j = 0; j < regions.size(); ++j)
     {
@@ -1007,8 +1006,8 @@ void ScanLineRegionizer::emplaceInScanLineRegionsHorizontal(ColorScanLineRegions
 }
 
 void ScanLineRegionizer::emplaceInScanLineRegionsVertical(ColorScanLineRegionsVerticalClipped& colorScanLineRegionsVerticalClipped,
-                                      const std::vector<unsigned short>& xPerScanLine,
-                                      const std::vector<std::vector<InternalRegion>>& regionsPerScanLine)
+                                      const FrameVector<unsigned short>& xPerScanLine,
+                                      const FrameVector<FrameVector<InternalRegion>>& regionsPerScanLine)
 {
   ASSERT(xPerScanLine.size() == regionsPerScanLine.size());
   std::size_t numOfScanLines = xPerScanLine.size();
@@ -1016,7 +1015,7 @@ void ScanLineRegionizer::emplaceInScanLineRegionsVertical(ColorScanLineRegionsVe
   for(std::size_t i = 0; i < numOfScanLines; ++i)
   {
     colorScanLineRegionsVerticalClipped.scanLines.emplace_back(xPerScanLine[i]);
-    const std::vector<InternalRegion>& regions = regionsPerScanLine[i];
+    const FrameVector<InternalRegion>& regions = regionsPerScanLine[i];
     std::vector<ScanLineRegion>& newRegions = colorScanLineRegionsVerticalClipped.scanLines[i].regions;
     for(std::size_t j = 0; j < regions.size(); ++j)
     {
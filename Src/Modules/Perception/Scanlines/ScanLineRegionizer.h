@@ -22,6 +22,7 @@
 #include "Representations/Perception/ImagePreprocessing/RelativeFieldColors.h"
 #include "Representations/Perception/ImagePreprocessing/ScanGrid.h"
 #include "ImageProcessing/PixelTypes.h"
+#include "Framework/FrameArena.h"
 #include "Framework/Module.h"
 
 #include <limits>
@@ -60,6 +61,8 @@ MODULE(ScanLineRegionizer,
 
 class ScanLineRegionizer : public ScanLineRegionizerBase
 {
+  ECImageRequest ecImageRequest{{ECImageRequest::grayscaled, ECImageRequest::saturated, ECImageRequest::hued}};
+
   struct EstimatedFieldColor
   {
     // no support for circular hue range here, field won't be on the zero crossing
@@ -222,7 +225,7 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param leftmostX Left-side starting point of the scan-line
    * @param rightmostX Right-side end point of the scan-line
    */
-  void scanHorizontal(unsigned int y, std::vector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX) const;
+  void scanHorizontal(unsigned int y, FrameVector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX) const;
 
   /**
    * Creates regions along a horizontal line.
@@ -241,7 +244,7 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param leftmostX Left-side starting point of the scan-line
    * @param rightmostX Right-side end point of the scan-line
    */
-  void scanHorizontalAdditionalSmoothing(unsigned int y, std::vector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX) const;
+  void scanHorizontalAdditionalSmoothing(unsigned int y, FrameVector<InternalRegion>& regions, const unsigned int leftmostX, const unsigned int rightmostX) const;
 
   /**
    * Creates regions along a vertical scan line.
@@ -250,7 +253,7 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param top The y coordinate (inclusive) below which the useful part of the image is located.
    * @param regions he regions to be filled.
    */
-  void scanVertical(const ScanGrid::Line& line, int middle, int top, std::vector<InternalRegion>& regions) const;
+  void scanVertical(const ScanGrid::Line& line, int middle, int top, FrameVector<InternalRegion>& regions) const;
 
   /**
    * Find an exact edge position in the scanRun in the subsegment designated by startPos and stopPos.
@@ -267,7 +270,7 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param maxEdge whether to search for black-to-white edge or a white-to-black edge
    */
   template <int filterSize>
-  void findEdgeInSubLineHorizontal(std::vector<InternalRegion>& regions, ScanRun<filterSize>& scanRun, unsigned int startPos, unsigned int stopPos, bool maxEdge) const;
+  void findEdgeInSubLineHorizontal(FrameVector<InternalRegion>& regions, ScanRun<filterSize>& scanRun, unsigned int startPos, unsigned int stopPos, bool maxEdge) const;
 
   /**
    * Find an exact edge position in the scanRun in the subsegment designated by startPos and stopPos.
@@ -284,7 +287,7 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param maxEdge whether to search for black-to-white edge or a white-to-black edge
    */
   template <int filterSize>
-  void findEdgeInSubLineVertical(std::vector<InternalRegion>& regions, ScanRun<filterSize>& scanRun, unsigned int startPos, unsigned int stopPos, bool maxEdge) const;
+  void findEdgeInSubLineVertical(FrameVector<InternalRegion>& regions, ScanRun<filterSize>& scanRun, unsigned int startPos, unsigned int stopPos, bool maxEdge) const;
 
   /**
    * Unites similar horizontal scan line regions.
@@ -292,7 +295,7 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param regions The regions (grouped by scan line), scan lines sorted from bottom to top,
    * regions in the scan lines sorted ascending by pixel number from left to right.
    */
-  void uniteHorizontalFieldRegions(const std::vector<unsigned short>& y, std::vector<std::vector<InternalRegion>>& regions) const;
+  void uniteHorizontalFieldRegions(const FrameVector<unsigned short>& y, FrameVector<FrameVector<InternalRegion>>& regions) const;
 
   /**
    * Unite similar vertical scan line regions.
@@ -300,7 +303,7 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param regions The regions (grouped by scan line), scan lines sorted from left to right,
    * regions in the scan lines sorted descending by pixel number from bottom to top.
    */
-  void uniteVerticalFieldRegions(const std::vector<unsigned short>& x, std::vector<std::vector<InternalRegion>>& regions) const;
+  void uniteVerticalFieldRegions(const FrameVector<unsigned short>& x, FrameVector<FrameVector<InternalRegion>>& regions) const;
 
   /**
    * Checks whether two regions are similar enough to unite them.
@@ -317,7 +320,7 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param regions The regions to classify.
    * @param horizontal Are the regions on horizontal (true) or vertical (false) scan lines
    */
-  void classifyFieldRegions(const std::vector<unsigned short>& xy, std::vector<std::vector<InternalRegion>>& regions, bool horizontal);
+  void classifyFieldRegions(const FrameVector<unsigned short>& xy, FrameVector<FrameVector<InternalRegion>>& regions, bool horizontal);
 
   /**
    * Classify all yet unclassified horizontal regions as field or not.
@@ -325,7 +328,7 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param y the in image heights of the scan lines
    * @param regions the regions
    */
-  void classifyFieldHorizontal(const std::vector<unsigned short>& y, std::vector<std::vector<InternalRegion>>& regions) const;
+  void classifyFieldHorizontal(const FrameVector<unsigned short>& y, FrameVector<FrameVector<InternalRegion>>& regions) const;
 
 
   /**
@@ -333,7 +336,7 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * Classification based on estimated field color.
    * @param regions the regions
    */
-  void classifyFieldVertical(std::vector<std::vector<InternalRegion>>& regions) const;
+  void classifyFieldVertical(FrameVector<FrameVector<InternalRegion>>& regions) const;
 
   /**
    * Classify a single yet unclassified region as field or not.
@@ -365,7 +368,7 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param regions The regions (grouped by scan line).
    * @param horizontal Whether the stitching is done on horizontal or vertical scan line regions.
    */
-  void classifyWhiteRegionsWithThreshold(std::vector<std::vector<InternalRegion>>& regions, bool horizontal) const;
+  void classifyWhiteRegionsWithThreshold(FrameVector<FrameVector<InternalRegion>>& regions, bool horizontal) const;
 
   /**
    * Checks if the region fulfills basic characteristics for being pre-labeled as white
@@ -387,7 +390,7 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param regions The regions.
    * @param horizontal Whether the stitching is done on horizontal or vertical scan line regions.
    */
-  void stitchUpHoles(std::vector<std::vector<InternalRegion>>& regions, bool horizontal) const;
+  void stitchUpHoles(FrameVector<FrameVector<InternalRegion>>& regions, bool horizontal) const;
 
   /**
    * Emplace computed scan-line regions into the ColorScanLineRegionsHorizontal representation.
@@ -398,8 +401,8 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param regionsPerScanLine a vector of scan-line regions per scan-line
    */
   static void emplaceInScanLineRegionsHorizontal(ColorScanLineRegionsHorizontal& colorScanLineRegionsHorizontal,
-                                          const std::vector<unsigned short>& yPerScanLine,
-                                          const std::vector<std::vector<InternalRegion>>& regionsPerScanLine);
+                                          const FrameVector<unsigned short>& yPerScanLine,
+                                          const FrameVector<FrameVector<InternalRegion>>& regionsPerScanLine);
 
   /**
    * Emplace computed scan-line regions into the ColorScanLineRegionsVerticalClipped representation.
@@ -410,8 +413,8 @@ class ScanLineRegionizer : public ScanLineRegionizerBase
    * @param regionsPerScanLine a vector of scan-line regions per scan-line
    */
   static void emplaceInScanLineRegionsVertical(ColorScanLineRegionsVerticalClipped& colorScanLineRegionsVerticalClipped,
-                                                 const std::vector<unsigned short>& xPerScanLine,
-                                                 const std::vector<std::vector<InternalRegion>>& regionsPerScanLine);
+                                                 const FrameVector<unsigned short>& xPerScanLine,
+                                                 const FrameVector<FrameVector<InternalRegion>>& regionsPerScanLine);
 
   /**
    * Checks by timestamp if the EstimatedFieldColor is still presumed valid.
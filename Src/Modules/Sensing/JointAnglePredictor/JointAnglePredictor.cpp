@@ -10,6 +10,7 @@
 #include "Debugging/Annotation.h"
 #include "Platform/SystemCall.h"
 
+#include <array>
 #include <filesystem>
 
 MAKE_MODULE(JointAnglePredictor);
@@ -33,10 +34,14 @@ void JointAnglePredictor::update(JointAnglePred& theJointAnglePred)
     theJointAnglePred.modelName = modelName;
   }
 
-  // Add the data from this frame.
-  jointSensorAngles.push_front(theJointAngles.angles);
-  // Add Request from last frame. == USES(JointRequest)
-  jointRequestAngles.push_front(theJointRequest.angles);
+  // Add the data from this frame, i.e. the request from last frame (== USES(JointRequest))
+  // and the current sensor values. Skip lHipYawPitch and use hipYawPitch==rHipYawPitch.
+  std::array<float, sliceSize> slice;
+  for(std::size_t joint = Joints::firstLegJoint + 1; joint < Joints::numOfJoints; joint++)
+  {
+    slice[joint - Joints::firstLegJoint - 1] = theJointRequest.angles[joint];
+    slice[joint - Joints::firstLegJoint - 1 + numOfModelJoints] = theJointAngles.angles[joint];
+  }
 
   // Fill all joints with ignore values.
   theJointAnglePred.angles.fill(SensorData::ignore);
@@ -44,30 +49,18 @@ void JointAnglePredictor::update(JointAnglePred& theJointAnglePred)
   // The model output is only valid during walking and is otherwise undefined.
   theJointAnglePred.isValid = theMotionInfo.isMotion(MotionPhase::walk);
 
-  // Do noting until data is present and only calculate the predictions if the results are valid.
-  if(!jointSensorAngles.full() || !jointRequestAngles.full() || !theJointAnglePred.isValid)
+  // A streaming model must see every frame to keep its state up to date. Otherwise, the model
+  // is only run if the results are valid. Do nothing until data is present.
+  bool predicted;
+  STOPWATCH("module:JointAnglePredictor:apply")
+    predicted = model.add(slice.data(), theJointAnglePred.isValid);
+  if(!predicted)
   {
     theJointAnglePred.isValid = false;
     return;
   }
 
-  // Add input to model.
-  float* input = network.input(0).data();
-  // Add values from old to new and first requests and then the sensor values.
-  for(int i = historyLength - 1; i >= 0; i--)
-  {
-    // Skip lHipYawPitch and use hipYawPitch==rHipYawPitch.
-    for(std::size_t joint = Joints::firstLegJoint + 1; joint < Joints::numOfJoints; joint++)
-      *input++ = jointRequestAngles[i][joint];
-    for(std::size_t joint = Joints::firstLegJoint + 1; joint < Joints::numOfJoints; joint++)
-      *input++ = jointSensorAngles[i][joint];
-  }
-
-  // Run network.
-  STOPWATCH("module:JointAnglePredictor:apply")
-    network.apply();
-
-  const float* output = network.output(0).data();
+  const float* output = model.network.output(0).data();
   // Override joints that are provided. Skip lHipYawPitch and use hipYawPitch==rHipYawPitch.
   for(std::size_t joint = Joints::firstLegJoint + 1; joint < Joints::numOfJoints; joint++)
     theJointAnglePred.angles[joint] = *output++;
@@ -87,20 +80,24 @@ void JointAnglePredictor::compile(bool output)
   else
     ASSERT(std::filesystem::exists(modelPath + modelName));
 
-  network.compile(Model(modelPath + modelName));
+  InferenceEngine& network = model.network;
+  network.load(modelPath + modelName);
   ASSERT(network.valid());
 
-  // Input shape: (historyLength, 22)
-  ASSERT(network.numOfInputs() == 1);
+  // Input shape: (historyLength, 22) or (1, 22) plus the state for streaming models.
+  const bool streaming = network.numOfInputs() > 1;
+  ASSERT(network.numOfInputs() == network.numOfOutputs());
   ASSERT(network.input(0).rank() == 2); // (Batch, Time, Features)
-  ASSERT(network.input(0).dims(0) == historyLength);
-  ASSERT(network.input(0).dims(1) == 22); // == Request + Sensor
+  ASSERT(network.input(0).dims(0) == (streaming ? 1 : historyLength));
+  ASSERT(network.input(0).dims(1) == sliceSize); // == Request + Sensor
+  for(std::size_t i = 1; i < network.numOfInputs(); ++i)
+    ASSERT(network.input(i).size() == network.output(i).size());
+  model.reset(historyLength, sliceSize);
 
   // Output shape: (1, 11)
-  ASSERT(network.numOfOutputs() == 1);
   ASSERT(network.output(0).rank() == 2); // (Batch, Time, Features)
   ASSERT(network.output(0).dims(0) == 1);
-  ASSERT(network.output(0).dims(1) == 11); // == Sensor
+  ASSERT(network.output(0).dims(1) == numOfModelJoints); // == Sensor
 
   if(output)
     ANNOTATION("JointAnglePredictor", "Change model to " + modelName);
@@ -9,17 +9,13 @@
 #pragma once
 
 #include "Framework/Module.h"
-#include "MathBase/RingBuffer.h"
 #include "Platform/File.h"
 #include "Representations/Infrastructure/JointRequest.h"
 #include "Representations/Infrastructure/JointAngles.h"
 #include "Representations/MotionControl/MotionInfo.h"
 #include "Representations/Sensing/JointAnglePred.h"
 
-//#include <CompiledNN/CompiledNN.h>
-#include <CompiledNN2ONNX/CompiledNN.h>
-
-using namespace NeuralNetworkONNX;
+#include "Tools/Inference/SequenceModel.h"
 
 MODULE(JointAnglePredictor,
 {,
@@ -37,22 +33,22 @@ MODULE(JointAnglePredictor,
 class JointAnglePredictor : public JointAnglePredictorBase
 {
 public:
-  JointAnglePredictor() : network(&Global::getAsmjitRuntime()) { compile(false); }
+  JointAnglePredictor() { compile(false); }
 
 private:
-  // Save input data from old to new.
-  RingBuffer<ENUM_INDEXED_ARRAY(Angle, Joints::Joint)> jointSensorAngles{ historyLength }; // ..., -2, -1, -0
-  RingBuffer<ENUM_INDEXED_ARRAY(Angle, Joints::Joint)> jointRequestAngles{ historyLength }; // ...,-3, -2, -1
+  static constexpr unsigned numOfModelJoints = Joints::numOfJoints - Joints::firstLegJoint - 1; /**< The leg joints without lHipYawPitch. */
+  static constexpr unsigned sliceSize = 2 * numOfModelJoints; /**< The requested and the measured angles of one frame. */
 
   // Model.
   const std::string modelPath = std::string(File::getBHDir()) + "/Config/NeuralNets/JointAngle/";
-  CompiledNN network; /**< The compiled neural network. */
+  SequenceModel<> model; /**< The neural network run on the input of the last historyLength frames. */
 
   /**
    * This method is called when the representation provided needs to be updated.
    * @param theJointAnglePred The representation updated.
    */
   void update(JointAnglePred& theJointAnglePred) override;
+
   /**
    * Compile the model.
    * @param output Whether to output information.
@@ -17,6 +17,7 @@
 
 STREAMABLE(WalkGenerator,
 {
+  /** Callbacks must not capture more than a pointer, because larger ones would be stored on the heap. */
   using CreateNextPhaseCallback = std::function<std::unique_ptr<MotionPhase>(const MotionPhase&, const WalkKickStep&)>;
 
   /**
@@ -0,0 +1,33 @@
+/**
+ * @file ECImage.cpp
+ *
+ * Implements the registry of the requests for the planes of the ECImage.
+ */
+
+#include "ECImage.h"
+#include <algorithm>
+
+thread_local std::list<const ECImageRequest*> ECImageRequest::requests;
+
+ECImageRequest::ECImageRequest(std::initializer_list<Plane> planes, int rowsAboveHorizon)
+{
+  this->rowsAboveHorizon.fill(notRequested);
+  for(const Plane plane : planes)
+    this->rowsAboveHorizon[plane] = std::max(rowsAboveHorizon, 0);
+  requests.push_back(this);
+}
+
+ECImageRequest::~ECImageRequest()
+{
+  requests.remove(this);
+}
+
+std::array<int, ECImageRequest::numOfPlanes> ECImageRequest::getUnion()
+{
+  std::array<int, numOfPlanes> rowsAboveHorizon;
+  rowsAboveHorizon.fill(notRequested);
+  for(const ECImageRequest* request : requests)
+    for(std::size_t i = 0; i < rowsAboveHorizon.size(); ++i)
+      rowsAboveHorizon[i] = std::max(rowsAboveHorizon[i], request->rowsAboveHorizon[i]);
+  return rowsAboveHorizon;
+}
@@ -15,11 +15,19 @@
 #include "ImageProcessing/Image.h"
 #include "ImageProcessing/PixelTypes.h"
 #include "Debugging/DebugImages.h"
+#include "Streaming/Enum.h"
+#include <array>
+#include <initializer_list>
+#include <limits>
+#include <list>
 
 /**
  * A representation containing both a color classified and a grayscale version of
  * the camera image.
  * It is advised to use this representation for all further image processing.
+ * Only the planes and rows requested through ECImageRequest objects are
+ * computed. The other planes are empty and the rows above the requested ones
+ * contain data of earlier images.
  */
 STREAMABLE(ECImage,
 {
@@ -48,3 +56,49 @@ STREAMABLE(OptionalECImage,
 {,
   (std::optional<ECImage>) image,
 });
+
+/**
+ * Modules reading the ECImage declare which of its planes and rows they need
+ * by owning an instance of this class. The ECImageProvider of the same thread
+ * only computes the union of all requests. Rows are requested relative to the
+ * horizon, because most modules only look at the field.
+ */
+class ECImageRequest
+{
+public:
+  ENUM(Plane,
+  {,
+    grayscaled,
+    saturated,
+    hued,
+    chromaticity, /**< Both blueChromaticity and redChromaticity. */
+  });
+
+  static constexpr int fullImage = std::numeric_limits<int>::max(); /**< The number of rows above the horizon that requests the whole image. */
+  static constexpr int notRequested = -1; /**< The number of rows above the horizon of a plane nobody requested. */
+
+  /**
+   * Registers a request of the current thread.
+   * @param planes The planes requested.
+   * @param rowsAboveHorizon The number of rows above the horizon requested in
+   *                         addition to all rows below it.
+   */
+  ECImageRequest(std::initializer_list<Plane> planes, int rowsAboveHorizon = 0);
+
+  /** Unregisters the request. */
+  ~ECImageRequest();
+
+  ECImageRequest(const ECImageRequest&) = delete;
+  ECImageRequest& operator=(const ECImageRequest&) = delete;
+
+  /**
+   * Determines the union of all requests of the current thread.
+   * @return The number of rows above the horizon requested for each plane.
+   */
+  static std::array<int, numOfPlanes> getUnion();
+
+private:
+  std::array<int, numOfPlanes> rowsAboveHorizon; /**< The number of rows above the horizon requested for each plane. */
+
+  static thread_local std::list<const ECImageRequest*> requests; /**< All requests of this thread. */
+};
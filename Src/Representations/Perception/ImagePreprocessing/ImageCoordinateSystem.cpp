@@ -13,27 +13,6 @@
 #include "ImageProcessing/Image.h"
 #include "Framework/Blackboard.h"
 
-Vector2f ImageCoordinateSystem::fromCorrected(const Vector2f& correctedCoords, const Vector2f& offset) const
-{
-  float y = correctedCoords.y();
-
-  // Correction of points too far outside the image cannot be inverted correctly,
-  // because they cannot be the result of toCorrected.
-  if(y < -cameraInfo.height / 4 || y >= cameraInfo.height * 5 / 4)
-    return correctedCoords;
-
-  float factor;
-  for(int i = 0; i < 3; ++i)
-  {
-    factor = a + y * b;
-    float lastY = y;
-    y = cameraInfo.opticalCenter.y() + std::tan(std::atan((correctedCoords.y() - cameraInfo.opticalCenter.y()) / cameraInfo.focalLengthHeight) + factor * offset.y()) * cameraInfo.focalLengthHeight;
-    if(std::abs(y - lastY) < 0.5f)
-      break;
-  }
-  return Vector2f(cameraInfo.opticalCenter.x() - std::tan(std::atan((cameraInfo.opticalCenter.x() - correctedCoords.x()) / cameraInfo.focalLength) + factor * offset.x()) * cameraInfo.focalLength, y);
-}
-
 void ImageCoordinateSystem::draw() const
 {
   DEBUG_DRAWING("horizon", "drawingOnImage") // displays the horizon
@@ -7,10 +7,12 @@
 
 #pragma once
 
+#include "RollingShutterCorrection.h"
 #include "Representations/Infrastructure/CameraInfo.h"
 #include "Math/BHMath.h"
 #include "Math/Eigen.h"
 #include "Streaming/AutoStreamable.h"
+#include <memory>
 
 /**
  * @struct ImageCoordinateSystem
@@ -19,32 +21,45 @@
 STREAMABLE(ImageCoordinateSystem,
 {
 private:
+  mutable std::shared_ptr<const RollingShutterCorrection> correction; /**< The correction for offset. Computed on demand. */
+  mutable std::shared_ptr<const RollingShutterCorrection> robotCorrection; /**< The correction for robotOffset. Computed on demand. */
+
   /**
-   * Corrects image coordinates so that the distortion resulting from the rolling
-   * shutter is compensated with a given camera offset.
-   * No clipping is done.
-   * @param imageCoords The point in image coordinates.
+   * Returns a correction for the current parameters of this object.
+   * @param cache The correction computed previously, which is replaced if
+   *              it does not match the parameters anymore.
    * @param offset The angular offset between the last camera poses.
-   * @return The corrected point.
+   * @return The correction.
    */
-  Vector2f toCorrected(const Vector2f& imageCoords, const Vector2f& offset) const
+  const RollingShutterCorrection& getCorrection(std::shared_ptr<const RollingShutterCorrection>& cache, const Vector2f& offset) const
   {
-    const float factor = a + imageCoords.y() * b;
-    return Vector2f(cameraInfo.opticalCenter.x() - std::tan(std::atan((cameraInfo.opticalCenter.x() - imageCoords.x()) / cameraInfo.focalLength) - factor * offset.x()) * cameraInfo.focalLength,
-                    cameraInfo.opticalCenter.y() + std::tan(std::atan((imageCoords.y() - cameraInfo.opticalCenter.y()) / cameraInfo.focalLengthHeight) - factor * offset.y()) * cameraInfo.focalLengthHeight);
+    if(!cache || !cache->matches(cameraInfo, a, b, offset))
+      cache = std::make_shared<const RollingShutterCorrection>(cameraInfo, a, b, offset);
+    return *cache;
   }
 
+public:
+  CameraInfo cameraInfo; /**< A copy of the camera information that is required for the methods to work. Isn't logged. */
+
   /**
-   * Inverse of toCorrected with a given camera offset.
-   *
-   * @param correctedCoords The corrected point in image coordinates.
-   * @param offset The angular offset between the last camera poses.
-   * @return The original point.
+   * Returns the rolling shutter correction for the current image. It can be
+   * used to correct arrays of points at once.
+   * @return The correction.
    */
-  Vector2f fromCorrected(const Vector2f& correctedCoords, const Vector2f& offset) const;
+  const RollingShutterCorrection& getCorrection() const
+  {
+    return getCorrection(correction, offset);
+  }
 
-public:
-  CameraInfo cameraInfo; /**< A copy of the camera information that is required for the methods to work. Isn't logged. */
+  /**
+   * Returns the rolling shutter correction for the current image for points
+   * that are static relative to the robot torso.
+   * @return The correction.
+   */
+  const RollingShutterCorrection& getRobotCorrection() const
+  {
+    return getCorrection(robotCorrection, robotOffset);
+  }
 
   /**
    * Corrects image coordinates so that the distortion resulting from the rolling
@@ -55,7 +70,7 @@ public:
    */
   Vector2f toCorrected(const Vector2f& imageCoords) const
   {
-    return toCorrected(imageCoords, offset);
+    return getCorrection().toCorrected(imageCoords);
   }
 
   /**
@@ -78,7 +93,7 @@ public:
    */
   Vector2f fromCorrected(const Vector2f& correctedCoords) const
   {
-    return fromCorrected(correctedCoords, offset);
+    return getCorrection().fromCorrected(correctedCoords);
   }
 
   /**
@@ -101,7 +116,7 @@ public:
    */
   Vector2f toCorrectedRobot(const Vector2f& imageCoords) const
   {
-    return toCorrected(imageCoords, robotOffset);
+    return getRobotCorrection().toCorrected(imageCoords);
   }
 
   /**
@@ -124,7 +139,7 @@ public:
    */
   Vector2f fromCorrectedRobot(const Vector2f& correctedCoords) const
   {
-    return fromCorrected(correctedCoords, robotOffset);
+    return getRobotCorrection().fromCorrected(correctedCoords);
   }
 
   /**
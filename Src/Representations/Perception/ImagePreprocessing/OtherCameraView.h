@@ -0,0 +1,27 @@
+/**
+ * @file OtherCameraView.h
+ *
+ * This file defines a representation that describes the view of the camera
+ * that took the older image in a Cognition frame that fuses the frames of
+ * both cameras. Modules that relate percepts to the image they stem from use
+ * it for the percepts that were added from the older image.
+ */
+
+#pragma once
+
+#include "Representations/Infrastructure/CameraInfo.h"
+#include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
+#include "Representations/Perception/ImagePreprocessing/FieldBoundary.h"
+#include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
+#include "Representations/Perception/ObstaclesPercepts/ObstaclesImagePercept.h"
+
+STREAMABLE(OtherCameraView,
+{,
+  (bool)(false) isValid, /**< Does the current frame fuse the frames of both cameras? Otherwise, the other attributes are undefined. */
+  (bool)(false) providesBallPercept, /**< Does the BallPercept stem from the older image? */
+  (CameraInfo) cameraInfo, /**< The camera that took the older image. */
+  (CameraMatrix) cameraMatrix, /**< The camera matrix of the older image relative to the robot at the time of the newer image. */
+  (ImageCoordinateSystem) imageCoordinateSystem, /**< The image coordinate system of the older image. */
+  (FieldBoundary) fieldBoundary, /**< The field boundary in the older image. */
+  (ObstaclesImagePercept) obstaclesImagePercept, /**< The obstacles in the older image. */
+});
@@ -0,0 +1,154 @@
+/**
+ * @file RollingShutterCorrection.cpp
+ * Implementation of a class that compensates the distortion resulting from the
+ * rolling shutter for the parameters of a single image.
+ */
+
+#include "RollingShutterCorrection.h"
+#include "ImageProcessing/SIMD.h"
+#include <algorithm>
+#include <limits>
+
+RollingShutterCorrection::RollingShutterCorrection(const CameraInfo& cameraInfo, float a, float b, const Vector2f& offset) :
+  width(cameraInfo.width), height(cameraInfo.height), opticalCenter(cameraInfo.opticalCenter),
+  focalLength(cameraInfo.focalLength), focalLengthHeight(cameraInfo.focalLengthHeight),
+  a(a), b(b), offset(offset),
+  firstRow(-cameraInfo.height / 2), firstCorrectedRow(-cameraInfo.height / 4)
+{
+  // The tables cover half an image above and below the image, so that all
+  // corrected rows that can be inverted are likely to be found.
+  const std::size_t rows = 2 * height + 1;
+  tanX.resize(rows);
+  tanY.resize(rows);
+  correctedRows.resize(rows);
+
+  // The correction angles grow linearly with the row. Therefore, their
+  // tangents can be computed incrementally using the addition theorem.
+  double tx = std::tan((a + b * static_cast<double>(firstRow)) * offset.x());
+  double ty = std::tan((a + b * static_cast<double>(firstRow)) * offset.y());
+  const double dx = std::tan(static_cast<double>(b) * offset.x());
+  const double dy = std::tan(static_cast<double>(b) * offset.y());
+  bool increasing = true;
+  for(std::size_t i = 0; i < rows; ++i)
+  {
+    tanX[i] = static_cast<float>(tx);
+    tanY[i] = static_cast<float>(ty);
+    const float v = (static_cast<float>(firstRow + static_cast<int>(i)) - opticalCenter.y()) / focalLengthHeight;
+    correctedRows[i] = opticalCenter.y() + (v - tanY[i]) / (1.f + v * tanY[i]) * focalLengthHeight;
+    increasing &= i == 0 || correctedRows[i] > correctedRows[i - 1];
+    tx = (tx + dx) / (1. - tx * dx);
+    ty = (ty + dy) / (1. - ty * dy);
+  }
+
+  // Invert the corrected rows. This is only possible if the correction keeps
+  // their order. Otherwise, fromCorrected falls back to iterating.
+  sourceRows.assign(height * 5 / 4 - firstCorrectedRow + 1, std::numeric_limits<float>::quiet_NaN());
+  if(increasing && rows > 1)
+    for(std::size_t i = 0, j = 0; j < sourceRows.size(); ++j)
+    {
+      const float correctedY = static_cast<float>(firstCorrectedRow + static_cast<int>(j));
+      while(i + 2 < rows && correctedRows[i + 1] <= correctedY)
+        ++i;
+      if(correctedRows[i] <= correctedY && correctedY <= correctedRows[i + 1])
+        sourceRows[j] = static_cast<float>(firstRow + static_cast<int>(i))
+                        + (correctedY - correctedRows[i]) / (correctedRows[i + 1] - correctedRows[i]);
+    }
+}
+
+float RollingShutterCorrection::getSourceRow(float correctedY) const
+{
+  const float row = correctedY - static_cast<float>(firstCorrectedRow);
+  const int index = std::min(static_cast<int>(row), static_cast<int>(sourceRows.size()) - 2);
+  if(index >= 0 && !std::isnan(sourceRows[index]) && !std::isnan(sourceRows[index + 1]))
+    return sourceRows[index] + (sourceRows[index + 1] - sourceRows[index]) * (row - static_cast<float>(index));
+
+  // The row cannot be looked up, so the inverse is approximated by iterating.
+  const float w = (correctedY - opticalCenter.y()) / focalLengthHeight;
+  float y = correctedY;
+  for(int i = 0; i < 3; ++i)
+  {
+    float tx, ty;
+    getTangents(y, tx, ty);
+    const float lastY = y;
+    y = opticalCenter.y() + (w + ty) / (1.f - w * ty) * focalLengthHeight;
+    if(std::abs(y - lastY) < 0.5f)
+      break;
+  }
+  return y;
+}
+
+void RollingShutterCorrection::toCorrected(const Vector2f* imageCoords, Vector2f* correctedCoords, std::size_t numOfPoints) const
+{
+  const __m128 centerX = _mm_set1_ps(opticalCenter.x());
+  const __m128 centerY = _mm_set1_ps(opticalCenter.y());
+  const __m128 focalLengthX = _mm_set1_ps(focalLength);
+  const __m128 focalLengthY = _mm_set1_ps(focalLengthHeight);
+  const __m128 one = _mm_set1_ps(1.f);
+
+  std::size_t i = 0;
+  for(; i + 4 <= numOfPoints; i += 4)
+  {
+    alignas(16) float tx[4];
+    alignas(16) float ty[4];
+    for(int j = 0; j < 4; ++j)
+      getTangents(imageCoords[i + j].y(), tx[j], ty[j]);
+    const __m128 tanX = _mm_load_ps(tx);
+    const __m128 tanY = _mm_load_ps(ty);
+
+    const __m128 p01 = _mm_loadu_ps(imageCoords[i].data());
+    const __m128 p23 = _mm_loadu_ps(imageCoords[i + 2].data());
+    const __m128 u = _mm_div_ps(_mm_sub_ps(centerX, _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0))), focalLengthX);
+    const __m128 v = _mm_div_ps(_mm_sub_ps(_mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1)), centerY), focalLengthY);
+    const __m128 x = _mm_sub_ps(centerX, _mm_mul_ps(_mm_div_ps(_mm_sub_ps(u, tanX), _mm_add_ps(one, _mm_mul_ps(u, tanX))), focalLengthX));
+    const __m128 y = _mm_add_ps(centerY, _mm_mul_ps(_mm_div_ps(_mm_sub_ps(v, tanY), _mm_add_ps(one, _mm_mul_ps(v, tanY))), focalLengthY));
+    _mm_storeu_ps(correctedCoords[i].data(), _mm_unpacklo_ps(x, y));
+    _mm_storeu_ps(correctedCoords[i + 2].data(), _mm_unpackhi_ps(x, y));
+  }
+  for(; i < numOfPoints; ++i)
+    correctedCoords[i] = toCorrected(imageCoords[i]);
+}
+
+void RollingShutterCorrection::fromCorrected(const Vector2f* correctedCoords, Vector2f* imageCoords, std::size_t numOfPoints) const
+{
+  const __m128 centerX = _mm_set1_ps(opticalCenter.x());
+  const __m128 focalLengthX = _mm_set1_ps(focalLength);
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 minY = _mm_set1_ps(static_cast<float>(-height / 4));
+  const __m128 maxY = _mm_set1_ps(static_cast<float>(height * 5 / 4));
+
+  std::size_t i = 0;
+  for(; i + 4 <= numOfPoints; i += 4)
+  {
+    alignas(16) float sourceY[4];
+    alignas(16) float tx[4] = {0.f, 0.f, 0.f, 0.f};
+    for(int j = 0; j < 4; ++j)
+    {
+      const float correctedY = correctedCoords[i + j].y();
+      if(correctedY < -height / 4 || correctedY >= height * 5 / 4)
+        sourceY[j] = correctedY; // Will not be changed.
+      else
+      {
+        float ty;
+        sourceY[j] = getSourceRow(correctedY);
+        getTangents(sourceY[j], tx[j], ty);
+      }
+    }
+    const __m128 tanX = _mm_load_ps(tx);
+    const __m128 y = _mm_load_ps(sourceY);
+
+    const __m128 p01 = _mm_loadu_ps(correctedCoords[i].data());
+    const __m128 p23 = _mm_loadu_ps(correctedCoords[i + 2].data());
+    const __m128 correctedX = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 correctedY = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+    const __m128 u = _mm_div_ps(_mm_sub_ps(centerX, correctedX), focalLengthX);
+    const __m128 x = _mm_sub_ps(centerX, _mm_mul_ps(_mm_div_ps(_mm_add_ps(u, tanX), _mm_sub_ps(one, _mm_mul_ps(u, tanX))), focalLengthX));
+
+    // Points that cannot be inverted keep their original x coordinate.
+    const __m128 outside = _mm_or_ps(_mm_cmplt_ps(correctedY, minY), _mm_cmpge_ps(correctedY, maxY));
+    const __m128 resultX = _mm_or_ps(_mm_and_ps(outside, correctedX), _mm_andnot_ps(outside, x));
+    _mm_storeu_ps(imageCoords[i].data(), _mm_unpacklo_ps(resultX, y));
+    _mm_storeu_ps(imageCoords[i + 2].data(), _mm_unpackhi_ps(resultX, y));
+  }
+  for(; i < numOfPoints; ++i)
+    imageCoords[i] = fromCorrected(correctedCoords[i]);
+}
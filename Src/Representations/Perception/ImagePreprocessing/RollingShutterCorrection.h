@@ -0,0 +1,148 @@
+/**
+ * @file RollingShutterCorrection.h
+ * Declaration of a class that compensates the distortion resulting from the
+ * rolling shutter for the parameters of a single image. The correction angles
+ * only depend on the image row. Therefore, their tangents are tabulated per
+ * row, so that correcting a point only requires a few multiplications and a
+ * division. The inverse correction is looked up in a table of source rows per
+ * corrected row instead of being iterated.
+ */
+
+#pragma once
+
+#include "Representations/Infrastructure/CameraInfo.h"
+#include "Math/Eigen.h"
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+class RollingShutterCorrection
+{
+  /** The parameters of the camera and the motion this correction was computed for. */
+  int width;
+  int height;
+  Vector2f opticalCenter;
+  float focalLength;
+  float focalLengthHeight;
+  float a; /**< Constant part of equation to motion distortion. */
+  float b; /**< Linear part of equation to motion distortion. */
+  Vector2f offset; /**< The angular offset between the last camera poses. */
+
+  int firstRow; /**< The image row of the first entry in the per-row tables. */
+  std::vector<float> tanX; /**< The tangent of the horizontal correction angle per row. */
+  std::vector<float> tanY; /**< The tangent of the vertical correction angle per row. */
+  std::vector<float> correctedRows; /**< The corrected y coordinate of each row. */
+
+  int firstCorrectedRow; /**< The corrected row of the first entry in sourceRows. */
+  std::vector<float> sourceRows; /**< The original y coordinate per corrected row. NaN if it cannot be looked up. */
+
+  /**
+   * Determines the tangents of the correction angles in a certain image row.
+   * Rows outside the tables are computed directly.
+   * @param y The y coordinate of the row.
+   * @param tx The tangent of the horizontal correction angle is returned here.
+   * @param ty The tangent of the vertical correction angle is returned here.
+   */
+  void getTangents(float y, float& tx, float& ty) const
+  {
+    const float row = y - static_cast<float>(firstRow);
+    if(row >= 0.f && row < static_cast<float>(tanX.size() - 1))
+    {
+      const int index = static_cast<int>(row);
+      const float fraction = row - static_cast<float>(index);
+      tx = tanX[index] + (tanX[index + 1] - tanX[index]) * fraction;
+      ty = tanY[index] + (tanY[index + 1] - tanY[index]) * fraction;
+    }
+    else
+    {
+      const float factor = a + y * b;
+      tx = std::tan(factor * offset.x());
+      ty = std::tan(factor * offset.y());
+    }
+  }
+
+  /**
+   * Determines the original y coordinate of a corrected point.
+   * @param correctedY The corrected y coordinate. Must lie in the range
+   *                   that can be inverted.
+   * @return The original y coordinate.
+   */
+  float getSourceRow(float correctedY) const;
+
+public:
+  /**
+   * Constructor. Computes the tables.
+   * @param cameraInfo The camera the image was taken with.
+   * @param a Constant part of equation to motion distortion.
+   * @param b Linear part of equation to motion distortion.
+   * @param offset The angular offset between the last camera poses.
+   */
+  RollingShutterCorrection(const CameraInfo& cameraInfo, float a, float b, const Vector2f& offset);
+
+  /**
+   * Was this correction computed for the given parameters?
+   * @param cameraInfo The camera the image was taken with.
+   * @param a Constant part of equation to motion distortion.
+   * @param b Linear part of equation to motion distortion.
+   * @param offset The angular offset between the last camera poses.
+   * @return Does the correction match the parameters?
+   */
+  bool matches(const CameraInfo& cameraInfo, float a, float b, const Vector2f& offset) const
+  {
+    return this->a == a && this->b == b && this->offset == offset
+           && width == cameraInfo.width && height == cameraInfo.height && opticalCenter == cameraInfo.opticalCenter
+           && focalLength == cameraInfo.focalLength && focalLengthHeight == cameraInfo.focalLengthHeight;
+  }
+
+  /**
+   * Corrects image coordinates so that the distortion resulting from the rolling
+   * shutter is compensated. No clipping is done.
+   * @param imageCoords The point in image coordinates.
+   * @return The corrected point.
+   */
+  Vector2f toCorrected(const Vector2f& imageCoords) const
+  {
+    float tx, ty;
+    getTangents(imageCoords.y(), tx, ty);
+    const float u = (opticalCenter.x() - imageCoords.x()) / focalLength;
+    const float v = (imageCoords.y() - opticalCenter.y()) / focalLengthHeight;
+    return Vector2f(opticalCenter.x() - (u - tx) / (1.f + u * tx) * focalLength,
+                    opticalCenter.y() + (v - ty) / (1.f + v * ty) * focalLengthHeight);
+  }
+
+  /**
+   * Inverse of toCorrected. Points too far above or below the image are
+   * returned unchanged, because they cannot be the result of toCorrected.
+   * @param correctedCoords The corrected point in image coordinates.
+   * @return The original point.
+   */
+  Vector2f fromCorrected(const Vector2f& correctedCoords) const
+  {
+    if(correctedCoords.y() < -height / 4 || correctedCoords.y() >= height * 5 / 4)
+      return correctedCoords;
+
+    const float y = getSourceRow(correctedCoords.y());
+    float tx, ty;
+    getTangents(y, tx, ty);
+    const float u = (opticalCenter.x() - correctedCoords.x()) / focalLength;
+    return Vector2f(opticalCenter.x() - (u + tx) / (1.f - u * tx) * focalLength, y);
+  }
+
+  /**
+   * Applies toCorrected to an array of points, four at a time.
+   * @param imageCoords The points in image coordinates.
+   * @param correctedCoords The corrected points are returned here. Can be
+   *                        the same array as imageCoords.
+   * @param numOfPoints The number of points in both arrays.
+   */
+  void toCorrected(const Vector2f* imageCoords, Vector2f* correctedCoords, std::size_t numOfPoints) const;
+
+  /**
+   * Applies fromCorrected to an array of points, four at a time.
+   * @param correctedCoords The corrected points in image coordinates.
+   * @param imageCoords The original points are returned here. Can be the
+   *                    same array as correctedCoords.
+   * @param numOfPoints The number of points in both arrays.
+   */
+  void fromCorrected(const Vector2f* correctedCoords, Vector2f* imageCoords, std::size_t numOfPoints) const;
+};
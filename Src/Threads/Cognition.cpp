@@ -8,6 +8,7 @@
 
 #include "Cognition.h"
 #include "Debugging/DebugRequest.h"
+#include "Framework/LogReplayBarrier.h"
 #include "Framework/Settings.h"
 #include "Modules/Infrastructure/InterThreadProviders/PerceptionProviders.h"
 #include "Modules/Infrastructure/LogDataProvider/LogDataProvider.h"
@@ -15,13 +16,19 @@
 #include "Platform/Thread.h"
 #include "Representations/Communication/BHumanMessageOutputGenerator.h"
 #include "Streaming/Global.h"
+#include "Streaming/InStreams.h"
 
 REGISTER_EXECUTION_UNIT(Cognition)
 
 thread_local bool Cognition::isUpper = false;
+thread_local bool Cognition::fused = false;
 
 Cognition::Cognition()
 {
+  InMapFile stream("cognition.cfg");
+  if(stream.exists())
+    stream >> parameters;
+
   Blackboard::getInstance().alloc<UpperFrameInfo>("UpperFrameInfo").time = minTime;
   Blackboard::getInstance().alloc<LowerFrameInfo>("LowerFrameInfo").time = minTime;
 }
@@ -38,8 +45,12 @@ bool Cognition::beforeFrame()
   const bool replay = (SystemCall::getMode() == SystemCall::logFileReplay || SystemCall::getMode() == SystemCall::remoteRobot)
                       && LogDataProvider::exists();
 
-  // During replay if there is no new frame and no delayed frame, there is nothing to process
-  if(replay && !LogDataProvider::isFrameDataComplete(false) && !delayedLogCounter)
+  // When replaying a log file, the frames of Upper and Lower this frame depends on are known.
+  const bool synchronized = replay && LogReplayBarrier::synchronized();
+
+  // During replay if there is no new frame and no delayed frame, there is nothing to process.
+  // A synchronized frame must also wait until Upper and Lower processed the frames it depends on.
+  if(replay && (!LogDataProvider::isFrameDataComplete(false) || !LogReplayBarrier::inputsPresent()) && !delayedLogCounter)
   {
     acceptNext = false;
     return false;
@@ -56,8 +67,9 @@ bool Cognition::beforeFrame()
   lastLowerFrameTime = lowerFrameTime;
 
   // Begin a new frame if either there is data for a new one left over from
-  // the previous frame or we have two from which we can choose.
-  if(acceptNext || (upperIsNew && lowerIsNew) || (upperIsNew && lowerIsLate) || (lowerIsNew && upperIsLate))
+  // the previous frame or we have two from which we can choose. A synchronized
+  // frame has all its data.
+  if(synchronized || acceptNext || (upperIsNew && lowerIsNew) || (upperIsNew && lowerIsLate) || (lowerIsNew && upperIsLate))
   {
     // The frame will be processed, so no delay and no data waiting anymore
     delayedLogCounter = 0;
@@ -66,8 +78,22 @@ bool Cognition::beforeFrame()
     if(replay)
       LogDataProvider::isFrameDataComplete();
 
-    // We switch between upper and lower except if one of them is really late
-    if(upperIsLate)
+    // If configured, a pair of new frames from both cameras is processed
+    // together. The newer one determines the time of the frame.
+    fused = parameters.fuseCameras && upperIsNew && lowerIsNew && !upperIsLate && !lowerIsLate;
+    if(fused)
+    {
+      isUpper = static_cast<int>(upperFrameTime - lowerFrameTime) >= 0;
+      lastAcceptedTime = isUpper ? upperFrameTime : lowerFrameTime;
+      upperIsNew = lowerIsNew = acceptNext = false;
+      return true;
+    }
+
+    // We switch between upper and lower except if one of them is really late.
+    // A synchronized frame uses the camera that provided new data if only one did.
+    if(synchronized && upperIsNew != lowerIsNew)
+      isUpper = upperIsNew;
+    else if(upperIsLate)
       isUpper = false;
     else if(lowerIsLate)
       isUpper = true;
@@ -97,10 +123,9 @@ bool Cognition::beforeFrame()
   }
   else if(replay)
   {
-    // Give Upper and Lower time to process the data. However, since logs can be
-    // replayed at different speeds, this code is not bullet-proof. There must
-    // be a timeout, because a frame from Upper or Lower can actually be missing
-    // and the log would get stuck.
+    // When data is streamed from a remote robot, give Upper and Lower time to
+    // process it. There must be a timeout, because a frame from Upper or Lower
+    // can actually be missing.
     Thread::sleep(3);
     if(++delayedLogCounter >= 11)
     {
@@ -114,6 +139,11 @@ bool Cognition::beforeFrame()
   return false;
 }
 
+std::vector<std::string> Cognition::getReplayInputs() const
+{
+  return {"Upper", "Lower"};
+}
+
 void Cognition::beforeModules()
 {
   BHExecutionUnit::beforeModules();
@@ -128,6 +158,7 @@ void Cognition::beforeModules()
 
 void Cognition::afterModules()
 {
+  BHExecutionUnit::afterModules();
   if(Blackboard::getInstance().exists("BHumanMessageOutputGenerator")
      && static_cast<const BHumanMessageOutputGenerator&>(Blackboard::getInstance()["BHumanMessageOutputGenerator"]).send
      && static_cast<const BHumanMessageOutputGenerator&>(Blackboard::getInstance()["BHumanMessageOutputGenerator"]).sendThisFrame
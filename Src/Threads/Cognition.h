@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "Streaming/AutoStreamable.h"
 #include "Tools/Framework/BHExecutionUnit.h"
 
 /**
@@ -18,6 +19,11 @@
 class Cognition : public BHExecutionUnit
 {
 private:
+  STREAMABLE(Parameters,
+  {,
+    (bool)(false) fuseCameras, /**< Process a pair of upper and lower frames in a single frame? */
+  });
+
   static const unsigned minTime = 100000; /**< The earliest time used. */
   unsigned lastUpperFrameTime = minTime; /**< The last timestamp received from the upper camera thread. */
   unsigned lastLowerFrameTime = minTime; /**< The last timestamp received from the lower camera thread. */
@@ -26,12 +32,15 @@ private:
   bool lowerIsNew = false; /**< The is unused data from the lower camera thread. */
   bool acceptNext = false; /**< Immediately process the frame still waiting. */
   int delayedLogCounter = 0; /**< How many cycles is the acknowledgement of received log data already delayed? */
+  Parameters parameters; /**< The parameters of this execution unit, read from cognition.cfg. */
 
 public:
   thread_local static bool isUpper; /**< The current frame picked is from the upper camera thread. */
+  thread_local static bool fused; /**< The current frame also contains the older frame of the other camera thread. */
 
   Cognition();
   ~Cognition();
+  std::vector<std::string> getReplayInputs() const override;
   bool beforeFrame() override;
   void beforeModules() override;
   void afterModules() override;
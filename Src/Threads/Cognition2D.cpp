@@ -20,6 +20,7 @@ bool Cognition2D::beforeFrame()
 
 void Cognition2D::afterModules()
 {
+  BHExecutionUnit::afterModules();
   if(Blackboard::getInstance().exists("BHumanMessageOutputGenerator")
      && static_cast<const BHumanMessageOutputGenerator&>(Blackboard::getInstance()["BHumanMessageOutputGenerator"]).send
      && static_cast<const BHumanMessageOutputGenerator&>(Blackboard::getInstance()["BHumanMessageOutputGenerator"]).sendThisFrame
@@ -25,6 +25,7 @@ bool Motion::beforeFrame()
 
 void Motion::afterModules()
 {
+  BHExecutionUnit::afterModules();
   NaoProvider::finishFrame();
   BoosterProvider::finishFrame();
 }
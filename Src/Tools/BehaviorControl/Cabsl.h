@@ -383,7 +383,7 @@ namespace cabsl
         optionsByName = new std::unordered_map<std::string, const OptionDescriptor*>;
         static OptionDescriptor descriptor("none", 0, 0);
         (*optionsByName)[descriptor.name] = &descriptor;
-        TypeRegistry::addEnum(typeid(Option).name());
+        TypeRegistry::addEnum(TypeRegistry::addType<Option>());
         TypeRegistry::addEnumConstant(typeid(Option).name(), "none");
       }
 
@@ -19,7 +19,7 @@ Role::Type Role::Type_Info::numOfElements = Role::none;
 void Role::Type_Info::reg()
 {
   PUBLISH(reg);
-  const char* _type = typeid(Type).name();
+  const char* _type = TypeRegistry::addType<Type>();
   TypeRegistry::addEnum(_type);
   TypeRegistry::addEnumConstant(_type, "none");
   unsigned counter = 1;
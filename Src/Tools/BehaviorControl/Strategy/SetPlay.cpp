@@ -25,7 +25,7 @@ SetPlay::Type SetPlay::Type_Info::numOfElements = SetPlay::none;
 void SetPlay::Type_Info::reg()
 {
   PUBLISH(reg);
-  const char* _type = typeid(Type).name();
+  const char* _type = TypeRegistry::addType<Type>();
   TypeRegistry::addEnum(_type);
   TypeRegistry::addEnumConstant(_type, "none");
   unsigned counter = 1;
@@ -21,7 +21,7 @@ template<typename Message>
 struct BHumanCompressedMessageParticle : public BHumanMessageParticle
 {
   BHumanCompressedMessageParticle() :
-    _typeName("the" + TypeRegistry::demangle(typeid(Message).name()))
+    _typeName(std::string("the") + TypeRegistry::getName<Message>())
   {}
 
   void operator>>(BHumanMessage& m) const override
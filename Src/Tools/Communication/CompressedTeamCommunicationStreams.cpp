@@ -1212,7 +1212,7 @@ void CompressedTeamCommunicationIn::inUChar(unsigned char& value)
   {
     const auto* type = TYPE_CAST<const CompressedTeamCommunication::EnumType*>(entry.dataType);
     ASSERT(type);
-    ASSERT(!check || type->name == TypeRegistry::demangle(entry.enumType));
+    ASSERT(!check || type->name == TypeRegistry::getName(entry.enumType));
     value = 0;
     readBits(&value, type->bits ? type->bits : sizeof(unsigned char) * 8);
   }
@@ -1446,7 +1446,7 @@ void CompressedTeamCommunicationOut::outUChar(unsigned char value)
   {
     const auto* type = TYPE_CAST<const CompressedTeamCommunication::EnumType*>(entry.dataType);
     ASSERT(type);
-    ASSERT(!check || type->name == TypeRegistry::demangle(entry.enumType));
+    ASSERT(!check || type->name == TypeRegistry::getName(entry.enumType));
     writeBits(&value, type->bits ? type->bits : sizeof(unsigned char) * 8);
   }
   else
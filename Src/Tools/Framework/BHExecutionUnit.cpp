@@ -9,6 +9,7 @@
 #include "BHExecutionUnit.h"
 #include "Tools/Framework/BHLoggingController.h"
 #include "Debugging/Annotation.h"
+#include "Debugging/Plot.h"
 #include "Framework/Blackboard.h"
 #include "Framework/Configuration.h"
 #include "Streaming/TypeRegistry.h"
@@ -41,3 +42,12 @@ void BHExecutionUnit::beforeModules()
     lastGameState = gameState.state;
   }
 }
+
+void BHExecutionUnit::afterModules()
+{
+  const ImageBufferPool::Statistics statistics = ImageBufferPool::getStatistics();
+  PLOT("thread:ImageBufferPool:hits", statistics.hits - lastImageBufferPoolStatistics.hits);
+  PLOT("thread:ImageBufferPool:misses", statistics.misses - lastImageBufferPoolStatistics.misses);
+  PLOT("thread:ImageBufferPool:cachedBytes", statistics.cachedBytes);
+  lastImageBufferPoolStatistics = statistics;
+}
@@ -8,6 +8,7 @@
 
 #include "Representations/Infrastructure/GameState.h"
 #include "Framework/FrameExecutionUnit.h"
+#include "ImageProcessing/ImageBufferPool.h"
 #include <string>
 
 class LoggingController;
@@ -20,6 +21,11 @@ protected:
    */
   void beforeModules() override;
 
+  /**
+   * This method plots how many image buffers were taken from the pool of this thread or had to be allocated in this frame.
+   */
+  void afterModules() override;
+
 private:
   /**
    * This function determines if this thread is the first thread in the config which provides the representation \c GameState.
@@ -31,4 +37,5 @@ private:
   const LoggingController* initLogging(const Configuration& config, const std::size_t index) override;
 
   GameState::State lastGameState = GameState::beforeHalf; /**< Game state in the last frame (for annotation). */
+  ImageBufferPool::Statistics lastImageBufferPoolStatistics; /**< The usage of the image buffer pool after the last frame (for plots). */
 };
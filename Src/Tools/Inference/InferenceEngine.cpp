@@ -0,0 +1,619 @@
+/**
+ * @file InferenceEngine.cpp
+ *
+ * This file implements a class that runs a neural network with one of several
+ * backends.
+ */
+
+#include "InferenceEngine.h"
+#include "CompiledNN/CompiledNN.h"
+#include "CompiledNN/Model.h"
+#include "CompiledNN2ONNX/CompiledNN.h"
+#include "CompiledNN2ONNX/Model.h"
+#include "Platform/BHAssert.h"
+#include "Platform/File.h"
+#include "Platform/SystemCall.h"
+#include "Platform/Thread.h"
+#include "Streaming/Global.h"
+#include "Streaming/InStreams.h"
+#include "Streaming/Output.h"
+#include "Streaming/TypeRegistry.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <unordered_map>
+#include <unordered_set>
+
+/** The interface of the backends. */
+class InferenceEngine::Network
+{
+public:
+  std::vector<TensorInfo> inputs; /**< The inputs of the network. */
+  std::vector<TensorInfo> outputs; /**< The outputs of the network. */
+
+  virtual ~Network() = default;
+
+  /** Runs the network on the current inputs. */
+  virtual void apply() = 0;
+
+  /**
+   * Sets the number of samples processed at once. The inputs and outputs
+   * then contain that many samples one after another.
+   * @param batchSize The number of samples.
+   * @return Does the backend support this batch size?
+   */
+  virtual bool setBatchSize(std::size_t batchSize) {return batchSize == 1;}
+};
+
+/**
+ * A backend based on CompiledNN or on the ONNX runtime wrapper that mimics
+ * CompiledNN.
+ * @tparam CompiledNN The class that runs the network.
+ * @tparam Model The class that describes the network.
+ */
+template<typename CompiledNN, typename Model> class InferenceEngine::NetworkImpl : public Network
+{
+  CompiledNN network; /**< The network run. */
+
+  /**
+   * Determines the shape and location of a tensor of the network.
+   * @param tensor The tensor.
+   * @param isUInt8 Are the values encoded as unsigned chars?
+   * @return The shape and location.
+   */
+  template<typename T> static TensorInfo getInfo(T&& tensor, bool isUInt8)
+  {
+    TensorInfo info{tensor.data(), tensor.size(), {}, isUInt8};
+    for(unsigned i = 0; i < tensor.rank(); ++i)
+      info.dimensions.push_back(tensor.dims(i));
+    return info;
+  }
+
+public:
+  /**
+   * Constructor. Loads and compiles the network.
+   * @param filename The path of the model.
+   * @param options The options of the module using the network.
+   * @param settings The compilation settings.
+   */
+  template<typename CompilationSettings>
+  NetworkImpl(const std::string& filename, const Options& options, const CompilationSettings& settings) :
+    network(&Global::getAsmjitRuntime())
+  {
+    Model model(filename);
+    for(std::size_t index : options.uint8Inputs)
+      model.setInputUInt8(index);
+    network.compile(model, settings);
+    if(network.valid())
+    {
+      for(std::size_t i = 0; i < network.numOfInputs(); ++i)
+        inputs.emplace_back(getInfo(network.input(i),
+                                    std::find(options.uint8Inputs.begin(), options.uint8Inputs.end(), i) != options.uint8Inputs.end()));
+      for(std::size_t i = 0; i < network.numOfOutputs(); ++i)
+        outputs.emplace_back(getInfo(network.output(i), false));
+    }
+  }
+
+  bool valid() const {return network.valid();}
+
+  void apply() override {network.apply();}
+
+  bool setBatchSize(std::size_t batchSize) override
+  {
+    if constexpr(requires {network.setBatchSize(batchSize);})
+    {
+      if(!network.setBatchSize(batchSize))
+        return false;
+
+      // The tensors were reallocated.
+      for(std::size_t i = 0; i < inputs.size(); ++i)
+        inputs[i] = getInfo(network.input(i), inputs[i].isUInt8);
+      for(std::size_t i = 0; i < outputs.size(); ++i)
+        outputs[i] = getInfo(network.output(i), false);
+      return true;
+    }
+    else
+      return batchSize == 1;
+  }
+};
+
+/**
+ * Runs a network for several instances of the InferenceEngine at once. A
+ * request that arrives while no batch is processed is run immediately,
+ * together with all others that are already waiting. Requests that arrive
+ * while a batch is processed wait for it and are combined into the next
+ * batch. Nobody waits for instances that do not run the network.
+ */
+class InferenceEngine::Batcher
+{
+  /** A request of an instance to run the network. */
+  struct Request
+  {
+    const std::vector<TensorInfo>& inputs; /**< The inputs of the instance. */
+    const std::vector<TensorInfo>& outputs; /**< The outputs of the instance that receive the results. */
+    bool done = false; /**< Was the request processed? */
+  };
+
+  std::unique_ptr<Network> network; /**< The network processing the batches. */
+  std::vector<std::size_t> inputSizes; /**< The number of values of each input of a single sample. */
+  std::vector<std::size_t> outputSizes; /**< The number of values of each output of a single sample. */
+  std::size_t batchSize = 0; /**< The batch size the network is currently set to. */
+  std::mutex mutex; /**< Synchronizes the instances. */
+  std::condition_variable processed; /**< Signals that a batch was processed. */
+  std::vector<Request*> pending; /**< The requests for the next batch. */
+  bool running = false; /**< Is a batch being processed? */
+  std::size_t largestBatchSize = 0; /**< The largest number of requests processed together so far. */
+
+  /**
+   * Copies the values of a single sample from one tensor to another.
+   * @param from The source tensor.
+   * @param fromSlot The position of the sample in the source tensor.
+   * @param to The target tensor.
+   * @param toSlot The position of the sample in the target tensor.
+   * @param size The number of values of a single sample.
+   */
+  static void copy(const TensorInfo& from, std::size_t fromSlot, const TensorInfo& to, std::size_t toSlot, std::size_t size)
+  {
+    if(from.isUInt8)
+      std::memcpy(reinterpret_cast<unsigned char*>(to.data) + toSlot * size,
+                  reinterpret_cast<const unsigned char*>(from.data) + fromSlot * size, size);
+    else
+      std::memcpy(to.data + toSlot * size, from.data + fromSlot * size, size * sizeof(float));
+  }
+
+  /**
+   * Processes a batch of requests.
+   * @param batch The requests.
+   */
+  void process(const std::vector<Request*>& batch)
+  {
+    if(batch.size() != batchSize)
+    {
+      VERIFY(network->setBatchSize(batch.size()));
+      batchSize = batch.size();
+    }
+    for(std::size_t slot = 0; slot < batch.size(); ++slot)
+      for(std::size_t i = 0; i < inputSizes.size(); ++i)
+        copy(batch[slot]->inputs[i], 0, network->inputs[i], slot, inputSizes[i]);
+    network->apply();
+    for(std::size_t slot = 0; slot < batch.size(); ++slot)
+      for(std::size_t i = 0; i < outputSizes.size(); ++i)
+        copy(network->outputs[i], slot, batch[slot]->outputs[i], 0, outputSizes[i]);
+    largestBatchSize = std::max(largestBatchSize, batch.size());
+  }
+
+public:
+  bool usable = false; /**< Does the network support batches that do not change its outputs? */
+
+  /**
+   * Constructor. Checks whether batches change the outputs of the network.
+   * @param network The network that will process the batches.
+   */
+  Batcher(std::unique_ptr<Network> network) :
+    network(std::move(network))
+  {
+    if(!this->network || !this->network->setBatchSize(1))
+      return;
+    for(const TensorInfo& input : this->network->inputs)
+      inputSizes.push_back(input.size);
+    for(const TensorInfo& output : this->network->outputs)
+      outputSizes.push_back(output.size);
+
+    // The results of each sample must be exactly the same as when it is
+    // processed alone. This is checked with random inputs.
+    constexpr std::size_t numOfSamples = 3;
+    const std::vector<std::vector<float>> samples = createRandomSamples(this->network->inputs, numOfSamples);
+    std::vector<std::vector<float>> expected;
+    for(const std::vector<float>& sample : samples)
+    {
+      setInputs(this->network->inputs, sample);
+      this->network->apply();
+      expected.emplace_back();
+      for(const TensorInfo& output : this->network->outputs)
+        expected.back().insert(expected.back().end(), output.data, output.data + output.size);
+    }
+
+    if(!this->network->setBatchSize(numOfSamples))
+      return;
+    batchSize = numOfSamples;
+    for(std::size_t slot = 0; slot < numOfSamples; ++slot)
+      setInputs(this->network->inputs, samples[slot], slot, numOfSamples);
+    this->network->apply();
+    usable = true;
+    for(std::size_t slot = 0; slot < numOfSamples; ++slot)
+    {
+      const float* values = expected[slot].data();
+      for(std::size_t i = 0; i < outputSizes.size(); ++i)
+      {
+        usable &= std::memcmp(this->network->outputs[i].data + slot * outputSizes[i], values, outputSizes[i] * sizeof(float)) == 0;
+        values += outputSizes[i];
+      }
+    }
+  }
+
+  /**
+   * Runs the network for an instance as part of the next batch. Returns
+   * after the batch was processed.
+   * @param inputs The inputs of the instance.
+   * @param outputs The outputs of the instance that receive the results.
+   */
+  void apply(const std::vector<TensorInfo>& inputs, const std::vector<TensorInfo>& outputs)
+  {
+    Request request{inputs, outputs};
+    std::unique_lock<std::mutex> lock(mutex);
+    pending.push_back(&request);
+    processed.wait(lock, [this, &request] {return request.done || !running;});
+    if(!request.done)
+    {
+      // This request processes all requests waiting, including itself.
+      std::vector<Request*> batch;
+      batch.swap(pending);
+      running = true;
+      lock.unlock();
+      process(batch);
+      lock.lock();
+      running = false;
+      for(Request* processedRequest : batch)
+        processedRequest->done = true;
+      processed.notify_all();
+    }
+  }
+
+  /**
+   * Returns the largest number of requests that were processed together.
+   * @return The largest batch size so far.
+   */
+  std::size_t getLargestBatchSize()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    return largestBatchSize;
+  }
+};
+
+InferenceEngine::Tensor& InferenceEngine::Tensor::operator=(const Tensor& other)
+{
+  ASSERT(size() == other.size());
+  std::copy(other.begin(), other.end(), begin());
+  return *this;
+}
+
+InferenceEngine::InferenceEngine() = default;
+
+InferenceEngine::~InferenceEngine() = default;
+
+const InferenceEngine::Settings& InferenceEngine::getSettings()
+{
+  static const Settings settings = []
+  {
+    Settings settings;
+    InMapFile stream("inference.cfg");
+    ASSERT(stream.exists());
+    stream >> settings;
+    return settings;
+  }();
+  return settings;
+}
+
+std::unique_ptr<InferenceEngine::Network> InferenceEngine::create(Backend backend, const std::string& filename, const Options& options) const
+{
+  std::unique_ptr<Network> network;
+  if(backend == compiledNN)
+  {
+    // CompiledNN runs the original model. On ARM, it is replaced by the ONNX
+    // runtime, which then runs the .onnx variant.
+    if(filename.ends_with(".onnx") || !File(filename, "rb", false).exists())
+      return nullptr;
+    NeuralNetwork::CompilationSettings settings;
+    settings.useExpApproxInSigmoid = options.useExpApprox;
+    settings.useExpApproxInTanh = options.useExpApprox;
+#if defined MACOS && defined __arm64__
+    settings.useCoreML = true;
+#endif
+    auto* impl = new NetworkImpl<NeuralNetwork::CompiledNN, NeuralNetwork::Model>(filename, options, settings);
+    network.reset(impl);
+    if(!impl->valid())
+      network.reset();
+  }
+  else
+  {
+    const std::string onnxFilename = base + (backend == onnxInt8 ? ".int8.onnx" : ".onnx");
+    if(!File(onnxFilename, "rb", false).exists())
+      return nullptr;
+
+    // A variant the runtime cannot load is skipped instead of terminating.
+    try
+    {
+      auto* impl = new NetworkImpl<NeuralNetworkONNX::CompiledNN, NeuralNetworkONNX::Model>(onnxFilename, options,
+                                                                                             NeuralNetworkONNX::CompilationSettings());
+      network.reset(impl);
+      if(!impl->valid())
+        network.reset();
+    }
+    catch(const std::exception& e)
+    {
+      OUTPUT_WARNING("InferenceEngine: Cannot load " << onnxFilename << ": " << e.what());
+    }
+  }
+  return network;
+}
+
+void InferenceEngine::load(const std::string& filename, const Options& options)
+{
+  // Process-wide choices of backends per network, so that each network is
+  // only benchmarked once, even if it is used by several threads.
+  static std::unordered_map<std::string, Backend> choices;
+  static std::mutex mutex;
+
+  batcher.reset();
+  network.reset();
+  inputs.clear();
+  outputs.clear();
+  backend = numOfBackends;
+  base = filename.substr(0, filename.find_last_of('.'));
+  if(base.ends_with(".int8"))
+    base.resize(base.size() - 5);
+  const std::size_t nameStart = base.find("NeuralNets/");
+  const std::string name = nameStart == std::string::npos ? base : base.substr(nameStart + 11);
+
+  const Settings& settings = getSettings();
+  const std::vector<Backend>* backends = &settings.backends;
+  float tolerance = settings.tolerance;
+  for(const NetworkSettings& networkSettings : settings.networks)
+    if(networkSettings.name == name)
+    {
+      backends = &networkSettings.backends;
+      tolerance = networkSettings.tolerance;
+      break;
+    }
+
+  // Only the ONNX runtime supports batches, so it is preferred by instances
+  // that batch. Motion must never wait for other threads.
+  const bool batch = settings.batchInSimulation && SystemCall::getMode() == SystemCall::simulatedRobot
+                     && Thread::getCurrentThreadName() != "Motion";
+  std::vector<Backend> batchBackends;
+  if(batch && std::find(backends->begin(), backends->end(), onnx) != backends->end())
+  {
+    batchBackends = *backends;
+    std::stable_partition(batchBackends.begin(), batchBackends.end(), [](Backend backend) {return backend == onnx;});
+    backends = &batchBackends;
+  }
+  const std::string choiceKey = batch ? name + "|batch" : name;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto choice = choices.find(choiceKey);
+  if(choice != choices.end())
+  {
+    network = create(choice->second, filename, options);
+    backend = choice->second;
+  }
+  else
+  {
+    std::vector<std::pair<Backend, std::unique_ptr<Network>>> candidates;
+    for(Backend candidate : *backends)
+    {
+      std::unique_ptr<Network> candidateNetwork = create(candidate, filename, options);
+      if(candidateNetwork)
+      {
+        candidates.emplace_back(candidate, std::move(candidateNetwork));
+        if(!settings.autotune)
+          break;
+      }
+    }
+    if(candidates.empty())
+    {
+      OUTPUT_WARNING("InferenceEngine: No backend available for " << name);
+      return;
+    }
+
+    const std::size_t index = candidates.size() > 1 ? autotune(candidates, tolerance, settings, name) : 0;
+    backend = candidates[index].first;
+    network = std::move(candidates[index].second);
+    choices[choiceKey] = backend;
+  }
+
+  if(network)
+  {
+    inputs = network->inputs;
+    outputs = network->outputs;
+    if(batch)
+      joinBatches(filename, options, settings, name);
+  }
+}
+
+void InferenceEngine::joinBatches(const std::string& filename, const Options& options, const Settings& settings, const std::string& name)
+{
+  // The batchers exist as long as instances use them. Networks whose
+  // outputs change in batches are only checked once.
+  static std::unordered_map<std::string, std::weak_ptr<Batcher>> batchers;
+  static std::unordered_set<std::string> unbatchable;
+  static std::mutex mutex;
+
+  std::string key = name + "|" + TypeRegistry::getEnumName(backend);
+  for(std::size_t index : options.uint8Inputs)
+    key += "|" + std::to_string(index);
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if(unbatchable.contains(key))
+    return;
+  batcher = batchers[key].lock();
+  if(!batcher)
+  {
+    batcher = std::make_shared<Batcher>(create(backend, filename, options));
+    if(!batcher->usable)
+    {
+      OUTPUT_TEXT("InferenceEngine: " << name << " (" << TypeRegistry::getEnumName(backend) << ") cannot be run in batches");
+      unbatchable.insert(key);
+      batcher.reset();
+      return;
+    }
+    batchers[key] = batcher;
+  }
+}
+
+std::size_t InferenceEngine::autotune(std::vector<std::pair<Backend, std::unique_ptr<Network>>>& candidates, float tolerance,
+                                      const Settings& settings, const std::string& name)
+{
+  // The float variant preferred is the reference for the accuracy.
+  std::size_t reference = 0;
+  while(reference < candidates.size() && candidates[reference].first == onnxInt8)
+    ++reference;
+  if(reference == candidates.size())
+    reference = 0;
+  const Network& referenceNetwork = *candidates[reference].second;
+
+  std::size_t sampleSize = 0;
+  for(const TensorInfo& input : referenceNetwork.inputs)
+    sampleSize += input.size;
+
+  // Compare the backends on recorded inputs if available. Otherwise, random
+  // inputs are used, which only allows a rough comparison.
+  std::vector<std::vector<float>> samples;
+  File file(base + ".inputs", "rb", false);
+  if(file.exists() && sampleSize > 0)
+  {
+    const std::size_t numOfSamples = std::min<std::size_t>(file.getSize() / (sampleSize * sizeof(float)), settings.maxSamples);
+    samples.resize(numOfSamples, std::vector<float>(sampleSize));
+    for(std::vector<float>& sample : samples)
+      file.read(sample.data(), sampleSize * sizeof(float));
+  }
+  if(samples.empty())
+    samples = createRandomSamples(referenceNetwork.inputs, std::max(1u, std::min(settings.maxSamples, 8u)));
+
+  std::vector<std::vector<float>> referenceOutputs;
+  for(const std::vector<float>& sample : samples)
+  {
+    Network& network = *candidates[reference].second;
+    setInputs(network.inputs, sample);
+    network.apply();
+    referenceOutputs.emplace_back();
+    for(const TensorInfo& output : network.outputs)
+      referenceOutputs.back().insert(referenceOutputs.back().end(), output.data, output.data + output.size);
+  }
+
+  std::size_t best = reference;
+  float bestDuration = std::numeric_limits<float>::max();
+  for(std::size_t i = 0; i < candidates.size(); ++i)
+  {
+    Network& network = *candidates[i].second;
+    bool compatible = network.inputs.size() == referenceNetwork.inputs.size()
+                      && network.outputs.size() == referenceNetwork.outputs.size();
+    for(std::size_t j = 0; compatible && j < network.inputs.size(); ++j)
+      compatible = network.inputs[j].size == referenceNetwork.inputs[j].size;
+    for(std::size_t j = 0; compatible && j < network.outputs.size(); ++j)
+      compatible = network.outputs[j].size == referenceNetwork.outputs[j].size;
+    if(!compatible)
+    {
+      OUTPUT_WARNING("InferenceEngine: " << name << " (" << TypeRegistry::getEnumName(candidates[i].first) << ") does not match the reference");
+      continue;
+    }
+
+    float deviation = 0.f;
+    for(std::size_t j = 0; j < samples.size(); ++j)
+    {
+      setInputs(network.inputs, samples[j]);
+      network.apply();
+      const float* expected = referenceOutputs[j].data();
+      for(const TensorInfo& output : network.outputs)
+        for(std::size_t k = 0; k < output.size; ++k)
+          deviation = std::max(deviation, std::abs(output.data[k] - *expected++));
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    for(unsigned j = 0; j < settings.benchmarkRuns; ++j)
+    {
+      setInputs(network.inputs, samples[j % samples.size()]);
+      network.apply();
+    }
+    const float duration = std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count()
+                           / static_cast<float>(std::max(1u, settings.benchmarkRuns));
+
+    OUTPUT_TEXT("InferenceEngine: " << name << " (" << TypeRegistry::getEnumName(candidates[i].first) << "): "
+                << duration << " µs, deviation " << deviation);
+    if((i == reference || deviation <= tolerance) && duration < bestDuration)
+    {
+      best = i;
+      bestDuration = duration;
+    }
+  }
+
+  OUTPUT_TEXT("InferenceEngine: " << name << " uses " << TypeRegistry::getEnumName(candidates[best].first));
+  return best;
+}
+
+std::vector<std::vector<float>> InferenceEngine::createRandomSamples(const std::vector<TensorInfo>& inputs, std::size_t numOfSamples)
+{
+  std::size_t sampleSize = 0;
+  for(const TensorInfo& input : inputs)
+    sampleSize += input.size;
+
+  std::mt19937 generator(0);
+  std::vector<std::vector<float>> samples(numOfSamples, std::vector<float>(sampleSize));
+  for(std::vector<float>& sample : samples)
+  {
+    float* p = sample.data();
+    for(const TensorInfo& input : inputs)
+    {
+      std::uniform_real_distribution<float> distribution(0.f, input.isUInt8 ? 255.f : 1.f);
+      for(std::size_t i = 0; i < input.size; ++i)
+        *p++ = input.isUInt8 ? std::round(distribution(generator)) : distribution(generator);
+    }
+  }
+  return samples;
+}
+
+void InferenceEngine::setInputs(const std::vector<TensorInfo>& inputs, const std::vector<float>& sample,
+                                std::size_t slot, std::size_t batchSize)
+{
+  const float* p = sample.data();
+  for(const TensorInfo& input : inputs)
+  {
+    const std::size_t size = input.size / batchSize;
+    if(input.isUInt8)
+      std::transform(p, p + size, reinterpret_cast<unsigned char*>(input.data) + slot * size,
+                     [](float value) {return static_cast<unsigned char>(value);});
+    else
+      std::copy(p, p + size, input.data + slot * size);
+    p += size;
+  }
+}
+
+std::size_t InferenceEngine::getLargestBatchSize() const
+{
+  return batcher ? batcher->getLargestBatchSize() : 0;
+}
+
+void InferenceEngine::apply()
+{
+  ASSERT(network);
+  const Settings& settings = getSettings();
+  if(settings.recordInterval && runs++ % settings.recordInterval == 0 && recordedInputs < settings.maxRecordedInputs)
+    recordInputs();
+  if(batcher)
+    batcher->apply(inputs, outputs);
+  else
+    network->apply();
+}
+
+void InferenceEngine::recordInputs()
+{
+  File file(base + ".inputs", "ab", false);
+  if(!file.exists())
+    return;
+
+  std::vector<float> sample;
+  for(const TensorInfo& input : inputs)
+    if(input.isUInt8)
+    {
+      const unsigned char* data = reinterpret_cast<const unsigned char*>(input.data);
+      sample.insert(sample.end(), data, data + input.size);
+    }
+    else
+      sample.insert(sample.end(), input.data, input.data + input.size);
+  file.write(sample.data(), sample.size() * sizeof(float));
+  ++recordedInputs;
+}
@@ -0,0 +1,256 @@
+/**
+ * @file InferenceEngine.h
+ *
+ * This file declares a class that runs a neural network with one of several
+ * backends. A network is given as the path of its model. Variants of the
+ * model are found next to it by their extensions: the original model (e.g.
+ * .h5) is run by CompiledNN, "<name>.onnx" by the ONNX runtime, and
+ * "<name>.int8.onnx" is an int8-quantized variant for the ONNX runtime.
+ * Which variant is used is configured in inference.cfg. If autotuning is
+ * enabled, all variants are benchmarked when the network is loaded and the
+ * fastest one whose outputs stay within a tolerance of the float reference
+ * is selected. The selection is shared by all instances of the same network.
+ * Inputs can be recorded to "<name>.inputs" to calibrate quantized variants
+ * and to compare variants on real data.
+ * In simulation, the runs of the same network by all robots that happen at
+ * the same time can be combined into batches that are processed at once by
+ * a network shared by all of them.
+ */
+
+#pragma once
+
+#include "Streaming/AutoStreamable.h"
+#include "Streaming/Enum.h"
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+class InferenceEngine
+{
+public:
+  /** The backends and precisions a network can be run with. */
+  ENUM(Backend,
+  {,
+    compiledNN, /**< The original model run by CompiledNN. */
+    onnx, /**< The .onnx model run by the ONNX runtime. */
+    onnxInt8, /**< The .int8.onnx model run by the ONNX runtime. */
+  });
+
+  /** The settings of a single network. */
+  STREAMABLE(NetworkSettings,
+  {,
+    (std::string) name, /**< The path of the model relative to Config/NeuralNets without extension. */
+    (std::vector<Backend>) backends, /**< The backends that may be used, preferred first. */
+    (float) tolerance, /**< The maximum deviation of an output from the float reference. */
+  });
+
+  /** The settings of all networks, read from inference.cfg. */
+  STREAMABLE(Settings,
+  {,
+    (bool) autotune, /**< Benchmark the backends when loading a network? Otherwise, the first one available is used. */
+    (unsigned) benchmarkRuns, /**< How often is each backend run when autotuning? */
+    (unsigned) maxSamples, /**< The maximum number of recorded inputs used to compare backends. */
+    (std::vector<Backend>) backends, /**< The backends that may be used by networks not listed, preferred first. */
+    (float) tolerance, /**< The maximum deviation of an output from the float reference for networks not listed. */
+    (std::vector<NetworkSettings>) networks, /**< Networks with specific settings. */
+    (unsigned) recordInterval, /**< Record the inputs of every nth run of each network (0 = never). */
+    (unsigned) maxRecordedInputs, /**< The maximum number of inputs recorded per network and run of the program. */
+    (bool) batchInSimulation, /**< Combine the runs of the same network by all simulated robots into batches? */
+  });
+
+  /** Options that are defined by the module using a network. */
+  struct Options
+  {
+    std::vector<std::size_t> uint8Inputs; /**< The inputs that are encoded as unsigned chars. */
+    bool useExpApprox = true; /**< Use approximations of exp in sigmoid and tanh? Only supported by CompiledNN. */
+  };
+
+  /**
+   * A view on an input or output of the network. It behaves like the tensors
+   * returned by CompiledNN, i.e. it supports data(), rank(), dims(), array
+   * access, iteration, and copying the data from one tensor to another.
+   */
+  class Tensor : public std::span<float>
+  {
+    const std::vector<unsigned>& dimensions; /**< The dimensions (shape) of the tensor without the batch dimension. */
+
+  public:
+    /**
+     * Constructor.
+     * @param data The actual tensor data.
+     * @param size The overall number of values in the tensor.
+     * @param dimensions The dimensions (shape) of the tensor.
+     */
+    Tensor(float* data, std::size_t size, const std::vector<unsigned>& dimensions) :
+      std::span<float>(data, size), dimensions(dimensions) {}
+
+    /**
+     * Returns the number of dimensions of the tensor.
+     * @return The rank of the tensor. The batch dimension is not counted.
+     */
+    unsigned rank() const {return static_cast<unsigned>(dimensions.size());}
+
+    /**
+     * Returns the size of a certain dimension of the tensor.
+     * @param dimension The number of the dimension. The batch dimension is skipped.
+     * @return The size of the dimension of the tensor.
+     */
+    unsigned dims(std::size_t dimension) const {return dimensions[dimension];}
+
+    /**
+     * Copies the tensor data from another tensor to this one.
+     * @param other The other tensor. It must have the same size as this one.
+     * @return This tensor after the assignment.
+     */
+    Tensor& operator=(const Tensor& other);
+  };
+
+private:
+  class Network; /**< The interface of the backends. */
+  template<typename CompiledNN, typename Model> class NetworkImpl;
+  class Batcher; /**< Combines the runs of the same network by several instances. */
+
+  /** The shape and location of an input or output. */
+  struct TensorInfo
+  {
+    float* data; /**< The address of the data in the backend. */
+    std::size_t size; /**< The overall number of values. */
+    std::vector<unsigned> dimensions; /**< The dimensions without the batch dimension. */
+    bool isUInt8; /**< Are the values encoded as unsigned chars? */
+  };
+
+  std::unique_ptr<Network> network; /**< The backend running the network. */
+  std::vector<TensorInfo> inputs; /**< The inputs of the network. */
+  std::vector<TensorInfo> outputs; /**< The outputs of the network. */
+  Backend backend = numOfBackends; /**< The backend used. */
+  std::string base; /**< The path of the model without extension. */
+  unsigned runs = 0; /**< How often was the network applied? */
+  unsigned recordedInputs = 0; /**< How many inputs were recorded? */
+  std::shared_ptr<Batcher> batcher; /**< Runs the network in batches with other instances or nullptr. */
+
+  /**
+   * Creates a backend for a variant of the model.
+   * @param backend The backend to create.
+   * @param filename The path of the model used by CompiledNN.
+   * @param options The options of the module using the network.
+   * @return The backend or nullptr if the variant does not exist.
+   */
+  std::unique_ptr<Network> create(Backend backend, const std::string& filename, const Options& options) const;
+
+  /**
+   * Selects the fastest backend that is accurate enough.
+   * @param candidates The backends available, the float reference first.
+   * @param tolerance The maximum deviation of an output from the reference.
+   * @param settings The settings of all networks.
+   * @param name The name of the network.
+   * @return The index of the backend selected.
+   */
+  std::size_t autotune(std::vector<std::pair<Backend, std::unique_ptr<Network>>>& candidates, float tolerance,
+                       const Settings& settings, const std::string& name);
+
+  /**
+   * Joins the batches of all other instances running the same network if
+   * batching is enabled and does not change the outputs.
+   * @param filename The path of the model used by CompiledNN.
+   * @param options The options of the module using the network.
+   * @param settings The settings of all networks.
+   * @param name The name of the network.
+   */
+  void joinBatches(const std::string& filename, const Options& options, const Settings& settings, const std::string& name);
+
+  /**
+   * Creates random inputs for a network.
+   * @param inputs The inputs of the network.
+   * @param numOfSamples The number of samples created.
+   * @return The samples. Each contains the values of all inputs one after another.
+   */
+  static std::vector<std::vector<float>> createRandomSamples(const std::vector<TensorInfo>& inputs, std::size_t numOfSamples);
+
+  /**
+   * Copies a sample to the inputs of a network.
+   * @param inputs The inputs of the network.
+   * @param sample The values of all inputs one after another.
+   * @param slot The position of the sample in the batch.
+   * @param batchSize The number of samples the inputs can hold.
+   */
+  static void setInputs(const std::vector<TensorInfo>& inputs, const std::vector<float>& sample,
+                        std::size_t slot = 0, std::size_t batchSize = 1);
+
+  /** Appends the current inputs to the recorded inputs of the network. */
+  void recordInputs();
+
+  /**
+   * Returns the settings of all networks. They are read when first needed.
+   * @return The settings.
+   */
+  static const Settings& getSettings();
+
+public:
+  InferenceEngine();
+  ~InferenceEngine();
+
+  /**
+   * Loads a network and selects the backend it is run with.
+   * @param filename The path of the model used by CompiledNN. The variants
+   *                 for the other backends are searched next to it.
+   * @param options The options of the module using the network.
+   */
+  void load(const std::string& filename, const Options& options);
+
+  /**
+   * Loads a network with default options.
+   * @param filename The path of the model used by CompiledNN.
+   */
+  void load(const std::string& filename) {load(filename, Options());}
+
+  /**
+   * Was a network successfully loaded?
+   * @return Is the network ready to be applied?
+   */
+  bool valid() const {return network != nullptr;}
+
+  /** Runs the network on the current inputs. */
+  void apply();
+
+  /**
+   * Returns the backend the network is run with.
+   * @return The backend or numOfBackends if no network was loaded.
+   */
+  Backend getBackend() const {return backend;}
+
+  /**
+   * Returns the largest number of runs that were processed together by the
+   * batches this instance takes part in.
+   * @return The largest batch size so far or 0 if the runs are not batched.
+   */
+  std::size_t getLargestBatchSize() const;
+
+  /**
+   * Returns the number of inputs.
+   * @return The number of inputs.
+   */
+  std::size_t numOfInputs() const {return inputs.size();}
+
+  /**
+   * Returns the number of outputs.
+   * @return The number of outputs.
+   */
+  std::size_t numOfOutputs() const {return outputs.size();}
+
+  /**
+   * Returns an input tensor. Inputs that are encoded as unsigned chars still
+   * have to be accessed through reinterpret_cast<unsigned char*>(data()).
+   * @param index The index of the input.
+   * @return The input tensor.
+   */
+  Tensor input(std::size_t index) {return Tensor(inputs[index].data, inputs[index].size, inputs[index].dimensions);}
+
+  /**
+   * Returns an output tensor.
+   * @param index The index of the output.
+   * @return The output tensor.
+   */
+  Tensor output(std::size_t index) {return Tensor(outputs[index].data, outputs[index].size, outputs[index].dimensions);}
+};
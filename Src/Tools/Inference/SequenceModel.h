@@ -0,0 +1,96 @@
+/**
+ * @file Tools/Inference/SequenceModel.h
+ *
+ * This file declares a class that runs a network on the last time slices of
+ * a sequence. A windowed model gets the whole window from the oldest to the
+ * newest slice as its first input. A streaming model only gets the newest
+ * slice as its first input. It has additional inputs for its internal state
+ * (e.g. the activations of the previous time steps) that are returned as
+ * additional outputs in the same order. Both kinds of models are run in a way
+ * that they produce the same predictions if they compute the same function.
+ */
+
+#pragma once
+
+#include "Tools/Inference/InferenceEngine.h"
+#include <algorithm>
+#include <vector>
+
+template<typename Network = InferenceEngine> class SequenceModel
+{
+  /**
+   * The last historyLength time slices. It is a ring buffer that is stored twice in a row,
+   * so the window from the oldest to the newest slice is always contiguous and can be
+   * copied in one go.
+   */
+  std::vector<float> history;
+  unsigned historyLength = 0; /**< The number of time slices in the window. */
+  unsigned sliceSize = 0; /**< The number of values per time slice. */
+  unsigned nextSlice = 0; /**< The index of the time slice in history that is written next. */
+  unsigned numOfSlices = 0; /**< The number of time slices recorded (up to historyLength). */
+  bool streaming = false; /**< Does the model only process the newest time slice? */
+
+public:
+  Network network; /**< The network. It must be (re)loaded before calling reset. */
+
+  /**
+   * Prepares running the network after it was (re)loaded. A new streaming model
+   * starts with an empty state, so it has to see the whole window again before
+   * its predictions are used.
+   * @param historyLength The number of time slices in the window.
+   * @param sliceSize The number of values per time slice.
+   */
+  void reset(unsigned historyLength, unsigned sliceSize)
+  {
+    if(historyLength != this->historyLength || sliceSize != this->sliceSize)
+    {
+      history.assign(2 * historyLength * sliceSize, 0.f);
+      this->historyLength = historyLength;
+      this->sliceSize = sliceSize;
+      nextSlice = numOfSlices = 0;
+    }
+
+    streaming = network.numOfInputs() > 1;
+    for(std::size_t i = 1; i < network.numOfInputs(); ++i)
+      std::fill(network.input(i).begin(), network.input(i).end(), 0.f);
+    if(streaming)
+      numOfSlices = 0;
+  }
+
+  /**
+   * Adds the newest time slice. A streaming model is run on every slice to keep
+   * its state up to date. A windowed model is only run if a prediction is needed.
+   * @param slice The newest time slice (sliceSize values).
+   * @param predict Is a prediction needed?
+   * @return Does network.output(0) contain the prediction? This requires that
+   *         the whole window was recorded.
+   */
+  bool add(const float* slice, bool predict)
+  {
+    float* entry = history.data() + nextSlice * sliceSize;
+    std::copy(slice, slice + sliceSize, entry);
+    std::copy(slice, slice + sliceSize, entry + historyLength * sliceSize);
+    nextSlice = (nextSlice + 1) % historyLength;
+    numOfSlices = std::min(numOfSlices + 1, historyLength);
+
+    if(streaming)
+    {
+      std::copy(slice, slice + sliceSize, network.input(0).data());
+      network.apply();
+      for(std::size_t i = 1; i < network.numOfInputs(); ++i)
+        std::copy(network.output(i).begin(), network.output(i).end(), network.input(i).begin());
+    }
+
+    if(numOfSlices < historyLength || !predict)
+      return false;
+
+    if(!streaming)
+    {
+      // The window starts with the oldest slice, which is the one overwritten next.
+      const float* window = history.data() + nextSlice * sliceSize;
+      std::copy(window, window + historyLength * sliceSize, network.input(0).data());
+      network.apply();
+    }
+    return true;
+  }
+};
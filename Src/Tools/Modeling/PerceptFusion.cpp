@@ -0,0 +1,107 @@
+/**
+ * @file Tools/Modeling/PerceptFusion.cpp
+ *
+ * This file implements functions that add the percepts from the older image
+ * of a Cognition frame that fuses the frames of both cameras to those from
+ * the newer image.
+ */
+
+#include "PerceptFusion.h"
+#include "Math/Pose3f.h"
+#include "MathBase/Covariance.h"
+#include "Representations/Perception/BallPercepts/BallPercept.h"
+#include "Representations/Perception/FieldPercepts/CirclePercept.h"
+#include "Representations/Perception/FieldPercepts/FieldLineIntersections.h"
+#include "Representations/Perception/FieldPercepts/FieldLines.h"
+#include "Representations/Perception/FieldPercepts/PenaltyMarkPercept.h"
+#include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
+#include "Representations/Perception/ObstaclesPercepts/ObstaclesFieldPercept.h"
+#include <algorithm>
+
+Pose2f PerceptFusion::olderToNewer(const Pose2f& newerOdometry, const Pose2f& olderOdometry)
+{
+  return newerOdometry.inverse() * olderOdometry;
+}
+
+bool PerceptFusion::isBetter(const BallPercept& older, const BallPercept& newer)
+{
+  return older.status == BallPercept::seen ? newer.status != BallPercept::seen
+         : older.status == BallPercept::guessed && newer.status == BallPercept::notSeen;
+}
+
+CameraMatrix PerceptFusion::moveToNewer(const CameraMatrix& cameraMatrix, const Pose2f& offset)
+{
+  CameraMatrix moved(Pose3f(offset.translation.x(), offset.translation.y(), 0.f).rotateZ(offset.rotation) * cameraMatrix);
+  moved.isValid = cameraMatrix.isValid;
+  return moved;
+}
+
+void PerceptFusion::fuse(BallPercept& ballPercept, const BallPercept& older, const Pose2f& offset)
+{
+  if(isBetter(older, ballPercept))
+  {
+    ballPercept = older;
+    ballPercept.positionOnField = offset * older.positionOnField;
+    ballPercept.covarianceOnField = Covariance::rotateCovarianceMatrix(older.covarianceOnField, offset.rotation);
+  }
+}
+
+void PerceptFusion::fuse(CirclePercept& circlePercept, const CirclePercept& older, const Pose2f& offset)
+{
+  if(!circlePercept.wasSeen && older.wasSeen)
+  {
+    circlePercept = older;
+    circlePercept.pos = offset * older.pos;
+    circlePercept.cov = Covariance::rotateCovarianceMatrix(older.cov, offset.rotation);
+  }
+}
+
+void PerceptFusion::fuse(FieldLines& fieldLines, const FieldLines& older, const Pose2f& offset)
+{
+  for(const FieldLines::Line& line : older.lines)
+  {
+    FieldLines::Line& fused = fieldLines.lines.emplace_back(line);
+    fused.alpha = Angle::normalize(line.alpha + offset.rotation);
+    fused.first = offset * line.first;
+    fused.last = offset * line.last;
+    fused.cov = Covariance::rotateCovarianceMatrix(line.cov, offset.rotation);
+  }
+
+  // The lines must still be sorted by their lengths.
+  std::stable_sort(fieldLines.lines.begin(), fieldLines.lines.end(),
+                   [](const FieldLines::Line& a, const FieldLines::Line& b) {return a.length > b.length;});
+}
+
+void PerceptFusion::fuse(FieldLineIntersections& fieldLineIntersections, const FieldLineIntersections& older, const Pose2f& offset)
+{
+  for(const FieldLineIntersections::Intersection& intersection : older.intersections)
+  {
+    FieldLineIntersections::Intersection& fused = fieldLineIntersections.intersections.emplace_back(intersection);
+    fused.pos = offset * intersection.pos;
+    fused.cov = Covariance::rotateCovarianceMatrix(intersection.cov, offset.rotation);
+    fused.dir1 = intersection.dir1.rotated(offset.rotation);
+    fused.dir2 = intersection.dir2.rotated(offset.rotation);
+  }
+}
+
+void PerceptFusion::fuse(ObstaclesFieldPercept& obstaclesFieldPercept, const ObstaclesFieldPercept& older, const Pose2f& offset)
+{
+  for(const ObstaclesFieldPercept::Obstacle& obstacle : older.obstacles)
+  {
+    ObstaclesFieldPercept::Obstacle& fused = obstaclesFieldPercept.obstacles.emplace_back(obstacle);
+    fused.center = offset * obstacle.center;
+    fused.left = offset * obstacle.left;
+    fused.right = offset * obstacle.right;
+    fused.covariance = Covariance::rotateCovarianceMatrix(obstacle.covariance, offset.rotation);
+  }
+}
+
+void PerceptFusion::fuse(PenaltyMarkPercept& penaltyMarkPercept, const PenaltyMarkPercept& older, const Pose2f& offset)
+{
+  if(!penaltyMarkPercept.wasSeen && older.wasSeen)
+  {
+    penaltyMarkPercept = older;
+    penaltyMarkPercept.positionOnField = offset * older.positionOnField;
+    penaltyMarkPercept.covarianceOnField = Covariance::rotateCovarianceMatrix(older.covarianceOnField, offset.rotation);
+  }
+}
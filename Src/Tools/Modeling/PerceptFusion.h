@@ -0,0 +1,64 @@
+/**
+ * @file Tools/Modeling/PerceptFusion.h
+ *
+ * This file declares functions that add the percepts from the older image
+ * of a Cognition frame that fuses the frames of both cameras to those from
+ * the newer image. The percepts are moved to the time of the newer image
+ * based on the odometry between both. Image coordinates are not changed.
+ */
+
+#pragma once
+
+#include "Math/Pose2f.h"
+
+struct BallPercept;
+struct CameraMatrix;
+struct CirclePercept;
+struct FieldLineIntersections;
+struct FieldLines;
+struct ObstaclesFieldPercept;
+struct PenaltyMarkPercept;
+
+namespace PerceptFusion
+{
+  /**
+   * The offset between the images of a fused frame.
+   * @param newerOdometry The odometry at the time of the newer image.
+   * @param olderOdometry The odometry at the time of the older image.
+   * @return The pose of the robot when the older image was taken relative to
+   *         its pose when the newer one was taken.
+   */
+  Pose2f olderToNewer(const Pose2f& newerOdometry, const Pose2f& olderOdometry);
+
+  /**
+   * Is the ball from the older image better than the one from the newer image?
+   * Only then, it is used in a fused frame.
+   * @param older The ball percept from the older image.
+   * @param newer The ball percept from the newer image.
+   * @return Is the older ball percept used?
+   */
+  bool isBetter(const BallPercept& older, const BallPercept& newer);
+
+  /**
+   * Moves the camera matrix of the older image to the time of the newer one.
+   * @param cameraMatrix The camera matrix of the older image.
+   * @param offset The offset between both images.
+   * @return The camera matrix relative to the robot at the time of the newer image.
+   */
+  CameraMatrix moveToNewer(const CameraMatrix& cameraMatrix, const Pose2f& offset);
+
+  /**
+   * Adds the percepts from the older image to those from the newer image.
+   * Percepts that only exist once per image are replaced if the older one
+   * was seen and the newer one was not.
+   * @param percept The percepts from the newer image, which are extended.
+   * @param older The percepts from the older image.
+   * @param offset The offset between both images.
+   */
+  void fuse(BallPercept& percept, const BallPercept& older, const Pose2f& offset);
+  void fuse(CirclePercept& percept, const CirclePercept& older, const Pose2f& offset);
+  void fuse(FieldLines& percept, const FieldLines& older, const Pose2f& offset);
+  void fuse(FieldLineIntersections& percept, const FieldLineIntersections& older, const Pose2f& offset);
+  void fuse(ObstaclesFieldPercept& percept, const ObstaclesFieldPercept& older, const Pose2f& offset);
+  void fuse(PenaltyMarkPercept& percept, const PenaltyMarkPercept& older, const Pose2f& offset);
+}
@@ -0,0 +1,92 @@
+/**
+ * @file MotionPhase.cpp
+ *
+ * This file implements the pools motion phases are allocated from. Objects
+ * are allocated with the global operator new, so that an allocation inside
+ * a Memory::NoAllocationScope, i.e. a pool miss, is reported.
+ */
+
+#include "MotionPhase.h"
+#include <new>
+#include <vector>
+
+namespace
+{
+  /** The unused phase objects of a thread, grouped by their size. */
+  class PhasePool
+  {
+    /** The unused objects of a certain size. */
+    struct FreeList
+    {
+      std::size_t size;
+      std::vector<void*> objects;
+    };
+
+    std::vector<FreeList> freeLists;
+
+  public:
+    static constexpr std::align_val_t alignment = std::align_val_t(32); /**< Enough for all vectorized members of phases. */
+
+    static thread_local PhasePool instance; /**< The pool of the current thread. */
+    static thread_local bool destroyed; /**< Was the pool of this thread already destroyed, e.g. during thread exit? */
+
+    ~PhasePool()
+    {
+      for(FreeList& freeList : freeLists)
+        for(void* object : freeList.objects)
+          ::operator delete(object, alignment);
+      destroyed = true;
+    }
+
+    /**
+     * Returns the free list for objects of a certain size.
+     * @param size The size of the objects.
+     * @return The free list. It is created if it did not exist yet.
+     */
+    std::vector<void*>& getFreeList(std::size_t size)
+    {
+      for(FreeList& freeList : freeLists)
+        if(freeList.size == size)
+          return freeList.objects;
+      freeLists.push_back({size, {}});
+      freeLists.back().objects.reserve(4);
+      return freeLists.back().objects;
+    }
+  };
+
+  thread_local PhasePool PhasePool::instance;
+  thread_local bool PhasePool::destroyed = false;
+}
+
+void* MotionPhase::operator new(std::size_t size)
+{
+  if(!PhasePool::destroyed)
+  {
+    std::vector<void*>& objects = PhasePool::instance.getFreeList(size);
+    if(!objects.empty())
+    {
+      void* object = objects.back();
+      objects.pop_back();
+      return object;
+    }
+  }
+
+  return ::operator new(size, PhasePool::alignment);
+}
+
+void MotionPhase::operator delete(void* ptr, std::size_t size)
+{
+  if(!ptr)
+    return;
+  else if(PhasePool::destroyed)
+    ::operator delete(ptr, PhasePool::alignment);
+  else
+    PhasePool::instance.getFreeList(size).push_back(ptr);
+}
+
+void MotionPhase::preallocate(std::size_t size, std::size_t count)
+{
+  std::vector<void*>& objects = PhasePool::instance.getFreeList(size);
+  while(objects.size() < count)
+    objects.push_back(::operator new(size, PhasePool::alignment));
+}
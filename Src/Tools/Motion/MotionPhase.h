@@ -50,6 +50,42 @@ struct MotionPhase
   /** Virtual destructor for polymorphism. */
   virtual ~MotionPhase() = default;
 
+  /**
+   * Phases are allocated from per-thread pools, one per object size, i.e. in
+   * practice one per phase type. Deleted phases are kept for reuse, so that
+   * phase transitions do not access the heap once every type was used.
+   * @param size The size of the phase object.
+   * @return The memory for the phase.
+   */
+  static void* operator new(std::size_t size);
+
+  /**
+   * Returns the memory of a phase to the pool of the current thread.
+   * @param ptr The memory of the phase.
+   * @param size The size of the phase object.
+   */
+  static void operator delete(void* ptr, std::size_t size);
+
+  /**
+   * Fills the pool of the current thread with objects for a phase type, so
+   * that even its first transitions do not access the heap. Engines call this
+   * in their constructors, which run in the thread that executes them.
+   * @tparam Phase The phase type.
+   * @param count The number of phases of this type that can exist at the same time.
+   */
+  template<typename Phase>
+  static void preallocate(std::size_t count = 4)
+  {
+    preallocate(sizeof(Phase), count);
+  }
+
+  /**
+   * Fills the pool of the current thread with objects of a certain size.
+   * @param size The size of the phase objects.
+   * @param count The number of objects the pool contains afterwards at least.
+   */
+  static void preallocate(std::size_t size, std::size_t count);
+
   /** Updates the state of the phase. */
   virtual void update()
   {}
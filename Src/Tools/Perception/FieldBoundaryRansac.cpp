@@ -0,0 +1,210 @@
+/**
+ * @file Tools/Perception/FieldBoundaryRansac.cpp
+ *
+ * This file implements a class that fits a field boundary to boundary spots
+ * using RANSAC.
+ *
+ * @author Arne Hasselbring
+ */
+
+#include "FieldBoundaryRansac.h"
+#include "ImageProcessing/SIMD.h"
+#include "Math/BHMath.h"
+#include "Math/Geometry.h"
+#include "MathBase/Random.h"
+#include "Representations/Infrastructure/CameraInfo.h"
+#include "Representations/Perception/ImagePreprocessing/CameraMatrix.h"
+#include "Representations/Perception/ImagePreprocessing/ImageCoordinateSystem.h"
+#include "Tools/Math/Transformation.h"
+#include <algorithm>
+#include <limits>
+
+void FieldBoundaryRansac::fit(const std::vector<Spot>& spots, const Parameters& parameters, const CameraMatrix& cameraMatrix,
+                              const CameraInfo& cameraInfo, const ImageCoordinateSystem& imageCoordinateSystem,
+                              const Pose2f& odometry, std::vector<Spot>& model)
+{
+  model.clear();
+  model.reserve(3);
+  if(spots.size() < 3)
+    return;
+
+  // Separate coordinate arrays for the vectorized error computation. The spots are sorted by their x-coordinate.
+  std::vector<float> xs(spots.size());
+  std::vector<float> ys(spots.size());
+  for(size_t i = 0; i < spots.size(); ++i)
+  {
+    xs[i] = static_cast<float>(spots[i].inImage.x());
+    ys[i] = static_cast<float>(spots[i].inImage.y());
+  }
+
+  int minError = std::numeric_limits<int>::max();
+  const int goodEnough = static_cast<int>(static_cast<float>(parameters.maxSquaredError * spots.size()) * parameters.acceptanceRatio);
+
+  // Evaluates the hypotheses of a sample of three spots sorted by their x-coordinate and keeps the best one.
+  auto evaluate = [&](const Spot& leftSpot, const Spot& middleSpot, const Spot& rightSpot)
+  {
+    // Construct lines, second is perpendicular to first one on the field.
+    Vector2f dirOnField = middleSpot.onField - leftSpot.onField;
+    const Geometry::Line leftOnField(leftSpot.onField, dirOnField);
+    const Geometry::Line rightOnField(rightSpot.onField, dirOnField.rotateLeft()); // Changes dirOnField!
+
+    // Compute hypothetical corner in field coordinates.
+    Vector2f inImage;
+    Spot corner;
+    if(Geometry::getIntersectionOfLines(leftOnField, rightOnField, corner.onField)
+       && Transformation::robotToImage(corner.onField, cameraMatrix, cameraInfo, inImage))
+    {
+      corner.inImage = imageCoordinateSystem.fromCorrected(inImage).cast<int>();
+
+      // Corner must be right of left spot, left of the right spot, and above connecting line.
+      if(corner.inImage.x() <= leftSpot.inImage.x() || corner.inImage.x() >= rightSpot.inImage.x()
+         || corner.inImage.y() >= leftSpot.inImage.y() + (corner.inImage.x() - leftSpot.inImage.x())
+         * (rightSpot.inImage.y() - leftSpot.inImage.y()) / (rightSpot.inImage.x() - leftSpot.inImage.x()))
+        corner.inImage.x() = cameraInfo.width; // It is not -> ignore
+    }
+    else
+      corner.inImage.x() = cameraInfo.width; // Corner invalid -> ignore
+
+    const Vector2i dirLeft = middleSpot.inImage - leftSpot.inImage;
+    const Vector2i dirRight = rightSpot.inImage - corner.inImage;
+
+    // Spots left of the corner are only compared to the left line.
+    const size_t split = std::lower_bound(xs.begin(), xs.end(), static_cast<float>(corner.inImage.x())) - xs.begin();
+
+    // Accumulate errors in image coordinates for left line.
+    const int errorLeft = sumErrors(xs, ys, 0, split, leftSpot.inImage, dirLeft, minError, parameters);
+    if(errorLeft >= minError)
+      return;
+
+    // Accumulate errors in image coordinates, assuming both a continuing left line and a separate right line.
+    const int abortError = minError - errorLeft;
+    const int errorRightLine = sumErrors(xs, ys, split, spots.size(), corner.inImage, dirRight, abortError, parameters); // Assuming a separate line on the right.
+    const int errorRightStraight = sumErrors(xs, ys, split, spots.size(), leftSpot.inImage, dirLeft, abortError, parameters); // Assuming left line continues.
+
+    // Update model if it is better than the best found so far.
+    const int error = errorLeft + std::min(errorRightLine, errorRightStraight);
+    if(error < minError)
+    {
+      minError = error;
+      model.clear();
+      model.emplace_back(leftSpot);
+
+      if(errorRightLine < errorRightStraight)
+      {
+        model.emplace_back(corner);
+        model.emplace_back(rightSpot);
+      }
+      else
+        model.emplace_back(middleSpot);
+    }
+  };
+
+  // A sample near the model of the previous frame is usually a good first hypothesis. It lets most samples be aborted early.
+  size_t left, middle, right;
+  if(parameters.warmStart && selectPreviousSample(xs, cameraMatrix, cameraInfo, imageCoordinateSystem, odometry, left, middle, right))
+    evaluate(spots[left], spots[middle], spots[right]);
+
+  for(int i = 0; i < parameters.maxNumberOfIterations && minError > goodEnough; ++i)
+  {
+    // Draw three unique samples sorted by their x-coordinate.
+    const size_t middleIndex = Random::uniformInt(static_cast<size_t>(1), spots.size() - 2);
+    evaluate(spots[Random::uniformInt(middleIndex - 1)], spots[middleIndex],
+             spots[Random::uniformInt(middleIndex + 1, spots.size() - 1)]);
+  }
+
+  previousModelOnField.clear();
+  for(const Spot& spot : model)
+    previousModelOnField.emplace_back(spot.onField);
+  previousOdometry = odometry;
+}
+
+int FieldBoundaryRansac::effectiveError(int error, const Parameters& parameters)
+{
+  return std::min(sqr(error), parameters.maxSquaredError) * (error < 0 ? 1 : parameters.spotAbovePenaltyFactor);
+}
+
+int FieldBoundaryRansac::sumErrors(const std::vector<float>& xs, const std::vector<float>& ys, size_t from, size_t to,
+                                   const Vector2i& base, const Vector2i& dir, int limit, const Parameters& parameters)
+{
+  // The quotient is computed in floating point and truncated, which is identical to the integer division
+  // of effectiveError for all offsets that matter, i.e. those that do not saturate anyway.
+  const __m128 baseX = _mm_set1_ps(static_cast<float>(base.x()));
+  const __m128 baseY = _mm_set1_ps(static_cast<float>(base.y()));
+  const __m128 slopeY = _mm_set1_ps(static_cast<float>(dir.y()));
+  const __m128 slopeX = _mm_set1_ps(static_cast<float>(dir.x()));
+  const __m128 maxOffset = _mm_set1_ps(32768.f);
+  const __m128 minOffset = _mm_set1_ps(-32768.f);
+  const __m128 maxError = _mm_set1_ps(static_cast<float>(parameters.maxSquaredError));
+  const __m128 abovePenalty = _mm_set1_ps(static_cast<float>(parameters.spotAbovePenaltyFactor));
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 zero = _mm_setzero_ps();
+
+  int sum = 0;
+  size_t i = from;
+  while(i + 8 <= to && sum < limit)
+  {
+    __m128i errors = _mm_setzero_si128();
+    for(const size_t end = i + 8; i < end; i += 4)
+    {
+      const __m128 x = _mm_loadu_ps(xs.data() + i);
+      const __m128 y = _mm_loadu_ps(ys.data() + i);
+      const __m128 quotient = _mm_min_ps(_mm_max_ps(_mm_div_ps(_mm_mul_ps(slopeY, _mm_sub_ps(x, baseX)), slopeX), minOffset), maxOffset);
+      const __m128 error = _mm_sub_ps(_mm_add_ps(baseY, _mm_cvtepi32_ps(_mm_cvttps_epi32(quotient))), y);
+      const __m128 factor = _mm_or_ps(_mm_and_ps(_mm_cmplt_ps(error, zero), one), _mm_andnot_ps(_mm_cmplt_ps(error, zero), abovePenalty));
+      errors = _mm_add_epi32(errors, _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_mul_ps(error, error), maxError), factor)));
+    }
+    errors = _mm_add_epi32(errors, _mm_shuffle_epi32(errors, _MM_SHUFFLE(1, 0, 3, 2)));
+    errors = _mm_add_epi32(errors, _mm_shuffle_epi32(errors, _MM_SHUFFLE(2, 3, 0, 1)));
+    sum += _mm_cvtsi128_si32(errors);
+  }
+
+  for(; i < to && sum < limit; ++i)
+    sum += effectiveError(base.y() + dir.y() * (static_cast<int>(xs[i]) - base.x()) / dir.x() - static_cast<int>(ys[i]), parameters);
+
+  return sum;
+}
+
+bool FieldBoundaryRansac::selectPreviousSample(const std::vector<float>& xs, const CameraMatrix& cameraMatrix, const CameraInfo& cameraInfo,
+                                               const ImageCoordinateSystem& imageCoordinateSystem, const Pose2f& odometry,
+                                               size_t& left, size_t& middle, size_t& right) const
+{
+  // Predict where the previous model is in the current image.
+  const Pose2f odometryOffset = odometry.inverse() * previousOdometry;
+  std::vector<float> modelXs;
+  for(const Vector2f& previousOnField : previousModelOnField)
+  {
+    Vector2f inImage;
+    if(!Transformation::robotToImage(odometryOffset * previousOnField, cameraMatrix, cameraInfo, inImage))
+      return false;
+    modelXs.emplace_back(imageCoordinateSystem.fromCorrected(inImage).x());
+    if(modelXs.size() > 1 && modelXs.back() <= modelXs[modelXs.size() - 2])
+      return false;
+  }
+  if(modelXs.size() < 2)
+    return false;
+
+  // The index of the spot closest to an x-coordinate.
+  auto closest = [&xs](float x)
+  {
+    const size_t i = std::lower_bound(xs.begin(), xs.end(), x) - xs.begin();
+    return i == xs.size() || (i > 0 && x - xs[i - 1] < xs[i] - x) ? i - 1 : i;
+  };
+
+  // A straight line is defined by its first two spots. A corner is constructed from
+  // a spot on the left line and the rightmost spot.
+  left = closest(modelXs[0]);
+  if(modelXs.size() == 2)
+  {
+    middle = closest(modelXs[1]);
+    right = xs.size() - 1;
+  }
+  else
+  {
+    middle = closest((modelXs[0] + modelXs[1]) / 2.f);
+    right = closest(modelXs[2]);
+  }
+  if(right < left + 2)
+    return false;
+  middle = std::clamp(middle, left + 1, right - 1);
+  return true;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file Tools/Perception/FieldBoundaryRansac.h
+ *
+ * This file declares a class that fits a field boundary to boundary spots
+ * using RANSAC. A model is either a straight line or two lines that are
+ * perpendicular on the field and meet in a corner.
+ *
+ * @author Arne Hasselbring
+ */
+
+#pragma once
+
+#include "Math/Eigen.h"
+#include "Math/Pose2f.h"
+#include <vector>
+
+struct CameraInfo;
+struct CameraMatrix;
+struct ImageCoordinateSystem;
+
+class FieldBoundaryRansac
+{
+public:
+  /** A boundary spot both in image and field coordinates. */
+  struct Spot
+  {
+    Vector2i inImage; /**< The spot in image coordinates. */
+    Vector2f onField; /**< The spot in robot-relative field coordinates. */
+    float uncertainty; /**<uncertainty of the network for this spot 0 if the network do not provide it */
+
+    Spot() = default;
+    Spot(const Vector2i& inImage, const Vector2f& onField, const float u) : inImage(inImage), onField(onField), uncertainty(u) {}
+  };
+
+  /** The parameters of the fitting. */
+  struct Parameters
+  {
+    int maxNumberOfIterations; /**< Up to how often does RANSAC iterate? */
+    int maxSquaredError; /**< Limit at which deviations of spots from the boundary saturate (in pixel^2).  */
+    int spotAbovePenaltyFactor; /**< A spot being above this boundary is this factor worse than being below. */
+    float acceptanceRatio; /**< Which overall ratio of maxSquaredError is good enough to end the RANSAC? */
+    bool warmStart; /**< Start with a sample near the model of the previous fit, moved by the odometry since then. */
+  };
+
+  /**
+   * Fits a field boundary. The method always constructs a model from three
+   * sample spots and considers a straight line between the first two spots or
+   * also a perpendicular line (in field coordinates) to the third spot.
+   * Hypotheses are dropped as soon as their partial error exceeds the error of
+   * the best one so far. If enabled, the first sample consists of the spots
+   * closest to the model of the previous fit as predicted for the current image.
+   * Therefore, the result always stems from the current spots.
+   * @param spots The boundary spots that are sampled. They must be sorted by their x-coordinates in the image.
+   * @param parameters The parameters of the fitting.
+   * @param cameraMatrix The camera matrix of the current image.
+   * @param cameraInfo The camera that took the current image.
+   * @param imageCoordinateSystem The image coordinate system of the current image.
+   * @param odometry The odometry at the time of the current image.
+   * @param model The model of two (straight line) or three (corner) spots is returned here.
+   *              It is empty if no hypothesis was valid.
+   */
+  void fit(const std::vector<Spot>& spots, const Parameters& parameters, const CameraMatrix& cameraMatrix,
+           const CameraInfo& cameraInfo, const ImageCoordinateSystem& imageCoordinateSystem, const Pose2f& odometry,
+           std::vector<Spot>& model);
+
+private:
+  std::vector<Vector2f> previousModelOnField; /**< The model of the previous fit in robot-relative coordinates. */
+  Pose2f previousOdometry; /**< The odometry when the previous model was determined. */
+
+  /**
+   * Return a weighted, squared, and saturated error between boundary spots and a
+   * boundary line.
+   * @param error The vertical pixel offset between spot and line. Positive if the
+   *              spot is above the line.
+   * @param parameters The parameters of the fitting.
+   */
+  static int effectiveError(int error, const Parameters& parameters);
+
+  /**
+   * Sum the effective errors of a range of boundary spots relative to a line in the image.
+   * Four spots are processed at once. The summation stops early when the limit is reached,
+   * i.e. the result is only exact if it is smaller than the limit.
+   * @param xs The x coordinates of all spots (sorted).
+   * @param ys The y coordinates of all spots.
+   * @param from The index of the first spot considered.
+   * @param to The index after the last spot considered.
+   * @param base A point on the line.
+   * @param dir The direction of the line. Its x component must not be 0 if the range is not empty.
+   * @param limit The sum at which the summation is aborted.
+   * @param parameters The parameters of the fitting.
+   * @return The sum of effective errors (or a value >= limit).
+   */
+  static int sumErrors(const std::vector<float>& xs, const std::vector<float>& ys, size_t from, size_t to,
+                       const Vector2i& base, const Vector2i& dir, int limit, const Parameters& parameters);
+
+  /**
+   * Selects the sample that is closest to the model of the previous fit as predicted for the current image.
+   * @param xs The x coordinates of all spots (sorted).
+   * @param cameraMatrix The camera matrix of the current image.
+   * @param cameraInfo The camera that took the current image.
+   * @param imageCoordinateSystem The image coordinate system of the current image.
+   * @param odometry The odometry at the time of the current image.
+   * @param left The index of the left spot of the sample is returned here.
+   * @param middle The index of the middle spot of the sample is returned here.
+   * @param right The index of the right spot of the sample is returned here.
+   * @return Was a valid sample selected?
+   */
+  bool selectPreviousSample(const std::vector<float>& xs, const CameraMatrix& cameraMatrix, const CameraInfo& cameraInfo,
+                            const ImageCoordinateSystem& imageCoordinateSystem, const Pose2f& odometry,
+                            size_t& left, size_t& middle, size_t& right) const;
+};
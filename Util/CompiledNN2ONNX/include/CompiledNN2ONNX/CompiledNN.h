@@ -8,6 +8,7 @@
 
 #include <algorithm>
 #include <span>
+#include <unordered_map>
 #include <asmjit/asmjit.h>
 #include <onnxruntime_cxx_api.h>
 #ifdef MACOS
@@ -49,6 +50,17 @@ namespace NeuralNetworkONNX
     std::vector<Ort::Value> inputTensors; /**< The pre-allocated tensors for each input. */
     std::vector<Ort::Value> outputTensors; /**< The pre-allocated tensors for each output. */
     std::vector<unsigned char*> uint8Buffers; /**< For each input that is encoded as unsigned chars, a buffer of the required size is provided. Otherwise, the entry is nullptr. */
+    bool dynamicBatch = false; /**< Is the first dimension of all inputs and outputs dynamic, i.e. can several samples be processed at once? */
+    size_t batchSize = 1; /**< The number of samples processed by \c apply. */
+
+    /** The tensors and buffers of a batch size that is currently not used. */
+    struct CachedBatch
+    {
+      std::vector<Ort::Value> inputTensors;
+      std::vector<Ort::Value> outputTensors;
+      std::vector<unsigned char*> uint8Buffers;
+    };
+    std::unordered_map<size_t, CachedBatch> cachedBatches; /**< The tensors of batch sizes used before, so that they are not recreated. */
 
     /**
      * Helper method to create a single ONNX environment that hosts the global
@@ -72,6 +84,9 @@ namespace NeuralNetworkONNX
         delete[] uint8Buffer;
       for(const char* outputName : outputNames)
         allocator.Free(const_cast<char*>(outputName));
+      for(auto& [size, cachedBatch] : cachedBatches)
+        for(unsigned char* uint8Buffer : cachedBatch.uint8Buffers)
+          delete[] uint8Buffer;
 
       inputNames.clear();
       inputDims.clear();
@@ -82,6 +97,9 @@ namespace NeuralNetworkONNX
       outputDims.clear();
       outputSizes.clear();
       outputTensors.clear();
+      cachedBatches.clear();
+      dynamicBatch = false;
+      batchSize = 1;
     }
 
   public:
@@ -195,12 +213,14 @@ namespace NeuralNetworkONNX
       session = Ort::Session(environment(), model.filename.c_str(), sessionOptions);
 #endif
       // Create the names, tensors, dimensions, sizes, and buffers for all inputs.
+      dynamicBatch = true;
       for(size_t i = 0; i < session.GetInputCount(); i++)
       {
         inputNames.emplace_back(session.GetInputName(i, allocator));
         if(session.GetInputTypeInfo(i).GetTensorTypeAndShapeInfo().GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT)
           ORT_CXX_API_THROW("Network inputs must be float values", ORT_FAIL);
         inputDims.emplace_back(session.GetInputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
+        dynamicBatch &= !inputDims.back().empty() && inputDims.back()[0] <= 0;
         size_t size = 1;
         for(int64_t& dim : inputDims.back())
         {
@@ -219,6 +239,7 @@ namespace NeuralNetworkONNX
         if(session.GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT)
           ORT_CXX_API_THROW("Network outputs must be float values", ORT_FAIL);
         outputDims.emplace_back(session.GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
+        dynamicBatch &= !outputDims.back().empty() && outputDims.back()[0] <= 0;
         size_t size = 1;
         for(int64_t& dim : outputDims.back())
         {
@@ -249,6 +270,63 @@ namespace NeuralNetworkONNX
                   outputNames.data(), outputTensors.data(), outputTensors.size());
     }
 
+    /**
+     * Sets the number of samples processed by \c apply. The inputs and
+     * outputs then contain that many samples one after another. This is
+     * only possible if the first dimension of all inputs and outputs of
+     * the model is dynamic. The contents of the tensors are lost. The
+     * tensors of each batch size are only created once and are kept while
+     * other batch sizes are used.
+     * @param batchSize The number of samples.
+     * @return Could the batch size be set?
+     */
+    bool setBatchSize(size_t batchSize)
+    {
+      if(!dynamicBatch || batchSize == 0)
+        return false;
+      if(batchSize != this->batchSize)
+      {
+        CachedBatch& previous = cachedBatches[this->batchSize];
+        previous.inputTensors = std::move(inputTensors);
+        previous.outputTensors = std::move(outputTensors);
+        previous.uint8Buffers = std::move(uint8Buffers);
+
+        const auto resize = [&](std::vector<int64_t>& dims, size_t& size)
+        {
+          size = size / static_cast<size_t>(dims[0]) * batchSize;
+          dims[0] = static_cast<int64_t>(batchSize);
+        };
+        for(size_t i = 0; i < inputDims.size(); ++i)
+          resize(inputDims[i], inputSizes[i]);
+        for(size_t i = 0; i < outputDims.size(); ++i)
+          resize(outputDims[i], outputSizes[i]);
+
+        const auto cached = cachedBatches.find(batchSize);
+        if(cached != cachedBatches.end())
+        {
+          inputTensors = std::move(cached->second.inputTensors);
+          outputTensors = std::move(cached->second.outputTensors);
+          uint8Buffers = std::move(cached->second.uint8Buffers);
+          cachedBatches.erase(cached);
+        }
+        else
+        {
+          inputTensors.clear();
+          outputTensors.clear();
+          uint8Buffers.clear();
+          for(size_t i = 0; i < inputDims.size(); ++i)
+          {
+            inputTensors.emplace_back(Ort::Value::CreateTensor<float>(allocator, inputDims[i].data(), inputDims[i].size()));
+            uint8Buffers.emplace_back(previous.uint8Buffers[i] ? new unsigned char[inputSizes[i]] : nullptr);
+          }
+          for(size_t i = 0; i < outputDims.size(); ++i)
+            outputTensors.emplace_back(Ort::Value::CreateTensor<float>(allocator, outputDims[i].data(), outputDims[i].size()));
+        }
+        this->batchSize = batchSize;
+      }
+      return true;
+    }
+
     /**
      * Was the network successfully compiled?
      * @return Always true after \c compile has been called, because ONNX would have terminated the program
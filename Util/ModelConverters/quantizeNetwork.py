@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+
+# Creates an int8-quantized variant "<name>.int8.onnx" of the network
+# "<name>.onnx". The quantization is calibrated with the inputs recorded by
+# the InferenceEngine in "<name>.inputs" (see recordInterval in
+# Config/inference.cfg). Each recorded sample contains all inputs of the
+# network in order, as 32 bit floats.
+
+import os
+import sys
+
+import numpy as np
+import onnx
+from onnx import version_converter
+from onnxruntime.quantization import CalibrationDataReader, QuantType, quantize_static
+
+if len(sys.argv) < 2:
+    print('Usage: quantizeNetwork.py FILE.onnx [MAX_SAMPLES]', file=sys.stderr)
+    exit(1)
+
+model_file = sys.argv[1]
+max_samples = int(sys.argv[2]) if len(sys.argv) > 2 else 500
+base = model_file[:-len('.onnx')] if model_file.endswith('.onnx') else model_file
+inputs_file = base + '.inputs'
+if not os.path.exists(inputs_file):
+    print(f'{inputs_file} does not exist. Record inputs first.', file=sys.stderr)
+    exit(1)
+
+model = onnx.load(base + '.onnx')
+
+# Per-channel quantization requires at least opset 13.
+quantization_input = base + '.onnx'
+if model.opset_import[0].version < 13:
+    model = version_converter.convert_version(model, 13)
+    quantization_input = base + '.opset13.onnx'
+    onnx.save(model, quantization_input)
+
+initializers = {i.name for i in model.graph.initializer}
+inputs = []
+for i in model.graph.input:
+    if i.name in initializers:
+        continue
+    shape = [d.dim_value if d.dim_value > 0 else 1 for d in i.type.tensor_type.shape.dim]
+    inputs.append((i.name, shape))
+
+sample_size = sum(int(np.prod(shape)) for _, shape in inputs)
+data = np.fromfile(inputs_file, dtype=np.float32)
+num_of_samples = min(len(data) // sample_size, max_samples)
+if num_of_samples == 0:
+    print(f'{inputs_file} does not contain a complete sample.', file=sys.stderr)
+    exit(1)
+samples = data[:num_of_samples * sample_size].reshape(num_of_samples, sample_size)
+
+
+class RecordedInputs(CalibrationDataReader):
+    def __init__(self):
+        self.index = 0
+
+    def get_next(self):
+        if self.index == num_of_samples:
+            return None
+        sample = samples[self.index]
+        self.index += 1
+        feed = {}
+        offset = 0
+        for name, shape in inputs:
+            size = int(np.prod(shape))
+            feed[name] = sample[offset:offset + size].reshape(shape)
+            offset += size
+        return feed
+
+
+quantize_static(quantization_input, base + '.int8.onnx', RecordedInputs(),
+                activation_type=QuantType.QUInt8, weight_type=QuantType.QInt8, per_channel=True)
+if quantization_input != base + '.onnx':
+    os.remove(quantization_input)
+print(f'Created {base}.int8.onnx from {num_of_samples} samples.')